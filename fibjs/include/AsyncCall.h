@@ -17,7 +17,8 @@ private:
 
 public:
     AsyncEvent(Isolate* isolate = NULL)
-        : m_isolate(isolate)
+        : m_queued(0)
+        , m_isolate(isolate)
         , m_state(kStateSync)
     {
     }
@@ -95,6 +96,9 @@ public:
     std::vector<Variant> m_ctx;
     obj_ptr<object_base> m_ctxo;
 
+    // uv_hrtime() when async() queued the event, for the pool latency stats
+    uint64_t m_queued;
+
 protected:
     Isolate* m_isolate;
 
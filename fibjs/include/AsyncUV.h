@@ -12,19 +12,37 @@
 #include <uv/include/uv.h>
 #include <functional>
 
+#define MAX_UV_LOOPS 64
+
 namespace fibjs {
 extern uv_loop_t* s_uv_loop;
 
+int32_t uv_loop_count();
+result_t uv_set_loop_count(int32_t count);
+uv_loop_t* uv_get_loop(int32_t no);
+uv_loop_t* uv_select_loop();
+int32_t uv_loop_pending(int32_t no);
+
 void uv_post(AsyncEvent* task);
 void uv_post(std::function<void(void)> proc);
+void uv_post(uv_loop_t* loop, AsyncEvent* task);
+void uv_post(uv_loop_t* loop, std::function<void(void)> proc);
 
 int uv_call(std::function<int(void)> proc);
+int uv_call(uv_loop_t* loop, std::function<int(void)> proc);
+
 inline int uv_async(std::function<int(void)> proc)
 {
     int ret = uv_call(proc);
     return ret ? ret : CALL_E_PENDDING;
 }
 
+inline int uv_async(uv_loop_t* loop, std::function<int(void)> proc)
+{
+    int ret = uv_call(loop, proc);
+    return ret ? ret : CALL_E_PENDDING;
+}
+
 class AutoReq : public uv_fs_t {
 public:
     ~AutoReq()
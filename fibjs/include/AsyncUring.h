@@ -0,0 +1,32 @@
+/*
+ * AsyncUring.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include <uv/include/uv.h>
+
+namespace fibjs {
+
+// file io through io_uring, turned on by --io-uring on kernels that have it.
+// each call only blocks the calling fiber, many fibers calling at once share one io_uring_enter.
+// without a ring, or when the ring is full, the calls fall back to the plain syscalls.
+
+// read, write and open behave like the syscalls they replace, they return -1 and set errno on failure.
+// pos is the file offset to use, -1 for the current position of fd.
+int32_t uring_read(int32_t fd, void* buf, int32_t len, int64_t pos = -1);
+int32_t uring_write(int32_t fd, const void* buf, int32_t len, int64_t pos = -1);
+int32_t uring_open(const char* path, int32_t flags, int32_t mode);
+
+// fsync and stat stand in for the synchronous uv_fs_* calls, they return 0 or a uv error code.
+int32_t uring_fsync(int32_t fd, bool datasync = false);
+int32_t uring_stat(const char* path, bool follow, uv_stat_t* statbuf);
+int32_t uring_fstat(int32_t fd, uv_stat_t* statbuf);
+
+// "IoUring" when the ring is up, "Sync" otherwise
+const char* uring_backend();
+
+} /* namespace fibjs */
@@ -19,7 +19,7 @@ public:
                 memcpy(data(), _data, _length);
         }
 
-        store(store& s)
+        store(const store& s)
             : m_store(s.m_store)
             , m_offset(s.m_offset)
             , m_length(s.m_length)
@@ -113,6 +113,11 @@ public:
         m_store.resize(length);
     }
 
+    const store& get_store() const
+    {
+        return m_store;
+    }
+
     static Buffer* Cast(Buffer_base* buf)
     {
         return static_cast<Buffer*>(buf);
@@ -8,8 +8,9 @@
 #pragma once
 
 #include "ifs/BufferedStream.h"
-#include "StringBuffer.h"
+#include "Buffer.h"
 #include "encoding_iconv.h"
+#include <deque>
 
 namespace fibjs {
 
@@ -18,6 +19,7 @@ public:
     BufferedStream(Stream_base* stm)
         : m_stm(stm)
         , m_pos(0)
+        , m_size(0)
         , m_temp(0)
     {
 #ifdef _WIN32
@@ -52,26 +54,57 @@ public:
     virtual result_t set_EOL(exlib::string newVal);
 
 public:
-    void append(int32_t n)
+    static BufferedStream* Cast(BufferedStream_base* stm)
     {
-        if (n > 0) {
-            if (m_pos == 0 && n == (int32_t)m_buf.length())
-                m_strbuf.append(m_buf);
-            else {
-                exlib::string s1(m_buf.substr(m_pos, n));
-                m_strbuf.append(s1);
-            }
-            m_pos += n;
+        return static_cast<BufferedStream*>(stm);
+    }
+
+    // the buffered data that is contiguous in memory, from the read position
+    const char* peek(int32_t& len)
+    {
+        if (m_bufs.empty()) {
+            len = 0;
+            return NULL;
         }
+
+        Buffer::store& data = m_bufs.front();
+        len = (int32_t)data.length() - m_pos;
+        return (const char*)data.data() + m_pos;
     }
 
+    void push(Buffer_base* buf)
+    {
+        Buffer::store data(Buffer::Cast(buf)->get_store());
+
+        if (data.length() > 0) {
+            m_size += (int32_t)data.length();
+            m_bufs.push_back(data);
+        }
+    }
+
+    void clear()
+    {
+        m_bufs.clear();
+        m_pos = 0;
+        m_size = 0;
+    }
+
+    // copies n buffered bytes to p without moving the read position
+    void copy(char* p, int32_t n);
+    void skip(int32_t n);
+    void take(int32_t n, obj_ptr<Buffer_base>& retVal);
+    void take(int32_t n, exlib::string& retVal);
+
 public:
     obj_ptr<Stream_base> m_stm;
-    exlib::string m_buf;
+    // buffers as they came from m_stm, m_pos is the read position in the first one
+    // and m_size counts the bytes left in all of them
+    std::deque<Buffer::store> m_bufs;
     int32_t m_pos;
+    int32_t m_size;
+    // bytes readUntil has already searched
     int32_t m_temp;
     exlib::string m_eol;
-    StringBuffer m_strbuf;
     encoding_iconv m_iconv;
 };
 
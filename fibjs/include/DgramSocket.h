@@ -10,14 +10,21 @@
 #include "ifs/DgramSocket.h"
 #include "AsyncUV.h"
 #include "Buffer.h"
+#include "SimpleObject.h"
+#include "inetAddr.h"
+#include <vector>
 
 namespace fibjs {
 
 class DgramSocket : public DgramSocket_base {
 public:
     DgramSocket()
-        : m_flags(0)
+        : m_loop(uv_select_loop())
+        , m_flags(0)
         , m_bound(false)
+        , m_recv_batch(1)
+        , m_gso(false)
+        , m_slab_used(0)
     {
     }
 
@@ -33,7 +40,7 @@ public:
             return;
         }
 
-        uv_post([&] {
+        uv_post(m_loop, [&] {
             uv_close(&m_handle, on_delete);
             return 0;
         });
@@ -50,6 +57,7 @@ public:
     virtual result_t bind(v8::Local<v8::Object> opts, AsyncEvent* ac);
     virtual result_t send(Buffer_base* msg, int32_t port, exlib::string address, int32_t& retVal, AsyncEvent* ac);
     virtual result_t send(Buffer_base* msg, int32_t offset, int32_t length, int32_t port, exlib::string address, int32_t& retVal, AsyncEvent* ac);
+    virtual result_t sendBatch(v8::Local<v8::Array> msgs, int32_t port, exlib::string address, int32_t& retVal, AsyncEvent* ac);
     virtual result_t address(obj_ptr<NObject>& retVal);
     virtual result_t close();
     virtual result_t close(v8::Local<v8::Function> callback);
@@ -68,6 +76,10 @@ public:
     void stop_bind();
 
 private:
+    result_t resolve(int32_t port, exlib::string address, inetAddr& retVal);
+    int32_t send_mmsg(std::vector<uv_buf_t>& bufs, inetAddr& addr, int32_t& bytes);
+    obj_ptr<Buffer> slab(const char* data, size_t length);
+
     static void on_alloc(uv_handle_t* handle, size_t suggested_size, uv_buf_t* buf);
     static void on_recv(uv_udp_t* handle, ssize_t nread, const uv_buf_t* buf, const struct sockaddr* addr, unsigned flags);
 
@@ -76,13 +88,22 @@ public:
         uv_handle_t m_handle;
         uv_udp_t m_udp;
     };
+    uv_loop_t* m_loop;
     int32_t m_family;
     int32_t m_flags;
     bool m_bound;
     int32_t m_recvbuf_size = -1;
     int32_t m_sendbuf_size = -1;
 
+    // datagrams taken by one recvmmsg, and whether sendBatch may use UDP GSO
+    int32_t m_recv_batch;
+    bool m_gso;
+
+    // recvmmsg lands in m_buf, small datagrams are then copied into a shared slab
+    // and handed out as views on it instead of one allocation each.
     exlib::string m_buf;
+    std::shared_ptr<v8::BackingStore> m_slab;
+    size_t m_slab_used;
 
     obj_ptr<ValueHolder> m_holder;
 };
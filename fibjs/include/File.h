@@ -5,6 +5,7 @@
 #include "Stat.h"
 #include "utf8.h"
 #include "Buffer.h"
+#include "AsyncUring.h"
 
 #include <fcntl.h>
 
@@ -71,6 +72,10 @@ public:
     virtual result_t get_fd(int32_t& retVal);
     virtual result_t chmod(int32_t mode, AsyncEvent* ac);
 
+public:
+    static bool canSendFile(Stream_base* stm);
+    result_t sendTo(Stream_base* stm, int64_t pos, int64_t bytes, int64_t& retVal, AsyncEvent* ac);
+
 public:
     result_t open(exlib::string fname, exlib::string flags);
     result_t close();
@@ -116,7 +121,7 @@ inline result_t file_open(exlib::string fname, exlib::string flags, int32_t mode
 #ifdef _WIN32
     fd = _wopen(UTF8_W(fname), _flags, _S_IREAD | _S_IWRITE);
 #else
-    fd = ::open(fname.c_str(), _flags, mode);
+    fd = uring_open(fname.c_str(), _flags, mode);
 #endif
     if (fd < 0)
         return CHECK_ERROR(LastError());
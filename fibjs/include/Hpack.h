@@ -0,0 +1,107 @@
+/*
+ * Hpack.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include "utils.h"
+#include <deque>
+#include <vector>
+
+namespace fibjs {
+
+// header compression for HTTP/2, RFC 7541
+class Hpack {
+public:
+    static const int32_t HPACK_STATIC_SIZE = 61;
+    static const int32_t HPACK_ENTRY_OVERHEAD = 32;
+    static const int32_t HPACK_DEFAULT_SIZE = 4096;
+
+    typedef std::pair<exlib::string, exlib::string> header;
+
+public:
+    class Table {
+    public:
+        Table()
+            : m_size(0)
+            , m_maxSize(HPACK_DEFAULT_SIZE)
+        {
+        }
+
+    public:
+        // index is 1 based and counts the static table first, as on the wire
+        const header* get(uint32_t index) const;
+        void add(const exlib::string& name, const exlib::string& value);
+        void resize(uint32_t maxSize);
+
+        // returns the index of the best match, exact is set when the value matches too
+        uint32_t find(const exlib::string& name, const exlib::string& value, bool& exact) const;
+
+    public:
+        std::deque<header> m_entries;
+        uint32_t m_size;
+        uint32_t m_maxSize;
+    };
+
+    class Encoder {
+    public:
+        Encoder()
+            : m_pending(false)
+            , m_limit(HPACK_DEFAULT_SIZE)
+        {
+        }
+
+    public:
+        // peer SETTINGS_HEADER_TABLE_SIZE, announced at the start of the next header block
+        void set_max_size(uint32_t maxSize);
+        void encode(const std::vector<header>& headers, exlib::string& out);
+
+    private:
+        void encode(const exlib::string& name, const exlib::string& value, exlib::string& out);
+
+    private:
+        Table m_table;
+        bool m_pending;
+        uint32_t m_limit;
+    };
+
+    class Decoder {
+    public:
+        Decoder()
+            : m_limit(HPACK_DEFAULT_SIZE)
+        {
+        }
+
+    public:
+        // our SETTINGS_HEADER_TABLE_SIZE, the peer can only shrink the table below it
+        void set_limit(uint32_t limit)
+        {
+            m_limit = limit;
+            if (m_table.m_maxSize > limit)
+                m_table.resize(limit);
+        }
+
+        // maxSize bounds the decoded header list, counted as in SETTINGS_MAX_HEADER_LIST_SIZE
+        result_t decode(const uint8_t* data, size_t len, std::vector<header>& headers, size_t maxSize);
+
+    private:
+        Table m_table;
+        uint32_t m_limit;
+    };
+
+public:
+    static void encode_int(exlib::string& out, uint8_t prefix, int32_t bits, uint32_t value);
+    static bool decode_int(const uint8_t*& p, const uint8_t* end, int32_t bits, uint32_t& value);
+
+    static void encode_str(exlib::string& out, const exlib::string& str);
+    static bool decode_str(const uint8_t*& p, const uint8_t* end, exlib::string& str);
+
+    static size_t huffman_size(const exlib::string& str);
+    static void huffman_encode(exlib::string& out, const exlib::string& str);
+    static bool huffman_decode(const uint8_t* p, size_t len, exlib::string& str);
+};
+
+} /* namespace fibjs */
@@ -0,0 +1,282 @@
+/*
+ * Http2Session.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include "ifs/Stream.h"
+#include "ifs/SeekableStream.h"
+#include "HttpRequest.h"
+#include "HttpResponse.h"
+#include "Hpack.h"
+#include <unordered_map>
+#include <deque>
+#include <vector>
+
+namespace fibjs {
+
+// one HTTP/2 connection, RFC 9113, with any number of requests multiplexed as streams
+// the session is a client unless it is given a dispatcher for the requests it receives
+class Http2Session : public obj_base {
+public:
+    enum {
+        FRAME_DATA = 0,
+        FRAME_HEADERS = 1,
+        FRAME_PRIORITY = 2,
+        FRAME_RST_STREAM = 3,
+        FRAME_SETTINGS = 4,
+        FRAME_PUSH_PROMISE = 5,
+        FRAME_PING = 6,
+        FRAME_GOAWAY = 7,
+        FRAME_WINDOW_UPDATE = 8,
+        FRAME_CONTINUATION = 9
+    };
+
+    enum {
+        FLAG_END_STREAM = 0x1,
+        FLAG_ACK = 0x1,
+        FLAG_END_HEADERS = 0x4,
+        FLAG_PADDED = 0x8,
+        FLAG_PRIORITY = 0x20
+    };
+
+    enum {
+        SETTINGS_HEADER_TABLE_SIZE = 1,
+        SETTINGS_ENABLE_PUSH = 2,
+        SETTINGS_MAX_CONCURRENT_STREAMS = 3,
+        SETTINGS_INITIAL_WINDOW_SIZE = 4,
+        SETTINGS_MAX_FRAME_SIZE = 5,
+        SETTINGS_MAX_HEADER_LIST_SIZE = 6
+    };
+
+    enum {
+        NO_ERROR = 0,
+        PROTOCOL_ERROR = 1,
+        INTERNAL_ERROR = 2,
+        FLOW_CONTROL_ERROR = 3,
+        STREAM_CLOSED = 5,
+        FRAME_SIZE_ERROR = 6,
+        REFUSED_STREAM = 7,
+        CANCEL = 8,
+        COMPRESSION_ERROR = 9,
+        ENHANCE_YOUR_CALM = 11
+    };
+
+    static const int32_t FRAME_HEADER_SIZE = 9;
+    static const int32_t DEFAULT_WINDOW = 65535;
+    static const int32_t DEFAULT_FRAME_SIZE = 16384;
+    static const int32_t MAX_WINDOW = 0x7fffffff;
+    static const int32_t STREAM_WINDOW = 1024 * 1024;
+    static const int32_t SESSION_WINDOW = 16 * 1024 * 1024;
+
+public:
+    class Stream;
+
+    class Dispatcher : public obj_base {
+    public:
+        // called with a complete request, outside the session lock
+        virtual void dispatch(Http2Session* session, Stream* s) = 0;
+    };
+
+public:
+    Http2Session(Stream_base* conn, Dispatcher* dispatcher = NULL)
+        : m_maxHeadersCount(128)
+        , m_maxHeaderSize(8192)
+        , m_maxBodySize(-1)
+        , m_maxStreams(100)
+        , m_tableSize(Hpack::HPACK_DEFAULT_SIZE)
+        , m_closed(false)
+        , m_writing(false)
+        , m_dispatcher(dispatcher)
+        , m_conn(conn)
+        , m_server(dispatcher != NULL)
+        , m_preface(0)
+        , m_closeAc(NULL)
+        , m_nextId(dispatcher ? 2 : 1)
+        , m_lastPeerId(0)
+        , m_goaway(false)
+        , m_sendWindow(DEFAULT_WINDOW)
+        , m_recvUnacked(0)
+        , m_peerInitialWindow(DEFAULT_WINDOW)
+        , m_peerMaxFrameSize(DEFAULT_FRAME_SIZE)
+        , m_peerMaxStreams(100)
+        , m_headerStream(0)
+        , m_headerFlags(0)
+        , m_inPos(0)
+    {
+    }
+
+public:
+    class Stream : public obj_base {
+    public:
+        Stream(int32_t id, int32_t sendWindow)
+            : m_id(id)
+            , m_sendWindow(sendWindow)
+            , m_recvUnacked(0)
+            , m_outPos(0)
+            , m_outEnd(false)
+            , m_localClosed(false)
+            , m_remoteClosed(false)
+            , m_noBody(false)
+            , m_retVal(NULL)
+            , m_ac(NULL)
+        {
+        }
+
+    public:
+        int32_t m_id;
+        int32_t m_sendWindow;
+        int32_t m_recvUnacked;
+
+        std::vector<Hpack::header> m_headers;
+        exlib::string m_out;
+        size_t m_outPos;
+        bool m_outEnd;
+
+        bool m_localClosed;
+        bool m_remoteClosed;
+        bool m_noBody;
+
+        obj_ptr<HttpRequest> m_request;
+        obj_ptr<HttpResponse> m_response;
+        obj_ptr<SeekableStream_base> m_body;
+        exlib::string m_data;
+        obj_ptr<HttpResponse_base>* m_retVal;
+        AsyncEvent* m_ac;
+    };
+
+public:
+    // sends the connection preface and starts reading frames
+    void start();
+    void close();
+
+    bool closed()
+    {
+        return m_closed || m_goaway;
+    }
+
+    // true when no stream has been open for timeout ms
+    bool idle(date_t d, double timeout);
+
+    result_t request(HttpRequest_base* req, SeekableStream_base* response_body,
+        obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac);
+
+    // server side, ac is posted when the connection is over
+    // bPreface is set when the client connection preface has not been read from conn yet
+    result_t serve(bool bPreface, AsyncEvent* ac);
+
+    // answers a stream handed out by the dispatcher, ac is posted once the response is sent
+    result_t respond(Stream* s, HttpResponse_base* rep, bool bHead, AsyncEvent* ac);
+
+public:
+    // used by the reader and writer fibers
+    bool pull(exlib::string& out);
+    result_t feed(const uint8_t* data, size_t len);
+    void shutdown(exlib::string msg);
+
+public:
+    int32_t m_maxHeadersCount;
+    int32_t m_maxHeaderSize;
+    int32_t m_maxBodySize;
+    int32_t m_maxStreams;
+    int32_t m_tableSize;
+
+    exlib::spinlock m_lock;
+    bool m_closed;
+    bool m_writing;
+
+    obj_ptr<Dispatcher> m_dispatcher;
+
+private:
+    static result_t build(HttpRequest_base* req, std::vector<Hpack::header>& headers);
+    size_t max_header_list();
+
+    // a stream id the peer has not opened yet
+    bool is_idle(int32_t id)
+    {
+        return m_server ? !(id & 1) || id > m_lastPeerId : id >= m_nextId;
+    }
+
+    result_t submit(Stream* s);
+    void open(Stream* s);
+    void release(Stream* s);
+    void flush();
+    result_t reply(Stream* s, std::vector<Hpack::header>& headers, exlib::string& body, AsyncEvent* ac);
+
+    void frame(exlib::string& out, int32_t type, int32_t flags, int32_t id, const char* data, size_t len);
+    void settings(exlib::string& out, int32_t id, uint32_t value);
+    void send_headers(Stream* s, exlib::string& block);
+    void send_rst(int32_t id, int32_t code);
+    void send_goaway(int32_t code);
+    result_t protocol_error(int32_t code, const char* msg);
+
+    result_t on_frame(int32_t type, int32_t flags, int32_t id, const uint8_t* p, size_t len);
+    result_t on_data(int32_t flags, int32_t id, const uint8_t* p, size_t len);
+    result_t on_headers(int32_t id, exlib::string& block, bool endStream);
+    result_t on_response(int32_t id, std::vector<Hpack::header>& headers, bool endStream);
+    result_t on_request(int32_t id, std::vector<Hpack::header>& headers, bool endStream);
+    result_t on_settings(int32_t flags, const uint8_t* p, size_t len);
+    result_t on_window_update(int32_t id, const uint8_t* p, size_t len);
+    result_t on_rst(int32_t id, const uint8_t* p, size_t len);
+    result_t on_goaway(const uint8_t* p, size_t len);
+
+    void end_local(Stream* s);
+    void end_remote(Stream* s);
+    void finish(Stream* s);
+    void fail(Stream* s, exlib::string msg);
+    void done();
+
+private:
+    class _job {
+    public:
+        _job()
+            : m_dispatch(false)
+        {
+        }
+
+    public:
+        obj_ptr<Stream> m_stream;
+        exlib::string m_error;
+        bool m_dispatch;
+    };
+
+    obj_ptr<Stream_base> m_conn;
+    bool m_server;
+    size_t m_preface;
+    AsyncEvent* m_closeAc;
+
+    int32_t m_nextId;
+    int32_t m_lastPeerId;
+    bool m_goaway;
+    date_t m_last;
+
+    int32_t m_sendWindow;
+    int32_t m_recvUnacked;
+    int32_t m_peerInitialWindow;
+    int32_t m_peerMaxFrameSize;
+    int32_t m_peerMaxStreams;
+
+    Hpack::Encoder m_encoder;
+    Hpack::Decoder m_decoder;
+
+    std::unordered_map<int32_t, obj_ptr<Stream>> m_streams;
+    std::deque<obj_ptr<Stream>> m_pending;
+    std::deque<obj_ptr<Stream>> m_sending;
+    exlib::string m_frames;
+
+    // a header block split over CONTINUATION frames
+    int32_t m_headerStream;
+    int32_t m_headerFlags;
+    exlib::string m_headerBlock;
+
+    // completions are collected under the lock and delivered after it is released
+    std::vector<_job> m_jobs;
+
+    exlib::string m_in;
+    size_t m_inPos;
+};
+
+} /* namespace fibjs */
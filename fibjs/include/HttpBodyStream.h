@@ -0,0 +1,82 @@
+/*
+ * HttpBodyStream.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include "ifs/SeekableStream.h"
+#include "BufferedStream.h"
+#include <vector>
+
+namespace fibjs {
+
+// request body left on the connection, read as the handler reads it.
+// content-length and chunked bodies are decoded on the way, maxBodySize is checked as the data arrives.
+// the stream only moves forward, seek is allowed to the current position only.
+class HttpBodyStream : public SeekableStream_base {
+public:
+    // length is the content-length, -1 for a chunked body.
+    // maxBodySize is in MB as on HttpMessage, maxLineSize limits chunk size and trailer lines.
+    HttpBodyStream(BufferedStream* stm, int64_t length, int32_t maxBodySize, int32_t maxLineSize)
+        : m_stm(stm)
+        , m_length(length)
+        , m_left(length > 0 ? length : 0)
+        , m_pos(0)
+        , m_limit(maxBodySize >= 0 ? (int64_t)maxBodySize * 1024 * 1024 : -1)
+        , m_maxLineSize(maxLineSize)
+        , m_end(length == 0)
+        , m_closed(false)
+        , m_error(0)
+    {
+    }
+
+public:
+    // Stream_base
+    virtual result_t get_fd(int32_t& retVal);
+    virtual result_t read(int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
+    virtual result_t write(Buffer_base* data, AsyncEvent* ac);
+    virtual result_t flush(AsyncEvent* ac);
+    virtual result_t close(AsyncEvent* ac);
+    virtual result_t copyTo(Stream_base* stm, int64_t bytes, int64_t& retVal, AsyncEvent* ac);
+
+public:
+    // SeekableStream_base
+    virtual result_t seek(int64_t offset, int32_t whence);
+    virtual result_t tell(int64_t& retVal);
+    virtual result_t rewind();
+    virtual result_t size(int64_t& retVal);
+    virtual result_t readAll(obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
+    virtual result_t truncate(int64_t bytes, AsyncEvent* ac);
+    virtual result_t eof(bool& retVal);
+    virtual result_t stat(obj_ptr<Stat_base>& retVal, AsyncEvent* ac);
+
+public:
+    // reads and drops whatever the handler left, so the next request on a keep-alive
+    // connection starts at its head. works after close.
+    result_t drain(AsyncEvent* ac);
+
+    bool ended()
+    {
+        return m_end;
+    }
+
+private:
+    // bytes < 0 returns the next piece of the body, at most STREAM_BUFF_SIZE
+    result_t _read(int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
+
+private:
+    obj_ptr<BufferedStream> m_stm;
+    int64_t m_length;
+    int64_t m_left;
+    int64_t m_pos;
+    int64_t m_limit;
+    int32_t m_maxLineSize;
+    bool m_end;
+    bool m_closed;
+    result_t m_error;
+};
+
+} /* namespace fibjs */
@@ -9,6 +9,9 @@
 #include "ifs/HttpClient.h"
 #include "HttpCookie.h"
 #include "Url.h"
+#include "Http2Session.h"
+#include <deque>
+#include <unordered_map>
 
 namespace fibjs {
 
@@ -27,6 +30,9 @@ public:
         , m_maxBodySize(-1)
         , m_poolSize(128)
         , m_poolTimeout(10000)
+        , m_maxConnsPerHost(0)
+        , m_pipelining(1)
+        , m_enableHttp2(false)
     {
         m_cookies = new NArray();
         m_userAgent = "Mozilla/5.0 AppleWebKit/537.36 (KHTML, like Gecko) Chrome/54.0.2840.98 Safari/537.36";
@@ -55,6 +61,12 @@ public:
     virtual result_t set_poolSize(int32_t newVal);
     virtual result_t get_poolTimeout(int32_t& retVal);
     virtual result_t set_poolTimeout(int32_t newVal);
+    virtual result_t get_maxConnsPerHost(int32_t& retVal);
+    virtual result_t set_maxConnsPerHost(int32_t newVal);
+    virtual result_t get_pipelining(int32_t& retVal);
+    virtual result_t set_pipelining(int32_t newVal);
+    virtual result_t get_enableHttp2(bool& retVal);
+    virtual result_t set_enableHttp2(bool newVal);
     virtual result_t get_http_proxy(exlib::string& retVal);
     virtual result_t set_http_proxy(exlib::string newVal);
     virtual result_t get_https_proxy(exlib::string& retVal);
@@ -70,6 +82,7 @@ public:
     virtual result_t put(exlib::string url, v8::Local<v8::Object> opts, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac);
     virtual result_t patch(exlib::string url, v8::Local<v8::Object> opts, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac);
     virtual result_t head(exlib::string url, v8::Local<v8::Object> opts, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac);
+    virtual result_t stats(v8::Local<v8::Object>& retVal);
 
 public:
     result_t init(v8::Local<v8::Object> options);
@@ -86,57 +99,70 @@ public:
     }
 
 public:
-    void clean_coon(date_t d)
-    {
-        std::vector<obj_ptr<Conn>> keep_conns;
-
-        m_lock.lock();
-        while (((int32_t)m_conns.size() > m_poolSize)
-            || (m_conns.size() && d.diff(m_conns[0]->d) >= (double)m_poolTimeout)) {
-            keep_conns.push_back(m_conns[0]);
-            m_conns.erase(m_conns.begin());
+    class Conn : public obj_base {
+    public:
+        Conn(Stream_base* _conn)
+            : conn(_conn)
+            , m_requests(0)
+            , m_tickets(0)
+            , m_idempotent(true)
+            , m_reusable(true)
+            , m_sent(0)
+            , m_read(0)
+            , m_broken(false)
+        {
         }
-        m_lock.unlock();
-    }
 
-    void save_conn(exlib::string url, Stream_base* _conn)
-    {
-        obj_ptr<Conn> conn = new Conn();
+    public:
+        // requests on one connection take tickets in send order and read their responses in the same order,
+        // both return 0 when it is already the turn of ticket, CALL_E_PENDDING after queuing ac
+        result_t wait_send(int32_t ticket, AsyncEvent* ac);
+        result_t wait_recv(int32_t ticket, AsyncEvent* ac);
+        void sent();
+        void received();
 
-        conn->d.now();
-        conn->url = url;
-        conn->conn = _conn;
+        // fails every request still queued on the connection
+        void fail();
 
-        clean_coon(conn->d);
+    public:
+        date_t d;
+        obj_ptr<Stream_base> conn;
+        obj_ptr<Stream_base> m_bs;
 
-        m_lock.lock();
-        m_conns.push_back(conn);
-        if ((int32_t)m_conns.size() > m_poolSize) {
-            conn = m_conns[0];
-            m_conns.erase(m_conns.begin());
-        }
-        m_lock.unlock();
-    }
+        // guarded by HttpClient::m_lock
+        int32_t m_requests;
+        int32_t m_tickets;
+        bool m_idempotent;
+        bool m_reusable;
 
-    bool get_conn(exlib::string url, obj_ptr<Stream_base>& _conn)
-    {
-        date_t d;
+    private:
+        result_t wait(int32_t& turn, std::unordered_map<int32_t, AsyncEvent*>& waits, int32_t ticket, AsyncEvent* ac);
+        void pass(int32_t& turn, std::unordered_map<int32_t, AsyncEvent*>& waits);
 
-        d.now();
-        clean_coon(d);
+    private:
+        exlib::spinlock m_lock;
+        int32_t m_sent;
+        int32_t m_read;
+        bool m_broken;
+        std::unordered_map<int32_t, AsyncEvent*> m_sendWaits;
+        std::unordered_map<int32_t, AsyncEvent*> m_recvWaits;
+    };
 
-        m_lock.lock();
-        for (std::vector<obj_ptr<Conn>>::iterator it = m_conns.begin(); it != m_conns.end(); it++)
-            if ((*it)->url == url) {
-                _conn = (*it)->conn;
-                m_conns.erase(it);
+public:
+    // returns 0 with a pooled connection in conn, or with conn empty when a new connection may be opened,
+    // CALL_E_PENDDING when the host is at maxConnsPerHost and ac has been queued
+    result_t acquire(exlib::string key, bool idempotent, obj_ptr<Conn>& conn, int32_t& ticket, AsyncEvent* ac);
+    void attach(exlib::string key, Stream_base* stream, bool idempotent, double connectTime, obj_ptr<Conn>& conn);
+    void release(exlib::string key, Conn* conn, bool keepAlive);
+    void clean_coon(date_t d);
 
-                m_lock.unlock();
-                return true;
-            }
-        m_lock.unlock();
-        return false;
-    }
+    // returns 0 with a live session, or with negotiate set when the caller should try h2 on a new connection,
+    // with neither when the host only speaks HTTP/1.1, CALL_E_PENDDING while another request is negotiating
+    result_t h2_acquire(exlib::string key, obj_ptr<Http2Session>& session, bool& negotiate, AsyncEvent* ac);
+    void h2_finish(exlib::string key, Http2Session* session, bool h1);
+
+    result_t _request(Stream_base* conn, Conn* pc, int32_t ticket, HttpRequest_base* req,
+        SeekableStream_base* response_body, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac);
 
 private:
     result_t update(HttpCookie_base* cookie);
@@ -155,16 +181,89 @@ private:
     exlib::string m_userAgent;
 
 private:
-    class Conn : public obj_base {
+    class Counters {
     public:
-        date_t d;
-        exlib::string url;
-        obj_ptr<Stream_base> conn;
+        Counters()
+            : m_requests(0)
+            , m_reused(0)
+            , m_pipelined(0)
+            , m_connects(0)
+            , m_connectTime(0)
+        {
+        }
+
+    public:
+        void add(const Counters& c)
+        {
+            m_requests += c.m_requests;
+            m_reused += c.m_reused;
+            m_pipelined += c.m_pipelined;
+            m_connects += c.m_connects;
+            m_connectTime += c.m_connectTime;
+        }
+
+    public:
+        int64_t m_requests;
+        int64_t m_reused;
+        int64_t m_pipelined;
+        int64_t m_connects;
+        double m_connectTime;
     };
 
-    std::vector<obj_ptr<Conn>> m_conns;
+    class Pool : public obj_base,
+                 public Counters {
+    public:
+        Pool()
+            : m_active(0)
+        {
+        }
+
+    public:
+        class waiter {
+        public:
+            AsyncEvent* m_ac;
+            obj_ptr<Conn>* m_conn;
+            int32_t* m_ticket;
+            bool m_idempotent;
+        };
+
+    public:
+        std::deque<obj_ptr<Conn>> m_idle;
+        std::vector<obj_ptr<Conn>> m_busy;
+        std::deque<waiter> m_waiters;
+        int32_t m_active;
+    };
+
+    void take(Pool* pool, Conn* conn, bool idempotent, int32_t& ticket);
+    Conn* pipe(Pool* pool);
+    void dispatch(Pool* pool, std::vector<AsyncEvent*>& wakes);
+    void sweep(date_t d, std::vector<obj_ptr<Conn>>& expired);
+
+    class H2Host : public obj_base {
+    public:
+        H2Host()
+            : m_connecting(false)
+            , m_h1(false)
+        {
+        }
+
+    public:
+        obj_ptr<Http2Session> m_session;
+        bool m_connecting;
+        bool m_h1;
+        std::vector<AsyncEvent*> m_waiters;
+    };
+
+    std::unordered_map<exlib::string, obj_ptr<H2Host>> m_h2;
+
+    std::unordered_map<exlib::string, obj_ptr<Pool>> m_pools;
+    // counters of the pools swept away, they stay in the totals
+    Counters m_retired;
     int32_t m_poolSize;
     int32_t m_poolTimeout;
+    int32_t m_maxConnsPerHost;
+    int32_t m_pipelining;
+    bool m_enableHttp2;
     exlib::string m_http_proxy;
     exlib::string m_https_proxy;
 };
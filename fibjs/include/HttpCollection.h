@@ -108,6 +108,16 @@ public:
         return 0;
     }
 
+    size_t count()
+    {
+        return m_count;
+    }
+
+    const std::pair<exlib::string, exlib::string>& at(size_t i)
+    {
+        return m_map[i];
+    }
+
     size_t size();
     size_t getData(char* buf, size_t sz);
 
@@ -8,7 +8,12 @@
 #pragma once
 
 #include "ifs/Handler.h"
+#include "ifs/Stat.h"
+#include "File.h"
+#include "date.h"
 #include <unordered_map>
+#include <list>
+#include <vector>
 #include "path.h"
 
 namespace fibjs {
@@ -16,26 +21,102 @@ namespace fibjs {
 class HttpFileHandler : public Handler_base {
     FIBER_FREE();
 
+public:
+    class CacheEntry : public obj_base {
+    public:
+        CacheEntry(exlib::string path)
+            : m_path(path)
+            , m_valid(true)
+        {
+        }
+
+        ~CacheEntry();
+
+    public:
+        // blocking, call it from the pool; returns -1 when the file changed since it was cached
+        int32_t acquire();
+        void release(int32_t fd);
+        void invalidate();
+
+    private:
+        bool same_file(const uv_stat_t* statbuf);
+
+    public:
+        exlib::string m_path;
+        exlib::string m_type;
+        exlib::string m_lastModified;
+        bool m_ranges;
+        obj_ptr<Stat_base> m_stat;
+        date_t m_mtime;
+        date_t m_check;
+
+    private:
+        exlib::spinlock m_lock;
+        std::vector<int32_t> m_fds;
+        bool m_valid;
+    };
+
+    class CachedFile : public File {
+    public:
+        CachedFile(CacheEntry* entry, int32_t fd)
+            : File(fd)
+            , m_entry(entry)
+        {
+            name = entry->m_path;
+        }
+
+        ~CachedFile()
+        {
+            if (m_fd != -1) {
+                m_entry->release(m_fd);
+                m_fd = -1;
+            }
+        }
+
+    private:
+        obj_ptr<CacheEntry> m_entry;
+    };
+
 public:
     HttpFileHandler(exlib::string root, bool autoIndex)
         : m_autoIndex(autoIndex)
+        , m_cacheSize(0)
+        , m_cacheTTL(1000)
     {
         path_base::normalize(root, m_root);
         if (!m_root.empty() && !isPathSlash(m_root.c_str()[m_root.length() - 1]))
             m_root += PATH_SLASH;
     }
 
+    ~HttpFileHandler();
+
 public:
     // Handler_base
     virtual result_t invoke(object_base* v, obj_ptr<Handler_base>& retVal,
         AsyncEvent* ac);
 
     result_t set_mimes(v8::Local<v8::Object> mimes);
+    result_t set_cache(v8::Local<v8::Object> cache);
+
+public:
+    obj_ptr<CacheEntry> cache_get(exlib::string path);
+    void cache_put(CacheEntry* entry);
+
+public:
+    static exlib::atomic s_cache_hits;
+    static exlib::atomic s_cache_misses;
+    static exlib::atomic s_cache_entries;
 
 private:
     exlib::string m_root;
     bool m_autoIndex;
     std::unordered_map<exlib::string, exlib::string> m_mimes;
+
+    int32_t m_cacheSize;
+    int32_t m_cacheTTL;
+    exlib::spinlock m_cacheLock;
+    std::list<obj_ptr<CacheEntry>> m_cacheList;
+    std::unordered_map<exlib::string, std::list<obj_ptr<CacheEntry>>::iterator> m_cache;
 };
 
 } /* namespace fibjs */
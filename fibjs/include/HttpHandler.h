@@ -8,6 +8,8 @@
 #pragma once
 
 #include "ifs/HttpHandler.h"
+#include "ifs/HttpRequest.h"
+#include "MemoryStream.h"
 
 namespace fibjs {
 
@@ -33,11 +35,42 @@ public:
     virtual result_t set_maxBodySize(int32_t newVal);
     virtual result_t get_enableEncoding(bool& retVal);
     virtual result_t set_enableEncoding(bool newVal);
+    virtual result_t get_enableHttp2(bool& retVal);
+    virtual result_t set_enableHttp2(bool newVal);
+    virtual result_t get_maxConcurrentStreams(int32_t& retVal);
+    virtual result_t set_maxConcurrentStreams(int32_t newVal);
+    virtual result_t get_headerTableSize(int32_t& retVal);
+    virtual result_t set_headerTableSize(int32_t newVal);
+    virtual result_t get_streamBody(bool& retVal);
+    virtual result_t set_streamBody(bool newVal);
     virtual result_t get_serverName(exlib::string& retVal);
     virtual result_t set_serverName(exlib::string newVal);
     virtual result_t get_handler(obj_ptr<Handler_base>& retVal);
     virtual result_t set_handler(Handler_base* newVal);
 
+public:
+    // shared by HTTP/1.1 connections and HTTP/2 streams
+    bool cross_origin(HttpRequest_base* req, HttpResponse_base* rep);
+    void fix_headers(HttpResponse_base* rep, bool options);
+
+    // CALL_RETURN_NULL when the body goes out as it is, otherwise zip is filled through ac
+    result_t encode(HttpRequest_base* req, HttpResponse_base* rep, obj_ptr<SeekableStream_base>& body,
+        obj_ptr<MemoryStream>& zip, exlib::string& zipKey, AsyncEvent* ac);
+    void encoded(HttpResponse_base* rep, MemoryStream* zip, const exlib::string& zipKey);
+
+public:
+    // mask of the codings in names that Accept-Encoding allows, shared with HttpFileHandler
+    static int32_t accept_encoding(exlib::string& hdr, const char* const* names, int32_t count);
+
+public:
+    static bool zip_get(const exlib::string& key, MemoryStream::Rope& retVal);
+    static void zip_put(const exlib::string& key, const MemoryStream::Rope& data);
+    static void zip_info(int64_t& entries, int64_t& size);
+
+public:
+    static exlib::atomic s_zip_hits;
+    static exlib::atomic s_zip_misses;
+
 private:
     obj_ptr<Handler_base> m_hdlr;
 
@@ -47,6 +80,10 @@ private:
     int32_t m_maxHeaderSize;
     int32_t m_maxBodySize;
     bool m_enableEncoding;
+    bool m_enableHttp2;
+    int32_t m_maxConcurrentStreams;
+    int32_t m_headerTableSize;
+    bool m_streamBody;
     exlib::string m_serverName;
 };
 
@@ -0,0 +1,60 @@
+/*
+ * HttpHead.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include "BufferedStream.h"
+#include <vector>
+
+namespace fibjs {
+
+// start line and header lines of an http/1.x message, parsed in one pass over the receive buffer.
+// the parser keeps spans into the buffer instead of copying, when the whole head is already
+// buffered it completes without another read.
+// the spans stay valid until the next call to read.
+class HttpHead {
+public:
+    class Field {
+    public:
+        const char* m_name;
+        int32_t m_szName;
+        const char* m_value;
+        int32_t m_szValue;
+    };
+
+public:
+    HttpHead()
+        : m_line(NULL)
+        , m_szLine(0)
+        , m_maxLineSize(-1)
+        , m_maxFields(-1)
+    {
+    }
+
+public:
+    // maxLineSize limits every line, maxFields the number of header lines, -1 for no limit.
+    // returns CALL_RETURN_NULL when the stream ends before the first byte of a head.
+    result_t read(BufferedStream* stm, int32_t maxLineSize, int32_t maxFields, AsyncEvent* ac);
+
+    // returns the length of the head including the empty line, CALL_E_PENDDING when buf ends
+    // before the head does.
+    result_t parse(const char* buf, int32_t len);
+
+public:
+    const char* m_line;
+    int32_t m_szLine;
+    std::vector<Field> m_fields;
+    int32_t m_maxLineSize;
+    int32_t m_maxFields;
+
+    // holds the head when it arrives in more than one read
+    exlib::string m_data;
+    // keeps the stream buffer the head was parsed in alive after the stream has moved past it
+    std::shared_ptr<v8::BackingStore> m_store;
+};
+
+} /* namespace fibjs */
@@ -9,7 +9,8 @@
 
 #include "Message.h"
 #include "HttpCollection.h"
-#include "ifs/BufferedStream.h"
+#include "HttpHead.h"
+#include "HttpBodyStream.h"
 
 namespace fibjs {
 
@@ -21,6 +22,7 @@ public:
         , m_maxHeadersCount(128)
         , m_maxHeaderSize(8192)
         , m_maxBodySize(64)
+        , m_streamBody(false)
     {
         m_headers = new HttpCollection();
         clear();
@@ -68,12 +70,11 @@ public:
         AsyncEvent* ac);
     result_t sendHeader(Stream_base* stm, exlib::string& strCommand,
         AsyncEvent* ac);
-    result_t readFrom(Stream_base* stm, AsyncEvent* ac);
+    result_t readFrom(BufferedStream* stm, HttpHead& head, AsyncEvent* ac);
 
 public:
     void addHeader(const char* name, int32_t szName, const char* value,
         int32_t szValue);
-    result_t addHeader(exlib::string& strLine);
     size_t size();
     size_t getData(char* buf, size_t sz);
 
@@ -93,6 +94,8 @@ public:
     int32_t m_maxHeadersCount;
     int32_t m_maxHeaderSize;
     int32_t m_maxBodySize;
+    bool m_streamBody;
+    obj_ptr<HttpBodyStream> m_bodyStream;
     exlib::string m_origin;
     exlib::string m_encoding;
     obj_ptr<HttpCollection> m_headers;
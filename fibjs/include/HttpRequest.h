@@ -91,6 +91,17 @@ public:
     virtual result_t get_query(obj_ptr<HttpCollection_base>& retVal);
 
 public:
+    // readFrom leaves the body on the connection, req.body reads it from there
+    void set_streamBody(bool newVal)
+    {
+        m_message->m_streamBody = newVal;
+    }
+
+    HttpBodyStream* bodyStream()
+    {
+        return m_message->m_bodyStream;
+    }
+
     result_t addHeader(NObject* map)
     {
         for (int32_t i = 0; i < (int32_t)map->m_values.size(); i++) {
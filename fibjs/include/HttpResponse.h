@@ -94,6 +94,9 @@ public:
     virtual result_t sendHeader(Stream_base* stm, AsyncEvent* ac);
 
 public:
+    // turns the cookies set on the response into Set-Cookie headers
+    void flushCookies();
+
     result_t allHeader(exlib::string name, obj_ptr<NArray>& retVal)
     {
         return m_message->allHeader(name, retVal);
@@ -9,6 +9,7 @@
 
 #include "ifs/HttpsServer.h"
 #include "HttpHandler.h"
+#include "TLSServer.h"
 
 namespace fibjs {
 
@@ -34,14 +35,23 @@ public:
     virtual result_t set_maxBodySize(int32_t newVal);
     virtual result_t get_enableEncoding(bool& retVal);
     virtual result_t set_enableEncoding(bool newVal);
+    virtual result_t get_enableHttp2(bool& retVal);
+    virtual result_t set_enableHttp2(bool newVal);
+    virtual result_t get_maxConcurrentStreams(int32_t& retVal);
+    virtual result_t set_maxConcurrentStreams(int32_t newVal);
+    virtual result_t get_headerTableSize(int32_t& retVal);
+    virtual result_t set_headerTableSize(int32_t newVal);
+    virtual result_t get_streamBody(bool& retVal);
+    virtual result_t set_streamBody(bool newVal);
     virtual result_t get_serverName(exlib::string& retVal);
     virtual result_t set_serverName(exlib::string newVal);
 
 public:
-    result_t create(SecureContext_base* context, exlib::string addr, int32_t port, Handler_base* hdlr);
+    result_t create(SecureContext_base* context, exlib::string addr, int32_t port, Handler_base* hdlr,
+        int32_t backlog = 1024, bool reusePort = false);
 
 private:
-    obj_ptr<TcpServer_base> m_server;
+    obj_ptr<TLSServer> m_server;
     obj_ptr<HttpHandler_base> m_handler;
 };
 
@@ -10,20 +10,88 @@
 #include "ifs/os.h"
 #include "ifs/fs.h"
 #include "ifs/MemoryStream.h"
-#include <sstream>
+#include "Buffer.h"
+#include <vector>
 
 namespace fibjs {
 
 class MemoryStream : public MemoryStream_base {
+public:
+    // stream data kept as a list of slices of buffer memory the stream owns.
+    // large writes get a slice of their own, small writes are packed into blocks.
+    // a slice is never written again once it is in the list, so clone shares the slices
+    // with the stream, and an overwrite replaces the slices it covers.
+    class Rope {
+    public:
+        struct Segment {
+            Buffer::store m_data;
+            int64_t m_start;
+        };
+
+    public:
+        Rope()
+            : m_size(0)
+            , m_tail(0)
+        {
+        }
+
+        Rope(const Rope& r)
+            : m_segs(r.m_segs)
+            , m_size(r.m_size)
+            , m_tail(0)
+        {
+        }
+
+        Rope& operator=(const Rope& r)
+        {
+            m_segs = r.m_segs;
+            m_size = r.m_size;
+            m_tail = 0;
+            return *this;
+        }
+
+    public:
+        int64_t size() const
+        {
+            return m_size;
+        }
+
+        void write(int64_t pos, Buffer* buf);
+        void truncate(int64_t bytes);
+        void clear();
+
+        // both advance pos, bytes < 0 reads to the end
+        result_t read(int64_t& pos, int32_t bytes, obj_ptr<Buffer_base>& retVal);
+        result_t copyTo(int64_t& pos, Stream_base* stm, int64_t bytes, int64_t& retVal, AsyncEvent* ac);
+
+    private:
+        size_t find(int64_t pos);
+        void append(Buffer::store& data);
+
+    private:
+        std::vector<Segment> m_segs;
+        int64_t m_size;
+        // free bytes behind the last segment in its block, only this rope writes there
+        size_t m_tail;
+    };
+
 public:
     class CloneStream : public MemoryStream_base {
     public:
         CloneStream(exlib::string buffer, date_t tm)
+            : m_time(tm)
+            , m_pos(0)
+        {
+            obj_ptr<Buffer> buf = new Buffer(buffer.c_str(), buffer.length());
+            m_buffer.write(0, buf);
+            extMemory((int32_t)buffer.length());
+        }
+
+        CloneStream(const Rope& buffer, date_t tm)
             : m_buffer(buffer)
             , m_time(tm)
             , m_pos(0)
         {
-            extMemory((int32_t)m_buffer.length());
         }
 
     public:
@@ -53,13 +121,14 @@ public:
         virtual result_t clear();
 
     private:
-        exlib::string m_buffer;
+        Rope m_buffer;
         date_t m_time;
-        int32_t m_pos;
+        int64_t m_pos;
     };
 
 public:
     MemoryStream()
+        : m_pos(0)
     {
         m_time.now();
     }
@@ -90,9 +159,17 @@ public:
     virtual result_t clone(obj_ptr<MemoryStream_base>& retVal);
     virtual result_t clear();
 
+public:
+    // the slices written so far, shared rather than copied
+    const Rope& rope() const
+    {
+        return m_buffer;
+    }
+
 private:
-    std::stringstream m_buffer;
+    Rope m_buffer;
     date_t m_time;
+    int64_t m_pos;
 };
 
 } /* namespace fibjs */
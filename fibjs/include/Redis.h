@@ -9,16 +9,27 @@
 
 #include "ifs/Redis.h"
 #include "ifs/Socket.h"
-#include "BufferedStream.h"
+#include "RespParser.h"
 #include "Variant.h"
 #include "QuickArray.h"
 #include "Buffer.h"
 #include <unordered_map>
+#include <deque>
+#include <vector>
 #include <inttypes.h>
 
 namespace fibjs {
 
 class Redis : public Redis_base {
+public:
+    Redis()
+        : m_subMode(0)
+        , m_autoPipelining(false)
+        , m_writing(false)
+        , m_reading(false)
+    {
+    }
+
 public:
     // Redis_base
     virtual result_t command(exlib::string cmd, OptArgs args, v8::Local<v8::Value>& retVal);
@@ -69,6 +80,9 @@ public:
     virtual result_t getList(Buffer_base* key, obj_ptr<RedisList_base>& retVal);
     virtual result_t getSet(Buffer_base* key, obj_ptr<RedisSet_base>& retVal);
     virtual result_t getSortedSet(Buffer_base* key, obj_ptr<RedisSortedSet_base>& retVal);
+    virtual result_t pipeline(obj_ptr<RedisPipeline_base>& retVal);
+    virtual result_t get_autoPipelining(bool& retVal);
+    virtual result_t set_autoPipelining(bool newVal);
     virtual result_t dump(Buffer_base* key, obj_ptr<Buffer_base>& retVal);
     virtual result_t restore(Buffer_base* key, Buffer_base* data, int64_t ttl);
     virtual result_t close();
@@ -78,8 +92,36 @@ public:
 
 public:
     result_t connect(const char* host, int32_t port, AsyncEvent* ac);
+    ASYNC_MEMBER2_CC(Redis, connect, const char*, int32_t);
     result_t _command(exlib::string& req, Variant& retVal, AsyncEvent* ac);
     ASYNC_MEMBERVALUE2_AC(Redis, _command, exlib::string, Variant);
+    virtual result_t _batch(exlib::string& req, int32_t count, Variant& retVal, AsyncEvent* ac);
+    ASYNC_MEMBERVALUE3_AC(Redis, _batch, exlib::string, int32_t, Variant);
+    ASYNC_MEMBERVALUE3_CC(Redis, _batch, exlib::string, int32_t, Variant);
+
+    virtual bool closed()
+    {
+        return !m_sock;
+    }
+
+    class _addr {
+    public:
+        exlib::string m_host;
+        int32_t m_port;
+    };
+
+    class _auth {
+    public:
+        exlib::string m_user;
+        exlib::string m_password;
+    };
+
+    // parses scheme://[user:password@]host1:port1,host2:port2/path?query
+    static result_t parse_addrs(exlib::string connString, int32_t defPort,
+        std::vector<_addr>& addrs, _auth& auth, exlib::string& path, exlib::string& query);
+
+    // sends AUTH on a new connection when the connection string carried a password
+    result_t login(_auth& auth);
 
     class _param {
     public:
@@ -284,7 +326,7 @@ public:
 
     result_t chkCommand(exlib::string cmd)
     {
-        if (!m_sock)
+        if (closed())
             return CHECK_ERROR(CALL_E_INVALID_CALL);
 
         if (m_subMode) {
@@ -504,11 +546,27 @@ public:
     bool regsub(exlib::string& key, v8::Local<v8::Function> func);
     bool unregsub(exlib::string& key, v8::Local<v8::Function> func);
 
+public:
+    class _request {
+    public:
+        exlib::string m_req;
+        int32_t m_count;
+        Variant* m_retVal;
+        AsyncEvent* m_ac;
+    };
+
 public:
     std::unordered_map<exlib::string, int32_t> m_funcs;
     obj_ptr<Socket_base> m_sock;
-    obj_ptr<BufferedStream_base> m_stmBuffered;
+    RespParser m_resp;
     int32_t m_subMode;
+
+    bool m_autoPipelining;
+    exlib::spinlock m_queueLock;
+    std::deque<_request> m_sending;
+    std::deque<_request> m_waiting;
+    bool m_writing;
+    bool m_reading;
 };
 
 } /* namespace fibjs */
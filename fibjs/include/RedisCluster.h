@@ -0,0 +1,162 @@
+/*
+ * RedisCluster.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include "Redis.h"
+#include <vector>
+#include <deque>
+#include <unordered_map>
+
+namespace fibjs {
+
+class RedisCluster : public Redis {
+public:
+    RedisCluster()
+        : m_poolSize(1)
+        , m_closed(false)
+        , m_refreshing(false)
+        , m_dirty(false)
+        , m_next(0)
+        , m_slots(REDIS_SLOTS)
+    {
+    }
+
+public:
+    static const int32_t REDIS_SLOTS = 16384;
+    static const int32_t MAX_REDIRECTS = 5;
+
+public:
+    // Redis_base
+    virtual result_t close();
+
+public:
+    // Redis
+    virtual result_t _batch(exlib::string& req, int32_t count, Variant& retVal, AsyncEvent* ac);
+    virtual bool closed();
+
+public:
+    result_t open(exlib::string connString);
+
+    static int32_t slot(const char* key, size_t len);
+
+private:
+    class Node : public obj_base {
+    public:
+        Node(exlib::string host, int32_t port)
+            : m_host(host)
+            , m_port(port)
+            , m_next(0)
+            , m_connecting(0)
+        {
+        }
+
+    public:
+        exlib::string m_host;
+        int32_t m_port;
+        std::vector<obj_ptr<Redis>> m_conns;
+        int32_t m_next;
+        int32_t m_connecting;
+        exlib::Locker m_lock;
+        exlib::CondVar m_ready;
+    };
+
+    class _cmd {
+    public:
+        exlib::string m_req;
+        std::vector<exlib::string> m_args;
+    };
+
+    class _job : public AsyncEvent {
+    public:
+        _job()
+            : m_slot(-1)
+            , m_count(0)
+            , m_asking(false)
+            , m_hr(0)
+            , m_pending(NULL)
+            , m_done(NULL)
+        {
+        }
+
+    public:
+        virtual int32_t post(int32_t v)
+        {
+            if (v == CALL_E_EXCEPTION)
+                m_error = Runtime::errMessage();
+
+            m_hr = v;
+            if (m_pending->dec() == 0)
+                m_done->set();
+
+            return 0;
+        }
+
+    public:
+        int32_t m_slot;
+        exlib::string m_req;
+        int32_t m_count;
+        std::vector<int32_t> m_index;
+        Redis::_param m_param;
+
+        obj_ptr<Node> m_node;
+        bool m_asking;
+        exlib::string m_send;
+        obj_ptr<Node> m_target;
+        obj_ptr<Redis> m_conn;
+
+        Variant m_val;
+        result_t m_hr;
+        exlib::string m_error;
+
+        exlib::atomic* m_pending;
+        exlib::Event* m_done;
+    };
+
+    enum {
+        MERGE_LIST,
+        MERGE_SUM,
+        MERGE_CONCAT,
+        MERGE_FIRST
+    };
+
+private:
+    static result_t parse_cmd(exlib::string& req, size_t& pos, _cmd& cmd);
+    static int32_t key_slot(_cmd& cmd);
+
+    obj_ptr<Node> get_node(exlib::string host, int32_t port);
+    result_t get_conn(Node* node, obj_ptr<Redis>& retVal);
+    void drop_conn(Node* node, Redis* conn);
+
+    result_t refresh();
+    result_t load(Variant& v, exlib::string& host);
+
+    result_t start(_job* job);
+    bool redirect(_job* job);
+    result_t execute(std::deque<_job>& jobs);
+    result_t route(_cmd& cmd, Variant& retVal);
+    result_t single(_cmd& cmd, Variant& retVal);
+    result_t fanout(_cmd& cmd, int32_t step, int32_t mode, Variant& retVal);
+    result_t broadcast(_cmd& cmd, int32_t mode, Variant& retVal);
+    result_t merge(std::deque<_job>& jobs, int32_t mode, int32_t count, Variant& retVal);
+
+private:
+    std::vector<Redis::_addr> m_seeds;
+    Redis::_auth m_auth;
+    int32_t m_poolSize;
+    bool m_closed;
+    bool m_refreshing;
+    bool m_dirty;
+    int32_t m_next;
+
+    exlib::spinlock m_nodesLock;
+    std::unordered_map<exlib::string, obj_ptr<Node>> m_nodes;
+    std::vector<obj_ptr<Node>> m_slots;
+    std::vector<obj_ptr<Node>> m_masters;
+};
+
+} /* namespace fibjs */
@@ -0,0 +1,49 @@
+/*
+ * RedisPipeline.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include "Redis.h"
+
+namespace fibjs {
+
+class RedisPipeline : public RedisPipeline_base {
+public:
+    RedisPipeline(Redis* rdb)
+        : m_rdb(rdb)
+        , m_count(0)
+    {
+    }
+
+public:
+    virtual bool enterTask(exlib::Task_base* current)
+    {
+        return m_rdb->enterTask(current);
+    }
+
+    virtual void enter()
+    {
+        m_rdb->enter();
+    }
+
+    virtual void leave(exlib::Task_base* current = NULL)
+    {
+        m_rdb->leave(current);
+    }
+
+public:
+    // RedisPipeline_base
+    virtual result_t command(exlib::string cmd, OptArgs args, obj_ptr<RedisPipeline_base>& retVal);
+    virtual result_t get_length(int32_t& retVal);
+    virtual result_t exec(obj_ptr<NArray>& retVal);
+
+private:
+    obj_ptr<Redis> m_rdb;
+    exlib::string m_req;
+    int32_t m_count;
+};
+}
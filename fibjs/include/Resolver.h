@@ -0,0 +1,60 @@
+/*
+ * Resolver.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include "ifs/Socket.h"
+#include <vector>
+
+namespace fibjs {
+
+// process wide host name cache in front of getaddrinfo
+// getaddrinfo does not report record ttl, entries live for a fixed time set by dns.ttl.
+// an expired entry is still served for another ttl while it is refreshed in the background,
+// failed lookups are remembered for dns.negativeTtl.
+class Resolver {
+public:
+    class Stats {
+    public:
+        Stats()
+            : m_hits(0)
+            , m_misses(0)
+            , m_stale(0)
+            , m_negative(0)
+            , m_entries(0)
+        {
+        }
+
+    public:
+        int64_t m_hits;
+        int64_t m_misses;
+        int64_t m_stale;
+        int64_t m_negative;
+        int64_t m_entries;
+    };
+
+public:
+    // all addresses of name, ipv4 and ipv6, in the order getaddrinfo sorted them
+    static result_t resolve(exlib::string name, std::vector<exlib::string>& retVal, AsyncEvent* ac);
+
+    // connects to host, racing its addresses as described in RFC 8305
+    static result_t connect(exlib::string host, int32_t port, int32_t timeout,
+        obj_ptr<Stream_base>& retVal, AsyncEvent* ac);
+
+    static void stats(Stats& retVal);
+
+public:
+    // seconds
+    static int32_t s_ttl;
+    static int32_t s_negative_ttl;
+
+    // delay before the next address is tried while the previous attempt is still pending
+    static const int32_t CONNECT_ATTEMPT_DELAY = 250;
+    static const size_t MAX_ENTRIES = 4096;
+};
+
+} /* namespace fibjs */
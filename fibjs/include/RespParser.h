@@ -0,0 +1,68 @@
+/*
+ * RespParser.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include "Buffer.h"
+#include "Variant.h"
+#include <vector>
+
+namespace fibjs {
+
+class RespParser {
+public:
+    RespParser()
+        : m_push(false)
+        , m_len(0)
+        , m_pos(0)
+        , m_need(0)
+        , m_recvSize(RESP_MIN_RECV)
+    {
+    }
+
+public:
+    static const int32_t RESP_MIN_RECV = 2048;
+    static const int32_t RESP_MAX_RECV = 65536;
+    static const int32_t RESP_MAX_LINE = 65536;
+
+public:
+    // size to ask the socket for on the next receive
+    int32_t recv_size() const
+    {
+        return m_recvSize;
+    }
+
+    void append(Buffer_base* data);
+
+    // returns 0 or CALL_RETURN_NULL with a complete reply, CALL_E_PENDDING when more data is needed
+    result_t parse(Variant& retVal);
+
+public:
+    // valid after parse() completes a reply
+    exlib::string m_error;
+    bool m_push;
+
+private:
+    Variant slice(size_t pos, size_t len);
+
+private:
+    class frame {
+    public:
+        obj_ptr<NArray> m_list;
+        int64_t m_count;
+        char m_type;
+    };
+
+    obj_ptr<Buffer> m_data;
+    size_t m_len;
+    size_t m_pos;
+    size_t m_need;
+    int32_t m_recvSize;
+    std::vector<frame> m_stack;
+};
+
+} /* namespace fibjs */
@@ -8,8 +8,10 @@
 #pragma once
 
 #include "ifs/Routing.h"
+#include "ifs/Message.h"
 #include <pcre/pcre.h>
 #include <vector>
+#include <map>
 
 namespace fibjs {
 
@@ -22,6 +24,7 @@ public:
             , m_re(re)
             , m_hdlr(hdlr)
             , m_bSub(bSub)
+            , m_bTree(false)
         {
         }
 
@@ -35,8 +38,87 @@ public:
         pcre* m_re;
         obj_ptr<Handler_base> m_hdlr;
         bool m_bSub;
+
+        // literal pieces of a tree-compiled pattern, one ':param' between each pair
+        std::vector<exlib::string> m_path;
+        bool m_bTree;
+    };
+
+    class node {
+    public:
+        node()
+            : m_param(NULL)
+            , m_end(-1)
+            , m_sub(-1)
+            , m_min(-1)
+        {
+        }
+
+        ~node()
+        {
+            for (size_t i = 0; i < m_childs.size(); i++)
+                delete m_childs[i];
+            delete m_param;
+        }
+
+    public:
+        class match {
+        public:
+            match()
+                : m_order(-1)
+                , m_rest(0)
+            {
+            }
+
+        public:
+            int32_t m_order;
+            size_t m_rest;
+            std::vector<std::pair<size_t, size_t>> m_params;
+            std::vector<std::pair<size_t, size_t>> m_stack;
+        };
+
+    public:
+        node* add(const exlib::string& key, size_t pos);
+        node* param();
+        int32_t update();
+        void find(const char* s, size_t len, size_t pos, match& m);
+
+    public:
+        exlib::string m_key;
+        std::vector<node*> m_childs;
+        node* m_param;
+        int32_t m_end;
+        int32_t m_sub;
+        int32_t m_min;
     };
 
+    // rules compiled into per-method prefix trees, indexed by match order.
+    // a tree is never changed once published, append builds a new one and swaps it in.
+    class tree : public obj_base {
+    public:
+        ~tree()
+        {
+            std::map<exlib::string, node*>::iterator it;
+
+            for (it = m_trees.begin(); it != m_trees.end(); it++)
+                delete it->second;
+        }
+
+    public:
+        void build(const std::vector<obj_ptr<rule>>& rules);
+
+    public:
+        std::map<exlib::string, node*> m_trees;
+        std::vector<obj_ptr<rule>> m_order;
+        std::vector<int32_t> m_regex;
+    };
+
+public:
+    Routing()
+        : m_tree(new tree())
+    {
+    }
+
 public:
     // Handler_base
     virtual result_t invoke(object_base* v,
@@ -69,9 +151,19 @@ public:
     result_t _append(exlib::string method, v8::Local<v8::Object> map, obj_ptr<Routing_base>& retVal);
     static exlib::string host2RegExp(exlib::string pattern);
     static exlib::string path2RegExp(exlib::string pattern);
+    static bool path2Tree(exlib::string pattern, bool bSub, std::vector<exlib::string>& path);
+
+private:
+    result_t add_rule(exlib::string method, exlib::string pattern, Handler_base* hdlr);
+    void build_tree();
+    void get_tree(obj_ptr<tree>& retVal);
+    bool match_rule(rule* r, Message_base* msg, exlib::string& test, bool isHost);
 
 private:
     std::vector<obj_ptr<rule>> m_array;
+
+    exlib::spinlock m_lock;
+    obj_ptr<tree> m_tree;
 };
 
 } /* namespace fibjs */
@@ -0,0 +1,46 @@
+/*
+ * SerializedValue.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include "object.h"
+#include <vector>
+
+namespace fibjs {
+
+class SerializedValue : public object_base {
+public:
+    ~SerializedValue()
+    {
+        if (m_data)
+            free(m_data);
+    }
+
+    virtual void Delete()
+    {
+        // the cached value is released in the isolate that read it
+        safe_release();
+    }
+
+public:
+    static result_t serialize(v8::Local<v8::Value> v, v8::Local<v8::Array> transfer, obj_ptr<object_base>& retVal);
+
+public:
+    virtual result_t valueOf(v8::Local<v8::Value>& retVal);
+
+public:
+    uint8_t* m_data = NULL;
+    size_t m_size = 0;
+
+    std::vector<obj_ptr<object_base>> m_objects;
+    std::vector<std::shared_ptr<v8::BackingStore>> m_shared;
+    std::vector<std::shared_ptr<v8::BackingStore>> m_transfer;
+
+    v8::Global<v8::Value> m_value;
+};
+
+} /* namespace fibjs */
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "ifs/TLSHandler.h"
+#include <vector>
 
 namespace fibjs {
 
@@ -31,9 +32,21 @@ public:
     virtual result_t get_handler(obj_ptr<Handler_base>& retVal);
     virtual result_t set_handler(Handler_base* newVal);
 
+public:
+    // protocols accepted through ALPN on every following connection, in order of preference
+    void set_alpn(const std::vector<exlib::string>& protocols)
+    {
+        m_lock.lock();
+        m_alpn = protocols;
+        m_lock.unlock();
+    }
+
 private:
     obj_ptr<Handler_base> m_handler;
     obj_ptr<SecureContext_base> m_ctx;
+
+    exlib::spinlock m_lock;
+    std::vector<exlib::string> m_alpn;
 };
 
 } /* namespace fibjs */
@@ -29,7 +29,13 @@ public:
     virtual result_t get_secureContext(obj_ptr<SecureContext_base>& retVal);
 
 public:
-    result_t create(SecureContext_base* context, exlib::string addr, int32_t port, Handler_base* listener);
+    result_t create(SecureContext_base* context, exlib::string addr, int32_t port, Handler_base* listener,
+        int32_t backlog = 1024, bool reusePort = false);
+
+    void set_alpn(const std::vector<exlib::string>& protocols)
+    {
+        m_handler.As<TLSHandler>()->set_alpn(protocols);
+    }
 
 private:
     obj_ptr<TcpServer_base> m_server;
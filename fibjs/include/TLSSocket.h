@@ -22,6 +22,7 @@ public:
     virtual result_t accept(Stream_base* socket, AsyncEvent* ac);
     virtual result_t get_stream(obj_ptr<Stream_base>& retVal);
     virtual result_t getProtocol(exlib::string& retVal);
+    virtual result_t getALPNProtocol(exlib::string& retVal);
     virtual result_t getX509Certificate(obj_ptr<X509Certificate_base>& retVal);
     virtual result_t getPeerX509Certificate(obj_ptr<X509Certificate_base>& retVal);
     virtual result_t get_secureContext(obj_ptr<SecureContext_base>& retVal);
@@ -46,6 +47,13 @@ public:
 public:
     result_t init(SecureContext_base* context);
 
+    // protocols offered in the client hello, or accepted from it, set before connect or accept
+    result_t set_alpn(const std::vector<exlib::string>& protocols);
+
+    // server side ALPN selection, installed on every SSL_CTX
+    static int select_alpn(SSL* ssl, const unsigned char** out, unsigned char* outlen,
+        const unsigned char* in, unsigned int inlen, void* arg);
+
     static TLSSocket* FromBIO(BIO* bio)
     {
         return static_cast<TLSSocket*>(BIO_get_data(bio));
@@ -89,6 +97,7 @@ public:
     exlib::Locker m_write_lock;
 
 private:
+    exlib::string m_alpn;
     obj_ptr<X509Certificate_base> m_cert;
     obj_ptr<X509Certificate_base> m_peer_cert;
 };
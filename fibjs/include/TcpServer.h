@@ -35,7 +35,10 @@ public:
     };
 
 public:
-    result_t create(exlib::string addr, int32_t port, Handler_base* listener);
+    result_t create(exlib::string addr, int32_t port, Handler_base* listener,
+        int32_t backlog = 1024, bool reusePort = false);
+    static result_t load_options(Isolate* isolate, v8::Local<v8::Object> options,
+        exlib::string& addr, int32_t& port, int32_t& backlog, bool& reusePort);
 
 private:
     bool m_running;
@@ -18,8 +18,9 @@ class UVSocket : public UVStream_tmpl<Socket_base> {
     FIBER_FREE();
 
 public:
-    UVSocket(int32_t family)
-        : m_family(family)
+    UVSocket(int32_t family, uv_loop_t* loop = NULL)
+        : UVStream_tmpl<Socket_base>(-1, loop)
+        , m_family(family)
     {
     }
 
@@ -48,6 +49,7 @@ public:
 private:
     static void on_listen(uv_stream_t* server, int status);
     void on_listen(int status);
+    void on_accept(UVSocket* sock);
 
 private:
     int32_t m_family;
@@ -25,7 +25,7 @@ public:
             , m_timeout(_this->m_timeout)
         {
             if (m_timeout > 0) {
-                uv_timer_init(s_uv_loop, this);
+                uv_timer_init(_this->m_loop, this);
                 uv_timer_start(this, on_timeout, m_timeout, 0);
             }
         }
@@ -35,7 +35,7 @@ public:
             , m_timeout(timeout)
         {
             if (m_timeout > 0) {
-                uv_timer_init(s_uv_loop, this);
+                uv_timer_init(_this->m_loop, this);
                 uv_timer_start(this, on_timeout, m_timeout, 0);
             }
         }
@@ -70,8 +70,9 @@ public:
     };
 
 public:
-    UVStream_tmpl(int32_t fd = -1)
+    UVStream_tmpl(int32_t fd = -1, uv_loop_t* loop = NULL)
         : m_fd(fd)
+        , m_loop(loop ? loop : s_uv_loop)
     {
     }
 
@@ -88,7 +89,7 @@ public:
             return;
         }
 
-        uv_post([&] {
+        uv_post(m_loop, [&] {
             uv_close(&m_handle, on_delete);
         });
     }
@@ -285,7 +286,7 @@ public:
         if (ac->isSync())
             return CHECK_ERROR(CALL_E_NOSYNC);
 
-        uv_post(new AsyncRead(this, true, bytes, retVal, ac));
+        uv_post(m_loop, new AsyncRead(this, true, bytes, retVal, ac));
         return CALL_E_PENDDING;
     }
 
@@ -294,7 +295,17 @@ public:
         if (ac->isSync())
             return CHECK_ERROR(CALL_E_NOSYNC);
 
-        uv_post(new AsyncWrite(this, data, ac));
+        uv_post(m_loop, new AsyncWrite(this, data, ac));
+        return CALL_E_PENDDING;
+    }
+
+    // counts the writes still queued on the loop, including bytes libuv has not flushed yet
+    result_t write_pending(int32_t& retVal, AsyncEvent* ac)
+    {
+        uv_post(m_loop, [this, &retVal, ac] {
+            retVal = queue_write.count() + (int32_t)m_stream.write_queue_size;
+            ac->apost(0);
+        });
         return CALL_E_PENDDING;
     }
 
@@ -319,7 +330,7 @@ public:
         if (ac && ac->isSync())
             return CHECK_ERROR(CALL_E_NOSYNC);
 
-        uv_post([this, ac] {
+        uv_post(m_loop, [this, ac] {
             if (uv_is_closing(&this->m_handle)) {
                 if (ac)
                     ac->apost(0);
@@ -353,6 +364,7 @@ public:
 
 public:
     int32_t m_fd;
+    uv_loop_t* m_loop;
     int32_t m_timeout = -1;
 
 public:
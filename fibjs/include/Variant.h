@@ -61,8 +61,6 @@ public:
         VT_Object,
         VT_JSValue,
         VT_JSON,
-        VT_UNBOUND_ARRAY,
-        VT_UNBOUND_OBJECT,
         VT_Type = 255
     };
 
@@ -154,9 +152,7 @@ public:
     {
         Type _t = type();
 
-        if (_t == VT_UNBOUND_ARRAY || _t == VT_UNBOUND_OBJECT)
-            clearUnbind();
-        else if (_t == VT_String || _t == VT_JSON)
+        if (_t == VT_String || _t == VT_JSON)
             strVal().~basic_string();
         else if (_t == VT_Object && m_Val.objVal)
             m_Val.objVal->Unref();
@@ -186,8 +182,6 @@ public:
         if (_t == VT_JSValue)
             return operator=(v.jsVal());
 
-        assert(_t != VT_UNBOUND_ARRAY && _t != VT_UNBOUND_OBJECT);
-
         clear();
         set_type(_t);
         m_Val.longVal = v.m_Val.longVal;
@@ -437,8 +431,7 @@ public:
             strVal() = v;
     }
 
-    int32_t unbind();
-    void clearUnbind();
+    int32_t unbind(v8::Local<v8::Array> transfer = v8::Local<v8::Array>());
 
     object_base* object() const
     {
@@ -485,11 +478,6 @@ private:
     }
 
 private:
-    struct buf {
-        int32_t cnt;
-        void* data;
-    };
-
     Type m_type;
     union {
         bool boolVal;
@@ -500,7 +488,6 @@ private:
         char dateVal[sizeof(date_t)];
         char strVal[sizeof(exlib::string)];
         char jsVal[sizeof(v8::Global<v8::Value>)];
-        buf buffer;
     } m_Val;
 };
 
@@ -27,7 +27,7 @@ public:
 
 public:
     // Worker_base
-    virtual result_t postMessage(v8::Local<v8::Value> data);
+    virtual result_t postMessage(v8::Local<v8::Value> data, v8::Local<v8::Array> transfer);
 
 public:
     EVENT_FUNC(load);
@@ -47,9 +47,9 @@ public:
     virtual result_t set_lastError(exlib::string newVal);
 
 public:
-    result_t unbind()
+    result_t unbind(v8::Local<v8::Array> transfer = v8::Local<v8::Array>())
     {
-        return m_v.unbind();
+        return m_v.unbind(transfer);
     }
 
 private:
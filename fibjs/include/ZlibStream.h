@@ -12,6 +12,15 @@
 #include "MemoryStream.h"
 #include <zlib/include/zlib.h>
 
+#ifdef HAVE_BROTLI
+#include <brotli/encode.h>
+#include <brotli/decode.h>
+#endif
+
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
 namespace fibjs {
 
 #define ZLIB_CHUNK 1024
@@ -51,7 +60,7 @@ private:
 
             err = m_pThis->do_process(m_flush);
             if (err != Z_OK && err != Z_BUF_ERROR)
-                return CHECK_ERROR(Runtime::setError(zError(err)));
+                return CHECK_ERROR(Runtime::setError(m_pThis->m_message ? m_pThis->m_message : zError(err)));
 
             if (m_pThis->strm.avail_out == ZLIB_CHUNK)
                 return next();
@@ -85,6 +94,7 @@ public:
         : m_stm(stm)
         , m_maxSize(maxSize)
         , m_dataSize(0)
+        , m_message(NULL)
     {
         strm.zalloc = Z_NULL;
         strm.zfree = Z_NULL;
@@ -253,6 +263,7 @@ protected:
     obj_ptr<Stream_base> m_stm;
     int32_t m_maxSize;
     int32_t m_dataSize;
+    const char* m_message;
     unsigned char m_outBuffer[ZLIB_CHUNK];
 };
 
@@ -367,4 +378,238 @@ public:
     }
 };
 
+// brotli and zstd keep their own state, strm only carries the in/out cursors
+// so that asyncWrite drives them the same way as zlib.
+#ifdef HAVE_BROTLI
+class brotli_enc : public ZlibStream {
+public:
+    brotli_enc(Stream_base* stm, int32_t level = -1)
+        : ZlibStream(stm)
+    {
+        if (level < 0)
+            level = BROTLI_DEFAULT_QUALITY;
+        else if (level > BROTLI_MAX_QUALITY)
+            level = BROTLI_MAX_QUALITY;
+
+        m_state = BrotliEncoderCreateInstance(NULL, NULL, NULL);
+        BrotliEncoderSetParameter(m_state, BROTLI_PARAM_QUALITY, level);
+    }
+
+    ~brotli_enc()
+    {
+        BrotliEncoderDestroyInstance(m_state);
+    }
+
+public:
+    virtual int32_t do_process(int32_t flush)
+    {
+        BrotliEncoderOperation op = BROTLI_OPERATION_PROCESS;
+
+        if (flush == Z_FINISH) {
+            if (BrotliEncoderIsFinished(m_state))
+                return Z_OK;
+            op = BROTLI_OPERATION_FINISH;
+        } else if (flush == Z_SYNC_FLUSH)
+            op = BROTLI_OPERATION_FLUSH;
+
+        size_t avail_in = strm.avail_in;
+        const uint8_t* next_in = strm.next_in;
+        size_t avail_out = strm.avail_out;
+        uint8_t* next_out = strm.next_out;
+
+        if (!BrotliEncoderCompressStream(m_state, op, &avail_in, &next_in, &avail_out, &next_out, NULL)) {
+            m_message = "brotli: compression failed.";
+            return Z_STREAM_ERROR;
+        }
+
+        strm.avail_in = (uInt)avail_in;
+        strm.next_in = (unsigned char*)next_in;
+        strm.avail_out = (uInt)avail_out;
+        strm.next_out = next_out;
+
+        return Z_OK;
+    }
+
+private:
+    BrotliEncoderState* m_state;
+};
+
+class brotli_dec : public ZlibStream {
+public:
+    brotli_dec(Stream_base* stm, int32_t maxSize)
+        : ZlibStream(stm, maxSize)
+        , m_result(BROTLI_DECODER_RESULT_NEEDS_MORE_INPUT)
+        , m_started(false)
+    {
+        m_state = BrotliDecoderCreateInstance(NULL, NULL, NULL);
+    }
+
+    ~brotli_dec()
+    {
+        BrotliDecoderDestroyInstance(m_state);
+    }
+
+public:
+    virtual int32_t do_process(int32_t flush)
+    {
+        if (m_result == BROTLI_DECODER_RESULT_SUCCESS) {
+            if (strm.avail_in > 0) {
+                m_message = "brotli: unexpected data after the end of stream.";
+                return Z_DATA_ERROR;
+            }
+            return Z_OK;
+        }
+
+        if (strm.avail_in > 0)
+            m_started = true;
+
+        size_t avail_in = strm.avail_in;
+        const uint8_t* next_in = strm.next_in;
+        size_t avail_out = strm.avail_out;
+        uint8_t* next_out = strm.next_out;
+
+        m_result = BrotliDecoderDecompressStream(m_state, &avail_in, &next_in, &avail_out, &next_out, NULL);
+        if (m_result == BROTLI_DECODER_RESULT_ERROR) {
+            m_message = BrotliDecoderErrorString(BrotliDecoderGetErrorCode(m_state));
+            return Z_DATA_ERROR;
+        }
+
+        strm.avail_in = (uInt)avail_in;
+        strm.next_in = (unsigned char*)next_in;
+        strm.avail_out = (uInt)avail_out;
+        strm.next_out = next_out;
+
+        // an empty body decodes to nothing, as a HEAD response does
+        if (flush == Z_FINISH && m_started && m_result == BROTLI_DECODER_RESULT_NEEDS_MORE_INPUT) {
+            m_message = "brotli: unexpected end of stream.";
+            return Z_DATA_ERROR;
+        }
+
+        return Z_OK;
+    }
+
+private:
+    BrotliDecoderState* m_state;
+    BrotliDecoderResult m_result;
+    bool m_started;
+};
+#endif
+
+#ifdef HAVE_ZSTD
+class zstd_enc : public ZlibStream {
+public:
+    zstd_enc(Stream_base* stm, int32_t level = -1, Buffer_base* dict = NULL)
+        : ZlibStream(stm)
+        , m_finished(false)
+    {
+        if (level <= 0)
+            level = ZSTD_CLEVEL_DEFAULT;
+        else if (level > ZSTD_maxCLevel())
+            level = ZSTD_maxCLevel();
+
+        m_cctx = ZSTD_createCCtx();
+        ZSTD_CCtx_setParameter(m_cctx, ZSTD_c_compressionLevel, level);
+
+        if (dict) {
+            Buffer* buf = Buffer::Cast(dict);
+            ZSTD_CCtx_loadDictionary(m_cctx, buf->data(), buf->length());
+        }
+    }
+
+    ~zstd_enc()
+    {
+        ZSTD_freeCCtx(m_cctx);
+    }
+
+public:
+    virtual int32_t do_process(int32_t flush)
+    {
+        ZSTD_EndDirective mode = ZSTD_e_continue;
+
+        if (flush == Z_FINISH) {
+            if (m_finished)
+                return Z_OK;
+            mode = ZSTD_e_end;
+        } else if (flush == Z_SYNC_FLUSH)
+            mode = ZSTD_e_flush;
+
+        ZSTD_inBuffer in = { strm.next_in, strm.avail_in, 0 };
+        ZSTD_outBuffer out = { strm.next_out, strm.avail_out, 0 };
+
+        size_t ret = ZSTD_compressStream2(m_cctx, &out, &in, mode);
+        if (ZSTD_isError(ret)) {
+            m_message = ZSTD_getErrorName(ret);
+            return Z_STREAM_ERROR;
+        }
+
+        strm.next_in += in.pos;
+        strm.avail_in -= (uInt)in.pos;
+        strm.next_out += out.pos;
+        strm.avail_out -= (uInt)out.pos;
+
+        // a write after close starts the next frame
+        m_finished = mode == ZSTD_e_end && ret == 0;
+
+        return Z_OK;
+    }
+
+private:
+    ZSTD_CCtx* m_cctx;
+    bool m_finished;
+};
+
+class zstd_dec : public ZlibStream {
+public:
+    zstd_dec(Stream_base* stm, int32_t maxSize, Buffer_base* dict = NULL)
+        : ZlibStream(stm, maxSize)
+        , m_pending(false)
+    {
+        m_dctx = ZSTD_createDCtx();
+
+        if (dict) {
+            Buffer* buf = Buffer::Cast(dict);
+            ZSTD_DCtx_loadDictionary(m_dctx, buf->data(), buf->length());
+        }
+    }
+
+    ~zstd_dec()
+    {
+        ZSTD_freeDCtx(m_dctx);
+    }
+
+public:
+    virtual int32_t do_process(int32_t flush)
+    {
+        ZSTD_inBuffer in = { strm.next_in, strm.avail_in, 0 };
+        ZSTD_outBuffer out = { strm.next_out, strm.avail_out, 0 };
+
+        size_t ret = ZSTD_decompressStream(m_dctx, &out, &in);
+        if (ZSTD_isError(ret)) {
+            m_message = ZSTD_getErrorName(ret);
+            return Z_DATA_ERROR;
+        }
+
+        strm.next_in += in.pos;
+        strm.avail_in -= (uInt)in.pos;
+        strm.next_out += out.pos;
+        strm.avail_out -= (uInt)out.pos;
+
+        // 0 means the frame is complete, concatenated frames are decoded one after another.
+        // a call without progress only hints the size of the next frame header.
+        if (in.pos > 0 || out.pos > 0)
+            m_pending = ret != 0;
+        else if (flush == Z_FINISH && m_pending) {
+            m_message = "zstd: unexpected end of stream.";
+            return Z_DATA_ERROR;
+        }
+
+        return Z_OK;
+    }
+
+private:
+    ZSTD_DCtx* m_dctx;
+    bool m_pending;
+};
+#endif
+
 } /* namespace fibjs */
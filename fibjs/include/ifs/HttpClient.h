@@ -50,6 +50,12 @@ public:
     virtual result_t set_poolSize(int32_t newVal) = 0;
     virtual result_t get_poolTimeout(int32_t& retVal) = 0;
     virtual result_t set_poolTimeout(int32_t newVal) = 0;
+    virtual result_t get_maxConnsPerHost(int32_t& retVal) = 0;
+    virtual result_t set_maxConnsPerHost(int32_t newVal) = 0;
+    virtual result_t get_pipelining(int32_t& retVal) = 0;
+    virtual result_t set_pipelining(int32_t newVal) = 0;
+    virtual result_t get_enableHttp2(bool& retVal) = 0;
+    virtual result_t set_enableHttp2(bool newVal) = 0;
     virtual result_t get_http_proxy(exlib::string& retVal) = 0;
     virtual result_t set_http_proxy(exlib::string newVal) = 0;
     virtual result_t get_https_proxy(exlib::string& retVal) = 0;
@@ -65,6 +71,7 @@ public:
     virtual result_t put(exlib::string url, v8::Local<v8::Object> opts, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac) = 0;
     virtual result_t patch(exlib::string url, v8::Local<v8::Object> opts, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac) = 0;
     virtual result_t head(exlib::string url, v8::Local<v8::Object> opts, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac) = 0;
+    virtual result_t stats(v8::Local<v8::Object>& retVal) = 0;
 
 public:
     template <typename T>
@@ -93,6 +100,12 @@ public:
     static void s_set_poolSize(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_get_poolTimeout(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_set_poolTimeout(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_maxConnsPerHost(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_maxConnsPerHost(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_pipelining(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_pipelining(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_enableHttp2(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_enableHttp2(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_get_http_proxy(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_set_http_proxy(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_get_https_proxy(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
@@ -104,6 +117,7 @@ public:
     static void s_put(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_patch(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_head(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_stats(const v8::FunctionCallbackInfo<v8::Value>& args);
 
 public:
     ASYNC_MEMBERVALUE3(HttpClient_base, request, Stream_base*, HttpRequest_base*, obj_ptr<HttpResponse_base>);
@@ -143,7 +157,8 @@ inline ClassInfo& HttpClient_base::class_info()
         { "patch", s_patch, false, ClassData::ASYNC_ASYNC },
         { "patchSync", s_patch, false, ClassData::ASYNC_SYNC },
         { "head", s_head, false, ClassData::ASYNC_ASYNC },
-        { "headSync", s_head, false, ClassData::ASYNC_SYNC }
+        { "headSync", s_head, false, ClassData::ASYNC_SYNC },
+        { "stats", s_stats, false, ClassData::ASYNC_SYNC }
     };
 
     static ClassData::ClassProperty s_property[] = {
@@ -158,6 +173,9 @@ inline ClassInfo& HttpClient_base::class_info()
         { "userAgent", s_get_userAgent, s_set_userAgent, false },
         { "poolSize", s_get_poolSize, s_set_poolSize, false },
         { "poolTimeout", s_get_poolTimeout, s_set_poolTimeout, false },
+        { "maxConnsPerHost", s_get_maxConnsPerHost, s_set_maxConnsPerHost, false },
+        { "pipelining", s_get_pipelining, s_set_pipelining, false },
+        { "enableHttp2", s_get_enableHttp2, s_set_enableHttp2, false },
         { "http_proxy", s_get_http_proxy, s_set_http_proxy, false },
         { "https_proxy", s_get_https_proxy, s_set_https_proxy, false }
     };
@@ -447,6 +465,75 @@ inline void HttpClient_base::s_set_poolTimeout(v8::Local<v8::Name> property, v8:
     PROPERTY_SET_LEAVE();
 }
 
+inline void HttpClient_base::s_get_maxConnsPerHost(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_INSTANCE(HttpClient_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_maxConnsPerHost(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpClient_base::s_set_maxConnsPerHost(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_INSTANCE(HttpClient_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = pInst->set_maxConnsPerHost(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void HttpClient_base::s_get_pipelining(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_INSTANCE(HttpClient_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_pipelining(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpClient_base::s_set_pipelining(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_INSTANCE(HttpClient_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = pInst->set_pipelining(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void HttpClient_base::s_get_enableHttp2(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    bool vr;
+
+    METHOD_INSTANCE(HttpClient_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_enableHttp2(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpClient_base::s_set_enableHttp2(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_INSTANCE(HttpClient_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(bool);
+
+    hr = pInst->set_enableHttp2(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
 inline void HttpClient_base::s_get_http_proxy(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
 {
     exlib::string vr;
@@ -673,4 +760,18 @@ inline void HttpClient_base::s_head(const v8::FunctionCallbackInfo<v8::Value>& a
 
     METHOD_RETURN();
 }
+
+inline void HttpClient_base::s_stats(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    v8::Local<v8::Object> vr;
+
+    METHOD_INSTANCE(HttpClient_base);
+    METHOD_ENTER();
+
+    METHOD_OVER(0, 0);
+
+    hr = pInst->stats(vr);
+
+    METHOD_RETURN();
+}
 }
@@ -33,6 +33,14 @@ public:
     virtual result_t set_maxBodySize(int32_t newVal) = 0;
     virtual result_t get_enableEncoding(bool& retVal) = 0;
     virtual result_t set_enableEncoding(bool newVal) = 0;
+    virtual result_t get_enableHttp2(bool& retVal) = 0;
+    virtual result_t set_enableHttp2(bool newVal) = 0;
+    virtual result_t get_maxConcurrentStreams(int32_t& retVal) = 0;
+    virtual result_t set_maxConcurrentStreams(int32_t newVal) = 0;
+    virtual result_t get_headerTableSize(int32_t& retVal) = 0;
+    virtual result_t set_headerTableSize(int32_t newVal) = 0;
+    virtual result_t get_streamBody(bool& retVal) = 0;
+    virtual result_t set_streamBody(bool newVal) = 0;
     virtual result_t get_serverName(exlib::string& retVal) = 0;
     virtual result_t set_serverName(exlib::string newVal) = 0;
     virtual result_t get_handler(obj_ptr<Handler_base>& retVal) = 0;
@@ -53,6 +61,14 @@ public:
     static void s_set_maxBodySize(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_get_enableEncoding(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_set_enableEncoding(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_enableHttp2(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_enableHttp2(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_maxConcurrentStreams(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_maxConcurrentStreams(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_headerTableSize(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_headerTableSize(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_streamBody(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_streamBody(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_get_serverName(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_set_serverName(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_get_handler(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
@@ -72,6 +88,10 @@ inline ClassInfo& HttpHandler_base::class_info()
         { "maxHeaderSize", s_get_maxHeaderSize, s_set_maxHeaderSize, false },
         { "maxBodySize", s_get_maxBodySize, s_set_maxBodySize, false },
         { "enableEncoding", s_get_enableEncoding, s_set_enableEncoding, false },
+        { "enableHttp2", s_get_enableHttp2, s_set_enableHttp2, false },
+        { "maxConcurrentStreams", s_get_maxConcurrentStreams, s_set_maxConcurrentStreams, false },
+        { "headerTableSize", s_get_headerTableSize, s_set_headerTableSize, false },
+        { "streamBody", s_get_streamBody, s_set_streamBody, false },
         { "serverName", s_get_serverName, s_set_serverName, false },
         { "handler", s_get_handler, s_set_handler, false }
     };
@@ -215,6 +235,98 @@ inline void HttpHandler_base::s_set_enableEncoding(v8::Local<v8::Name> property,
     PROPERTY_SET_LEAVE();
 }
 
+inline void HttpHandler_base::s_get_enableHttp2(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    bool vr;
+
+    METHOD_INSTANCE(HttpHandler_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_enableHttp2(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpHandler_base::s_set_enableHttp2(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_INSTANCE(HttpHandler_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(bool);
+
+    hr = pInst->set_enableHttp2(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void HttpHandler_base::s_get_maxConcurrentStreams(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_INSTANCE(HttpHandler_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_maxConcurrentStreams(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpHandler_base::s_set_maxConcurrentStreams(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_INSTANCE(HttpHandler_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = pInst->set_maxConcurrentStreams(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void HttpHandler_base::s_get_headerTableSize(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_INSTANCE(HttpHandler_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_headerTableSize(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpHandler_base::s_set_headerTableSize(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_INSTANCE(HttpHandler_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = pInst->set_headerTableSize(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void HttpHandler_base::s_get_streamBody(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    bool vr;
+
+    METHOD_INSTANCE(HttpHandler_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_streamBody(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpHandler_base::s_set_streamBody(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_INSTANCE(HttpHandler_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(bool);
+
+    hr = pInst->set_streamBody(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
 inline void HttpHandler_base::s_get_serverName(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
 {
     exlib::string vr;
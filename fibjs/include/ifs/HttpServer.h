@@ -26,6 +26,7 @@ public:
     // HttpServer_base
     static result_t _new(int32_t port, Handler_base* hdlr, obj_ptr<HttpServer_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
     static result_t _new(exlib::string addr, int32_t port, Handler_base* hdlr, obj_ptr<HttpServer_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
+    static result_t _new(v8::Local<v8::Object> options, Handler_base* hdlr, obj_ptr<HttpServer_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
     static result_t _new(exlib::string addr, Handler_base* hdlr, obj_ptr<HttpServer_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
     virtual result_t enableCrossOrigin(exlib::string allowHeaders) = 0;
     virtual result_t get_maxHeadersCount(int32_t& retVal) = 0;
@@ -36,6 +37,14 @@ public:
     virtual result_t set_maxBodySize(int32_t newVal) = 0;
     virtual result_t get_enableEncoding(bool& retVal) = 0;
     virtual result_t set_enableEncoding(bool newVal) = 0;
+    virtual result_t get_enableHttp2(bool& retVal) = 0;
+    virtual result_t set_enableHttp2(bool newVal) = 0;
+    virtual result_t get_maxConcurrentStreams(int32_t& retVal) = 0;
+    virtual result_t set_maxConcurrentStreams(int32_t newVal) = 0;
+    virtual result_t get_headerTableSize(int32_t& retVal) = 0;
+    virtual result_t set_headerTableSize(int32_t newVal) = 0;
+    virtual result_t get_streamBody(bool& retVal) = 0;
+    virtual result_t set_streamBody(bool newVal) = 0;
     virtual result_t get_serverName(exlib::string& retVal) = 0;
     virtual result_t set_serverName(exlib::string newVal) = 0;
 
@@ -54,6 +63,14 @@ public:
     static void s_set_maxBodySize(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_get_enableEncoding(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_set_enableEncoding(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_enableHttp2(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_enableHttp2(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_maxConcurrentStreams(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_maxConcurrentStreams(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_headerTableSize(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_headerTableSize(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_streamBody(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_streamBody(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_get_serverName(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_set_serverName(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
 };
@@ -73,6 +90,10 @@ inline ClassInfo& HttpServer_base::class_info()
         { "maxHeaderSize", s_get_maxHeaderSize, s_set_maxHeaderSize, false },
         { "maxBodySize", s_get_maxBodySize, s_set_maxBodySize, false },
         { "enableEncoding", s_get_enableEncoding, s_set_enableEncoding, false },
+        { "enableHttp2", s_get_enableHttp2, s_set_enableHttp2, false },
+        { "maxConcurrentStreams", s_get_maxConcurrentStreams, s_set_maxConcurrentStreams, false },
+        { "headerTableSize", s_get_headerTableSize, s_set_headerTableSize, false },
+        { "streamBody", s_get_streamBody, s_set_streamBody, false },
         { "serverName", s_get_serverName, s_set_serverName, false }
     };
 
@@ -117,6 +138,13 @@ void HttpServer_base::__new(const T& args)
 
     METHOD_OVER(2, 2);
 
+    ARG(v8::Local<v8::Object>, 0);
+    ARG(obj_ptr<Handler_base>, 1);
+
+    hr = _new(v0, v1, vr, args.This());
+
+    METHOD_OVER(2, 2);
+
     ARG(exlib::string, 0);
     ARG(obj_ptr<Handler_base>, 1);
 
@@ -231,6 +259,98 @@ inline void HttpServer_base::s_set_enableEncoding(v8::Local<v8::Name> property,
     PROPERTY_SET_LEAVE();
 }
 
+inline void HttpServer_base::s_get_enableHttp2(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    bool vr;
+
+    METHOD_INSTANCE(HttpServer_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_enableHttp2(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpServer_base::s_set_enableHttp2(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_INSTANCE(HttpServer_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(bool);
+
+    hr = pInst->set_enableHttp2(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void HttpServer_base::s_get_maxConcurrentStreams(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_INSTANCE(HttpServer_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_maxConcurrentStreams(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpServer_base::s_set_maxConcurrentStreams(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_INSTANCE(HttpServer_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = pInst->set_maxConcurrentStreams(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void HttpServer_base::s_get_headerTableSize(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_INSTANCE(HttpServer_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_headerTableSize(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpServer_base::s_set_headerTableSize(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_INSTANCE(HttpServer_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = pInst->set_headerTableSize(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void HttpServer_base::s_get_streamBody(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    bool vr;
+
+    METHOD_INSTANCE(HttpServer_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_streamBody(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpServer_base::s_set_streamBody(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_INSTANCE(HttpServer_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(bool);
+
+    hr = pInst->set_streamBody(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
 inline void HttpServer_base::s_get_serverName(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
 {
     exlib::string vr;
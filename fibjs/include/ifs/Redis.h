@@ -20,6 +20,7 @@ class RedisHash_base;
 class RedisList_base;
 class RedisSet_base;
 class RedisSortedSet_base;
+class RedisPipeline_base;
 
 class Redis_base : public object_base {
     DECLARE_CLASS(Redis_base);
@@ -76,6 +77,9 @@ public:
     virtual result_t getList(Buffer_base* key, obj_ptr<RedisList_base>& retVal) = 0;
     virtual result_t getSet(Buffer_base* key, obj_ptr<RedisSet_base>& retVal) = 0;
     virtual result_t getSortedSet(Buffer_base* key, obj_ptr<RedisSortedSet_base>& retVal) = 0;
+    virtual result_t pipeline(obj_ptr<RedisPipeline_base>& retVal) = 0;
+    virtual result_t get_autoPipelining(bool& retVal) = 0;
+    virtual result_t set_autoPipelining(bool newVal) = 0;
     virtual result_t dump(Buffer_base* key, obj_ptr<Buffer_base>& retVal) = 0;
     virtual result_t restore(Buffer_base* key, Buffer_base* data, int64_t ttl) = 0;
     virtual result_t close() = 0;
@@ -128,6 +132,9 @@ public:
     static void s_getList(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_getSet(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_getSortedSet(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_pipeline(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_get_autoPipelining(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_autoPipelining(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_dump(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_restore(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_close(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -139,6 +146,7 @@ public:
 #include "ifs/RedisList.h"
 #include "ifs/RedisSet.h"
 #include "ifs/RedisSortedSet.h"
+#include "ifs/RedisPipeline.h"
 
 namespace fibjs {
 inline ClassInfo& Redis_base::class_info()
@@ -180,13 +188,15 @@ inline ClassInfo& Redis_base::class_info()
         { "getList", s_getList, false, ClassData::ASYNC_SYNC },
         { "getSet", s_getSet, false, ClassData::ASYNC_SYNC },
         { "getSortedSet", s_getSortedSet, false, ClassData::ASYNC_SYNC },
+        { "pipeline", s_pipeline, false, ClassData::ASYNC_SYNC },
         { "dump", s_dump, false, ClassData::ASYNC_SYNC },
         { "restore", s_restore, false, ClassData::ASYNC_SYNC },
         { "close", s_close, false, ClassData::ASYNC_SYNC }
     };
 
     static ClassData::ClassProperty s_property[] = {
-        { "onsuberror", s_get_onsuberror, s_set_onsuberror, false }
+        { "onsuberror", s_get_onsuberror, s_set_onsuberror, false },
+        { "autoPipelining", s_get_autoPipelining, s_set_autoPipelining, false }
     };
 
     static ClassData s_cd = {
@@ -879,6 +889,43 @@ inline void Redis_base::s_getSortedSet(const v8::FunctionCallbackInfo<v8::Value>
     METHOD_RETURN();
 }
 
+inline void Redis_base::s_pipeline(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    obj_ptr<RedisPipeline_base> vr;
+
+    METHOD_INSTANCE(Redis_base);
+    METHOD_ENTER();
+
+    METHOD_OVER(0, 0);
+
+    hr = pInst->pipeline(vr);
+
+    METHOD_RETURN();
+}
+
+inline void Redis_base::s_get_autoPipelining(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    bool vr;
+
+    METHOD_INSTANCE(Redis_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_autoPipelining(vr);
+
+    METHOD_RETURN();
+}
+
+inline void Redis_base::s_set_autoPipelining(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_INSTANCE(Redis_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(bool);
+
+    hr = pInst->set_autoPipelining(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
 inline void Redis_base::s_dump(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     obj_ptr<Buffer_base> vr;
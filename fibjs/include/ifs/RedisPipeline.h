@@ -0,0 +1,108 @@
+/***************************************************************************
+ *                                                                         *
+ *   This file was automatically generated using idlc.js                   *
+ *   PLEASE DO NOT EDIT!!!!                                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+/**
+ @author Leo Hoo <lion@9465.net>
+ */
+
+#include "../object.h"
+
+namespace fibjs {
+
+class RedisPipeline_base : public object_base {
+    DECLARE_CLASS(RedisPipeline_base);
+
+public:
+    // RedisPipeline_base
+    virtual result_t command(exlib::string cmd, OptArgs args, obj_ptr<RedisPipeline_base>& retVal) = 0;
+    virtual result_t get_length(int32_t& retVal) = 0;
+    virtual result_t exec(obj_ptr<NArray>& retVal) = 0;
+
+public:
+    static void s__new(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        CONSTRUCT_INIT();
+
+        isolate->m_isolate->ThrowException(
+            isolate->NewString("not a constructor"));
+    }
+
+public:
+    static void s_command(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_get_length(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_exec(const v8::FunctionCallbackInfo<v8::Value>& args);
+};
+}
+
+namespace fibjs {
+inline ClassInfo& RedisPipeline_base::class_info()
+{
+    static ClassData::ClassMethod s_method[] = {
+        { "command", s_command, false, ClassData::ASYNC_SYNC },
+        { "exec", s_exec, false, ClassData::ASYNC_SYNC }
+    };
+
+    static ClassData::ClassProperty s_property[] = {
+        { "length", s_get_length, block_set, false }
+    };
+
+    static ClassData s_cd = {
+        "RedisPipeline", false, s__new, NULL,
+        ARRAYSIZE(s_method), s_method, 0, NULL, ARRAYSIZE(s_property), s_property, 0, NULL, NULL, NULL,
+        &object_base::class_info(),
+        false
+    };
+
+    static ClassInfo s_ci(s_cd);
+    return s_ci;
+}
+
+inline void RedisPipeline_base::s_command(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    obj_ptr<RedisPipeline_base> vr;
+
+    METHOD_INSTANCE(RedisPipeline_base);
+    METHOD_ENTER();
+
+    METHOD_OVER(-1, 1);
+
+    ARG(exlib::string, 0);
+    ARG_LIST(1);
+
+    hr = pInst->command(v0, v1, vr);
+
+    METHOD_RETURN();
+}
+
+inline void RedisPipeline_base::s_get_length(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_INSTANCE(RedisPipeline_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_length(vr);
+
+    METHOD_RETURN();
+}
+
+inline void RedisPipeline_base::s_exec(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    obj_ptr<NArray> vr;
+
+    METHOD_INSTANCE(RedisPipeline_base);
+    METHOD_ENTER();
+
+    METHOD_OVER(0, 0);
+
+    hr = pInst->exec(vr);
+
+    METHOD_RETURN();
+}
+}
@@ -32,6 +32,7 @@ public:
     virtual result_t accept(Stream_base* socket, AsyncEvent* ac) = 0;
     virtual result_t get_stream(obj_ptr<Stream_base>& retVal) = 0;
     virtual result_t getProtocol(exlib::string& retVal) = 0;
+    virtual result_t getALPNProtocol(exlib::string& retVal) = 0;
     virtual result_t getX509Certificate(obj_ptr<X509Certificate_base>& retVal) = 0;
     virtual result_t getPeerX509Certificate(obj_ptr<X509Certificate_base>& retVal) = 0;
     virtual result_t get_secureContext(obj_ptr<SecureContext_base>& retVal) = 0;
@@ -50,6 +51,7 @@ public:
     static void s_accept(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_get_stream(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_getProtocol(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_getALPNProtocol(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_getX509Certificate(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_getPeerX509Certificate(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_get_secureContext(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
@@ -76,6 +78,7 @@ inline ClassInfo& TLSSocket_base::class_info()
         { "accept", s_accept, false, ClassData::ASYNC_ASYNC },
         { "acceptSync", s_accept, false, ClassData::ASYNC_SYNC },
         { "getProtocol", s_getProtocol, false, ClassData::ASYNC_SYNC },
+        { "getALPNProtocol", s_getALPNProtocol, false, ClassData::ASYNC_SYNC },
         { "getX509Certificate", s_getX509Certificate, false, ClassData::ASYNC_SYNC },
         { "getPeerX509Certificate", s_getPeerX509Certificate, false, ClassData::ASYNC_SYNC }
     };
@@ -194,6 +197,20 @@ inline void TLSSocket_base::s_getProtocol(const v8::FunctionCallbackInfo<v8::Val
     METHOD_RETURN();
 }
 
+inline void TLSSocket_base::s_getALPNProtocol(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    exlib::string vr;
+
+    METHOD_INSTANCE(TLSSocket_base);
+    METHOD_ENTER();
+
+    METHOD_OVER(0, 0);
+
+    hr = pInst->getALPNProtocol(vr);
+
+    METHOD_RETURN();
+}
+
 inline void TLSSocket_base::s_getX509Certificate(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     obj_ptr<X509Certificate_base> vr;
@@ -24,7 +24,7 @@ class Worker_base : public EventEmitter_base {
 public:
     // Worker_base
     static result_t _new(exlib::string path, v8::Local<v8::Object> opts, obj_ptr<Worker_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
-    virtual result_t postMessage(v8::Local<v8::Value> data) = 0;
+    virtual result_t postMessage(v8::Local<v8::Value> data, v8::Local<v8::Array> transfer) = 0;
     virtual result_t get_onload(v8::Local<v8::Function>& retVal) = 0;
     virtual result_t set_onload(v8::Local<v8::Function> newVal) = 0;
     virtual result_t get_onmessage(v8::Local<v8::Function>& retVal) = 0;
@@ -100,11 +100,12 @@ inline void Worker_base::s_postMessage(const v8::FunctionCallbackInfo<v8::Value>
     METHOD_INSTANCE(Worker_base);
     METHOD_ENTER();
 
-    METHOD_OVER(1, 1);
+    METHOD_OVER(2, 1);
 
     ARG(v8::Local<v8::Value>, 0);
+    OPT_ARG(v8::Local<v8::Array>, 1, v8::Array::New(isolate->m_isolate));
 
-    hr = pInst->postMessage(v0);
+    hr = pInst->postMessage(v0, v1);
 
     METHOD_VOID();
 }
@@ -34,6 +34,7 @@ public:
     static result_t parallel(OptArgs funcs, v8::Local<v8::Array>& retVal);
     static result_t current(obj_ptr<Fiber_base>& retVal);
     static result_t sleep(int32_t ms, AsyncEvent* ac);
+    static result_t stats(v8::Local<v8::Object>& retVal);
     static result_t get_fibers(v8::Local<v8::Array>& retVal);
     static result_t get_spareFibers(int32_t& retVal);
     static result_t set_spareFibers(int32_t newVal);
@@ -55,6 +56,7 @@ public:
     static void s_static_parallel(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_current(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_sleep(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_stats(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_get_fibers(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_static_get_spareFibers(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_static_set_spareFibers(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
@@ -82,7 +84,8 @@ inline ClassInfo& coroutine_base::class_info()
         { "parallel", s_static_parallel, true, ClassData::ASYNC_SYNC },
         { "current", s_static_current, true, ClassData::ASYNC_SYNC },
         { "sleep", s_static_sleep, true, ClassData::ASYNC_ASYNC },
-        { "sleepSync", s_static_sleep, true, ClassData::ASYNC_SYNC }
+        { "sleepSync", s_static_sleep, true, ClassData::ASYNC_SYNC },
+        { "stats", s_static_stats, true, ClassData::ASYNC_SYNC }
     };
 
     static ClassData::ClassObject s_object[] = {
@@ -194,6 +197,19 @@ inline void coroutine_base::s_static_sleep(const v8::FunctionCallbackInfo<v8::Va
     METHOD_VOID();
 }
 
+inline void coroutine_base::s_static_stats(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    v8::Local<v8::Object> vr;
+
+    METHOD_ENTER();
+
+    METHOD_OVER(0, 0);
+
+    hr = stats(vr);
+
+    METHOD_RETURN();
+}
+
 inline void coroutine_base::s_static_get_fibers(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
 {
     v8::Local<v8::Array> vr;
@@ -20,6 +20,10 @@ class dns_base : public object_base {
 
 public:
     // dns_base
+    static result_t get_ttl(int32_t& retVal);
+    static result_t set_ttl(int32_t newVal);
+    static result_t get_negativeTtl(int32_t& retVal);
+    static result_t set_negativeTtl(int32_t newVal);
     static result_t resolve(exlib::string name, obj_ptr<NArray>& retVal, AsyncEvent* ac);
     static result_t lookup(exlib::string name, exlib::string& retVal, AsyncEvent* ac);
 
@@ -33,6 +37,10 @@ public:
     }
 
 public:
+    static void s_static_get_ttl(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_static_set_ttl(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_static_get_negativeTtl(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_static_set_negativeTtl(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_static_resolve(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_lookup(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -52,9 +60,14 @@ inline ClassInfo& dns_base::class_info()
         { "lookupSync", s_static_lookup, true, ClassData::ASYNC_SYNC }
     };
 
+    static ClassData::ClassProperty s_property[] = {
+        { "ttl", s_static_get_ttl, s_static_set_ttl, true },
+        { "negativeTtl", s_static_get_negativeTtl, s_static_set_negativeTtl, true }
+    };
+
     static ClassData s_cd = {
         "dns", true, s__new, NULL,
-        ARRAYSIZE(s_method), s_method, 0, NULL, 0, NULL, 0, NULL, NULL, NULL,
+        ARRAYSIZE(s_method), s_method, 0, NULL, ARRAYSIZE(s_property), s_property, 0, NULL, NULL, NULL,
         &object_base::class_info(),
         true
     };
@@ -63,6 +76,48 @@ inline ClassInfo& dns_base::class_info()
     return s_ci;
 }
 
+inline void dns_base::s_static_get_ttl(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    PROPERTY_ENTER();
+
+    hr = get_ttl(vr);
+
+    METHOD_RETURN();
+}
+
+inline void dns_base::s_static_set_ttl(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = set_ttl(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void dns_base::s_static_get_negativeTtl(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    PROPERTY_ENTER();
+
+    hr = get_negativeTtl(vr);
+
+    METHOD_RETURN();
+}
+
+inline void dns_base::s_static_set_negativeTtl(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = set_negativeTtl(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
 inline void dns_base::s_static_resolve(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     obj_ptr<NArray> vr;
@@ -36,6 +36,7 @@ public:
 
 public:
     // fs_base
+    static result_t backend(exlib::string& retVal);
     static result_t exists(exlib::string path, bool& retVal, AsyncEvent* ac);
     static result_t access(exlib::string path, int32_t mode, AsyncEvent* ac);
     static result_t link(exlib::string oldPath, exlib::string newPath, AsyncEvent* ac);
@@ -100,6 +101,7 @@ public:
     }
 
 public:
+    static void s_static_backend(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_exists(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_access(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_link(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -201,6 +203,7 @@ namespace fibjs {
 inline ClassInfo& fs_base::class_info()
 {
     static ClassData::ClassMethod s_method[] = {
+        { "backend", s_static_backend, true, ClassData::ASYNC_SYNC },
         { "exists", s_static_exists, true, ClassData::ASYNC_ASYNC },
         { "existsSync", s_static_exists, true, ClassData::ASYNC_SYNC },
         { "access", s_static_access, true, ClassData::ASYNC_ASYNC },
@@ -300,6 +303,19 @@ inline ClassInfo& fs_base::class_info()
     return s_ci;
 }
 
+inline void fs_base::s_static_backend(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    exlib::string vr;
+
+    METHOD_ENTER();
+
+    METHOD_OVER(0, 0);
+
+    hr = backend(vr);
+
+    METHOD_RETURN();
+}
+
 inline void fs_base::s_static_exists(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     bool vr;
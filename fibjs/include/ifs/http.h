@@ -54,11 +54,18 @@ public:
     static result_t set_poolSize(int32_t newVal);
     static result_t get_poolTimeout(int32_t& retVal);
     static result_t set_poolTimeout(int32_t newVal);
+    static result_t get_maxConnsPerHost(int32_t& retVal);
+    static result_t set_maxConnsPerHost(int32_t newVal);
+    static result_t get_pipelining(int32_t& retVal);
+    static result_t set_pipelining(int32_t newVal);
+    static result_t get_enableHttp2(bool& retVal);
+    static result_t set_enableHttp2(bool newVal);
     static result_t get_http_proxy(exlib::string& retVal);
     static result_t set_http_proxy(exlib::string newVal);
     static result_t get_https_proxy(exlib::string& retVal);
     static result_t set_https_proxy(exlib::string newVal);
-    static result_t fileHandler(exlib::string root, v8::Local<v8::Object> mimes, bool autoIndex, obj_ptr<Handler_base>& retVal);
+    static result_t fileHandler(exlib::string root, v8::Local<v8::Object> mimes, bool autoIndex, v8::Local<v8::Object> cache, obj_ptr<Handler_base>& retVal);
+    static result_t stats(v8::Local<v8::Object>& retVal);
     static result_t request(Stream_base* conn, HttpRequest_base* req, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac);
     static result_t request(Stream_base* conn, HttpRequest_base* req, SeekableStream_base* response_body, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac);
     static result_t request(exlib::string method, exlib::string url, v8::Local<v8::Object> opts, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac);
@@ -103,11 +110,18 @@ public:
     static void s_static_set_poolSize(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_static_get_poolTimeout(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_static_set_poolTimeout(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_static_get_maxConnsPerHost(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_static_set_maxConnsPerHost(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_static_get_pipelining(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_static_set_pipelining(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_static_get_enableHttp2(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_static_set_enableHttp2(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_static_get_http_proxy(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_static_set_http_proxy(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_static_get_https_proxy(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_static_set_https_proxy(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_static_fileHandler(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_stats(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_request(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_get(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_post(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -148,6 +162,7 @@ inline ClassInfo& http_base::class_info()
 {
     static ClassData::ClassMethod s_method[] = {
         { "fileHandler", s_static_fileHandler, true, ClassData::ASYNC_SYNC },
+        { "stats", s_static_stats, true, ClassData::ASYNC_SYNC },
         { "request", s_static_request, true, ClassData::ASYNC_ASYNC },
         { "requestSync", s_static_request, true, ClassData::ASYNC_SYNC },
         { "get", s_static_get, true, ClassData::ASYNC_ASYNC },
@@ -188,6 +203,9 @@ inline ClassInfo& http_base::class_info()
         { "userAgent", s_static_get_userAgent, s_static_set_userAgent, true },
         { "poolSize", s_static_get_poolSize, s_static_set_poolSize, true },
         { "poolTimeout", s_static_get_poolTimeout, s_static_set_poolTimeout, true },
+        { "maxConnsPerHost", s_static_get_maxConnsPerHost, s_static_set_maxConnsPerHost, true },
+        { "pipelining", s_static_get_pipelining, s_static_set_pipelining, true },
+        { "enableHttp2", s_static_get_enableHttp2, s_static_set_enableHttp2, true },
         { "http_proxy", s_static_get_http_proxy, s_static_set_http_proxy, true },
         { "https_proxy", s_static_get_https_proxy, s_static_set_https_proxy, true }
     };
@@ -435,6 +453,69 @@ inline void http_base::s_static_set_poolTimeout(v8::Local<v8::Name> property, v8
     PROPERTY_SET_LEAVE();
 }
 
+inline void http_base::s_static_get_maxConnsPerHost(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    PROPERTY_ENTER();
+
+    hr = get_maxConnsPerHost(vr);
+
+    METHOD_RETURN();
+}
+
+inline void http_base::s_static_set_maxConnsPerHost(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = set_maxConnsPerHost(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void http_base::s_static_get_pipelining(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    PROPERTY_ENTER();
+
+    hr = get_pipelining(vr);
+
+    METHOD_RETURN();
+}
+
+inline void http_base::s_static_set_pipelining(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = set_pipelining(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void http_base::s_static_get_enableHttp2(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    bool vr;
+
+    PROPERTY_ENTER();
+
+    hr = get_enableHttp2(vr);
+
+    METHOD_RETURN();
+}
+
+inline void http_base::s_static_set_enableHttp2(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    PROPERTY_ENTER();
+    PROPERTY_VAL(bool);
+
+    hr = set_enableHttp2(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
 inline void http_base::s_static_get_http_proxy(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
 {
     exlib::string vr;
@@ -483,13 +564,27 @@ inline void http_base::s_static_fileHandler(const v8::FunctionCallbackInfo<v8::V
 
     METHOD_ENTER();
 
-    METHOD_OVER(3, 1);
+    METHOD_OVER(4, 1);
 
     ARG(exlib::string, 0);
     OPT_ARG(v8::Local<v8::Object>, 1, v8::Object::New(isolate->m_isolate));
     OPT_ARG(bool, 2, false);
+    OPT_ARG(v8::Local<v8::Object>, 3, v8::Object::New(isolate->m_isolate));
+
+    hr = fileHandler(v0, v1, v2, v3, vr);
+
+    METHOD_RETURN();
+}
+
+inline void http_base::s_static_stats(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    v8::Local<v8::Object> vr;
+
+    METHOD_ENTER();
+
+    METHOD_OVER(0, 0);
 
-    hr = fileHandler(v0, v1, v2, vr);
+    hr = stats(vr);
 
     METHOD_RETURN();
 }
@@ -36,7 +36,10 @@ public:
     // net_base
     static result_t get_use_uv_socket(bool& retVal);
     static result_t set_use_uv_socket(bool newVal);
+    static result_t get_uv_loops(int32_t& retVal);
+    static result_t set_uv_loops(int32_t newVal);
     static result_t info(v8::Local<v8::Object>& retVal);
+    static result_t stats(v8::Local<v8::Object>& retVal);
     static result_t resolve(exlib::string name, int32_t family, exlib::string& retVal, AsyncEvent* ac);
     static result_t ip(exlib::string name, exlib::string& retVal, AsyncEvent* ac);
     static result_t ipv6(exlib::string name, exlib::string& retVal, AsyncEvent* ac);
@@ -59,7 +62,10 @@ public:
 public:
     static void s_static_get_use_uv_socket(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_static_set_use_uv_socket(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_static_get_uv_loops(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_static_set_uv_loops(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_static_info(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_stats(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_resolve(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_ip(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_ipv6(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -90,6 +96,7 @@ inline ClassInfo& net_base::class_info()
 {
     static ClassData::ClassMethod s_method[] = {
         { "info", s_static_info, true, ClassData::ASYNC_SYNC },
+        { "stats", s_static_stats, true, ClassData::ASYNC_SYNC },
         { "resolve", s_static_resolve, true, ClassData::ASYNC_ASYNC },
         { "resolveSync", s_static_resolve, true, ClassData::ASYNC_SYNC },
         { "ip", s_static_ip, true, ClassData::ASYNC_ASYNC },
@@ -114,7 +121,8 @@ inline ClassInfo& net_base::class_info()
     };
 
     static ClassData::ClassProperty s_property[] = {
-        { "use_uv_socket", s_static_get_use_uv_socket, s_static_set_use_uv_socket, true }
+        { "use_uv_socket", s_static_get_use_uv_socket, s_static_set_use_uv_socket, true },
+        { "uv_loops", s_static_get_uv_loops, s_static_set_uv_loops, true }
     };
 
     static ClassData::ClassConst s_const[] = {
@@ -156,6 +164,27 @@ inline void net_base::s_static_set_use_uv_socket(v8::Local<v8::Name> property, v
     PROPERTY_SET_LEAVE();
 }
 
+inline void net_base::s_static_get_uv_loops(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    PROPERTY_ENTER();
+
+    hr = get_uv_loops(vr);
+
+    METHOD_RETURN();
+}
+
+inline void net_base::s_static_set_uv_loops(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = set_uv_loops(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
 inline void net_base::s_static_info(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     v8::Local<v8::Object> vr;
@@ -169,6 +198,19 @@ inline void net_base::s_static_info(const v8::FunctionCallbackInfo<v8::Value>& a
     METHOD_RETURN();
 }
 
+inline void net_base::s_static_stats(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    v8::Local<v8::Object> vr;
+
+    METHOD_ENTER();
+
+    METHOD_OVER(0, 0);
+
+    hr = stats(vr);
+
+    METHOD_RETURN();
+}
+
 inline void net_base::s_static_resolve(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     exlib::string vr;
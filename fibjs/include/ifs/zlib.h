@@ -38,6 +38,12 @@ public:
     static result_t createGzip(Stream_base* to, obj_ptr<Stream_base>& retVal);
     static result_t createInflate(Stream_base* to, int32_t maxSize, obj_ptr<Stream_base>& retVal);
     static result_t createInflateRaw(Stream_base* to, int32_t maxSize, obj_ptr<Stream_base>& retVal);
+    static result_t createBrotliCompress(Stream_base* to, obj_ptr<Stream_base>& retVal);
+    static result_t createBrotliDecompress(Stream_base* to, int32_t maxSize, obj_ptr<Stream_base>& retVal);
+    static result_t createZstdCompress(Stream_base* to, obj_ptr<Stream_base>& retVal);
+    static result_t createZstdCompress(Stream_base* to, Buffer_base* dict, obj_ptr<Stream_base>& retVal);
+    static result_t createZstdDecompress(Stream_base* to, int32_t maxSize, obj_ptr<Stream_base>& retVal);
+    static result_t createZstdDecompress(Stream_base* to, Buffer_base* dict, int32_t maxSize, obj_ptr<Stream_base>& retVal);
     static result_t deflate(Buffer_base* data, int32_t level, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
     static result_t deflateTo(Buffer_base* data, Stream_base* stm, int32_t level, AsyncEvent* ac);
     static result_t deflateTo(Stream_base* src, Stream_base* stm, int32_t level, AsyncEvent* ac);
@@ -56,6 +62,20 @@ public:
     static result_t inflateRaw(Buffer_base* data, int32_t maxSize, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
     static result_t inflateRawTo(Buffer_base* data, Stream_base* stm, int32_t maxSize, AsyncEvent* ac);
     static result_t inflateRawTo(Stream_base* src, Stream_base* stm, int32_t maxSize, AsyncEvent* ac);
+    static result_t brotliCompress(Buffer_base* data, int32_t level, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
+    static result_t brotliCompressTo(Buffer_base* data, Stream_base* stm, int32_t level, AsyncEvent* ac);
+    static result_t brotliCompressTo(Stream_base* src, Stream_base* stm, int32_t level, AsyncEvent* ac);
+    static result_t brotliDecompress(Buffer_base* data, int32_t maxSize, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
+    static result_t brotliDecompressTo(Buffer_base* data, Stream_base* stm, int32_t maxSize, AsyncEvent* ac);
+    static result_t brotliDecompressTo(Stream_base* src, Stream_base* stm, int32_t maxSize, AsyncEvent* ac);
+    static result_t zstdCompress(Buffer_base* data, int32_t level, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
+    static result_t zstdCompress(Buffer_base* data, Buffer_base* dict, int32_t level, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
+    static result_t zstdCompressTo(Buffer_base* data, Stream_base* stm, int32_t level, AsyncEvent* ac);
+    static result_t zstdCompressTo(Stream_base* src, Stream_base* stm, int32_t level, AsyncEvent* ac);
+    static result_t zstdDecompress(Buffer_base* data, int32_t maxSize, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
+    static result_t zstdDecompress(Buffer_base* data, Buffer_base* dict, int32_t maxSize, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
+    static result_t zstdDecompressTo(Buffer_base* data, Stream_base* stm, int32_t maxSize, AsyncEvent* ac);
+    static result_t zstdDecompressTo(Stream_base* src, Stream_base* stm, int32_t maxSize, AsyncEvent* ac);
 
 public:
     static void s__new(const v8::FunctionCallbackInfo<v8::Value>& args)
@@ -73,6 +93,10 @@ public:
     static void s_static_createGzip(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_createInflate(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_createInflateRaw(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_createBrotliCompress(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_createBrotliDecompress(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_createZstdCompress(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_createZstdDecompress(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_deflate(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_deflateTo(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_inflate(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -85,6 +109,14 @@ public:
     static void s_static_deflateRawTo(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_inflateRaw(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_inflateRawTo(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_brotliCompress(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_brotliCompressTo(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_brotliDecompress(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_brotliDecompressTo(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_zstdCompress(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_zstdCompressTo(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_zstdDecompress(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_zstdDecompressTo(const v8::FunctionCallbackInfo<v8::Value>& args);
 
 public:
     ASYNC_STATICVALUE3(zlib_base, deflate, Buffer_base*, int32_t, obj_ptr<Buffer_base>);
@@ -105,6 +137,20 @@ public:
     ASYNC_STATICVALUE3(zlib_base, inflateRaw, Buffer_base*, int32_t, obj_ptr<Buffer_base>);
     ASYNC_STATIC3(zlib_base, inflateRawTo, Buffer_base*, Stream_base*, int32_t);
     ASYNC_STATIC3(zlib_base, inflateRawTo, Stream_base*, Stream_base*, int32_t);
+    ASYNC_STATICVALUE3(zlib_base, brotliCompress, Buffer_base*, int32_t, obj_ptr<Buffer_base>);
+    ASYNC_STATIC3(zlib_base, brotliCompressTo, Buffer_base*, Stream_base*, int32_t);
+    ASYNC_STATIC3(zlib_base, brotliCompressTo, Stream_base*, Stream_base*, int32_t);
+    ASYNC_STATICVALUE3(zlib_base, brotliDecompress, Buffer_base*, int32_t, obj_ptr<Buffer_base>);
+    ASYNC_STATIC3(zlib_base, brotliDecompressTo, Buffer_base*, Stream_base*, int32_t);
+    ASYNC_STATIC3(zlib_base, brotliDecompressTo, Stream_base*, Stream_base*, int32_t);
+    ASYNC_STATICVALUE3(zlib_base, zstdCompress, Buffer_base*, int32_t, obj_ptr<Buffer_base>);
+    ASYNC_STATICVALUE4(zlib_base, zstdCompress, Buffer_base*, Buffer_base*, int32_t, obj_ptr<Buffer_base>);
+    ASYNC_STATIC3(zlib_base, zstdCompressTo, Buffer_base*, Stream_base*, int32_t);
+    ASYNC_STATIC3(zlib_base, zstdCompressTo, Stream_base*, Stream_base*, int32_t);
+    ASYNC_STATICVALUE3(zlib_base, zstdDecompress, Buffer_base*, int32_t, obj_ptr<Buffer_base>);
+    ASYNC_STATICVALUE4(zlib_base, zstdDecompress, Buffer_base*, Buffer_base*, int32_t, obj_ptr<Buffer_base>);
+    ASYNC_STATIC3(zlib_base, zstdDecompressTo, Buffer_base*, Stream_base*, int32_t);
+    ASYNC_STATIC3(zlib_base, zstdDecompressTo, Stream_base*, Stream_base*, int32_t);
 };
 }
 
@@ -122,6 +168,10 @@ inline ClassInfo& zlib_base::class_info()
         { "createGzip", s_static_createGzip, true, ClassData::ASYNC_SYNC },
         { "createInflate", s_static_createInflate, true, ClassData::ASYNC_SYNC },
         { "createInflateRaw", s_static_createInflateRaw, true, ClassData::ASYNC_SYNC },
+        { "createBrotliCompress", s_static_createBrotliCompress, true, ClassData::ASYNC_SYNC },
+        { "createBrotliDecompress", s_static_createBrotliDecompress, true, ClassData::ASYNC_SYNC },
+        { "createZstdCompress", s_static_createZstdCompress, true, ClassData::ASYNC_SYNC },
+        { "createZstdDecompress", s_static_createZstdDecompress, true, ClassData::ASYNC_SYNC },
         { "deflate", s_static_deflate, true, ClassData::ASYNC_ASYNC },
         { "deflateSync", s_static_deflate, true, ClassData::ASYNC_SYNC },
         { "deflateTo", s_static_deflateTo, true, ClassData::ASYNC_ASYNC },
@@ -145,7 +195,23 @@ inline ClassInfo& zlib_base::class_info()
         { "inflateRaw", s_static_inflateRaw, true, ClassData::ASYNC_ASYNC },
         { "inflateRawSync", s_static_inflateRaw, true, ClassData::ASYNC_SYNC },
         { "inflateRawTo", s_static_inflateRawTo, true, ClassData::ASYNC_ASYNC },
-        { "inflateRawToSync", s_static_inflateRawTo, true, ClassData::ASYNC_SYNC }
+        { "inflateRawToSync", s_static_inflateRawTo, true, ClassData::ASYNC_SYNC },
+        { "brotliCompress", s_static_brotliCompress, true, ClassData::ASYNC_ASYNC },
+        { "brotliCompressSync", s_static_brotliCompress, true, ClassData::ASYNC_SYNC },
+        { "brotliCompressTo", s_static_brotliCompressTo, true, ClassData::ASYNC_ASYNC },
+        { "brotliCompressToSync", s_static_brotliCompressTo, true, ClassData::ASYNC_SYNC },
+        { "brotliDecompress", s_static_brotliDecompress, true, ClassData::ASYNC_ASYNC },
+        { "brotliDecompressSync", s_static_brotliDecompress, true, ClassData::ASYNC_SYNC },
+        { "brotliDecompressTo", s_static_brotliDecompressTo, true, ClassData::ASYNC_ASYNC },
+        { "brotliDecompressToSync", s_static_brotliDecompressTo, true, ClassData::ASYNC_SYNC },
+        { "zstdCompress", s_static_zstdCompress, true, ClassData::ASYNC_ASYNC },
+        { "zstdCompressSync", s_static_zstdCompress, true, ClassData::ASYNC_SYNC },
+        { "zstdCompressTo", s_static_zstdCompressTo, true, ClassData::ASYNC_ASYNC },
+        { "zstdCompressToSync", s_static_zstdCompressTo, true, ClassData::ASYNC_SYNC },
+        { "zstdDecompress", s_static_zstdDecompress, true, ClassData::ASYNC_ASYNC },
+        { "zstdDecompressSync", s_static_zstdDecompress, true, ClassData::ASYNC_SYNC },
+        { "zstdDecompressTo", s_static_zstdDecompressTo, true, ClassData::ASYNC_ASYNC },
+        { "zstdDecompressToSync", s_static_zstdDecompressTo, true, ClassData::ASYNC_SYNC }
     };
 
     static ClassData::ClassObject s_object[] = {
@@ -263,6 +329,83 @@ inline void zlib_base::s_static_createInflateRaw(const v8::FunctionCallbackInfo<
     METHOD_RETURN();
 }
 
+inline void zlib_base::s_static_createBrotliCompress(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    obj_ptr<Stream_base> vr;
+
+    METHOD_ENTER();
+
+    METHOD_OVER(1, 1);
+
+    ARG(obj_ptr<Stream_base>, 0);
+
+    hr = createBrotliCompress(v0, vr);
+
+    METHOD_RETURN();
+}
+
+inline void zlib_base::s_static_createBrotliDecompress(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    obj_ptr<Stream_base> vr;
+
+    METHOD_ENTER();
+
+    METHOD_OVER(2, 1);
+
+    ARG(obj_ptr<Stream_base>, 0);
+    OPT_ARG(int32_t, 1, -1);
+
+    hr = createBrotliDecompress(v0, v1, vr);
+
+    METHOD_RETURN();
+}
+
+inline void zlib_base::s_static_createZstdCompress(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    obj_ptr<Stream_base> vr;
+
+    METHOD_ENTER();
+
+    METHOD_OVER(1, 1);
+
+    ARG(obj_ptr<Stream_base>, 0);
+
+    hr = createZstdCompress(v0, vr);
+
+    METHOD_OVER(2, 2);
+
+    ARG(obj_ptr<Stream_base>, 0);
+    ARG(obj_ptr<Buffer_base>, 1);
+
+    hr = createZstdCompress(v0, v1, vr);
+
+    METHOD_RETURN();
+}
+
+inline void zlib_base::s_static_createZstdDecompress(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    obj_ptr<Stream_base> vr;
+
+    METHOD_ENTER();
+
+    METHOD_OVER(2, 1);
+
+    ARG(obj_ptr<Stream_base>, 0);
+    OPT_ARG(int32_t, 1, -1);
+
+    hr = createZstdDecompress(v0, v1, vr);
+
+    METHOD_OVER(3, 2);
+
+    ARG(obj_ptr<Stream_base>, 0);
+    ARG(obj_ptr<Buffer_base>, 1);
+    OPT_ARG(int32_t, 2, -1);
+
+    hr = createZstdDecompress(v0, v1, v2, vr);
+
+    METHOD_RETURN();
+}
+
 inline void zlib_base::s_static_deflate(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     obj_ptr<Buffer_base> vr;
@@ -547,4 +690,218 @@ inline void zlib_base::s_static_inflateRawTo(const v8::FunctionCallbackInfo<v8::
 
     METHOD_VOID();
 }
+
+inline void zlib_base::s_static_brotliCompress(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    obj_ptr<Buffer_base> vr;
+
+    METHOD_ENTER();
+
+    ASYNC_METHOD_OVER(2, 1);
+
+    ARG(obj_ptr<Buffer_base>, 0);
+    OPT_ARG(int32_t, 1, C_DEFAULT_COMPRESSION);
+
+    if (!cb.IsEmpty())
+        hr = acb_brotliCompress(v0, v1, cb, args);
+    else
+        hr = ac_brotliCompress(v0, v1, vr);
+
+    METHOD_RETURN();
+}
+
+inline void zlib_base::s_static_brotliCompressTo(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    METHOD_ENTER();
+
+    ASYNC_METHOD_OVER(3, 2);
+
+    ARG(obj_ptr<Buffer_base>, 0);
+    ARG(obj_ptr<Stream_base>, 1);
+    OPT_ARG(int32_t, 2, C_DEFAULT_COMPRESSION);
+
+    if (!cb.IsEmpty())
+        hr = acb_brotliCompressTo(v0, v1, v2, cb, args);
+    else
+        hr = ac_brotliCompressTo(v0, v1, v2);
+
+    ASYNC_METHOD_OVER(3, 2);
+
+    ARG(obj_ptr<Stream_base>, 0);
+    ARG(obj_ptr<Stream_base>, 1);
+    OPT_ARG(int32_t, 2, C_DEFAULT_COMPRESSION);
+
+    if (!cb.IsEmpty())
+        hr = acb_brotliCompressTo(v0, v1, v2, cb, args);
+    else
+        hr = ac_brotliCompressTo(v0, v1, v2);
+
+    METHOD_VOID();
+}
+
+inline void zlib_base::s_static_brotliDecompress(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    obj_ptr<Buffer_base> vr;
+
+    METHOD_ENTER();
+
+    ASYNC_METHOD_OVER(2, 1);
+
+    ARG(obj_ptr<Buffer_base>, 0);
+    OPT_ARG(int32_t, 1, -1);
+
+    if (!cb.IsEmpty())
+        hr = acb_brotliDecompress(v0, v1, cb, args);
+    else
+        hr = ac_brotliDecompress(v0, v1, vr);
+
+    METHOD_RETURN();
+}
+
+inline void zlib_base::s_static_brotliDecompressTo(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    METHOD_ENTER();
+
+    ASYNC_METHOD_OVER(3, 2);
+
+    ARG(obj_ptr<Buffer_base>, 0);
+    ARG(obj_ptr<Stream_base>, 1);
+    OPT_ARG(int32_t, 2, -1);
+
+    if (!cb.IsEmpty())
+        hr = acb_brotliDecompressTo(v0, v1, v2, cb, args);
+    else
+        hr = ac_brotliDecompressTo(v0, v1, v2);
+
+    ASYNC_METHOD_OVER(3, 2);
+
+    ARG(obj_ptr<Stream_base>, 0);
+    ARG(obj_ptr<Stream_base>, 1);
+    OPT_ARG(int32_t, 2, -1);
+
+    if (!cb.IsEmpty())
+        hr = acb_brotliDecompressTo(v0, v1, v2, cb, args);
+    else
+        hr = ac_brotliDecompressTo(v0, v1, v2);
+
+    METHOD_VOID();
+}
+
+inline void zlib_base::s_static_zstdCompress(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    obj_ptr<Buffer_base> vr;
+
+    METHOD_ENTER();
+
+    ASYNC_METHOD_OVER(2, 1);
+
+    ARG(obj_ptr<Buffer_base>, 0);
+    OPT_ARG(int32_t, 1, C_DEFAULT_COMPRESSION);
+
+    if (!cb.IsEmpty())
+        hr = acb_zstdCompress(v0, v1, cb, args);
+    else
+        hr = ac_zstdCompress(v0, v1, vr);
+
+    ASYNC_METHOD_OVER(3, 2);
+
+    ARG(obj_ptr<Buffer_base>, 0);
+    ARG(obj_ptr<Buffer_base>, 1);
+    OPT_ARG(int32_t, 2, C_DEFAULT_COMPRESSION);
+
+    if (!cb.IsEmpty())
+        hr = acb_zstdCompress(v0, v1, v2, cb, args);
+    else
+        hr = ac_zstdCompress(v0, v1, v2, vr);
+
+    METHOD_RETURN();
+}
+
+inline void zlib_base::s_static_zstdCompressTo(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    METHOD_ENTER();
+
+    ASYNC_METHOD_OVER(3, 2);
+
+    ARG(obj_ptr<Buffer_base>, 0);
+    ARG(obj_ptr<Stream_base>, 1);
+    OPT_ARG(int32_t, 2, C_DEFAULT_COMPRESSION);
+
+    if (!cb.IsEmpty())
+        hr = acb_zstdCompressTo(v0, v1, v2, cb, args);
+    else
+        hr = ac_zstdCompressTo(v0, v1, v2);
+
+    ASYNC_METHOD_OVER(3, 2);
+
+    ARG(obj_ptr<Stream_base>, 0);
+    ARG(obj_ptr<Stream_base>, 1);
+    OPT_ARG(int32_t, 2, C_DEFAULT_COMPRESSION);
+
+    if (!cb.IsEmpty())
+        hr = acb_zstdCompressTo(v0, v1, v2, cb, args);
+    else
+        hr = ac_zstdCompressTo(v0, v1, v2);
+
+    METHOD_VOID();
+}
+
+inline void zlib_base::s_static_zstdDecompress(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    obj_ptr<Buffer_base> vr;
+
+    METHOD_ENTER();
+
+    ASYNC_METHOD_OVER(2, 1);
+
+    ARG(obj_ptr<Buffer_base>, 0);
+    OPT_ARG(int32_t, 1, -1);
+
+    if (!cb.IsEmpty())
+        hr = acb_zstdDecompress(v0, v1, cb, args);
+    else
+        hr = ac_zstdDecompress(v0, v1, vr);
+
+    ASYNC_METHOD_OVER(3, 2);
+
+    ARG(obj_ptr<Buffer_base>, 0);
+    ARG(obj_ptr<Buffer_base>, 1);
+    OPT_ARG(int32_t, 2, -1);
+
+    if (!cb.IsEmpty())
+        hr = acb_zstdDecompress(v0, v1, v2, cb, args);
+    else
+        hr = ac_zstdDecompress(v0, v1, v2, vr);
+
+    METHOD_RETURN();
+}
+
+inline void zlib_base::s_static_zstdDecompressTo(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    METHOD_ENTER();
+
+    ASYNC_METHOD_OVER(3, 2);
+
+    ARG(obj_ptr<Buffer_base>, 0);
+    ARG(obj_ptr<Stream_base>, 1);
+    OPT_ARG(int32_t, 2, -1);
+
+    if (!cb.IsEmpty())
+        hr = acb_zstdDecompressTo(v0, v1, v2, cb, args);
+    else
+        hr = ac_zstdDecompressTo(v0, v1, v2);
+
+    ASYNC_METHOD_OVER(3, 2);
+
+    ARG(obj_ptr<Stream_base>, 0);
+    ARG(obj_ptr<Stream_base>, 1);
+    OPT_ARG(int32_t, 2, -1);
+
+    if (!cb.IsEmpty())
+        hr = acb_zstdDecompressTo(v0, v1, v2, cb, args);
+    else
+        hr = ac_zstdDecompressTo(v0, v1, v2);
+
+    METHOD_VOID();
+}
 }
@@ -26,6 +26,13 @@ extern bool g_ssldump;
 extern exlib::string g_exec_code;
 
 extern bool g_uv_socket;
+extern int32_t g_uv_loops;
+
+extern bool g_io_uring;
+
+extern int32_t g_pool_threads_min;
+extern int32_t g_pool_threads_max;
+extern bool g_pool_affinity;
 
 extern bool g_track_native_object;
 
@@ -20,6 +20,7 @@ void InitializeDateUtils();
 void InitializeAcPool();
 void InitializeAsyncIOThread();
 void initializeUVAsyncThread();
+void initializeAsyncUring();
 void init_signal();
 void init_sym();
 void init_binding();
@@ -51,6 +52,7 @@ static void createBasisForFiberLoop(Isolate::platform_creator get_platform)
     InitializeAcPool();
     InitializeAsyncIOThread();
     initializeUVAsyncThread();
+    initializeAsyncUring();
     init_tls();
 
 #ifdef Linux
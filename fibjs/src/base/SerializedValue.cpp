@@ -0,0 +1,305 @@
+/*
+ * SerializedValue.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "SerializedValue.h"
+#include "Buffer.h"
+
+namespace fibjs {
+
+enum {
+    HOST_OBJECT = 0,
+    HOST_VIEW
+};
+
+enum {
+    VIEW_Int8Array = 0,
+    VIEW_Uint8Array,
+    VIEW_Uint8ClampedArray,
+    VIEW_Int16Array,
+    VIEW_Uint16Array,
+    VIEW_Int32Array,
+    VIEW_Uint32Array,
+    VIEW_Float32Array,
+    VIEW_Float64Array,
+    VIEW_BigInt64Array,
+    VIEW_BigUint64Array,
+    VIEW_DataView
+};
+
+static int32_t view_type(v8::Local<v8::ArrayBufferView> view)
+{
+    if (view->IsInt8Array())
+        return VIEW_Int8Array;
+    if (view->IsUint8Array())
+        return VIEW_Uint8Array;
+    if (view->IsUint8ClampedArray())
+        return VIEW_Uint8ClampedArray;
+    if (view->IsInt16Array())
+        return VIEW_Int16Array;
+    if (view->IsUint16Array())
+        return VIEW_Uint16Array;
+    if (view->IsInt32Array())
+        return VIEW_Int32Array;
+    if (view->IsUint32Array())
+        return VIEW_Uint32Array;
+    if (view->IsFloat32Array())
+        return VIEW_Float32Array;
+    if (view->IsFloat64Array())
+        return VIEW_Float64Array;
+    if (view->IsBigInt64Array())
+        return VIEW_BigInt64Array;
+    if (view->IsBigUint64Array())
+        return VIEW_BigUint64Array;
+    if (view->IsDataView())
+        return VIEW_DataView;
+
+    return -1;
+}
+
+static v8::Local<v8::Object> new_view(int32_t type, v8::Local<v8::ArrayBuffer> ab, size_t length)
+{
+    switch (type) {
+    case VIEW_Int8Array:
+        return v8::Int8Array::New(ab, 0, length);
+    case VIEW_Uint8Array:
+        return v8::Uint8Array::New(ab, 0, length);
+    case VIEW_Uint8ClampedArray:
+        return v8::Uint8ClampedArray::New(ab, 0, length);
+    case VIEW_Int16Array:
+        return v8::Int16Array::New(ab, 0, length / 2);
+    case VIEW_Uint16Array:
+        return v8::Uint16Array::New(ab, 0, length / 2);
+    case VIEW_Int32Array:
+        return v8::Int32Array::New(ab, 0, length / 4);
+    case VIEW_Uint32Array:
+        return v8::Uint32Array::New(ab, 0, length / 4);
+    case VIEW_Float32Array:
+        return v8::Float32Array::New(ab, 0, length / 4);
+    case VIEW_Float64Array:
+        return v8::Float64Array::New(ab, 0, length / 8);
+    case VIEW_BigInt64Array:
+        return v8::BigInt64Array::New(ab, 0, length / 8);
+    case VIEW_BigUint64Array:
+        return v8::BigUint64Array::New(ab, 0, length / 8);
+    case VIEW_DataView:
+        return v8::DataView::New(ab, 0, length);
+    }
+
+    return v8::Local<v8::Object>();
+}
+
+class CloneSerializer : public v8::ValueSerializer::Delegate {
+public:
+    CloneSerializer(Isolate* isolate, SerializedValue* sv)
+        : m_isolate(isolate)
+        , m_sv(sv)
+        , m_serializer(isolate->m_isolate, this)
+    {
+        m_serializer.SetTreatArrayBufferViewsAsHostObjects(true);
+    }
+
+public:
+    virtual void ThrowDataCloneError(v8::Local<v8::String> message)
+    {
+        m_isolate->m_isolate->ThrowException(v8::Exception::Error(message));
+    }
+
+    virtual bool HasCustomHostObject(v8::Isolate* isolate)
+    {
+        return true;
+    }
+
+    virtual v8::Maybe<bool> IsHostObject(v8::Isolate* isolate, v8::Local<v8::Object> object)
+    {
+        return v8::Just(object_base::getInstance(object) != NULL);
+    }
+
+    virtual v8::Maybe<bool> WriteHostObject(v8::Isolate* isolate, v8::Local<v8::Object> object)
+    {
+        obj_ptr<object_base> obj;
+
+        if (IsJSBuffer(object))
+            obj = new Buffer(object.As<v8::Uint8Array>());
+        else if (object->IsArrayBufferView()) {
+            // plain typed arrays and DataView are copied, Buffer shares its store
+            v8::Local<v8::ArrayBufferView> view = object.As<v8::ArrayBufferView>();
+            size_t length = view->ByteLength();
+            std::vector<uint8_t> data(length);
+
+            view->CopyContents(data.data(), length);
+
+            m_serializer.WriteUint32(HOST_VIEW);
+            m_serializer.WriteUint32(view_type(view));
+            m_serializer.WriteUint64(length);
+            m_serializer.WriteRawBytes(data.data(), length);
+
+            return v8::Just(true);
+        } else {
+            object_base* o = object_base::getInstance(object);
+            result_t hr = o ? o->unbind(obj) : CALL_E_INVALID_CALL;
+
+            if (hr < 0) {
+                ThrowDataCloneError(m_isolate->NewString(getResultMessage(hr)));
+                return v8::Nothing<bool>();
+            }
+        }
+
+        m_serializer.WriteUint32(HOST_OBJECT);
+        m_serializer.WriteUint32((uint32_t)m_sv->m_objects.size());
+        m_sv->m_objects.push_back(obj);
+
+        return v8::Just(true);
+    }
+
+    virtual v8::Maybe<uint32_t> GetSharedArrayBufferId(v8::Isolate* isolate, v8::Local<v8::SharedArrayBuffer> sab)
+    {
+        m_sv->m_shared.push_back(sab->GetBackingStore());
+        return v8::Just((uint32_t)(m_sv->m_shared.size() - 1));
+    }
+
+public:
+    Isolate* m_isolate;
+    SerializedValue* m_sv;
+    v8::ValueSerializer m_serializer;
+};
+
+class CloneDeserializer : public v8::ValueDeserializer::Delegate {
+public:
+    CloneDeserializer(Isolate* isolate, SerializedValue* sv)
+        : m_sv(sv)
+        , m_deserializer(isolate->m_isolate, sv->m_data, sv->m_size, this)
+    {
+    }
+
+public:
+    virtual v8::MaybeLocal<v8::Object> ReadHostObject(v8::Isolate* isolate)
+    {
+        uint32_t kind, id;
+
+        if (!m_deserializer.ReadUint32(&kind))
+            return v8::MaybeLocal<v8::Object>();
+
+        if (kind == HOST_VIEW) {
+            uint64_t length;
+            const void* data;
+
+            if (!m_deserializer.ReadUint32(&id) || !m_deserializer.ReadUint64(&length)
+                || !m_deserializer.ReadRawBytes(length, &data))
+                return v8::MaybeLocal<v8::Object>();
+
+            v8::Local<v8::ArrayBuffer> ab = v8::ArrayBuffer::New(isolate, length);
+            memcpy(ab->GetBackingStore()->Data(), data, length);
+
+            return new_view(id, ab, length);
+        }
+
+        if (!m_deserializer.ReadUint32(&id) || id >= m_sv->m_objects.size())
+            return v8::MaybeLocal<v8::Object>();
+
+        v8::Local<v8::Value> v;
+        m_sv->m_objects[id]->valueOf(v);
+
+        return v.As<v8::Object>();
+    }
+
+    virtual v8::MaybeLocal<v8::SharedArrayBuffer> GetSharedArrayBufferFromId(v8::Isolate* isolate, uint32_t id)
+    {
+        if (id >= m_sv->m_shared.size())
+            return v8::MaybeLocal<v8::SharedArrayBuffer>();
+
+        return v8::SharedArrayBuffer::New(isolate, m_sv->m_shared[id]);
+    }
+
+public:
+    SerializedValue* m_sv;
+    v8::ValueDeserializer m_deserializer;
+};
+
+result_t SerializedValue::serialize(v8::Local<v8::Value> v, v8::Local<v8::Array> transfer, obj_ptr<object_base>& retVal)
+{
+    Isolate* isolate = Isolate::current();
+    v8::Local<v8::Context> context = isolate->context();
+    obj_ptr<SerializedValue> sv = new SerializedValue();
+    CloneSerializer s(isolate, sv);
+    std::vector<v8::Local<v8::ArrayBuffer>> abs;
+
+    if (!transfer.IsEmpty()) {
+        int32_t len = transfer->Length();
+
+        for (int32_t i = 0; i < len; i++) {
+            JSValue tv = transfer->Get(context, i);
+
+            if (!tv->IsArrayBuffer())
+                return CHECK_ERROR(Runtime::setError("postMessage: only ArrayBuffer can be transferred."));
+
+            v8::Local<v8::ArrayBuffer> ab = tv.As<v8::ArrayBuffer>();
+            if (!ab->IsDetachable())
+                return CHECK_ERROR(Runtime::setError("postMessage: ArrayBuffer can not be transferred."));
+
+            s.m_serializer.TransferArrayBuffer(i, ab);
+            abs.push_back(ab);
+        }
+    }
+
+    s.m_serializer.WriteHeader();
+    if (s.m_serializer.WriteValue(context, v).IsNothing())
+        return CALL_E_JAVASCRIPT;
+
+    for (auto& ab : abs) {
+        sv->m_transfer.push_back(ab->GetBackingStore());
+        ab->Detach(v8::Local<v8::Value>()).Check();
+    }
+
+    std::pair<uint8_t*, size_t> data = s.m_serializer.Release();
+    sv->m_data = data.first;
+    sv->m_size = data.second;
+
+    retVal = sv;
+    return 0;
+}
+
+result_t SerializedValue::valueOf(v8::Local<v8::Value>& retVal)
+{
+    Isolate* isolate = Isolate::current();
+
+    // the value belongs to the first isolate that reads it
+    if (holder(isolate) != isolate)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    if (!m_value.IsEmpty()) {
+        retVal = m_value.Get(isolate->m_isolate);
+        return 0;
+    }
+
+    v8::Local<v8::Context> context = isolate->context();
+    CloneDeserializer d(isolate, this);
+
+    for (size_t i = 0; i < m_transfer.size(); i++)
+        d.m_deserializer.TransferArrayBuffer(i, v8::ArrayBuffer::New(isolate->m_isolate, m_transfer[i]));
+
+    if (d.m_deserializer.ReadHeader(context).IsNothing())
+        return CALL_E_JAVASCRIPT;
+
+    if (!d.m_deserializer.ReadValue(context).ToLocal(&retVal))
+        return CALL_E_JAVASCRIPT;
+
+    // transferred stores now belong to retVal, later reads get the same value instead of another alias
+    m_value.Reset(isolate->m_isolate, retVal);
+
+    free(m_data);
+    m_data = NULL;
+    m_size = 0;
+
+    m_objects.clear();
+    m_shared.clear();
+    m_transfer.clear();
+
+    return 0;
+}
+
+} /* namespace fibjs */
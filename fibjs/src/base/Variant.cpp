@@ -9,18 +9,13 @@
 #include "object.h"
 #include "ifs/json.h"
 #include "Buffer.h"
+#include "SerializedValue.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <inttypes.h>
 
 namespace fibjs {
 
-class UNBIND_DATA {
-public:
-    exlib::string k;
-    Variant v;
-};
-
 Variant& Variant::operator=(v8::Local<v8::Value> v)
 {
     clear();
@@ -74,7 +69,6 @@ Variant& Variant::operator=(v8::Local<v8::Value> v)
 Variant::operator v8::Local<v8::Value>() const
 {
     Isolate* isolate = Isolate::current();
-    v8::Local<v8::Context> context = isolate->context();
 
     switch (type()) {
     case VT_Undefined:
@@ -112,34 +106,6 @@ Variant::operator v8::Local<v8::Value>() const
         exlib::string& str = strVal();
         return isolate->NewString(str);
     }
-    case VT_UNBOUND_ARRAY: {
-        v8::Local<v8::Array> a;
-        int32_t len, i;
-        UNBIND_DATA* data;
-
-        len = m_Val.buffer.cnt;
-        data = (UNBIND_DATA*)m_Val.buffer.data;
-        a = v8::Array::New(isolate->m_isolate, len);
-
-        for (i = 0; i < len; i++)
-            a->Set(context, i, data[i].v.operator v8::Local<v8::Value>()).IsJust();
-
-        return a;
-    }
-    case VT_UNBOUND_OBJECT: {
-        v8::Local<v8::Object> o;
-        int32_t len, i;
-        UNBIND_DATA* data;
-
-        len = m_Val.buffer.cnt;
-        data = (UNBIND_DATA*)m_Val.buffer.data;
-        o = v8::Object::New(isolate->m_isolate);
-
-        for (i = 0; i < len; i++)
-            o->Set(context, isolate->NewString(data[i].k), data[i].v.operator v8::Local<v8::Value>()).IsJust();
-
-        return o;
-    }
     }
 
     return v8::Null(isolate->m_isolate);
@@ -309,8 +275,6 @@ void Variant::toString(exlib::string& retVal) const
         retVal = strVal();
         break;
     case VT_JSValue:
-    case VT_UNBOUND_ARRAY:
-    case VT_UNBOUND_OBJECT:
         retVal = "[Object]";
         break;
     case VT_JSON:
@@ -330,7 +294,7 @@ void Variant::toJSON()
     }
 }
 
-result_t Variant::unbind()
+result_t Variant::unbind(v8::Local<v8::Array> transfer)
 {
     result_t hr;
 
@@ -353,53 +317,13 @@ result_t Variant::unbind()
         break;
     }
     case VT_JSValue: {
-        v8::Local<v8::Value> v = operator v8::Local<v8::Value>();
-        v8::Local<v8::Object> o;
-        v8::Local<v8::Array> a;
-        int32_t len, i;
-        UNBIND_DATA* data;
-        Isolate* isolate = Isolate::current();
-
-        if (GetArgumentValue(isolate, v, a, true) >= 0) {
-            clear();
-            set_type(VT_UNBOUND_ARRAY);
-
-            v8::Local<v8::Context> context = a->GetCreationContextChecked();
-            len = a->Length();
-
-            m_Val.buffer.cnt = len;
-            if (len > 0) {
-                m_Val.buffer.data = data = new UNBIND_DATA[len];
-
-                for (i = 0; i < len; i++)
-                    data[i].v = JSValue(a->Get(context, i));
-            }
-        } else if (GetArgumentValue(isolate, v, o, true) >= 0) {
-            clear();
-            set_type(VT_UNBOUND_OBJECT);
-
-            v8::Local<v8::Context> context = o->GetCreationContextChecked();
-            JSArray ks = o->GetPropertyNames(context);
-            len = ks->Length();
-
-            m_Val.buffer.cnt = len;
-            if (len > 0) {
-                m_Val.buffer.data = data = new UNBIND_DATA[len];
-                for (i = 0; i < len; i++) {
-                    JSValue k = ks->Get(context, i);
-                    GetArgumentValue(isolate, k, data[i].k);
-                    data[i].v = JSValue(o->Get(context, k));
-                }
-            }
-        } else
-            return CHECK_ERROR(CALL_E_TYPEMISMATCH);
-
-        for (i = 0; i < len; i++) {
-            hr = data[i].v.unbind();
-            if (hr < 0)
-                return hr;
-        }
+        obj_ptr<object_base> obj;
+
+        hr = SerializedValue::serialize(jsVal(), transfer, obj);
+        if (hr < 0)
+            return hr;
 
+        operator=(obj);
         break;
     }
     default:
@@ -408,10 +332,4 @@ result_t Variant::unbind()
 
     return 0;
 }
-
-void Variant::clearUnbind()
-{
-    if (m_Val.buffer.cnt > 0)
-        delete[] (UNBIND_DATA*)m_Val.buffer.data;
-}
 }
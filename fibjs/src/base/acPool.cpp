@@ -10,19 +10,68 @@
 #include "ifs/console.h"
 #include <exlib/include/thread.h>
 #include "console.h"
-#include <unordered_map>
+#include "options.h"
 #include "Fiber.h"
+#include <uv/include/uv.h>
+#include <deque>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+#ifdef Linux
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 namespace fibjs {
 
 #define WORKER_STACK_SIZE 128
+#define WORKER_IDLE_TIMEOUT 30
+
+// queue latency, bucket i counts the events that waited less than 2^i us, the last one all the others
+class acHistogram {
+public:
+    static const int32_t BUCKETS = 21;
+
+public:
+    acHistogram()
+    {
+        for (int32_t i = 0; i < BUCKETS; i++)
+            m_counts[i] = 0;
+    }
+
+public:
+    void add(AsyncEvent* ac)
+    {
+        uint64_t us = (uv_hrtime() - ac->m_queued) / 1000;
+        int32_t i = 0;
+
+        while (i < BUCKETS - 1 && us >= (1ull << i))
+            i++;
+
+        m_counts[i]++;
+    }
+
+    void fill(Isolate* isolate, v8::Local<v8::Array> counts)
+    {
+        v8::Local<v8::Context> context = isolate->context();
+
+        for (int32_t i = 0; i < BUCKETS; i++)
+            counts->Set(context, i, v8::Number::New(isolate->m_isolate, (double)m_counts[i].load())).IsJust();
+    }
+
+public:
+    std::atomic<int64_t> m_counts[BUCKETS];
+};
 
+// short calls run on worker fibers, the pool is split in shards to spread the queue lock
 class acPool {
 public:
-    acPool(int32_t max_idle, bool bThread = false)
-        : m_bThread(bThread)
-        , m_max_idle(max_idle)
+    acPool(int32_t max_idle, acHistogram& latency)
+        : m_workers(0)
         , m_idleWorkers(1)
+        , m_max_idle(max_idle)
+        , m_latency(latency)
     {
         new_worker();
     }
@@ -36,38 +85,7 @@ public:
 private:
     void new_worker()
     {
-        class _thread : public exlib::OSThread {
-        public:
-            typedef void (*thread_func)(void*);
-
-        public:
-            _thread(thread_func proc, void* arg)
-                : m_proc(proc)
-                , m_arg(arg)
-            {
-            }
-
-        public:
-            virtual void Run()
-            {
-#ifdef _WIN32
-                CoInitializeEx(NULL, COINIT_MULTITHREADED);
-                m_proc(m_arg);
-                CoUninitialize();
-#else
-                m_proc(m_arg);
-#endif
-            }
-
-        private:
-            thread_func m_proc;
-            void* m_arg;
-        };
-
-        if (m_bThread)
-            (new _thread(FiberProcWorker, this))->start();
-        else
-            exlib::Service::CreateFiber(FiberProcWorker, this, WORKER_STACK_SIZE * 1024, "WorkerFiber");
+        exlib::Service::CreateFiber(FiberProcWorker, this, WORKER_STACK_SIZE * 1024, "WorkerFiber");
     }
 
     void FiberProcWorker()
@@ -76,6 +94,7 @@ private:
         AsyncEvent* p;
 
         m_idleWorkers.dec();
+        m_workers.inc();
 
         while (true) {
             if (m_idleWorkers.inc() > m_max_idle) {
@@ -90,8 +109,11 @@ private:
                 if (m_idleWorkers.CompareAndSwap(0, 1) == 0)
                     new_worker();
 
+            m_latency.add(p);
             p->invoke();
         }
+
+        m_workers.dec();
     }
 
     static void FiberProcWorker(void* ptr)
@@ -99,22 +121,335 @@ private:
         ((acPool*)ptr)->FiberProcWorker();
     }
 
+public:
+    exlib::atomic m_workers;
+    exlib::atomic m_idleWorkers;
+
 private:
-    bool m_bThread;
     int32_t m_max_idle;
     exlib::Queue<AsyncEvent> m_pool;
-    exlib::atomic m_idleWorkers;
+    acHistogram& m_latency;
 };
 
-static acPool* s_acPool;
-static acPool* s_lsPool;
+// long synchronous calls block a whole thread. every worker thread owns a deque,
+// events queued by a worker go to its own deque, the others are spread over the workers,
+// and a worker that runs out of work steals from the others before it sleeps.
+class thPool {
+public:
+    // slots live in blocks that are never moved, so a new worker never invalidates a slot in use
+    static const int32_t SLOT_BLOCK = 64;
+    static const int32_t SLOT_BLOCKS = 1024;
+
+    class _slot {
+    public:
+        _slot()
+            : m_active(false)
+        {
+        }
+
+    public:
+        exlib::spinlock m_lock;
+        std::deque<AsyncEvent*> m_queue;
+        bool m_active;
+    };
+
+    class _thread : public exlib::OSThread {
+    public:
+        _thread(thPool* pool, int32_t id)
+            : m_pool(pool)
+            , m_id(id)
+        {
+        }
+
+    public:
+        virtual void Run()
+        {
+#ifdef _WIN32
+            CoInitializeEx(NULL, COINIT_MULTITHREADED);
+            m_pool->work(m_id);
+            CoUninitialize();
+#else
+            m_pool->work(m_id);
+#endif
+        }
+
+    private:
+        thPool* m_pool;
+        int32_t m_id;
+    };
+
+public:
+    thPool(int32_t min_threads, int32_t max_threads, bool affinity)
+        : m_min(min_threads)
+        , m_max(max_threads > 0 ? max_threads : SLOT_BLOCK * SLOT_BLOCKS)
+        , m_affinity(affinity)
+        , m_high(0)
+        , m_active(0)
+        , m_ready(0)
+        , m_idle(0)
+        , m_queued(0)
+        , m_steals(0)
+        , m_next(0)
+    {
+        for (int32_t i = 0; i < SLOT_BLOCKS; i++)
+            m_blocks[i] = NULL;
+
+        for (int32_t i = 0; i < m_min; i++) {
+            m_ready++;
+            if (!new_worker())
+                m_ready--;
+        }
+    }
+
+public:
+    void put(AsyncEvent* ac)
+    {
+        bool bQueued = false;
+
+        m_queued++;
+
+        // retiring keeps m_min workers active, so the scan only repeats when it races with one
+        while (!bQueued) {
+            int32_t high = m_high;
+            int32_t id = s_id;
+
+            // a worker keeps what it queues, the event is likely to need the same data
+            if (s_pool != this)
+                id = (int32_t)(m_next++ % (uint32_t)high);
+
+            for (int32_t i = 0; i < high && !bQueued; i++) {
+                _slot& slot = get_slot((id + i) % high);
+
+                slot.m_lock.lock();
+                if (slot.m_active) {
+                    slot.m_queue.push_back(ac);
+                    bQueued = true;
+                }
+                slot.m_lock.unlock();
+            }
+        }
+
+        if (m_idle > 0) {
+            {
+                std::lock_guard<std::mutex> l(m_mutex);
+            }
+            m_cv.notify_one();
+        }
+    }
+
+    void stats(Isolate* isolate, v8::Local<v8::Object> info)
+    {
+        v8::Local<v8::Context> context = isolate->context();
+        v8::Local<v8::Array> latency = v8::Array::New(isolate->m_isolate);
+
+        info->Set(context, isolate->NewString("threads"), v8::Number::New(isolate->m_isolate, m_active)).IsJust();
+        info->Set(context, isolate->NewString("idle"), v8::Number::New(isolate->m_isolate, m_idle)).IsJust();
+        info->Set(context, isolate->NewString("queued"), v8::Number::New(isolate->m_isolate, (double)m_queued)).IsJust();
+        info->Set(context, isolate->NewString("steals"), v8::Number::New(isolate->m_isolate, (double)m_steals)).IsJust();
+
+        m_latency.fill(isolate, latency);
+        info->Set(context, isolate->NewString("latency"), latency).IsJust();
+    }
+
+private:
+    _slot& get_slot(int32_t id)
+    {
+        return m_blocks[id / SLOT_BLOCK][id % SLOT_BLOCK];
+    }
+
+    bool new_worker()
+    {
+        int32_t id = -1;
+
+        m_lock.lock();
+        if (m_active < m_max) {
+            for (id = 0; id < m_high && get_slot(id).m_active; id++)
+                ;
+
+            if (m_blocks[id / SLOT_BLOCK] == NULL)
+                m_blocks[id / SLOT_BLOCK] = new _slot[SLOT_BLOCK];
+
+            _slot& slot = get_slot(id);
+
+            slot.m_lock.lock();
+            slot.m_active = true;
+            slot.m_lock.unlock();
+
+            m_active++;
+            if (m_high <= id)
+                m_high = id + 1;
+        }
+        m_lock.unlock();
+
+        if (id < 0)
+            return false;
+
+        (new _thread(this, id))->start();
+        return true;
+    }
+
+    AsyncEvent* get(int32_t id)
+    {
+        AsyncEvent* p = NULL;
+        int32_t high = m_high;
+        _slot& me = get_slot(id);
+
+        me.m_lock.lock();
+        if (!me.m_queue.empty()) {
+            p = me.m_queue.front();
+            me.m_queue.pop_front();
+        }
+        me.m_lock.unlock();
+
+        // steal from the tail, the owner works on the head
+        for (int32_t i = 1; !p && i < high; i++) {
+            _slot& slot = get_slot((id + i) % high);
+
+            slot.m_lock.lock();
+            if (!slot.m_queue.empty()) {
+                p = slot.m_queue.back();
+                slot.m_queue.pop_back();
+                m_steals++;
+            }
+            slot.m_lock.unlock();
+        }
+
+        if (p)
+            m_queued--;
+
+        return p;
+    }
+
+    // called with m_mutex held, a worker only retires with an empty deque so nothing is left behind
+    bool retire(int32_t id)
+    {
+        bool bRetire = false;
+
+        m_lock.lock();
+        if (m_active > m_min) {
+            _slot& me = get_slot(id);
+
+            me.m_lock.lock();
+            if (me.m_queue.empty()) {
+                me.m_active = false;
+                bRetire = true;
+            }
+            me.m_lock.unlock();
+
+            if (bRetire)
+                m_active--;
+        }
+        m_lock.unlock();
+
+        return bRetire;
+    }
+
+    void set_affinity(int32_t id)
+    {
+        int32_t cpus = 0;
+
+        os_base::cpuNumbers(cpus);
+        if (cpus < 1)
+            return;
+
+#ifdef _WIN32
+        SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << (id % cpus));
+#elif defined(Linux)
+        cpu_set_t set;
+
+        CPU_ZERO(&set);
+        CPU_SET(id % cpus, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+    }
+
+    void work(int32_t id)
+    {
+        Runtime rtForThread(NULL);
+        AsyncEvent* p;
+
+        s_pool = this;
+        s_id = id;
+
+        if (m_affinity)
+            set_affinity(id);
+
+        while (true) {
+            p = get(id);
+            if (p) {
+                // a blocking call may wait for the events behind it, so a spare worker is
+                // started whenever the last ready one picks up work
+                if (--m_ready == 0) {
+                    int32_t zero = 0;
+
+                    if (m_ready.compare_exchange_strong(zero, 1) && !new_worker())
+                        m_ready--;
+                }
+
+                m_latency.add(p);
+                p->invoke();
+
+                m_ready++;
+                continue;
+            }
+
+            std::unique_lock<std::mutex> l(m_mutex);
+            bool bTimeout = false;
+
+            m_idle++;
+            while (m_queued == 0 && !bTimeout)
+                bTimeout = m_cv.wait_for(l, std::chrono::seconds(WORKER_IDLE_TIMEOUT)) == std::cv_status::timeout;
+            m_idle--;
+
+            if (bTimeout && m_queued == 0 && retire(id)) {
+                m_ready--;
+                break;
+            }
+        }
+
+        s_pool = NULL;
+    }
+
+private:
+    int32_t m_min;
+    int32_t m_max;
+    bool m_affinity;
+
+    _slot* m_blocks[SLOT_BLOCKS];
+    exlib::spinlock m_lock;
+    std::atomic<int32_t> m_high;
+    std::atomic<int32_t> m_active;
+    std::atomic<int32_t> m_ready;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::atomic<int32_t> m_idle;
+    std::atomic<int64_t> m_queued;
+    std::atomic<int64_t> m_steals;
+    std::atomic<uint32_t> m_next;
+
+    acHistogram m_latency;
+
+    static thread_local thPool* s_pool;
+    static thread_local int32_t s_id;
+};
+
+thread_local thPool* thPool::s_pool = NULL;
+thread_local int32_t thPool::s_id = 0;
+
+static std::vector<acPool*> s_acPools;
+static std::atomic<uint32_t> s_acNext(0);
+static acHistogram s_acLatency;
+static thPool* s_lsPool;
 
 void putGuiPool(AsyncEvent* ac);
 
 void AsyncEvent::async(int32_t type)
 {
+    m_queued = uv_hrtime();
+
     if (type == CALL_E_NOSYNC)
-        s_acPool->put(this);
+        s_acPools[s_acNext++ % s_acPools.size()]->put(this);
     else if (type == CALL_E_LONGSYNC)
         s_lsPool->put(this);
     else if (type == CALL_E_GUICALL)
@@ -210,9 +545,49 @@ int32_t AsyncCallBack::check_result(int32_t hr, const v8::FunctionCallbackInfo<v
     return CALL_RETURN_UNDEFINED;
 }
 
+result_t pool_stats(v8::Local<v8::Object>& retVal)
+{
+    Isolate* isolate = Isolate::current();
+    v8::Local<v8::Context> context = isolate->context();
+    v8::Local<v8::Object> info = v8::Object::New(isolate->m_isolate);
+    v8::Local<v8::Object> async = v8::Object::New(isolate->m_isolate);
+    v8::Local<v8::Object> blocking = v8::Object::New(isolate->m_isolate);
+    v8::Local<v8::Array> latency = v8::Array::New(isolate->m_isolate);
+    intptr_t workers = 0, idle = 0;
+
+    for (size_t i = 0; i < s_acPools.size(); i++) {
+        workers += s_acPools[i]->m_workers;
+        idle += s_acPools[i]->m_idleWorkers;
+    }
+
+    async->Set(context, isolate->NewString("pools"), v8::Number::New(isolate->m_isolate, (double)s_acPools.size())).IsJust();
+    async->Set(context, isolate->NewString("workers"), v8::Number::New(isolate->m_isolate, (double)workers)).IsJust();
+    async->Set(context, isolate->NewString("idle"), v8::Number::New(isolate->m_isolate, (double)idle)).IsJust();
+
+    s_acLatency.fill(isolate, latency);
+    async->Set(context, isolate->NewString("latency"), latency).IsJust();
+
+    s_lsPool->stats(isolate, blocking);
+
+    info->Set(context, isolate->NewString("async"), async).IsJust();
+    info->Set(context, isolate->NewString("blocking"), blocking).IsJust();
+
+    retVal = info;
+
+    return 0;
+}
+
 void InitializeAcPool()
 {
-    s_lsPool = new acPool(2, true);
-    s_acPool = new acPool(2);
+    int32_t cpus = 0;
+
+    os_base::cpuNumbers(cpus);
+    if (cpus < 1)
+        cpus = 1;
+
+    s_lsPool = new thPool(g_pool_threads_min, g_pool_threads_max, g_pool_affinity);
+
+    for (int32_t i = 0; i < cpus; i++)
+        s_acPools.push_back(new acPool(2, s_acLatency));
 }
 }
@@ -12,6 +12,7 @@
 #include "path.h"
 #include "Fiber.h"
 #include "options.h"
+#include "AsyncUV.h"
 #include "unicode/locid.h"
 #include "unicode/timezone.h"
 
@@ -33,6 +34,13 @@ bool g_ssldump = false;
 bool g_no_deprecation = false;
 
 bool g_uv_socket = false;
+int32_t g_uv_loops = 1;
+
+bool g_io_uring = false;
+
+int32_t g_pool_threads_min = 2;
+int32_t g_pool_threads_max = 0;
+bool g_pool_affinity = false;
 
 bool g_track_native_object = false;
 
@@ -63,6 +71,12 @@ static void printHelp()
          "\n"
          "  --use-uv-socket[=on|off]\n"
          "                              use uv as socket backend.\n"
+         "  --uv-loops=n                run uv sockets on n event loops (default: 1).\n"
+         "\n"
+         "  --io-uring[=on|off]         use io_uring for file io where the kernel supports it.\n"
+         "\n"
+         "  --pool-threads=min[,max]    threads for blocking calls (default: 2, no max).\n"
+         "  --pool-affinity             pin the blocking call threads to cpu cores.\n"
          "\n"
          "  --init                      write a package.json file.\n"
          "  --install [opt] foo         install the dependencies in the local node_modules folder.\n"
@@ -131,6 +145,32 @@ void options(int32_t& pos, char* argv[])
         } else if (!qstrcmp(arg, "--use-uv-socket", 15)) {
             g_uv_socket = (arg[15] == 0 || !qstrcmp(arg + 15, "=on"));
             df++;
+        } else if (!qstrcmp(arg, "--uv-loops=", 11)) {
+            g_uv_loops = atoi(arg + 11);
+            if (g_uv_loops < 1)
+                g_uv_loops = 1;
+            else if (g_uv_loops > MAX_UV_LOOPS)
+                g_uv_loops = MAX_UV_LOOPS;
+            df++;
+        } else if (!qstrcmp(arg, "--io-uring", 10)) {
+            g_io_uring = (arg[10] == 0 || !qstrcmp(arg + 10, "=on"));
+            df++;
+        } else if (!qstrcmp(arg, "--pool-threads=", 15)) {
+            const char* p = qstrchr(arg + 15, ',');
+
+            g_pool_threads_min = atoi(arg + 15);
+            if (g_pool_threads_min < 1)
+                g_pool_threads_min = 1;
+
+            if (p) {
+                g_pool_threads_max = atoi(p + 1);
+                if (g_pool_threads_max < g_pool_threads_min)
+                    g_pool_threads_max = g_pool_threads_min;
+            }
+            df++;
+        } else if (!qstrcmp(arg, "--pool-affinity")) {
+            g_pool_affinity = true;
+            df++;
         } else if (!qstrcmp(arg, "--prof")) {
             g_prof = true;
             df++;
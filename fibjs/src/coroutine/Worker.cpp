@@ -128,10 +128,10 @@ Worker::Worker(exlib::string path, v8::Local<v8::Object> opts)
     m_isolate->m_worker = m_worker;
 }
 
-result_t Worker::postMessage(v8::Local<v8::Value> data)
+result_t Worker::postMessage(v8::Local<v8::Value> data, v8::Local<v8::Array> transfer)
 {
     obj_ptr<WorkerMessage> wm = new WorkerMessage(data);
-    result_t hr = wm->unbind();
+    result_t hr = wm->unbind(transfer);
     if (hr < 0)
         return hr;
 
@@ -18,6 +18,8 @@ DECLARE_MODULE(coroutine);
 
 extern int32_t g_spareFibers;
 
+result_t pool_stats(v8::Local<v8::Object>& retVal);
+
 result_t coroutine_base::start(v8::Local<v8::Function> func, OptArgs args,
     obj_ptr<Fiber_base>& retVal)
 {
@@ -235,6 +237,11 @@ result_t coroutine_base::sleep(int32_t ms, AsyncEvent* ac)
     return CALL_E_PENDDING;
 }
 
+result_t coroutine_base::stats(v8::Local<v8::Object>& retVal)
+{
+    return pool_stats(retVal);
+}
+
 result_t coroutine_base::get_fibers(v8::Local<v8::Array>& retVal)
 {
     Isolate* isolate = Isolate::current();
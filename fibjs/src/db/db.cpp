@@ -35,7 +35,9 @@ result_t db_base::open(exlib::string connString, obj_ptr<object_base>& retVal, A
     if (!qstrcmp(connString.c_str(), "psql:", 5))
         return openPSQL(connString, (obj_ptr<DbConnection_base>&)retVal, ac);
 
-    if (!qstrcmp(connString.c_str(), "redis:", 6))
+    if (!qstrcmp(connString.c_str(), "redis:", 6)
+        || !qstrcmp(connString.c_str(), "redis-cluster:", 14)
+        || !qstrcmp(connString.c_str(), "redis-sentinel:", 15))
         return openRedis(connString, (obj_ptr<Redis_base>&)retVal, ac);
 
     if (!qstrcmp(connString.c_str(), "leveldb:", 8))
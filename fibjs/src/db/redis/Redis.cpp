@@ -14,9 +14,161 @@
 #include "RedisList.h"
 #include "RedisSet.h"
 #include "RedisSortedSet.h"
+#include "RedisPipeline.h"
+#include "RedisCluster.h"
 
 namespace fibjs {
 
+result_t Redis::parse_addrs(exlib::string connString, int32_t defPort,
+    std::vector<_addr>& addrs, _auth& auth, exlib::string& path, exlib::string& query)
+{
+    const char* s = qstrchr(connString.c_str(), ':');
+    if (!s || qstrcmp(s, "://", 3))
+        return CHECK_ERROR(CALL_E_INVALIDARG);
+    s += 3;
+
+    const char* e = s;
+    while (*e && *e != '/' && *e != '?')
+        e++;
+
+    const char* at = s;
+    while (at < e && *at != '@')
+        at++;
+    if (at < e) {
+        const char* c = s;
+        while (c < at && *c != ':')
+            c++;
+
+        encoding_base::decodeURI(exlib::string(s, c - s), auth.m_user);
+        if (c < at)
+            encoding_base::decodeURI(exlib::string(c + 1, at - c - 1), auth.m_password);
+
+        s = at + 1;
+    }
+
+    while (s < e) {
+        const char* p = s;
+        while (p < e && *p != ',')
+            p++;
+
+        const char* h = s;
+        const char* c;
+
+        if (*h == '[') {
+            c = h + 1;
+            while (c < p && *c != ']')
+                c++;
+            if (c == p)
+                return CHECK_ERROR(CALL_E_INVALIDARG);
+            h++;
+        } else {
+            c = h;
+            while (c < p && *c != ':')
+                c++;
+        }
+
+        _addr a;
+
+        a.m_host.assign(h, c - h);
+        if (*c == ']')
+            c++;
+
+        a.m_port = (c < p && *c == ':') ? atoi(exlib::string(c + 1, p - c - 1).c_str()) : defPort;
+        if (a.m_host.empty() || a.m_port <= 0 || a.m_port > 65535)
+            return CHECK_ERROR(CALL_E_INVALIDARG);
+
+        addrs.push_back(a);
+        s = p < e ? p + 1 : p;
+    }
+
+    if (addrs.empty())
+        return CHECK_ERROR(CALL_E_INVALIDARG);
+
+    if (*e == '/') {
+        s = ++e;
+        while (*e && *e != '?')
+            e++;
+        path.assign(s, e - s);
+    }
+
+    if (*e == '?')
+        query = e + 1;
+
+    return 0;
+}
+
+result_t Redis::login(_auth& auth)
+{
+    if (auth.m_password.empty())
+        return 0;
+
+    _param ps;
+    ps.add("AUTH");
+    if (!auth.m_user.empty())
+        ps.add(auth.m_user);
+    ps.add(auth.m_password);
+
+    exlib::string req = ps.str();
+    Variant v;
+
+    result_t hr = cc__batch(req, 0, v);
+    return hr < 0 ? hr : 0;
+}
+
+static result_t sentinel_master(exlib::string connString, exlib::string& host, int32_t& port,
+    Redis::_auth& auth)
+{
+    std::vector<Redis::_addr> addrs;
+    exlib::string name, query;
+    result_t hr;
+
+    hr = Redis::parse_addrs(connString, 26379, addrs, auth, name, query);
+    if (hr < 0)
+        return hr;
+
+    if (name.empty())
+        return CHECK_ERROR(Runtime::setError("Redis: sentinel master name is required."));
+
+    Redis::_param ps;
+    ps.add("SENTINEL");
+    ps.add("get-master-addr-by-name");
+    ps.add(name);
+    exlib::string req = ps.str();
+
+    // the first sentinel that answers wins, an unreachable one is skipped
+    for (int32_t i = 0; i < (int32_t)addrs.size(); i++) {
+        obj_ptr<Redis> conn = new Redis();
+        Variant v;
+
+        hr = conn->cc_connect(addrs[i].m_host.c_str(), addrs[i].m_port);
+        if (hr < 0)
+            continue;
+
+        hr = conn->cc__batch(req, 0, v);
+        conn->m_sock->cc_close();
+
+        if (hr == CALL_RETURN_NULL)
+            return CHECK_ERROR(Runtime::setError("Redis: unknown sentinel master " + name + "."));
+        if (hr < 0)
+            continue;
+
+        obj_ptr<NArray> addr;
+        exlib::string strPort;
+
+        hr = Redis::retValue(v, addr);
+        if (hr < 0 || addr->length() != 2)
+            return CHECK_ERROR(Runtime::setError("Redis: Invalid response."));
+
+        Redis::retValue(addr->m_array[0], host);
+        Redis::retValue(addr->m_array[1], strPort);
+        port = atoi(strPort.c_str());
+
+        return 0;
+    }
+
+    return hr;
+}
+
 result_t db_base::openRedis(exlib::string connString,
     obj_ptr<Redis_base>& retVal, AsyncEvent* ac)
 {
@@ -28,7 +180,40 @@ result_t db_base::openRedis(exlib::string connString,
     exlib::string host;
     int32_t nPort = 6379;
 
-    if (!qstrcmp(c_str, "redis:", 6)) {
+    if (!qstrcmp(c_str, "redis-cluster:", 14)) {
+        obj_ptr<RedisCluster> conn = new RedisCluster();
+
+        result_t hr = conn->open(connString);
+        if (hr < 0)
+            return hr;
+
+        retVal = conn;
+        return 0;
+    }
+
+    if (!qstrcmp(c_str, "redis-sentinel:", 15)) {
+        Redis::_auth auth;
+
+        result_t hr = sentinel_master(connString, host, nPort, auth);
+        if (hr < 0)
+            return hr;
+
+        // the credentials belong to the master, the sentinels are asked without them
+        if (!auth.m_password.empty()) {
+            obj_ptr<Redis> conn = new Redis();
+
+            hr = conn->cc_connect(host.c_str(), nPort);
+            if (hr >= 0)
+                hr = conn->login(auth);
+            if (hr < 0)
+                return hr;
+
+            retVal = conn;
+            return 0;
+        }
+
+        c_str = host.c_str();
+    } else if (!qstrcmp(c_str, "redis:", 6)) {
         obj_ptr<Url> u = new Url();
 
         result_t hr = u->parse(c_str);
@@ -56,44 +241,71 @@ result_t Redis::connect(const char* host, int32_t port, AsyncEvent* ac)
     if (hr < 0)
         return hr;
 
-    m_stmBuffered = new BufferedStream(m_sock);
-    m_stmBuffered->set_EOL("\r\n");
-
     m_subMode = 0;
 
     return m_sock->connect(host, port, 0, ac);
 }
 
-#define REDIS_MAX_LINE 1024
 result_t Redis::_command(exlib::string& req, Variant& retVal, AsyncEvent* ac)
+{
+    return _batch(req, 0, retVal, ac);
+}
+
+result_t Redis::_batch(exlib::string& req, int32_t count, Variant& retVal, AsyncEvent* ac)
 {
     class asyncCommand : public AsyncState {
     public:
-        asyncCommand(Redis* pThis, exlib::string& req, Variant& retVal, AsyncEvent* ac)
+        asyncCommand(Redis* pThis, exlib::string& req, int32_t count, Variant& retVal, AsyncEvent* ac)
             : AsyncState(ac)
             , m_pThis(pThis)
             , m_req(req)
-            , m_retVal(retVal)
+            , m_retVal(&retVal)
+            , m_queued(false)
         {
             m_subMode = pThis->m_subMode;
-            m_stmBuffered = pThis->m_stmBuffered;
+            m_sock = pThis->m_sock;
+            start(count);
             next(send);
         }
 
-        asyncCommand(Redis* pThis)
+        asyncCommand(Redis* pThis, bool queued = false)
             : AsyncState(NULL)
             , m_pThis(pThis)
-            , m_retVal(m_val)
+            , m_retVal(&m_val)
+            , m_queued(queued)
         {
-            m_subMode = pThis->m_subMode;
-            m_stmBuffered = pThis->m_stmBuffered;
-            next(read);
+            m_subMode = queued ? 0 : pThis->m_subMode;
+            m_sock = pThis->m_sock;
+            start(0);
+            next(queued ? pop : read);
+        }
+
+        void start(int32_t count)
+        {
+            m_count = count;
+            if (count)
+                m_batch = new NArray();
         }
 
         ON_STATE(asyncCommand, send)
         {
             m_buffer = new Buffer(m_req.c_str(), m_req.length());
-            return m_stmBuffered->write(m_buffer, next(read));
+            return m_sock->write(m_buffer, next(read));
+        }
+
+        ON_STATE(asyncCommand, pop)
+        {
+            m_pThis->m_queueLock.lock();
+            if (m_pThis->m_waiting.empty()) {
+                m_pThis->m_reading = false;
+                m_pThis->m_queueLock.unlock();
+                return next();
+            }
+
+            start(m_pThis->m_waiting.front().m_count);
+            m_pThis->m_queueLock.unlock();
+
+            return next(read);
         }
 
         ON_STATE(asyncCommand, read)
@@ -101,7 +313,29 @@ result_t Redis::_command(exlib::string& req, Variant& retVal, AsyncEvent* ac)
             if (m_subMode == 2)
                 return next(n);
 
-            return m_stmBuffered->readLine(REDIS_MAX_LINE, m_strLine, next(read_ok));
+            RespParser& resp = m_pThis->m_resp;
+            result_t hr = resp.parse(m_val);
+
+            if (hr == CALL_E_PENDDING)
+                return m_sock->recv(resp.recv_size(), m_buffer, next(fill));
+            if (hr < 0)
+                return hr;
+
+            if (m_error.empty() && !resp.m_error.empty())
+                m_error = resp.m_error;
+
+            return setResult(hr);
+        }
+
+        ON_STATE(asyncCommand, fill)
+        {
+            if (n == CALL_RETURN_NULL)
+                return CHECK_ERROR(Runtime::setError("Redis: Connection closed."));
+
+            m_pThis->m_resp.append(m_buffer);
+            m_buffer.Release();
+
+            return next(read);
         }
 
         void _emit()
@@ -153,137 +387,197 @@ result_t Redis::_command(exlib::string& req, Variant& retVal, AsyncEvent* ac)
             }
         }
 
-        int32_t setResult(int32_t hr = 0)
+        int32_t setResult(int32_t hr)
         {
-            while (m_lists.size()) {
-                int32_t idx = (int32_t)m_lists.size() - 1;
-                m_lists[idx]->append(m_val);
-                m_counts[idx]--;
+            // RESP3 push messages are not replies, they never consume a request
+            if (m_subMode != 0 || m_pThis->m_resp.m_push) {
+                if (m_subMode != 0 && !m_error.empty())
+                    return CHECK_ERROR(Runtime::setError(m_error));
 
-                if (m_counts[idx]) {
-                    m_val.clear();
-                    return next(read);
-                }
+                _emit();
 
-                m_val = m_lists[idx];
-                m_lists.pop();
-                m_counts.pop();
+                m_val.clear();
+                return next(read);
+            }
+
+            if (m_count) {
+                m_batch->append(m_val);
+                m_val.clear();
+
+                if (--m_count)
+                    return next(read);
 
+                m_val = m_batch;
+                m_batch.Release();
                 hr = 0;
             }
 
-            if (hr < 0)
-                return next(hr);
+            if (!m_error.empty()) {
+                hr = Runtime::setError(m_error);
+                m_error.clear();
+            }
 
-            if (m_subMode == 0) {
-                m_retVal = m_val;
+            if (!m_queued) {
+                if (hr >= 0)
+                    *m_retVal = m_val;
                 return next(hr);
             }
 
-            _emit();
+            Redis::_request r;
 
+            m_pThis->m_queueLock.lock();
+            r = m_pThis->m_waiting.front();
+            m_pThis->m_waiting.pop_front();
+            m_pThis->m_queueLock.unlock();
+
+            if (hr >= 0)
+                *r.m_retVal = m_val;
             m_val.clear();
-            return next(read);
+
+            r.m_ac->post(hr);
+
+            return next(pop);
         }
 
-        ON_STATE(asyncCommand, read_ok)
+        virtual int32_t error(int32_t v)
         {
-            if (m_strLine.length() == 0)
-                return CHECK_ERROR(Runtime::setError("Redis: Invalid response."));
+            if (m_subMode == 1)
+                m_pThis->_emit("suberror");
 
-            char ch = m_strLine.c_str()[0];
+            if (m_queued) {
+                std::deque<Redis::_request> rs;
 
-            if (ch == '+') {
-                m_val = new Buffer(m_strLine.c_str() + 1, m_strLine.length() - 1);
-                return setResult();
-            }
+                m_pThis->m_queueLock.lock();
+                rs.swap(m_pThis->m_waiting);
+                m_pThis->m_reading = false;
+                m_pThis->m_queueLock.unlock();
 
-            if (ch == '-')
-                return CHECK_ERROR(Runtime::setError(m_strLine.substr(1)));
-
-            if (ch == ':') {
-                m_val.parseInt(m_strLine.c_str() + 1);
-                return setResult();
+                for (auto& r : rs)
+                    r.m_ac->post(v);
             }
 
-            if (ch == '$') {
-                int32_t sz = atoi(m_strLine.c_str() + 1);
-
-                if (sz < 0) {
-                    m_val.setNull();
-                    return setResult(CALL_RETURN_NULL);
-                }
+            return v;
+        }
 
-                return m_stmBuffered->read(sz + 2, m_buffer, next(bulk_ok));
-            }
+    protected:
+        obj_ptr<Redis> m_pThis;
+        exlib::string m_req;
+        Variant* m_retVal;
+        Variant m_val;
+        obj_ptr<Socket_base> m_sock;
+        obj_ptr<Buffer_base> m_buffer;
+        exlib::string m_error;
+        obj_ptr<NArray> m_batch;
+        int32_t m_count;
+        int32_t m_subMode;
+        bool m_queued;
+    };
 
-            if (ch == '*') {
-                int32_t sz = atoi(m_strLine.c_str() + 1);
+    class asyncSend : public AsyncState {
+    public:
+        asyncSend(Redis* pThis)
+            : AsyncState(NULL)
+            , m_pThis(pThis)
+        {
+            m_sock = pThis->m_sock;
+            next(send);
+        }
 
-                if (sz < 0) {
-                    m_val.setNull();
-                    return setResult(CALL_RETURN_NULL);
-                }
+        ON_STATE(asyncSend, send)
+        {
+            exlib::string req;
+            bool bRead = false;
+
+            m_pThis->m_queueLock.lock();
+            if (m_pThis->m_sending.empty()) {
+                m_pThis->m_writing = false;
+                m_pThis->m_queueLock.unlock();
+                return next();
+            }
 
-                if (sz == 0) {
-                    m_val = new NArray();
-                    return setResult();
-                }
+            // everything queued while the last write was pending goes out in one write
+            while (!m_pThis->m_sending.empty()) {
+                Redis::_request& r = m_pThis->m_sending.front();
 
-                m_lists.append(new NArray());
-                m_counts.append(sz);
+                req.append(r.m_req);
+                r.m_req.clear();
 
-                return next(read);
+                m_pThis->m_waiting.push_back(r);
+                m_pThis->m_sending.pop_front();
             }
 
-            return CHECK_ERROR(Runtime::setError("Redis: Invalid response."));
-        }
+            if (!m_pThis->m_reading)
+                m_pThis->m_reading = bRead = true;
+            m_pThis->m_queueLock.unlock();
 
-        ON_STATE(asyncCommand, bulk_ok)
-        {
-            if (n == CALL_RETURN_NULL)
-                return setResult(CALL_RETURN_NULL);
+            if (bRead)
+                (new asyncCommand(m_pThis, true))->post(0);
 
-            int32_t sz = Buffer::Cast(m_buffer)->length();
-            obj_ptr<Buffer_base> buf;
-            m_buffer->slice(0, sz - 2, buf);
-            m_buffer.Release();
-
-            m_val = buf;
-
-            return setResult();
+            m_buffer = new Buffer(req.c_str(), req.length());
+            return m_sock->write(m_buffer, next(send));
         }
 
         virtual int32_t error(int32_t v)
         {
-            if (m_subMode == 1)
-                m_pThis->_emit("suberror");
+            std::deque<Redis::_request> rs;
+
+            m_pThis->m_queueLock.lock();
+            rs.swap(m_pThis->m_sending);
+            m_pThis->m_writing = false;
+            m_pThis->m_queueLock.unlock();
+
+            for (auto& r : rs)
+                r.m_ac->post(v);
 
             return v;
         }
 
     protected:
         obj_ptr<Redis> m_pThis;
-        exlib::string m_req;
-        Variant& m_retVal;
-        Variant m_val;
-        obj_ptr<BufferedStream_base> m_stmBuffered;
+        obj_ptr<Socket_base> m_sock;
         obj_ptr<Buffer_base> m_buffer;
-        QuickArray<obj_ptr<NArray>> m_lists;
-        QuickArray<int32_t> m_counts;
-        exlib::string m_strLine;
-        int32_t m_subMode;
     };
 
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_NOSYNC);
 
     if (m_subMode == 1) {
+        if (m_writing || m_reading)
+            return CHECK_ERROR(Runtime::setError("Redis: pipelined commands are still pending."));
+
         (new asyncCommand(this))->post(0);
         m_subMode = 2;
     }
 
-    return (new asyncCommand(this, req, retVal, ac))->post(0);
+    if (m_subMode == 0) {
+        bool bQueued = false;
+        bool bSend = false;
+
+        m_queueLock.lock();
+        if (m_autoPipelining || m_writing || m_reading) {
+            Redis::_request r;
+
+            r.m_req = req;
+            r.m_count = count;
+            r.m_retVal = &retVal;
+            r.m_ac = ac;
+            m_sending.push_back(r);
+
+            if (!m_writing)
+                m_writing = bSend = true;
+            bQueued = true;
+        }
+        m_queueLock.unlock();
+
+        if (bQueued) {
+            // flush from the pool so that fibers running in the same turn share the write
+            if (bSend)
+                (new asyncSend(this))->apost(0);
+            return CALL_E_PENDDING;
+        }
+    }
+
+    return (new asyncCommand(this, req, count, retVal, ac))->post(0);
 }
 
 result_t Redis::command(exlib::string cmd, OptArgs args,
@@ -492,6 +786,24 @@ result_t Redis::getSortedSet(Buffer_base* key, obj_ptr<RedisSortedSet_base>& ret
     return 0;
 }
 
+result_t Redis::pipeline(obj_ptr<RedisPipeline_base>& retVal)
+{
+    retVal = new RedisPipeline(this);
+    return 0;
+}
+
+result_t Redis::get_autoPipelining(bool& retVal)
+{
+    retVal = m_autoPipelining;
+    return 0;
+}
+
+result_t Redis::set_autoPipelining(bool newVal)
+{
+    m_autoPipelining = newVal;
+    return 0;
+}
+
 result_t Redis::dump(Buffer_base* key, obj_ptr<Buffer_base>& retVal)
 {
     return doCommand("DUMP", key, retVal);
@@ -514,7 +826,6 @@ result_t Redis::close()
     m_sock->ac_close();
 
     m_sock.Release();
-    m_stmBuffered.Release();
 
     return 0;
 }
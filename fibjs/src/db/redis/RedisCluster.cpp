@@ -0,0 +1,777 @@
+/*
+ * RedisCluster.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "RedisCluster.h"
+
+namespace fibjs {
+
+static class _crc16 {
+public:
+    _crc16()
+    {
+        for (int32_t i = 0; i < 256; i++) {
+            uint16_t crc = (uint16_t)(i << 8);
+
+            for (int32_t j = 0; j < 8; j++)
+                crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+
+            m_table[i] = crc;
+        }
+    }
+
+public:
+    uint16_t sum(const char* buf, size_t len)
+    {
+        uint16_t crc = 0;
+
+        while (len--)
+            crc = (uint16_t)((crc << 8) ^ m_table[((crc >> 8) ^ (uint8_t)*buf++) & 0xff]);
+
+        return crc;
+    }
+
+private:
+    uint16_t m_table[256];
+} s_crc16;
+
+int32_t RedisCluster::slot(const char* key, size_t len)
+{
+    // only the part inside the first non-empty {...} is hashed, so related keys can share a slot
+    const char* s = (const char*)memchr(key, '{', len);
+
+    if (s) {
+        const char* e = (const char*)memchr(s + 1, '}', key + len - s - 1);
+
+        if (e && e > s + 1) {
+            key = s + 1;
+            len = e - key;
+        }
+    }
+
+    return s_crc16.sum(key, len) & (REDIS_SLOTS - 1);
+}
+
+static bool read_num(exlib::string& req, size_t& pos, char type, int32_t& retVal)
+{
+    const char* p = req.c_str();
+    size_t len = req.length();
+    int32_t n = 0;
+
+    if (pos >= len || p[pos] != type)
+        return false;
+
+    pos++;
+    while (pos < len && p[pos] >= '0' && p[pos] <= '9')
+        n = n * 10 + (p[pos++] - '0');
+
+    if (pos + 1 >= len || p[pos] != '\r' || p[pos + 1] != '\n')
+        return false;
+
+    pos += 2;
+    retVal = n;
+
+    return true;
+}
+
+result_t RedisCluster::parse_cmd(exlib::string& req, size_t& pos, _cmd& cmd)
+{
+    size_t start = pos;
+    int32_t n, len, i;
+
+    if (!read_num(req, pos, '*', n) || n < 1)
+        return CHECK_ERROR(CALL_E_INVALIDARG);
+
+    cmd.m_args.resize(n);
+    for (i = 0; i < n; i++) {
+        if (!read_num(req, pos, '$', len) || pos + len + 2 > req.length())
+            return CHECK_ERROR(CALL_E_INVALIDARG);
+
+        cmd.m_args[i].assign(req.c_str() + pos, len);
+        pos += len + 2;
+    }
+
+    cmd.m_req.assign(req.c_str() + start, pos - start);
+
+    return 0;
+}
+
+static const char* s_keyless[] = {
+    "PING", "ECHO", "INFO", "AUTH", "HELLO", "SELECT", "TIME", "CLUSTER",
+    "CONFIG", "CLIENT", "COMMAND", "SCRIPT", "FUNCTION", "SLOWLOG", "LATENCY",
+    "PUBLISH", "SCAN", "RANDOMKEY", "WAIT", "LASTSAVE", "DEBUG", NULL
+};
+
+int32_t RedisCluster::key_slot(_cmd& cmd)
+{
+    std::vector<exlib::string>& args = cmd.m_args;
+    const char* name = args[0].c_str();
+    int32_t i;
+
+    for (i = 0; s_keyless[i]; i++)
+        if (!qstricmp(name, s_keyless[i]))
+            return -1;
+
+    if (!qstricmp(name, "EVAL") || !qstricmp(name, "EVALSHA")
+        || !qstricmp(name, "EVAL_RO") || !qstricmp(name, "EVALSHA_RO")
+        || !qstricmp(name, "FCALL") || !qstricmp(name, "FCALL_RO")) {
+        if (args.size() > 3 && atoi(args[2].c_str()) > 0)
+            return slot(args[3].c_str(), args[3].length());
+        return -1;
+    }
+
+    if (!qstricmp(name, "XREAD") || !qstricmp(name, "XREADGROUP")) {
+        for (i = 1; i < (int32_t)args.size() - 1; i++)
+            if (!qstricmp(args[i].c_str(), "STREAMS"))
+                return slot(args[i + 1].c_str(), args[i + 1].length());
+        return -1;
+    }
+
+    if (args.size() < 2)
+        return -1;
+
+    return slot(args[1].c_str(), args[1].length());
+}
+
+obj_ptr<RedisCluster::Node> RedisCluster::get_node(exlib::string host, int32_t port)
+{
+    char numStr[16];
+    obj_ptr<Node> retVal;
+
+    snprintf(numStr, sizeof(numStr), ":%d", port);
+    exlib::string key = host + numStr;
+
+    m_nodesLock.lock();
+    obj_ptr<Node>& node = m_nodes[key];
+    if (!node)
+        node = new Node(host, port);
+    retVal = node;
+    m_nodesLock.unlock();
+
+    return retVal;
+}
+
+result_t RedisCluster::get_conn(Node* node, obj_ptr<Redis>& retVal)
+{
+    int32_t sz, i;
+    result_t hr;
+
+    node->m_lock.lock();
+
+    while (true) {
+        // an idle connection first, a new one while the pool has room, then round robin
+        sz = (int32_t)node->m_conns.size();
+        for (i = 0; i < sz; i++) {
+            Redis* conn = node->m_conns[(node->m_next + i) % sz];
+
+            if (!conn->m_writing && !conn->m_reading) {
+                retVal = conn;
+                node->m_lock.unlock();
+                return 0;
+            }
+        }
+
+        if (sz + node->m_connecting < m_poolSize)
+            break;
+
+        if (sz) {
+            retVal = node->m_conns[node->m_next % sz];
+            node->m_next = (node->m_next + 1) % sz;
+            node->m_lock.unlock();
+            return 0;
+        }
+
+        // the whole pool is still connecting, wait for one of them
+        node->m_ready.wait(node->m_lock);
+    }
+
+    // the slot is reserved, other fibers keep using the node while this one connects
+    node->m_connecting++;
+    node->m_lock.unlock();
+
+    obj_ptr<Redis> conn = new Redis();
+
+    hr = conn->cc_connect(node->m_host.c_str(), node->m_port);
+    if (hr >= 0)
+        hr = conn->login(m_auth);
+
+    node->m_lock.lock();
+    node->m_connecting--;
+    if (hr >= 0 && m_closed)
+        hr = CHECK_ERROR(CALL_E_INVALID_CALL);
+    if (hr >= 0) {
+        conn->m_autoPipelining = true;
+        node->m_conns.push_back(conn);
+        retVal = conn;
+    }
+    node->m_ready.notify_all();
+    node->m_lock.unlock();
+
+    if (hr < 0 && !conn->closed())
+        conn->close();
+
+    return hr < 0 ? hr : 0;
+}
+
+void RedisCluster::drop_conn(Node* node, Redis* conn)
+{
+    node->m_lock.lock();
+    for (int32_t i = 0; i < (int32_t)node->m_conns.size(); i++)
+        if (node->m_conns[i] == conn) {
+            node->m_conns.erase(node->m_conns.begin() + i);
+            break;
+        }
+    node->m_next = 0;
+    node->m_lock.unlock();
+}
+
+result_t RedisCluster::load(Variant& v, exlib::string& host)
+{
+    std::vector<obj_ptr<Node>> slots(REDIS_SLOTS);
+    std::vector<obj_ptr<Node>> masters;
+    obj_ptr<NArray> ranges;
+    result_t hr;
+    int32_t i, j;
+
+    hr = retValue(v, ranges);
+    if (hr < 0)
+        return hr;
+
+    for (i = 0; i < ranges->length(); i++) {
+        obj_ptr<NArray> range, master;
+
+        if (retValue(ranges->m_array[i], range) < 0 || range->length() < 3
+            || retValue(range->m_array[2], master) < 0 || master->length() < 2)
+            return CHECK_ERROR(Runtime::setError("Redis: Invalid response."));
+
+        int32_t from = range->m_array[0].intVal();
+        int32_t to = range->m_array[1].intVal();
+
+        if (from < 0 || to >= REDIS_SLOTS || from > to)
+            return CHECK_ERROR(Runtime::setError("Redis: Invalid response."));
+
+        // an empty or unknown endpoint means the node that answered
+        exlib::string h;
+        retValue(master->m_array[0], h);
+        if (h.empty() || !qstrcmp(h.c_str(), "?"))
+            h = host;
+
+        obj_ptr<Node> node = get_node(h, master->m_array[1].intVal());
+
+        for (j = from; j <= to; j++)
+            slots[j] = node;
+
+        for (j = 0; j < (int32_t)masters.size(); j++)
+            if (masters[j] == node)
+                break;
+        if (j == (int32_t)masters.size())
+            masters.push_back(node);
+    }
+
+    m_nodesLock.lock();
+    m_slots.swap(slots);
+    m_masters.swap(masters);
+    m_nodesLock.unlock();
+
+    return 0;
+}
+
+result_t RedisCluster::refresh()
+{
+    std::vector<obj_ptr<Node>> nodes;
+    exlib::string req("*2\r\n$7\r\nCLUSTER\r\n$5\r\nSLOTS\r\n");
+    result_t hr = 0;
+    int32_t i;
+
+    m_nodesLock.lock();
+    if (m_refreshing) {
+        m_nodesLock.unlock();
+        return 0;
+    }
+    m_refreshing = true;
+    m_dirty = false;
+    nodes = m_masters;
+    m_nodesLock.unlock();
+
+    for (i = 0; i < (int32_t)m_seeds.size(); i++)
+        nodes.push_back(get_node(m_seeds[i].m_host, m_seeds[i].m_port));
+
+    // the first node that answers wins, known masters are asked before the seeds
+    for (i = 0; i < (int32_t)nodes.size(); i++) {
+        Node* node = nodes[i];
+        obj_ptr<Redis> conn;
+        Variant v;
+
+        hr = get_conn(node, conn);
+        if (hr < 0)
+            continue;
+
+        hr = conn->cc__batch(req, 0, v);
+        if (hr < 0) {
+            if (hr != CALL_E_EXCEPTION)
+                drop_conn(node, conn);
+            continue;
+        }
+
+        hr = load(v, node->m_host);
+        if (hr >= 0)
+            break;
+    }
+
+    m_nodesLock.lock();
+    m_refreshing = false;
+    m_nodesLock.unlock();
+
+    return hr;
+}
+
+result_t RedisCluster::start(_job* job)
+{
+    obj_ptr<Node> node = job->m_node;
+    result_t hr;
+
+    if (!node) {
+        m_nodesLock.lock();
+        if (job->m_slot >= 0)
+            node = m_slots[job->m_slot];
+        else if (m_masters.size()) {
+            m_next = (m_next + 1) % (int32_t)m_masters.size();
+            node = m_masters[m_next];
+        }
+        m_nodesLock.unlock();
+    }
+
+    if (!node)
+        return CHECK_ERROR(Runtime::setError("Redis: cluster slot is not served by any node."));
+
+    job->m_target = node;
+    job->m_conn.Release();
+    job->m_error.clear();
+    job->m_hr = 0;
+
+    hr = get_conn(node, job->m_conn);
+    if (hr < 0)
+        return hr;
+
+    job->setAsync();
+
+    if (job->m_asking) {
+        job->m_send = "*1\r\n$6\r\nASKING\r\n";
+        job->m_send.append(job->m_req);
+        return job->m_conn->_batch(job->m_send, 2, job->m_val, job);
+    }
+
+    return job->m_conn->_batch(job->m_req, job->m_count, job->m_val, job);
+}
+
+bool RedisCluster::redirect(_job* job)
+{
+    const char* err = job->m_error.c_str();
+    bool ask = !qstrcmp(err, "ASK ", 4);
+
+    if (!ask && qstrcmp(err, "MOVED ", 6))
+        return false;
+
+    // part of a group may already have run on the old node, only MOVED means none of it did
+    if (ask && job->m_count)
+        return false;
+
+    const char* p = qstrchr(err, ' ') + 1;
+    int32_t s = atoi(p);
+
+    p = qstrchr(p, ' ');
+    if (!p)
+        return false;
+    p++;
+
+    const char* c = qstrrchr(p, ':');
+    if (!c || s < 0 || s >= REDIS_SLOTS)
+        return false;
+
+    obj_ptr<Node> node = get_node(exlib::string(p, c - p), atoi(c + 1));
+
+    if (ask) {
+        job->m_node = node;
+        job->m_asking = true;
+    } else {
+        m_nodesLock.lock();
+        m_slots[s] = node;
+        m_nodesLock.unlock();
+
+        m_dirty = true;
+        job->m_node.Release();
+    }
+
+    return true;
+}
+
+result_t RedisCluster::execute(std::deque<_job>& jobs)
+{
+    std::vector<_job*> runs;
+    int32_t redirects = 0;
+    int32_t i;
+    result_t hr;
+
+    for (auto& job : jobs)
+        runs.push_back(&job);
+
+    while (true) {
+        exlib::atomic pending;
+        exlib::Event done;
+
+        // all jobs are in flight together, jobs bound to the same node share its pipelined connection
+        pending.inc();
+        for (i = 0; i < (int32_t)runs.size(); i++) {
+            _job* job = runs[i];
+
+            job->m_pending = &pending;
+            job->m_done = &done;
+            pending.inc();
+
+            hr = start(job);
+            if (hr != CALL_E_PENDDING)
+                job->post(hr);
+        }
+
+        if (pending.dec() != 0)
+            done.wait();
+
+        std::vector<_job*> retries;
+
+        for (i = 0; i < (int32_t)runs.size(); i++) {
+            _job* job = runs[i];
+
+            if (job->m_asking) {
+                job->m_asking = false;
+                job->m_node.Release();
+
+                obj_ptr<NArray> list;
+                if (job->m_hr >= 0 && retValue(job->m_val, list) >= 0 && list->length() == 2) {
+                    job->m_val = list->m_array[1];
+                    job->m_hr = job->m_val.type() == Variant::VT_Null ? CALL_RETURN_NULL : 0;
+                }
+            }
+
+            if (job->m_hr >= 0)
+                continue;
+
+            if (job->m_hr != CALL_E_EXCEPTION || !qstrcmp(job->m_error.c_str(), "Redis: ", 7)) {
+                // the connection is unusable, and the node may be gone as well
+                if (job->m_conn)
+                    drop_conn(job->m_target, job->m_conn);
+                m_dirty = true;
+            } else if (redirect(job))
+                retries.push_back(job);
+        }
+
+        if (retries.empty() || ++redirects > MAX_REDIRECTS)
+            break;
+
+        runs.swap(retries);
+    }
+
+    if (m_dirty)
+        refresh();
+
+    for (auto& job : jobs)
+        if (job.m_hr < 0) {
+            if (job.m_hr == CALL_E_EXCEPTION)
+                return CHECK_ERROR(Runtime::setError(job.m_error));
+            return job.m_hr;
+        }
+
+    return 0;
+}
+
+result_t RedisCluster::merge(std::deque<_job>& jobs, int32_t mode, int32_t count, Variant& retVal)
+{
+    if (mode == MERGE_FIRST) {
+        retVal = jobs.front().m_val;
+        return 0;
+    }
+
+    if (mode == MERGE_SUM) {
+        int64_t n = 0;
+
+        for (auto& job : jobs)
+            n += job.m_val.longVal();
+
+        retVal = n;
+        return 0;
+    }
+
+    obj_ptr<NArray> list = new NArray();
+    result_t hr;
+    int32_t i;
+
+    if (mode == MERGE_LIST)
+        list->resize(count);
+
+    for (auto& job : jobs) {
+        obj_ptr<NArray> vals;
+
+        hr = retValue(job.m_val, vals);
+        if (hr < 0)
+            return hr;
+
+        if (mode == MERGE_CONCAT) {
+            for (i = 0; i < vals->length(); i++)
+                list->append(vals->m_array[i]);
+        } else {
+            if (vals->length() != (int32_t)job.m_index.size())
+                return CHECK_ERROR(Runtime::setError("Redis: Invalid response."));
+
+            for (i = 0; i < vals->length(); i++)
+                list->m_array[job.m_index[i]] = vals->m_array[i];
+        }
+    }
+
+    retVal = list;
+    return 0;
+}
+
+result_t RedisCluster::route(_cmd& cmd, Variant& retVal)
+{
+    std::deque<_job> jobs;
+    result_t hr;
+
+    jobs.emplace_back();
+    _job& job = jobs.back();
+
+    job.m_slot = key_slot(cmd);
+    job.m_req = cmd.m_req;
+
+    hr = execute(jobs);
+    if (hr < 0)
+        return hr;
+
+    retVal = job.m_val;
+    return job.m_hr;
+}
+
+result_t RedisCluster::fanout(_cmd& cmd, int32_t step, int32_t mode, Variant& retVal)
+{
+    std::vector<exlib::string>& args = cmd.m_args;
+    int32_t count = ((int32_t)args.size() - 1) / step;
+
+    if (count < 1 || ((int32_t)args.size() - 1) % step)
+        return route(cmd, retVal);
+
+    // keys are grouped by slot, a group is a valid multi-key command on its own
+    std::deque<_job> jobs;
+    std::unordered_map<int32_t, _job*> groups;
+    result_t hr;
+    int32_t i, j;
+
+    for (i = 0; i < count; i++) {
+        exlib::string& key = args[1 + i * step];
+        int32_t s = slot(key.c_str(), key.length());
+        _job*& job = groups[s];
+
+        if (!job) {
+            jobs.emplace_back();
+            job = &jobs.back();
+            job->m_slot = s;
+            job->m_param.add(args[0]);
+        }
+
+        for (j = 0; j < step; j++)
+            job->m_param.add(args[1 + i * step + j]);
+        job->m_index.push_back(i);
+    }
+
+    if (jobs.size() == 1)
+        jobs.front().m_req = cmd.m_req;
+    else
+        for (auto& job : jobs)
+            job.m_req = job.m_param.str();
+
+    hr = execute(jobs);
+    if (hr < 0)
+        return hr;
+
+    return merge(jobs, mode, count, retVal);
+}
+
+result_t RedisCluster::broadcast(_cmd& cmd, int32_t mode, Variant& retVal)
+{
+    std::vector<obj_ptr<Node>> masters;
+    std::deque<_job> jobs;
+    result_t hr;
+
+    m_nodesLock.lock();
+    masters = m_masters;
+    m_nodesLock.unlock();
+
+    if (masters.empty())
+        return CHECK_ERROR(Runtime::setError("Redis: cluster slot is not served by any node."));
+
+    for (auto& node : masters) {
+        jobs.emplace_back();
+        _job& job = jobs.back();
+
+        job.m_node = node;
+        job.m_req = cmd.m_req;
+    }
+
+    hr = execute(jobs);
+    if (hr < 0)
+        return hr;
+
+    return merge(jobs, mode, 0, retVal);
+}
+
+result_t RedisCluster::single(_cmd& cmd, Variant& retVal)
+{
+    const char* name = cmd.m_args[0].c_str();
+
+    if (!qstricmp(name, "MGET"))
+        return fanout(cmd, 1, MERGE_LIST, retVal);
+
+    if (!qstricmp(name, "DEL") || !qstricmp(name, "UNLINK")
+        || !qstricmp(name, "EXISTS") || !qstricmp(name, "TOUCH"))
+        return fanout(cmd, 1, MERGE_SUM, retVal);
+
+    if (!qstricmp(name, "MSET"))
+        return fanout(cmd, 2, MERGE_FIRST, retVal);
+
+    if (!qstricmp(name, "KEYS"))
+        return broadcast(cmd, MERGE_CONCAT, retVal);
+
+    if (!qstricmp(name, "DBSIZE"))
+        return broadcast(cmd, MERGE_SUM, retVal);
+
+    if (!qstricmp(name, "FLUSHDB") || !qstricmp(name, "FLUSHALL"))
+        return broadcast(cmd, MERGE_FIRST, retVal);
+
+    return route(cmd, retVal);
+}
+
+result_t RedisCluster::_batch(exlib::string& req, int32_t count, Variant& retVal, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    if (m_subMode) {
+        m_subMode = 0;
+        m_funcs.clear();
+        return CHECK_ERROR(Runtime::setError("Redis: subscribe is not supported in cluster mode."));
+    }
+
+    if (m_closed)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    size_t pos = 0;
+    result_t hr;
+
+    if (count == 0) {
+        _cmd cmd;
+
+        hr = parse_cmd(req, pos, cmd);
+        if (hr < 0)
+            return hr;
+
+        return single(cmd, retVal);
+    }
+
+    // pipelined commands are grouped by slot, each group keeps its own order
+    std::deque<_job> jobs;
+    std::unordered_map<int32_t, _job*> groups;
+    int32_t i;
+
+    for (i = 0; i < count; i++) {
+        _cmd cmd;
+
+        hr = parse_cmd(req, pos, cmd);
+        if (hr < 0)
+            return hr;
+
+        int32_t s = key_slot(cmd);
+        _job*& job = groups[s];
+
+        if (!job) {
+            jobs.emplace_back();
+            job = &jobs.back();
+            job->m_slot = s;
+        }
+
+        job->m_req.append(cmd.m_req);
+        job->m_count++;
+        job->m_index.push_back(i);
+    }
+
+    hr = execute(jobs);
+    if (hr < 0)
+        return hr;
+
+    return merge(jobs, MERGE_LIST, count, retVal);
+}
+
+bool RedisCluster::closed()
+{
+    return m_closed;
+}
+
+result_t RedisCluster::open(exlib::string connString)
+{
+    exlib::string path, query;
+    result_t hr;
+
+    hr = parse_addrs(connString, 6379, m_seeds, m_auth, path, query);
+    if (hr < 0)
+        return hr;
+
+    const char* p = query.c_str();
+
+    while (*p) {
+        const char* e = p;
+        while (*e && *e != '&')
+            e++;
+
+        if (!qstrcmp(p, "poolSize=", 9)) {
+            m_poolSize = atoi(p + 9);
+            if (m_poolSize < 1)
+                return CHECK_ERROR(CALL_E_INVALIDARG);
+        }
+
+        p = *e ? e + 1 : e;
+    }
+
+    return refresh();
+}
+
+result_t RedisCluster::close()
+{
+    std::vector<obj_ptr<Node>> nodes;
+    std::vector<obj_ptr<Redis>> conns;
+
+    if (m_closed)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    m_closed = true;
+
+    m_nodesLock.lock();
+    for (auto& it : m_nodes)
+        nodes.push_back(it.second);
+    m_nodes.clear();
+    m_masters.clear();
+    m_nodesLock.unlock();
+
+    for (auto& node : nodes) {
+        node->m_lock.lock();
+        conns.insert(conns.end(), node->m_conns.begin(), node->m_conns.end());
+        node->m_conns.clear();
+        node->m_lock.unlock();
+    }
+
+    for (auto& conn : conns)
+        conn->close();
+
+    return 0;
+}
+
+} /* namespace fibjs */
@@ -0,0 +1,68 @@
+/*
+ * RedisPipeline.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "RedisPipeline.h"
+
+namespace fibjs {
+
+result_t RedisPipeline::command(exlib::string cmd, OptArgs args, obj_ptr<RedisPipeline_base>& retVal)
+{
+    result_t hr;
+
+    hr = m_rdb->chkCommand(cmd);
+    if (hr < 0)
+        return hr;
+
+    Redis::_param ps;
+
+    hr = ps.add(cmd);
+    if (hr < 0)
+        return hr;
+
+    hr = ps.add(args);
+    if (hr < 0)
+        return hr;
+
+    m_req.append(ps.str());
+    m_count++;
+
+    retVal = this;
+    return 0;
+}
+
+result_t RedisPipeline::get_length(int32_t& retVal)
+{
+    retVal = m_count;
+    return 0;
+}
+
+result_t RedisPipeline::exec(obj_ptr<NArray>& retVal)
+{
+    if (m_rdb->closed())
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    if (!m_count) {
+        retVal = new NArray();
+        return 0;
+    }
+
+    exlib::string req = m_req;
+    int32_t count = m_count;
+    Variant v;
+    result_t hr;
+
+    m_req.clear();
+    m_count = 0;
+
+    hr = m_rdb->ac__batch(req, count, v);
+    if (hr < 0)
+        return hr;
+
+    return Redis::retValue(v, retVal);
+}
+}
@@ -0,0 +1,265 @@
+/*
+ * RespParser.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "RespParser.h"
+
+namespace fibjs {
+
+static bool parse_int(const char* p, size_t len, int64_t& retVal)
+{
+    bool neg = false;
+    uint64_t n = 0;
+
+    if (len && *p == '-') {
+        neg = true;
+        p++;
+        len--;
+    }
+
+    if (len == 0 || len > 19)
+        return false;
+
+    // INT64_MIN has one more in magnitude than INT64_MAX
+    uint64_t limit = neg ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+
+    while (len--) {
+        char ch = *p++;
+        if (ch < '0' || ch > '9')
+            return false;
+
+        uint64_t d = ch - '0';
+        if (n > (limit - d) / 10)
+            return false;
+        n = n * 10 + d;
+    }
+
+    retVal = neg ? (int64_t)(0 - n) : (int64_t)n;
+    return true;
+}
+
+void RespParser::append(Buffer_base* data)
+{
+    Buffer* buf = Buffer::Cast(data);
+    size_t sz = buf->length();
+
+    // a full receive buffer means bulk traffic, grow it; small replies should not pin large chunks
+    if (sz >= (size_t)m_recvSize) {
+        if (m_recvSize < RESP_MAX_RECV)
+            m_recvSize *= 2;
+    } else if (sz < (size_t)m_recvSize / 4 && m_recvSize > RESP_MIN_RECV)
+        m_recvSize /= 2;
+
+    if (m_pos == m_len) {
+        m_data = buf;
+        m_len = sz;
+        m_pos = 0;
+        return;
+    }
+
+    if (m_len + sz <= m_data->length()) {
+        memcpy(m_data->data() + m_len, buf->data(), sz);
+        m_len += sz;
+        return;
+    }
+
+    // only the unparsed tail is carried over, sized for the pending bulk string when known
+    size_t left = m_len - m_pos;
+    size_t cap = left + sz;
+
+    if (cap < m_need)
+        cap = m_need;
+
+    obj_ptr<Buffer> merged = new Buffer(NULL, cap);
+    memcpy(merged->data(), m_data->data() + m_pos, left);
+    memcpy(merged->data() + left, buf->data(), sz);
+
+    m_data = merged;
+    m_len = left + sz;
+    m_pos = 0;
+}
+
+Variant RespParser::slice(size_t pos, size_t len)
+{
+    Buffer::store& s = m_data->m_store;
+    obj_ptr<Buffer_base> buf = new Buffer(s.m_store, s.m_offset + pos, len);
+
+    return buf;
+}
+
+result_t RespParser::parse(Variant& retVal)
+{
+    if (m_stack.empty()) {
+        m_error.clear();
+        m_push = false;
+    }
+
+    while (true) {
+        if (m_pos >= m_len)
+            return CALL_E_PENDDING;
+
+        const char* base = (const char*)m_data->data();
+        const char* p = base + m_pos;
+        const char* eol = (const char*)memchr(p, '\n', m_len - m_pos);
+
+        if (!eol) {
+            if (m_len - m_pos > (size_t)RESP_MAX_LINE)
+                return CHECK_ERROR(Runtime::setError("Redis: Invalid response."));
+
+            m_need = 0;
+            return CALL_E_PENDDING;
+        }
+
+        if (eol - p < 2 || eol[-1] != '\r')
+            return CHECK_ERROR(Runtime::setError("Redis: Invalid response."));
+
+        char type = *p;
+        const char* line = p + 1;
+        size_t len = eol - 1 - line;
+        size_t next = eol + 1 - base;
+        bool isNull = false;
+        int64_t num;
+        Variant v;
+
+        switch (type) {
+        case '+':
+        case ',':
+        case '(':
+            v = slice(line - base, len);
+            break;
+        case '-':
+            if (m_error.empty())
+                m_error.assign(line, len);
+            isNull = true;
+            break;
+        case ':':
+            if (!parse_int(line, len, num))
+                return CHECK_ERROR(Runtime::setError("Redis: Invalid response."));
+            v = num;
+            break;
+        case '#':
+            v = (int32_t)(len && *line == 't');
+            break;
+        case '_':
+            isNull = true;
+            break;
+        case '$':
+        case '=':
+        case '!':
+            if (!parse_int(line, len, num))
+                return CHECK_ERROR(Runtime::setError("Redis: Invalid response."));
+
+            if (num < 0) {
+                isNull = true;
+                break;
+            }
+
+            if (next + num + 2 > m_len) {
+                m_need = next + num + 2 - m_pos;
+                return CALL_E_PENDDING;
+            }
+
+            if (base[next + num] != '\r' || base[next + num + 1] != '\n')
+                return CHECK_ERROR(Runtime::setError("Redis: Invalid response."));
+
+            if (type == '!') {
+                if (m_error.empty())
+                    m_error.assign(base + next, num);
+                isNull = true;
+            } else if (type == '=' && num >= 4)
+                v = slice(next + 4, num - 4);
+            else
+                v = slice(next, num);
+
+            next += num + 2;
+            break;
+        case '*':
+        case '~':
+        case '>':
+        case '%':
+        case '|':
+            if (!parse_int(line, len, num))
+                return CHECK_ERROR(Runtime::setError("Redis: Invalid response."));
+
+            if (num < 0) {
+                isNull = true;
+                break;
+            }
+
+            // maps and attributes are flattened to key/value lists, as RESP2 returns them
+            if (type == '%' || type == '|')
+                num *= 2;
+
+            if (num == 0 && type == '|') {
+                m_pos = next;
+                continue;
+            }
+
+            if (num > 0) {
+                frame f;
+
+                f.m_list = new NArray();
+                f.m_count = num;
+                f.m_type = type;
+                m_stack.push_back(f);
+
+                m_pos = next;
+                continue;
+            }
+
+            v = new NArray();
+            break;
+        default:
+            return CHECK_ERROR(Runtime::setError("Redis: Invalid response."));
+        }
+
+        m_pos = next;
+        m_need = 0;
+
+        if (isNull)
+            v.setNull();
+
+        bool bMore = false;
+
+        while (!m_stack.empty()) {
+            frame& f = m_stack.back();
+
+            f.m_list->append(v);
+
+            if (--f.m_count) {
+                bMore = true;
+                break;
+            }
+
+            v = f.m_list;
+            type = f.m_type;
+            isNull = false;
+            m_stack.pop_back();
+
+            // an attribute only annotates the value that follows it
+            if (type == '|') {
+                bMore = true;
+                break;
+            }
+        }
+
+        if (bMore)
+            continue;
+
+        m_push = type == '>';
+
+        if (m_pos == m_len) {
+            m_data.Release();
+            m_len = m_pos = 0;
+        }
+
+        retVal = v;
+        return isNull ? CALL_RETURN_NULL : 0;
+    }
+}
+
+} /* namespace fibjs */
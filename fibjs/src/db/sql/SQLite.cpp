@@ -63,6 +63,8 @@ result_t SQLite::open(const char* file)
 
 SQLite::~SQLite()
 {
+    clear_stmts();
+
     if (m_conn)
         asyncCall(sqlite3_close, (sqlite3*)m_conn);
 }
@@ -81,6 +83,8 @@ result_t SQLite::close(AsyncEvent* ac)
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_LONGSYNC);
 
+    clear_stmts();
+
     sqlite3_close((sqlite3*)m_conn);
     m_conn = NULL;
 
@@ -128,135 +132,273 @@ int32_t sqlite3_prepare_sleep(sqlite3* db, const char* zSql, int nByte,
     }
 }
 
-result_t SQLite::execute(exlib::string sql, obj_ptr<NArray>& retVal, AsyncEvent* ac)
+#define SQLITE_STMT_CACHE_SIZE 128
+
+sqlite3_stmt* SQLite::get_stmt(const exlib::string& sql)
 {
-    if (!m_conn)
-        return CHECK_ERROR(CALL_E_INVALID_CALL);
+    sqlite3_stmt* stmt = NULL;
+
+    m_lock.lock();
+    auto it = m_stmt_cache.find(sql);
+    if (it != m_stmt_cache.end()) {
+        stmt = it->second->second;
+        m_stmts.erase(it->second);
+        m_stmt_cache.erase(it);
+    }
+    m_lock.unlock();
 
-    if (ac->isSync())
-        return CHECK_ERROR(CALL_E_LONGSYNC);
+    return stmt;
+}
 
-    const char* pStr = sql.c_str();
-    int32_t sLen = (int32_t)sql.length();
-    const char* pStr1;
+void SQLite::put_stmt(const exlib::string& sql, sqlite3_stmt* stmt)
+{
+    std::vector<sqlite3_stmt*> drops;
 
-    do {
-        sqlite3_stmt* stmt = 0;
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
 
-        if (sqlite3_prepare_sleep((sqlite3*)m_conn, pStr, sLen, &stmt, &pStr1, m_nCmdTimeout)) {
-            result_t hr = CHECK_ERROR(Runtime::setError(sqlite3_errmsg((sqlite3*)m_conn)));
-            if (stmt)
-                sqlite3_finalize(stmt);
-            return hr;
-        }
+    m_lock.lock();
+    m_stmts.push_front(std::make_pair(sql, stmt));
+    m_stmt_cache.insert(std::make_pair(sql, m_stmts.begin()));
 
-        if (!stmt)
-            return CHECK_ERROR(Runtime::setError("SQLite: Query was empty"));
+    while (m_stmts.size() > SQLITE_STMT_CACHE_SIZE) {
+        auto last = std::prev(m_stmts.end());
+        auto range = m_stmt_cache.equal_range(last->first);
 
-        sLen -= (int32_t)(pStr1 - pStr);
+        for (auto it = range.first; it != range.second; ++it)
+            if (it->second == last) {
+                m_stmt_cache.erase(it);
+                break;
+            }
 
-        int32_t columns = sqlite3_column_count(stmt);
-        obj_ptr<DBResult> res;
+        drops.push_back(last->second);
+        m_stmts.erase(last);
+    }
+    m_lock.unlock();
 
-        if (columns > 0) {
-            int32_t i;
-            res = new DBResult(columns);
+    for (size_t i = 0; i < drops.size(); i++)
+        sqlite3_finalize(drops[i]);
+}
 
-            for (i = 0; i < columns; i++) {
-                exlib::string s = sqlite3_column_name(stmt, i);
-                res->setField(i, s);
-            }
+void SQLite::clear_stmts()
+{
+    m_lock.lock();
+    for (auto it = m_stmts.begin(); it != m_stmts.end(); ++it)
+        sqlite3_finalize(it->second);
+    m_stmts.clear();
+    m_stmt_cache.clear();
+    m_lock.unlock();
+}
 
-            while (true) {
-                int32_t r = sqlite3_step_sleep(stmt, m_nCmdTimeout);
-                if (r == SQLITE_ROW) {
-                    res->beginRow();
-                    for (i = 0; i < columns; i++) {
-                        Variant v;
+// binds the parameters of stmt from params, returns how many were used.
+// without params nothing is bound, the statement runs with NULL parameters.
+result_t SQLite::bind(sqlite3_stmt* stmt, const Variant* params, int32_t count)
+{
+    if (!params)
+        return 0;
+
+    int32_t n = sqlite3_bind_parameter_count(stmt);
+    int32_t r = SQLITE_OK;
+
+    if (n > count)
+        return CHECK_ERROR(Runtime::setError("SQLite: the number of arguments does not match the number of parameters."));
+
+    for (int32_t i = 0; i < n && r == SQLITE_OK; i++) {
+        const Variant& v = params[i];
+
+        switch (v.type()) {
+        case Variant::VT_Undefined:
+        case Variant::VT_Null:
+            r = sqlite3_bind_null(stmt, i + 1);
+            break;
+        case Variant::VT_Integer:
+        case Variant::VT_Long:
+            r = sqlite3_bind_int64(stmt, i + 1, v.longVal());
+            break;
+        case Variant::VT_Number:
+            r = sqlite3_bind_double(stmt, i + 1, v.dblVal());
+            break;
+        case Variant::VT_Object: {
+            Buffer* buf = (Buffer*)v.object();
+            r = sqlite3_bind_blob(stmt, i + 1, buf->data(), (int32_t)buf->length(), SQLITE_TRANSIENT);
+            break;
+        }
+        default: {
+            exlib::string str = v.string();
+            r = sqlite3_bind_text(stmt, i + 1, str.c_str(), (int32_t)str.length(), SQLITE_TRANSIENT);
+            break;
+        }
+        }
+    }
 
-                        switch (sqlite3_column_type(stmt, i)) {
-                        case SQLITE_NULL:
-                            v.setNull();
-                            break;
+    if (r != SQLITE_OK)
+        return CHECK_ERROR(Runtime::setError(sqlite3_errmsg((sqlite3*)m_conn)));
 
-                        case SQLITE_INTEGER:
-                            v = (double)sqlite3_column_int64(stmt, i);
-                            break;
+    return n;
+}
+
+result_t SQLite::step(sqlite3_stmt* stmt, obj_ptr<DBResult>& res)
+{
+    int32_t columns = sqlite3_column_count(stmt);
 
-                        case SQLITE_FLOAT:
-                            v = sqlite3_column_double(stmt, i);
-                            break;
+    if (columns > 0) {
+        int32_t i;
+        res = new DBResult(columns);
+
+        for (i = 0; i < columns; i++) {
+            exlib::string s = sqlite3_column_name(stmt, i);
+            res->setField(i, s);
+        }
 
-                        case SQLITE_BLOB: {
+        while (true) {
+            int32_t r = sqlite3_step_sleep(stmt, m_nCmdTimeout);
+            if (r == SQLITE_ROW) {
+                res->beginRow();
+                for (i = 0; i < columns; i++) {
+                    Variant v;
+
+                    switch (sqlite3_column_type(stmt, i)) {
+                    case SQLITE_NULL:
+                        v.setNull();
+                        break;
+
+                    case SQLITE_INTEGER:
+                        v = (double)sqlite3_column_int64(stmt, i);
+                        break;
+
+                    case SQLITE_FLOAT:
+                        v = sqlite3_column_double(stmt, i);
+                        break;
+
+                    case SQLITE_BLOB: {
+                        const char* data = (const char*)sqlite3_column_blob(stmt, i);
+                        int32_t size = sqlite3_column_bytes(stmt, i);
+
+                        v = new Buffer(data, size);
+                        break;
+                    }
+
+                    default:
+                        const char* type = sqlite3_column_decltype(stmt, i);
+                        if (type
+                            && (!qstricmp(type, "blob", 4)
+                                || !qstricmp(type, "tinyblob", 8)
+                                || !qstricmp(type, "mediumblob", 10)
+                                || !qstricmp(type, "longblob", 8)
+                                || !qstricmp(type, "binary", 6)
+                                || !qstricmp(type, "varbinary", 9))) {
                             const char* data = (const char*)sqlite3_column_blob(stmt, i);
                             int32_t size = sqlite3_column_bytes(stmt, i);
 
                             v = new Buffer(data, size);
-                            break;
-                        }
+                        } else if (type
+                            && (!qstricmp(type, "datetime")
+                                || !qstricmp(type, "timestamp")
+                                || !qstricmp(type, "date")
+                                || !qstricmp(type, "time"))) {
+                            const char* data = (const char*)sqlite3_column_text(stmt, i);
+                            int32_t size = sqlite3_column_bytes(stmt, i);
 
-                        default:
-                            const char* type = sqlite3_column_decltype(stmt, i);
-                            if (type
-                                && (!qstricmp(type, "blob", 4)
-                                       || !qstricmp(type, "tinyblob", 8)
-                                       || !qstricmp(type, "mediumblob", 10)
-                                       || !qstricmp(type, "longblob", 8)
-                                       || !qstricmp(type, "binary", 6)
-                                       || !qstricmp(type, "varbinary", 9))) {
-                                const char* data = (const char*)sqlite3_column_blob(stmt, i);
-                                int32_t size = sqlite3_column_bytes(stmt, i);
-
-                                v = new Buffer(data, size);
-                            } else if (type
-                                && (!qstricmp(type, "datetime")
-                                       || !qstricmp(type, "timestamp")
-                                       || !qstricmp(type, "date")
-                                       || !qstricmp(type, "time"))) {
-                                const char* data = (const char*)sqlite3_column_text(stmt, i);
-                                int32_t size = sqlite3_column_bytes(stmt, i);
-
-                                v.parseDate(data, size);
-                            } else {
-                                const char* data = (const char*)sqlite3_column_text(stmt, i);
-                                int32_t size = sqlite3_column_bytes(stmt, i);
-
-                                v = exlib::string(data, size);
-                            }
-                            break;
-                        }
+                            v.parseDate(data, size);
+                        } else {
+                            const char* data = (const char*)sqlite3_column_text(stmt, i);
+                            int32_t size = sqlite3_column_bytes(stmt, i);
 
-                        res->rowValue(i, v);
+                            v = exlib::string(data, size);
+                        }
+                        break;
                     }
-                    res->endRow();
-                } else if (r == SQLITE_DONE)
-                    break;
-                else {
-                    sqlite3_finalize(stmt);
-                    return CHECK_ERROR(Runtime::setError(sqlite3_errmsg((sqlite3*)m_conn)));
+
+                    res->rowValue(i, v);
                 }
-            }
-        } else {
-            int32_t r = sqlite3_step_sleep(stmt, m_nCmdTimeout);
-            if (r == SQLITE_DONE)
-                res = new DBResult(0, sqlite3_changes((sqlite3*)m_conn),
-                    sqlite3_last_insert_rowid((sqlite3*)m_conn));
-            else {
-                sqlite3_finalize(stmt);
+                res->endRow();
+            } else if (r == SQLITE_DONE)
+                break;
+            else
                 return CHECK_ERROR(Runtime::setError(sqlite3_errmsg((sqlite3*)m_conn)));
-            }
         }
+    } else {
+        int32_t r = sqlite3_step_sleep(stmt, m_nCmdTimeout);
+        if (r == SQLITE_DONE)
+            res = new DBResult(0, sqlite3_changes((sqlite3*)m_conn),
+                sqlite3_last_insert_rowid((sqlite3*)m_conn));
+        else
+            return CHECK_ERROR(Runtime::setError(sqlite3_errmsg((sqlite3*)m_conn)));
+    }
 
-        sqlite3_finalize(stmt);
+    return 0;
+}
+
+result_t SQLite::execute(exlib::string& sql, const Variant* params, int32_t count,
+    obj_ptr<NArray>& retVal)
+{
+    sqlite3_stmt* stmt = get_stmt(sql);
+
+    if (stmt) {
+        // a cached statement is always the whole sql text.
+        obj_ptr<DBResult> res;
+        result_t hr = bind(stmt, params, count);
+        if (hr >= 0 && params && hr != count)
+            hr = CHECK_ERROR(Runtime::setError("SQLite: the number of arguments does not match the number of parameters."));
+        if (hr >= 0)
+            hr = step(stmt, res);
+
+        if (hr < 0) {
+            sqlite3_finalize(stmt);
+            return hr;
+        }
+
+        put_stmt(sql, stmt);
+        retVal = res;
+
+        return 0;
+    }
+
+    const char* pStr = sql.c_str();
+    int32_t sLen = (int32_t)sql.length();
+    const char* pStr1;
+    int32_t used = 0;
+
+    do {
+        if (sqlite3_prepare_sleep((sqlite3*)m_conn, pStr, sLen, &stmt, &pStr1, m_nCmdTimeout)) {
+            result_t hr = CHECK_ERROR(Runtime::setError(sqlite3_errmsg((sqlite3*)m_conn)));
+            if (stmt)
+                sqlite3_finalize(stmt);
+            return hr;
+        }
+
+        if (!stmt)
+            return CHECK_ERROR(Runtime::setError("SQLite: Query was empty"));
+
+        sLen -= (int32_t)(pStr1 - pStr);
 
         while (qisspace(*pStr1)) {
             pStr1++;
             sLen--;
         }
 
+        // each statement takes its parameters in turn, the last one must use up the rest.
+        obj_ptr<DBResult> res;
+        result_t hr = bind(stmt, params ? params + used : NULL, count - used);
+        if (hr >= 0) {
+            used += hr;
+            if (params && !*pStr1 && used != count)
+                hr = CHECK_ERROR(Runtime::setError("SQLite: the number of arguments does not match the number of parameters."));
+        }
+        if (hr >= 0)
+            hr = step(stmt, res);
+
+        if (hr < 0) {
+            sqlite3_finalize(stmt);
+            return hr;
+        }
+
         if (!*pStr1 && retVal == NULL) {
+            put_stmt(sql, stmt);
             retVal = res;
         } else {
+            sqlite3_finalize(stmt);
+
             if (retVal == NULL)
                 retVal = new NArray();
 
@@ -269,6 +411,182 @@ result_t SQLite::execute(exlib::string sql, obj_ptr<NArray>& retVal, AsyncEvent*
     return 0;
 }
 
+result_t SQLite::execute(exlib::string sql, obj_ptr<NArray>& retVal, AsyncEvent* ac)
+{
+    if (!m_conn)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_LONGSYNC);
+
+    return execute(sql, NULL, 0, retVal);
+}
+
+// returns the end of the quoted literal, identifier or comment at p, or p when there is none.
+static const char* skip_literal(const char* p)
+{
+    char end;
+
+    switch (*p) {
+    case '\'':
+    case '"':
+    case '`':
+        end = *p;
+        break;
+    case '[':
+        end = ']';
+        break;
+    case '-':
+        if (p[1] != '-')
+            return p;
+        while (*p && *p != '\n')
+            p++;
+        return p;
+    case '/':
+        if (p[1] != '*')
+            return p;
+        p += 2;
+        while (*p && (p[0] != '*' || p[1] != '/'))
+            p++;
+        return *p ? p + 2 : p;
+    default:
+        return p;
+    }
+
+    for (p++; *p; p++)
+        if (*p == end) {
+            if (end != ']' && p[1] == end)
+                p++;
+            else
+                return p + 1;
+        }
+
+    return p;
+}
+
+// converts an argument for sqlite3_bind_*, an array becomes (?,?,...) in sql and binds its items.
+static result_t to_param(Isolate* isolate, v8::Local<v8::Value> v, std::vector<Variant>& params,
+    exlib::string* sql)
+{
+    if (v->IsFunction())
+        return CHECK_ERROR(CALL_E_INVALIDARG);
+
+    if (v->IsArray()) {
+        if (!sql)
+            return CHECK_ERROR(CALL_E_INVALIDARG);
+
+        v8::Local<v8::Array> a = v8::Local<v8::Array>::Cast(v);
+        v8::Local<v8::Context> context = isolate->context();
+        int32_t len = a->Length();
+
+        sql->append(1, '(');
+        for (int32_t i = 0; i < len; i++) {
+            JSValue v1 = a->Get(context, i);
+
+            if (i > 0)
+                sql->append(1, ',');
+            if (!v1->IsArray())
+                sql->append(1, '?');
+
+            result_t hr = to_param(isolate, v1, params, sql);
+            if (hr < 0)
+                return hr;
+        }
+        sql->append(1, ')');
+
+        return 0;
+    }
+
+    Variant var;
+
+    if (IsJSBuffer(v)) {
+        obj_ptr<Buffer> buf = Buffer::getInstance(v);
+        var = buf;
+    } else if (v->IsBigInt() || v->IsBigIntObject()) {
+        int64_t n;
+        result_t hr = GetArgumentValue(isolate, v, n);
+        if (hr < 0)
+            return hr;
+        var = n;
+    } else if (v->IsNumber() || v->IsNumberObject()) {
+        double n;
+        result_t hr = GetArgumentValue(isolate, v, n);
+        if (hr < 0)
+            return hr;
+
+        if (n == (double)(int64_t)n && n > -9007199254740992.0 && n < 9007199254740992.0)
+            var = (int64_t)n;
+        else
+            var = n;
+    } else if (v->IsUndefined() || v->IsNull())
+        var.setNull();
+    else if (v->IsDate()) {
+        exlib::string s;
+        date_t d = v;
+
+        d.sqlString(s);
+        var = s;
+    } else
+        var = isolate->toString(v);
+
+    params.push_back(var);
+    return 0;
+}
+
+result_t SQLite::execute(exlib::string sql, OptArgs args, obj_ptr<NArray>& retVal,
+    AsyncEvent* ac)
+{
+    if (!m_conn)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    if (ac->isSync()) {
+        Isolate* isolate = Isolate::current();
+        int32_t argc = args.Length();
+        exlib::string str;
+        const char* p = sql.c_str();
+        int32_t used = 0;
+        result_t hr;
+
+        ac->m_ctx.resize(1);
+
+        // an array argument expands to a list of placeholders at its own ?, a ? in a literal is not one.
+        while (*p) {
+            const char* p1 = skip_literal(p);
+            if (p1 != p) {
+                str.append(p, p1 - p);
+                p = p1;
+            } else if (*p == '?' && !qisdigit(p[1]) && used < argc) {
+                if (args[used]->IsArray()) {
+                    hr = to_param(isolate, args[used++], ac->m_ctx, &str);
+                    if (hr < 0)
+                        return hr;
+                } else {
+                    hr = to_param(isolate, args[used++], ac->m_ctx, NULL);
+                    if (hr < 0)
+                        return hr;
+                    str.append(1, '?');
+                }
+                p++;
+            } else
+                str.append(1, *p++);
+        }
+
+        // named or numbered parameters take the rest in order
+        while (used < argc) {
+            hr = to_param(isolate, args[used++], ac->m_ctx, NULL);
+            if (hr < 0)
+                return hr;
+        }
+
+        ac->m_ctx[0] = str;
+
+        return CHECK_ERROR(CALL_E_LONGSYNC);
+    }
+
+    exlib::string str = ac->m_ctx[0].string();
+    return execute(str, ac->m_ctx.data() + 1, (int32_t)ac->m_ctx.size() - 1, retVal);
+}
+
 result_t SQLite::get_fileName(exlib::string& retVal)
 {
     if (!m_conn)
@@ -10,6 +10,9 @@
 #include "ifs/SQLite.h"
 #include <sqlite/sqlite3.h>
 #include "../db_tmpl.h"
+#include "DBResult.h"
+#include <unordered_map>
+#include <list>
 
 namespace fibjs {
 
@@ -27,6 +30,7 @@ public:
     virtual result_t get_type(exlib::string& retVal);
     virtual result_t close(AsyncEvent* ac);
     virtual result_t execute(exlib::string sql, obj_ptr<NArray>& retVal, AsyncEvent* ac);
+    virtual result_t execute(exlib::string sql, OptArgs args, obj_ptr<NArray>& retVal, AsyncEvent* ac);
 
 public:
     // SQLite_base
@@ -39,9 +43,22 @@ public:
     result_t open(const char* file);
     int vec_init();
 
+private:
+    result_t execute(exlib::string& sql, const Variant* params, int32_t count, obj_ptr<NArray>& retVal);
+    result_t step(sqlite3_stmt* stmt, obj_ptr<DBResult>& retVal);
+    result_t bind(sqlite3_stmt* stmt, const Variant* params, int32_t count);
+
+    sqlite3_stmt* get_stmt(const exlib::string& sql);
+    void put_stmt(const exlib::string& sql, sqlite3_stmt* stmt);
+    void clear_stmts();
+
 private:
     exlib::string m_file;
     int32_t m_nCmdTimeout;
+
+    exlib::spinlock m_lock;
+    std::list<std::pair<exlib::string, sqlite3_stmt*>> m_stmts;
+    std::unordered_multimap<exlib::string, std::list<std::pair<exlib::string, sqlite3_stmt*>>::iterator> m_stmt_cache;
 };
 
 } /* namespace fibjs */
@@ -10,8 +10,12 @@
 #include "SQLite.h"
 #include "hnswlib/hnswlib.h"
 #include "hnswlib/bruteforce.h"
+#include "hnswlib/hnswalg.h"
 #include <string>
 #include <vector>
+#include <set>
+#include <map>
+#include <algorithm>
 
 #include <nlohmann/json.hpp>
 
@@ -28,11 +32,155 @@ namespace fibjs {
 
 #define VEC_INDEX_BLOCK_SIZE 4096
 
+#define VEC_HNSW_MAGIC 0x57534e48
+#define VEC_HNSW_PAGE_SIZE 256
+#define VEC_HNSW_SUFFIX ":hnsw"
+#define VEC_FLOAT_SUFFIX ":float"
+#define VEC_FLOAT_PAGE_BYTES 65536
+
+enum VecQuantize {
+    none,
+    int8,
+    binary
+};
+
 static void vec_version(sqlite3_context* context, int argc, sqlite3_value** argv)
 {
     sqlite3_result_text(context, SQLITE_VEC_VERSION, -1, SQLITE_STATIC);
 }
 
+class VecIndexOptions {
+public:
+    bool hnsw = false;
+    size_t M = 16;
+    size_t efConstruction = 200;
+    size_t efSearch = 64;
+    VecQuantize quantize = VecQuantize::none;
+    size_t rerank = 0;
+};
+
+/*
+ * int8 vectors are normalized floats scaled by 127, so the dot product of two
+ * rows divided by 127 * 127 approximates the float inner product. the loops are
+ * kept simple enough for the compiler to vectorize them.
+ */
+class Int8Space : public hnswlib::SpaceInterface<float> {
+public:
+    Int8Space(size_t dim)
+        : dim_(dim)
+    {
+    }
+
+public:
+    static void encode(const float* v, size_t dim, void* out)
+    {
+        int8_t* q = (int8_t*)out;
+
+        for (size_t i = 0; i < dim; i++) {
+            float f = v[i] * 127.0f;
+            q[i] = (int8_t)(f > 127.0f ? 127 : f < -127.0f ? -127 : lrintf(f));
+        }
+    }
+
+    static float distance(const void* a, const void* b, const void* param)
+    {
+        const int8_t* x = (const int8_t*)a;
+        const int8_t* y = (const int8_t*)b;
+        size_t dim = *(const size_t*)param;
+        int32_t sum = 0;
+
+        for (size_t i = 0; i < dim; i++)
+            sum += (int32_t)x[i] * (int32_t)y[i];
+
+        return 1.0f - (float)sum * (1.0f / (127.0f * 127.0f));
+    }
+
+public:
+    virtual size_t get_data_size()
+    {
+        return dim_;
+    }
+
+    virtual hnswlib::DISTFUNC<float> get_dist_func()
+    {
+        return distance;
+    }
+
+    virtual void* get_dist_func_param()
+    {
+        return &dim_;
+    }
+
+private:
+    size_t dim_;
+};
+
+/*
+ * binary vectors keep one sign bit per dimension. the distance is the hamming
+ * distance scaled to [0, 2], the same range as the float inner product distance.
+ */
+class BinarySpace : public hnswlib::SpaceInterface<float> {
+public:
+    BinarySpace(size_t dim)
+    {
+        param_[0] = dim;
+        param_[1] = (dim + 7) / 8;
+    }
+
+public:
+    static void encode(const float* v, size_t dim, void* out)
+    {
+        uint8_t* q = (uint8_t*)out;
+
+        memset(q, 0, (dim + 7) / 8);
+        for (size_t i = 0; i < dim; i++)
+            if (v[i] > 0)
+                q[i >> 3] |= (uint8_t)(1 << (i & 7));
+    }
+
+    static float distance(const void* a, const void* b, const void* param)
+    {
+        const uint8_t* x = (const uint8_t*)a;
+        const uint8_t* y = (const uint8_t*)b;
+        size_t dim = ((const size_t*)param)[0];
+        size_t bytes = ((const size_t*)param)[1];
+        size_t bits = 0;
+        size_t i;
+
+        for (i = 0; i + 8 <= bytes; i += 8) {
+            uint64_t u, v;
+
+            memcpy(&u, x + i, 8);
+            memcpy(&v, y + i, 8);
+            bits += __builtin_popcountll(u ^ v);
+        }
+
+        for (; i < bytes; i++)
+            bits += __builtin_popcount(x[i] ^ y[i]);
+
+        return 2.0f * bits / dim;
+    }
+
+public:
+    virtual size_t get_data_size()
+    {
+        return param_[1];
+    }
+
+    virtual hnswlib::DISTFUNC<float> get_dist_func()
+    {
+        return distance;
+    }
+
+    virtual void* get_dist_func_param()
+    {
+        return param_;
+    }
+
+private:
+    size_t param_[2];
+};
+
 class VecColumn : public hnswlib::BruteforceSearch<float> {
 public:
     VecColumn()
@@ -42,16 +190,25 @@ public:
 
     ~VecColumn()
     {
+        if (hnsw)
+            delete hnsw;
         if (space)
             delete space;
     }
 
 public:
-    int init(std::string _name, size_t dim)
+    int init(std::string _name, size_t dim, const VecIndexOptions& opts)
     {
         name = _name;
+        options = opts;
+        dimensions = dim;
 
-        space = new hnswlib::InnerProductSpace(dim);
+        if (options.quantize == VecQuantize::int8)
+            space = new Int8Space(dim);
+        else if (options.quantize == VecQuantize::binary)
+            space = new BinarySpace(dim);
+        else
+            space = new hnswlib::InnerProductSpace(dim);
         data_size_ = space->get_data_size();
         fstdistfunc_ = space->get_dist_func();
         dist_func_param_ = space->get_dist_func_param();
@@ -61,6 +218,9 @@ public:
         data_ = nullptr;
         cur_element_count = 0;
 
+        if (options.hnsw)
+            return reset_graph();
+
         return SQLITE_OK;
     }
 
@@ -81,27 +241,298 @@ public:
 
     size_t dim() const
     {
-        return data_size_ / sizeof(float);
+        return dimensions;
     }
 
-    void addPoint(const void* datapoint, hnswlib::labeltype label, bool replace_deleted = false)
+    const void* encode(const float* v, std::vector<char>& buf) const
     {
+        if (options.quantize == VecQuantize::none)
+            return v;
+
+        buf.resize(data_size_);
+        if (options.quantize == VecQuantize::int8)
+            Int8Space::encode(v, dimensions, buf.data());
+        else
+            BinarySpace::encode(v, dimensions, buf.data());
+
+        return buf.data();
+    }
+
+    int putPoint(const float* vec, hnswlib::labeltype label)
+    {
+        std::vector<char> buf;
+        const void* datapoint = encode(vec, buf);
+
         if (cur_element_count == maxelements_) {
             maxelements_ += VEC_INDEX_BLOCK_SIZE;
             data_ = (char*)realloc(data_, maxelements_ * size_per_element_);
         }
 
-        hnswlib::BruteforceSearch<float>::addPoint(datapoint, label, replace_deleted);
+        hnswlib::BruteforceSearch<float>::addPoint(datapoint, label);
+
+        if (hnsw)
+            return add_graph_point(datapoint, label);
+
+        return SQLITE_OK;
     }
 
-    void removePoint(hnswlib::labeltype cur_external)
+    int erasePoint(hnswlib::labeltype cur_external)
     {
-        size_t cur_c = dict_external_to_internal[cur_external];
-
-        dict_external_to_internal.erase(cur_external);
-        memcpy(data_ + size_per_element_ * cur_c,
-            data_ + size_per_element_ * (cur_element_count - 1), size_per_element_);
+        auto it = dict_external_to_internal.find(cur_external);
+        if (it == dict_external_to_internal.end())
+            return SQLITE_OK;
+
+        size_t cur_c = it->second;
+        hnswlib::labeltype last = rowid(cur_element_count - 1);
+
+        dict_external_to_internal.erase(it);
+        if (cur_c != cur_element_count - 1) {
+            memcpy(data_ + size_per_element_ * cur_c,
+                data_ + size_per_element_ * (cur_element_count - 1), size_per_element_);
+            dict_external_to_internal[last] = cur_c;
+        }
         cur_element_count--;
+
+        if (hnsw) {
+            auto it = hnsw->label_lookup_.find(cur_external);
+            if (it != hnsw->label_lookup_.end() && !hnsw->isMarkedDeleted(it->second)) {
+                hnsw->markDelete(cur_external);
+                graph_dirty.insert(it->second);
+            }
+        }
+
+        return SQLITE_OK;
+    }
+
+public:
+    int reset_graph()
+    {
+        if (hnsw) {
+            delete hnsw;
+            hnsw = nullptr;
+        }
+
+        graph_dirty.clear();
+        graph_full = true;
+
+        try {
+            hnsw = new hnswlib::HierarchicalNSW<float>(space, 1, options.M, options.efConstruction, 100, true);
+        } catch (std::exception&) {
+            return SQLITE_NOMEM;
+        }
+
+        return SQLITE_OK;
+    }
+
+    // marks a node and its neighbors on every level, their link lists are what an insert or update rewrites
+    void touch_graph_node(hnswlib::tableint id)
+    {
+        graph_dirty.insert(id);
+
+        for (int32_t level = 0; level <= hnsw->element_levels_[id]; level++) {
+            hnswlib::linklistsizeint* ll = hnsw->get_linklist_at_level(id, level);
+            hnswlib::tableint* links = (hnswlib::tableint*)(ll + 1);
+            size_t size = hnsw->getListCount(ll);
+
+            for (size_t i = 0; i < size; i++)
+                graph_dirty.insert(links[i]);
+        }
+    }
+
+    int add_graph_point(const void* datapoint, hnswlib::labeltype label)
+    {
+        try {
+            auto it = hnsw->label_lookup_.find(label);
+            if (it != hnsw->label_lookup_.end()) {
+                // update in place, a deleted slot must be revived first
+                touch_graph_node(it->second);
+                if (hnsw->isMarkedDeleted(it->second))
+                    hnsw->unmarkDelete(label);
+                hnsw->addPoint(datapoint, label, false);
+                touch_graph_node(it->second);
+                return SQLITE_OK;
+            }
+
+            // addPoint reuses the first deleted slot, its old neighbors are rewired too
+            if (hnsw->getDeletedCount() > 0)
+                touch_graph_node(*hnsw->deleted_elements.begin());
+            else if (hnsw->cur_element_count == hnsw->max_elements_)
+                hnsw->resizeIndex((hnsw->cur_element_count + VEC_INDEX_BLOCK_SIZE) / VEC_INDEX_BLOCK_SIZE * VEC_INDEX_BLOCK_SIZE);
+
+            hnsw->addPoint(datapoint, label, true);
+            touch_graph_node(hnsw->label_lookup_[label]);
+        } catch (std::exception&) {
+            return SQLITE_NOMEM;
+        }
+
+        return SQLITE_OK;
+    }
+
+    int build_graph()
+    {
+        int rc = reset_graph();
+        if (rc != SQLITE_OK)
+            return rc;
+
+        for (size_t i = 0; i < cur_element_count; i++) {
+            rc = add_graph_point(data_ + size_per_element_ * i, rowid(i));
+            if (rc != SQLITE_OK)
+                return rc;
+        }
+
+        return SQLITE_OK;
+    }
+
+    struct graph_header {
+        uint32_t magic;
+        uint32_t dim;
+        uint32_t M;
+        uint32_t count;
+        int32_t maxlevel;
+        uint32_t enterpoint;
+    };
+
+    /*
+     * graph layout: graph_header, then for every internal node its label, level,
+     * level 0 links and upper links. vectors are not duplicated here, they are
+     * restored from the block storage by label when the graph is loaded.
+     * the header and every VEC_HNSW_PAGE_SIZE nodes are stored in their own row,
+     * so a commit only rewrites the pages holding nodes it touched.
+     */
+    void save_graph_header(std::string& out) const
+    {
+        graph_header hdr;
+
+        hdr.magic = VEC_HNSW_MAGIC;
+        hdr.dim = (uint32_t)dim();
+        hdr.M = (uint32_t)hnsw->M_;
+        hdr.count = (uint32_t)hnsw->cur_element_count;
+        hdr.maxlevel = hnsw->maxlevel_;
+        hdr.enterpoint = hnsw->enterpoint_node_;
+
+        out.assign((const char*)&hdr, sizeof(hdr));
+    }
+
+    size_t graph_pages() const
+    {
+        return (hnsw->cur_element_count + VEC_HNSW_PAGE_SIZE - 1) / VEC_HNSW_PAGE_SIZE;
+    }
+
+    void save_graph_page(size_t page, std::string& out) const
+    {
+        size_t end = (page + 1) * VEC_HNSW_PAGE_SIZE;
+
+        if (end > hnsw->cur_element_count)
+            end = hnsw->cur_element_count;
+
+        out.clear();
+        for (size_t i = page * VEC_HNSW_PAGE_SIZE; i < end; i++) {
+            hnswlib::labeltype label = hnsw->getExternalLabel((hnswlib::tableint)i);
+            int32_t level = hnsw->element_levels_[i];
+
+            out.append((const char*)&label, sizeof(label));
+            out.append((const char*)&level, sizeof(level));
+            out.append((const char*)hnsw->get_linklist0((hnswlib::tableint)i), hnsw->size_links_level0_);
+            if (level > 0)
+                out.append(hnsw->linkLists_[i], hnsw->size_links_per_element_ * level);
+        }
+    }
+
+    // the pages to write on the next sync, all of them after the graph was rebuilt
+    void dirty_graph_pages(std::set<size_t>& pages) const
+    {
+        if (graph_full) {
+            for (size_t i = 0; i < graph_pages(); i++)
+                pages.insert(i);
+        } else
+            for (auto id : graph_dirty)
+                pages.insert(id / VEC_HNSW_PAGE_SIZE);
+    }
+
+    void graph_saved()
+    {
+        graph_dirty.clear();
+        graph_full = false;
+    }
+
+    int load_graph(const void* data, size_t size)
+    {
+        const char* p = (const char*)data;
+        const char* end = p + size;
+        graph_header hdr;
+
+        if (size < sizeof(hdr))
+            return build_graph();
+
+        memcpy(&hdr, p, sizeof(hdr));
+        p += sizeof(hdr);
+
+        if (hdr.magic != VEC_HNSW_MAGIC || hdr.dim != dim() || hdr.M != options.M
+            || hdr.count < cur_element_count)
+            return build_graph();
+
+        int rc = reset_graph();
+        if (rc != SQLITE_OK)
+            return rc;
+
+        try {
+            if (hdr.count > hnsw->max_elements_)
+                hnsw->resizeIndex((hdr.count + VEC_INDEX_BLOCK_SIZE - 1) / VEC_INDEX_BLOCK_SIZE * VEC_INDEX_BLOCK_SIZE);
+        } catch (std::exception&) {
+            return SQLITE_NOMEM;
+        }
+
+        for (uint32_t i = 0; i < hdr.count; i++) {
+            hnswlib::labeltype label;
+            int32_t level;
+
+            if (end - p < (ptrdiff_t)(sizeof(label) + sizeof(level) + hnsw->size_links_level0_))
+                return build_graph();
+
+            memcpy(&label, p, sizeof(label));
+            p += sizeof(label);
+            memcpy(&level, p, sizeof(level));
+            p += sizeof(level);
+
+            if (level < 0 || level > hdr.maxlevel
+                || end - p < (ptrdiff_t)(hnsw->size_links_level0_ + hnsw->size_links_per_element_ * level))
+                return build_graph();
+
+            memcpy(hnsw->get_linklist0(i), p, hnsw->size_links_level0_);
+            p += hnsw->size_links_level0_;
+
+            hnsw->element_levels_[i] = level;
+            if (level > 0) {
+                hnsw->linkLists_[i] = (char*)malloc(hnsw->size_links_per_element_ * level);
+                if (hnsw->linkLists_[i] == nullptr)
+                    return SQLITE_NOMEM;
+                memcpy(hnsw->linkLists_[i], p, hnsw->size_links_per_element_ * level);
+                p += hnsw->size_links_per_element_ * level;
+            }
+
+            hnsw->setExternalLabel(i, label);
+            hnsw->label_lookup_[label] = i;
+            hnsw->cur_element_count = i + 1;
+
+            auto it = dict_external_to_internal.find(label);
+            if (hnsw->isMarkedDeleted(i)) {
+                memset(hnsw->getDataByInternalId(i), 0, data_size_);
+                hnsw->num_deleted_ += 1;
+                hnsw->deleted_elements.insert(i);
+            } else if (it != dict_external_to_internal.end())
+                memcpy(hnsw->getDataByInternalId(i), data_ + size_per_element_ * it->second, data_size_);
+            else
+                return build_graph();
+        }
+
+        hnsw->maxlevel_ = hdr.maxlevel;
+        hnsw->enterpoint_node_ = hdr.enterpoint;
+
+        if (hnsw->cur_element_count - hnsw->getDeletedCount() != cur_element_count)
+            return build_graph();
+
+        graph_saved();
+        return SQLITE_OK;
     }
 
     static bool appendResult(std::priority_queue<std::pair<float, hnswlib::labeltype>>& topResults, size_t k,
@@ -139,10 +570,18 @@ public:
         return 0;
     }
 
-    std::priority_queue<std::pair<float, hnswlib::labeltype>> search(const void* query_data, size_t k) const
+    std::priority_queue<std::pair<float, hnswlib::labeltype>> search(const float* query, size_t k) const
     {
         assert(k <= cur_element_count);
 
+        std::vector<char> buf;
+        const void* query_data = encode(query, buf);
+
+        if (hnsw) {
+            hnsw->setEf(k > options.efSearch ? k : options.efSearch);
+            return hnsw->searchKnn(query_data, k);
+        }
+
         int32_t cpus = 0;
         os_base::cpuNumbers(cpus);
 
@@ -198,7 +637,14 @@ public:
 
 public:
     std::string name;
-    hnswlib::InnerProductSpace* space = nullptr;
+    size_t dimensions = 0;
+    VecIndexOptions options;
+    hnswlib::SpaceInterface<float>* space = nullptr;
+    hnswlib::HierarchicalNSW<float>* hnsw = nullptr;
+
+    // internal ids whose graph record changed since the graph was loaded or saved
+    std::set<hnswlib::tableint> graph_dirty;
+    bool graph_full = true;
 };
 
 class VecIndexColumn {
@@ -216,9 +662,10 @@ public:
     };
 
 public:
-    VecIndex(sqlite3* db, const char* _name, std::vector<VecIndexColumn>& _columns)
+    VecIndex(sqlite3* db, const char* _name, std::vector<VecIndexColumn>& _columns, const VecIndexOptions& options)
         : db(db)
         , name(_name)
+        , options(options)
     {
         memset(this, 0, sizeof(sqlite3_vtab));
 
@@ -226,7 +673,7 @@ public:
         columns = new VecColumn[indexCount];
 
         for (int i = 0; i < indexCount; i++)
-            columns[i].init(_columns[i].name, _columns[i].dimensions);
+            columns[i].init(_columns[i].name, _columns[i].dimensions, options);
     }
 
     ~VecIndex()
@@ -255,6 +702,24 @@ public:
             sqlite3_free((void*)zQuery);
             if (rc != SQLITE_OK)
                 return rc;
+
+            if (options.hnsw) {
+                zQuery = sqlite3_mprintf("INSERT INTO vec_index(tbl, name) VALUES (\"%w\", \"%w" VEC_HNSW_SUFFIX "\")",
+                    name.c_str(), columns[i].name.c_str());
+                rc = sqlite3_exec(db, zQuery, 0, 0, 0);
+                sqlite3_free((void*)zQuery);
+                if (rc != SQLITE_OK)
+                    return rc;
+            }
+
+            if (options.rerank) {
+                zQuery = sqlite3_mprintf("INSERT INTO vec_index(tbl, name) VALUES (\"%w\", \"%w" VEC_FLOAT_SUFFIX "\")",
+                    name.c_str(), columns[i].name.c_str());
+                rc = sqlite3_exec(db, zQuery, 0, 0, 0);
+                sqlite3_free((void*)zQuery);
+                if (rc != SQLITE_OK)
+                    return rc;
+            }
         }
 
         return SQLITE_OK;
@@ -294,61 +759,525 @@ public:
             sqlite3_finalize(stmt);
             if (rc != SQLITE_OK)
                 return rc;
+
+            if (options.hnsw) {
+                zQuery = sqlite3_mprintf("SELECT data  FROM vec_index WHERE tbl = \"%w\" AND name = \"%w" VEC_HNSW_SUFFIX "\"",
+                    name.c_str(), columns[i].name.c_str());
+                rc = sqlite3_prepare_v2(db, zQuery, -1, &stmt, 0);
+                sqlite3_free((void*)zQuery);
+                if (rc != SQLITE_OK)
+                    return rc;
+
+                std::string graph;
+                bool legacy = false;
+
+                if ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+                    graph.assign((const char*)sqlite3_column_blob(stmt, 0), sqlite3_column_bytes(stmt, 0));
+                sqlite3_finalize(stmt);
+                if (rc != SQLITE_ROW && rc != SQLITE_DONE)
+                    return rc;
+
+                if (graph.length() == sizeof(VecColumn::graph_header)) {
+                    rc = load_graph_pages(i, graph);
+                    if (rc != SQLITE_OK)
+                        return rc;
+                } else
+                    legacy = graph.length() > sizeof(VecColumn::graph_header);
+
+                rc = columns[i].load_graph(graph.c_str(), graph.length());
+                if (rc != SQLITE_OK)
+                    return rc;
+
+                // graphs saved in a single row are moved to pages on the next commit
+                if (legacy)
+                    columns[i].graph_full = true;
+            }
         }
 
         return SQLITE_OK;
     }
 
+    /*
+     * the graph header row is followed by rows named <column>:hnsw:<page>,
+     * appending them in order gives back the layout load_graph expects.
+     * a missing page leaves the graph short and load_graph rebuilds it.
+     */
+    int load_graph_pages(int32_t i, std::string& graph)
+    {
+        VecColumn::graph_header hdr;
+        const char* zQuery;
+        sqlite3_stmt* stmt;
+        int rc;
+
+        memcpy(&hdr, graph.c_str(), sizeof(hdr));
+
+        zQuery = sqlite3_mprintf("SELECT data  FROM vec_index WHERE tbl = \"%w\" AND name = ?",
+            name.c_str());
+        rc = sqlite3_prepare_v2(db, zQuery, -1, &stmt, 0);
+        sqlite3_free((void*)zQuery);
+        if (rc != SQLITE_OK)
+            return rc;
+
+        size_t pages = ((size_t)hdr.count + VEC_HNSW_PAGE_SIZE - 1) / VEC_HNSW_PAGE_SIZE;
+        for (size_t page = 0; page < pages; page++) {
+            std::string row_name = page_name(i, VEC_HNSW_SUFFIX, page);
+
+            sqlite3_bind_text(stmt, 1, row_name.c_str(), (int)row_name.length(), SQLITE_TRANSIENT);
+            rc = sqlite3_step(stmt);
+            if (rc == SQLITE_ROW)
+                graph.append((const char*)sqlite3_column_blob(stmt, 0), sqlite3_column_bytes(stmt, 0));
+            sqlite3_reset(stmt);
+
+            if (rc != SQLITE_ROW)
+                break;
+        }
+
+        sqlite3_finalize(stmt);
+        return rc == SQLITE_ROW || rc == SQLITE_DONE ? SQLITE_OK : rc;
+    }
+
+    std::string page_name(int32_t i, const char* suffix, size_t page) const
+    {
+        return columns[i].name + suffix + ":" + std::to_string(page);
+    }
+
+    int read_row(const std::string& row_name, std::string& data)
+    {
+        const char* zQuery;
+        sqlite3_stmt* stmt;
+        int rc;
+
+        zQuery = sqlite3_mprintf("SELECT data  FROM vec_index WHERE tbl = \"%w\" AND name = \"%w\"",
+            name.c_str(), row_name.c_str());
+        rc = sqlite3_prepare_v2(db, zQuery, -1, &stmt, 0);
+        sqlite3_free((void*)zQuery);
+        if (rc != SQLITE_OK)
+            return rc;
+
+        data.clear();
+        if ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+            data.assign((const char*)sqlite3_column_blob(stmt, 0), sqlite3_column_bytes(stmt, 0));
+        sqlite3_finalize(stmt);
+
+        return rc == SQLITE_ROW || rc == SQLITE_DONE ? SQLITE_OK : rc;
+    }
+
+    int save_row(const std::string& row_name, const std::string& data)
+    {
+        const char* zQuery;
+        sqlite3_stmt* stmt;
+        int rc;
+
+        zQuery = sqlite3_mprintf("UPDATE vec_index SET data = ? WHERE tbl = \"%w\" AND name = \"%w\"",
+            name.c_str(), row_name.c_str());
+        rc = save_blob(zQuery, data.c_str(), data.length());
+        sqlite3_free((void*)zQuery);
+        if (rc != SQLITE_OK || sqlite3_changes(db) > 0)
+            return rc;
+
+        zQuery = sqlite3_mprintf("INSERT INTO vec_index(tbl, name, data) VALUES (\"%w\", \"%w\", ?)",
+            name.c_str(), row_name.c_str());
+        rc = sqlite3_prepare_v2(db, zQuery, -1, &stmt, 0);
+        sqlite3_free((void*)zQuery);
+        if (rc != SQLITE_OK)
+            return rc;
+
+        rc = sqlite3_bind_blob64(stmt, 1, data.c_str(), data.length(), SQLITE_TRANSIENT);
+        if (rc == SQLITE_OK)
+            rc = sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+
+        return rc == SQLITE_DONE ? SQLITE_OK : rc;
+    }
+
+    int delete_row(const std::string& row_name)
+    {
+        const char* zQuery;
+        int rc;
+
+        zQuery = sqlite3_mprintf("DELETE FROM vec_index WHERE tbl = \"%w\" AND name = \"%w\"",
+            name.c_str(), row_name.c_str());
+        rc = sqlite3_exec(db, zQuery, 0, 0, 0);
+        sqlite3_free((void*)zQuery);
+
+        return rc;
+    }
+
+    /*
+     * writes the header row and the pages holding nodes changed since the
+     * last sync. a rebuilt graph rewrites every page and drops the pages
+     * left over from a larger graph.
+     */
+    int save_graph(int32_t i)
+    {
+        VecColumn& _idx = columns[i];
+        std::set<size_t> pages;
+        std::string data;
+        const char* zQuery;
+        int rc;
+
+        _idx.save_graph_header(data);
+        zQuery = sqlite3_mprintf("UPDATE vec_index SET data = ? WHERE tbl = \"%w\" AND name = \"%w" VEC_HNSW_SUFFIX "\"",
+            name.c_str(), _idx.name.c_str());
+        rc = save_blob(zQuery, data.c_str(), data.length());
+        sqlite3_free((void*)zQuery);
+        if (rc != SQLITE_OK)
+            return rc;
+
+        _idx.dirty_graph_pages(pages);
+        for (size_t page : pages) {
+            _idx.save_graph_page(page, data);
+            rc = save_row(page_name(i, VEC_HNSW_SUFFIX, page), data);
+            if (rc != SQLITE_OK)
+                return rc;
+        }
+
+        if (_idx.graph_full) {
+            for (size_t page = _idx.graph_pages();; page++) {
+                rc = delete_row(page_name(i, VEC_HNSW_SUFFIX, page));
+                if (rc != SQLITE_OK)
+                    return rc;
+
+                if (sqlite3_changes(db) == 0)
+                    break;
+            }
+        }
+
+        _idx.graph_saved();
+        return SQLITE_OK;
+    }
+
+    /*
+     * quantized columns with rerank keep the original float vectors in rows
+     * named <column>:float:<page>. the records follow the same order as the
+     * quantized block storage, a commit only rewrites the pages holding
+     * records it changed. older databases keep every record in the
+     * <column>:float row, it is read as before until the next commit.
+     */
+    size_t float_record(int32_t i) const
+    {
+        return columns[i].dim() * sizeof(float) + sizeof(hnswlib::labeltype);
+    }
+
+    size_t float_page_size(int32_t i) const
+    {
+        size_t n = VEC_FLOAT_PAGE_BYTES / float_record(i);
+        return n ? n : 1;
+    }
+
+    // the float records a sync changed, positions are those of the quantized block storage
+    class float_changes {
+    public:
+        size_t count = 0;
+        std::set<size_t> dirty;
+        std::unordered_map<hnswlib::labeltype, std::vector<float>> fresh;
+        std::unordered_map<hnswlib::labeltype, size_t> origin;
+    };
+
+    static void float_erased(float_changes& changes, const VecColumn& column, hnswlib::labeltype label)
+    {
+        auto it = column.dict_external_to_internal.find(label);
+        if (it == column.dict_external_to_internal.end())
+            return;
+
+        // erasePoint moves the last record into the erased slot
+        size_t last = column.cur_element_count - 1;
+        changes.dirty.insert(it->second);
+        if (it->second != last)
+            changes.origin.emplace(column.rowid(last), last);
+    }
+
+    static void float_put(float_changes& changes, const VecColumn& column, hnswlib::labeltype label, const std::vector<float>& data)
+    {
+        auto it = column.dict_external_to_internal.find(label);
+
+        changes.dirty.insert(it != column.dict_external_to_internal.end() ? it->second : column.cur_element_count);
+        changes.fresh[label] = data;
+    }
+
+    int read_float(int32_t i, const std::string& legacy, std::map<size_t, std::string>& pages, size_t pos, const char*& retVal)
+    {
+        size_t record = float_record(i);
+
+        if (legacy.length()) {
+            if ((pos + 1) * record > legacy.length())
+                return SQLITE_CORRUPT;
+            retVal = legacy.c_str() + pos * record;
+            return SQLITE_OK;
+        }
+
+        size_t per_page = float_page_size(i);
+        size_t page = pos / per_page;
+        auto it = pages.find(page);
+
+        if (it == pages.end()) {
+            int rc = read_row(page_name(i, VEC_FLOAT_SUFFIX, page), pages[page]);
+            if (rc != SQLITE_OK)
+                return rc;
+            it = pages.find(page);
+        }
+
+        pos %= per_page;
+        if ((pos + 1) * record > it->second.length())
+            return SQLITE_CORRUPT;
+
+        retVal = it->second.c_str() + pos * record;
+        return SQLITE_OK;
+    }
+
+    int save_float(int32_t i, const float_changes& changes)
+    {
+        const VecColumn& _idx = columns[i];
+        size_t dim = _idx.dim();
+        size_t record = float_record(i);
+        size_t per_page = float_page_size(i);
+        size_t count = _idx.cur_element_count;
+        size_t npages = (count + per_page - 1) / per_page;
+        size_t old_pages = (changes.count + per_page - 1) / per_page;
+        std::map<size_t, std::string> old_data;
+        std::map<size_t, std::string> new_data;
+        std::string legacy;
+        int rc;
+
+        rc = read_row(_idx.name + VEC_FLOAT_SUFFIX, legacy);
+        if (rc != SQLITE_OK)
+            return rc;
+
+        if (legacy.length()) {
+            for (size_t page = 0; page < npages; page++)
+                new_data[page];
+            old_pages = 0;
+        } else {
+            for (size_t pos : changes.dirty)
+                if (pos < count)
+                    new_data[pos / per_page];
+            if (count != changes.count && count > 0)
+                new_data[(count - 1) / per_page];
+        }
+
+        // every page is built from the old rows before any row is written
+        for (auto& it : new_data) {
+            size_t start = it.first * per_page;
+            size_t end = start + per_page < count ? start + per_page : count;
+            std::string& data = it.second;
+
+            data.resize((end - start) * record);
+            for (size_t pos = start; pos < end; pos++) {
+                hnswlib::labeltype label = _idx.rowid(pos);
+                char* p = &data[(pos - start) * record];
+
+                auto fresh = changes.fresh.find(label);
+                if (fresh != changes.fresh.end())
+                    memcpy(p, fresh->second.data(), dim * sizeof(float));
+                else {
+                    auto origin = changes.origin.find(label);
+                    const char* old;
+
+                    rc = read_float(i, legacy, old_data, origin != changes.origin.end() ? origin->second : pos, old);
+                    if (rc != SQLITE_OK)
+                        return rc;
+                    memcpy(p, old, dim * sizeof(float));
+                }
+                memcpy(p + dim * sizeof(float), &label, sizeof(label));
+            }
+        }
+
+        for (auto& it : new_data) {
+            rc = save_row(page_name(i, VEC_FLOAT_SUFFIX, it.first), it.second);
+            if (rc != SQLITE_OK)
+                return rc;
+        }
+
+        for (size_t page = npages; page < old_pages; page++) {
+            rc = delete_row(page_name(i, VEC_FLOAT_SUFFIX, page));
+            if (rc != SQLITE_OK)
+                return rc;
+        }
+
+        if (legacy.length()) {
+            const char* zQuery = sqlite3_mprintf("UPDATE vec_index SET data = NULL WHERE tbl = \"%w\" AND name = \"%w" VEC_FLOAT_SUFFIX "\"",
+                name.c_str(), _idx.name.c_str());
+            rc = sqlite3_exec(db, zQuery, 0, 0, 0);
+            sqlite3_free((void*)zQuery);
+        }
+
+        return rc;
+    }
+
+    int row_id(const std::string& row_name, sqlite3_int64& retVal, size_t* size = nullptr)
+    {
+        const char* zQuery;
+        sqlite3_stmt* stmt;
+        int rc;
+
+        zQuery = sqlite3_mprintf("SELECT rowid, length(data)  FROM vec_index WHERE tbl = \"%w\" AND name = \"%w\"",
+            name.c_str(), row_name.c_str());
+        rc = sqlite3_prepare_v2(db, zQuery, -1, &stmt, 0);
+        sqlite3_free((void*)zQuery);
+        if (rc != SQLITE_OK)
+            return rc;
+
+        retVal = 0;
+        if (size)
+            *size = 0;
+
+        if ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+            retVal = sqlite3_column_int64(stmt, 0);
+            if (size)
+                *size = sqlite3_column_int64(stmt, 1);
+        }
+        sqlite3_finalize(stmt);
+
+        return rc == SQLITE_ROW ? SQLITE_OK : rc == SQLITE_DONE ? SQLITE_NOTFOUND : rc;
+    }
+
+    int rerank(int32_t i, const float* query, std::priority_queue<std::pair<float, hnswlib::labeltype>>& result, size_t k)
+    {
+        const VecColumn& column = columns[i];
+        sqlite3_blob* blob = nullptr;
+        sqlite3_int64 legacy_row;
+        size_t legacy_size;
+        int rc;
+
+        if (result.empty())
+            return SQLITE_OK;
+
+        rc = row_id(column.name + VEC_FLOAT_SUFFIX, legacy_row, &legacy_size);
+        if (rc != SQLITE_OK)
+            return rc;
+
+        size_t dim = column.dim();
+        size_t record = float_record(i);
+        size_t per_page = legacy_size ? SIZE_MAX : float_page_size(i);
+        std::vector<std::pair<size_t, hnswlib::labeltype>> positions;
+        std::vector<float> vec(dim);
+        std::priority_queue<std::pair<float, hnswlib::labeltype>> topResults;
+
+        while (!result.empty()) {
+            hnswlib::labeltype label = result.top().second;
+            result.pop();
+
+            auto it = column.dict_external_to_internal.find(label);
+            if (it != column.dict_external_to_internal.end())
+                positions.push_back(std::make_pair(it->second, label));
+        }
+
+        // candidates sharing a page are read through one open blob
+        std::sort(positions.begin(), positions.end());
+
+        size_t cur_page = SIZE_MAX;
+        for (auto& pos : positions) {
+            size_t page = pos.first / per_page;
+
+            if (page != cur_page) {
+                sqlite3_int64 row = legacy_row;
+
+                if (!legacy_size) {
+                    rc = row_id(page_name(i, VEC_FLOAT_SUFFIX, page), row);
+                    if (rc != SQLITE_OK)
+                        break;
+                }
+
+                rc = blob ? sqlite3_blob_reopen(blob, row) : sqlite3_blob_open(db, "main", "vec_index", "data", row, 0, &blob);
+                if (rc != SQLITE_OK)
+                    break;
+                cur_page = page;
+            }
+
+            rc = sqlite3_blob_read(blob, vec.data(), dim * sizeof(float), (pos.first - page * per_page) * record);
+            if (rc != SQLITE_OK)
+                break;
+
+            VecColumn::appendResult(topResults, k, pos.second, hnswlib::InnerProductDistance(query, vec.data(), &dim));
+        }
+
+        if (blob)
+            sqlite3_blob_close(blob);
+        result = std::move(topResults);
+
+        return rc;
+    }
+
+    int save_blob(const char* zQuery, const void* data, size_t size)
+    {
+        sqlite3_stmt* stmt;
+        int rc;
+
+        rc = sqlite3_prepare_v2(db, zQuery, -1, &stmt, 0);
+        if (rc != SQLITE_OK || stmt == 0)
+            return rc;
+
+        rc = sqlite3_bind_blob64(stmt, 1, data, size, SQLITE_TRANSIENT);
+        if (rc == SQLITE_OK)
+            rc = sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+
+        return rc == SQLITE_DONE ? SQLITE_OK : rc;
+    }
+
     int sync_index()
     {
         if (ops.size()) {
             std::vector<bool> dirty;
             dirty.resize(indexCount);
+            int rc = SQLITE_OK;
+
+            std::vector<float_changes> raws(options.rerank ? indexCount : 0);
+            for (size_t i = 0; i < raws.size(); i++)
+                raws[i].count = columns[i].cur_element_count;
 
             for (auto& op : ops) {
+                if (rc != SQLITE_OK)
+                    break;
+
                 if (op.datas.size() == 0) {
                     // delete
-                    for (int i = 0; i < indexCount; i++) {
+                    for (int i = 0; i < indexCount && rc == SQLITE_OK; i++) {
                         dirty[i] = true;
-                        columns[i].removePoint(op.rowid);
+                        if (raws.size())
+                            float_erased(raws[i], columns[i], op.rowid);
+                        rc = columns[i].erasePoint(op.rowid);
                     }
                 } else {
                     // insert or update
-                    for (int i = 0; i < indexCount; i++)
+                    for (int i = 0; i < indexCount && rc == SQLITE_OK; i++)
                         if (op.datas[i].size()) {
                             dirty[i] = true;
-                            columns[i].addPoint(op.datas[i].data(), op.rowid);
+                            if (raws.size())
+                                float_put(raws[i], columns[i], op.rowid, op.datas[i]);
+                            rc = columns[i].putPoint(op.datas[i].data(), op.rowid);
                         }
                 }
             }
 
             rollback();
+            if (rc != SQLITE_OK)
+                return rc;
 
-            int rc;
             const char* zQuery;
-            sqlite3_stmt* stmt;
 
             for (int i = 0; i < indexCount; i++)
                 if (dirty[i]) {
-                    zQuery = sqlite3_mprintf("UPDATE vec_index SET data = ? WHERE tbl = \"%w\" AND name = \"%w\"",
-                        name.c_str(), columns[i].name.c_str());
-                    rc = sqlite3_prepare_v2(db, zQuery, -1, &stmt, 0);
-                    if (rc != SQLITE_OK || stmt == 0) {
-                        return rc;
-                    }
                     const VecColumn& _idx = columns[i];
-                    rc = sqlite3_bind_blob64(stmt, 1, _idx.data_, _idx.cur_element_count * _idx.size_per_element_, SQLITE_TRANSIENT);
-                    if (rc != SQLITE_OK) {
-                        sqlite3_free((void*)zQuery);
-                        return rc;
-                    }
 
-                    rc = sqlite3_step(stmt);
-                    sqlite3_finalize(stmt);
+                    zQuery = sqlite3_mprintf("UPDATE vec_index SET data = ? WHERE tbl = \"%w\" AND name = \"%w\"",
+                        name.c_str(), _idx.name.c_str());
+                    rc = save_blob(zQuery, _idx.data_, _idx.cur_element_count * _idx.size_per_element_);
                     sqlite3_free((void*)zQuery);
-
-                    if (rc != SQLITE_DONE)
+                    if (rc != SQLITE_OK)
                         return rc;
+
+                    if (_idx.hnsw) {
+                        rc = save_graph(i);
+                        if (rc != SQLITE_OK)
+                            return rc;
+                    }
+
+                    if (raws.size()) {
+                        rc = save_float(i, raws[i]);
+                        if (rc != SQLITE_OK)
+                            return rc;
+                    }
                 }
         }
 
@@ -375,6 +1304,7 @@ public:
     sqlite3* db;
 
     std::string name;
+    VecIndexOptions options;
 
     int32_t indexCount;
     VecColumn* columns;
@@ -401,12 +1331,73 @@ public:
     size_t iCurrent;
 };
 
-std::vector<VecIndexColumn> parse_constructor(int argc, const char* const* argv)
+static bool parse_option(std::string arg, VecIndexOptions& options)
+{
+    std::size_t eq = arg.find("=");
+    std::string key = arg.substr(0, eq);
+    std::string value = arg.substr(eq + 1);
+
+    key.erase(key.find_last_not_of(" \t") + 1);
+    value.erase(0, value.find_first_not_of(" \t"));
+
+    if (sqlite3_stricmp(key.c_str(), "index") == 0) {
+        if (sqlite3_stricmp(value.c_str(), "hnsw") == 0)
+            options.hnsw = true;
+        else if (sqlite3_stricmp(value.c_str(), "flat") == 0)
+            options.hnsw = false;
+        else
+            return false;
+
+        return true;
+    }
+
+    if (sqlite3_stricmp(key.c_str(), "quantize") == 0) {
+        if (sqlite3_stricmp(value.c_str(), "int8") == 0)
+            options.quantize = VecQuantize::int8;
+        else if (sqlite3_stricmp(value.c_str(), "binary") == 0)
+            options.quantize = VecQuantize::binary;
+        else if (sqlite3_stricmp(value.c_str(), "none") == 0)
+            options.quantize = VecQuantize::none;
+        else
+            return false;
+
+        return true;
+    }
+
+    int32_t n = std::atoi(value.c_str());
+    if (n <= 0)
+        return false;
+
+    if (sqlite3_stricmp(key.c_str(), "M") == 0) {
+        if (n < 2 || n > 128)
+            return false;
+        options.M = n;
+    } else if (sqlite3_stricmp(key.c_str(), "efConstruction") == 0)
+        options.efConstruction = n;
+    else if (sqlite3_stricmp(key.c_str(), "efSearch") == 0)
+        options.efSearch = n;
+    else if (sqlite3_stricmp(key.c_str(), "rerank") == 0)
+        options.rerank = n;
+    else
+        return false;
+
+    return true;
+}
+
+std::vector<VecIndexColumn> parse_constructor(int argc, const char* const* argv, VecIndexOptions& options)
 {
     std::vector<VecIndexColumn> columns;
     for (int i = 3; i < argc; i++) {
         std::string arg = argv[i];
 
+        if (arg.find("=") != std::string::npos) {
+            if (!parse_option(arg, options)) {
+                columns.clear();
+                return columns;
+            }
+            continue;
+        }
+
         std::size_t lparen = arg.find("(");
         std::size_t rparen = arg.find(")");
 
@@ -425,6 +1416,9 @@ std::vector<VecIndexColumn> parse_constructor(int argc, const char* const* argv)
         columns.push_back({ name, dimensions });
     }
 
+    if (options.rerank && options.quantize == VecQuantize::none)
+        columns.clear();
+
     return columns;
 }
 
@@ -503,7 +1497,8 @@ static int init(sqlite3* db, void* pAux, int argc, const char* const* argv,
     sqlite3_vtab_config(db, SQLITE_VTAB_CONSTRAINT_SUPPORT, 1);
     int rc;
 
-    std::vector<VecIndexColumn> columns = parse_constructor(argc, argv);
+    VecIndexOptions options;
+    std::vector<VecIndexColumn> columns = parse_constructor(argc, argv, options);
     if (columns.size() == 0) {
         *pzErr = sqlite3_mprintf("Error parsing constructor");
         return SQLITE_ERROR;
@@ -523,7 +1518,7 @@ static int init(sqlite3* db, void* pAux, int argc, const char* const* argv,
     if (rc != SQLITE_OK)
         return rc;
 
-    VecIndex* pNew = new VecIndex(db, argv[2], columns);
+    VecIndex* pNew = new VecIndex(db, argv[2], columns, options);
     *ppVtab = pNew;
 
     if (isCreate)
@@ -653,7 +1648,19 @@ static int vecIndexFilter(sqlite3_vtab_cursor* pVtabCursor, int idxNum, const ch
         }
 
         std::priority_queue<std::pair<float, hnswlib::labeltype>> search_result;
-        search_result = column.search(query_vector.data(), nlimit < column.cur_element_count ? nlimit : column.cur_element_count);
+        size_t k = nlimit < column.cur_element_count ? nlimit : column.cur_element_count;
+
+        if (column.options.rerank) {
+            size_t n = k * column.options.rerank;
+            search_result = column.search(query_vector.data(), n < column.cur_element_count ? n : column.cur_element_count);
+
+            int rc = ((VecIndex*)pCur->pVtab)->rerank(idxNum, query_vector.data(), search_result, k);
+            if (rc != SQLITE_OK) {
+                ((VecIndex*)pCur->pVtab)->zErrMsg = sqlite3_mprintf("Failed to rerank \"%s\"", column.name.c_str());
+                return rc;
+            }
+        } else
+            search_result = column.search(query_vector.data(), k);
 
         size_t sz = search_result.size();
 
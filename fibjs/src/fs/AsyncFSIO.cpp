@@ -5,11 +5,11 @@
 #include <uv/include/uv.h>
 #include "Runtime.h"
 #include "Buffer.h"
+#include "options.h"
 
 namespace fibjs {
 
 uv_loop_t* s_uv_loop;
-exlib::LockedList<AsyncEvent> s_uv_tasks;
 
 uv_loop_s* Isolate::event_loop()
 {
@@ -20,6 +20,11 @@ class UVAsyncThread : public exlib::OSThread {
 public:
     UVAsyncThread()
     {
+        uv_loop_init(&m_loop);
+        m_loop.data = this;
+
+        uv_async_init(&m_loop, &m_uv_async, AsyncEventCallback);
+
         start();
     }
 
@@ -28,50 +33,103 @@ public:
     {
         Runtime rtForThread(NULL);
 
-        s_uv_loop = new uv_loop_t();
-        uv_loop_init(s_uv_loop);
-
-        uv_async_init(s_uv_loop, &m_uv_async, AsyncEventCallback);
-
-        m_init.set();
-
-        uv_run(s_uv_loop, UV_RUN_DEFAULT);
+        uv_run(&m_loop, UV_RUN_DEFAULT);
     }
 
     void post(AsyncEvent* task)
     {
-        m_init.wait();
-        s_uv_tasks.putTail(task);
+        m_pending.inc();
+        m_tasks.putTail(task);
         uv_async_send(&m_uv_async);
     }
 
 private:
     static void AsyncEventCallback(uv_async_t* handle)
     {
+        UVAsyncThread* pThis = container_of(handle, UVAsyncThread, m_uv_async);
         exlib::List<AsyncEvent> jobs;
         AsyncEvent* p1;
 
-        s_uv_tasks.getList(jobs);
+        pThis->m_tasks.getList(jobs);
 
-        while ((p1 = jobs.getHead()) != 0)
+        while ((p1 = jobs.getHead()) != 0) {
+            pThis->m_pending.dec();
             p1->invoke();
+        }
     }
 
 public:
-    exlib::Event m_init;
+    uv_loop_t m_loop;
+    exlib::atomic m_pending;
 
 private:
     uv_async_t m_uv_async;
+    exlib::LockedList<AsyncEvent> m_tasks;
 };
 
-static UVAsyncThread* s_afsIO;
+static UVAsyncThread* s_loops[MAX_UV_LOOPS];
+static exlib::atomic s_loop_count;
+static int32_t s_loop_active;
+static exlib::atomic s_loop_next;
+static exlib::spinlock s_loop_lock;
+
+int32_t uv_loop_count()
+{
+    return s_loop_active;
+}
+
+result_t uv_set_loop_count(int32_t count)
+{
+    if (count < 1 || count > MAX_UV_LOOPS)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    s_loop_lock.lock();
+    while (s_loop_count.value() < count) {
+        s_loops[s_loop_count.value()] = new UVAsyncThread();
+        s_loop_count.inc();
+    }
+    s_loop_active = count;
+    s_loop_lock.unlock();
+
+    return 0;
+}
+
+uv_loop_t* uv_get_loop(int32_t no)
+{
+    if (no < 0 || no >= s_loop_count.value())
+        return NULL;
+    return &s_loops[no]->m_loop;
+}
+
+// loops are handed out round-robin, a handle stays on the loop it was created on.
+uv_loop_t* uv_select_loop()
+{
+    int32_t count = s_loop_active;
+
+    if (count == 1)
+        return s_uv_loop;
+
+    return &s_loops[(uint32_t)s_loop_next.inc() % count]->m_loop;
+}
+
+int32_t uv_loop_pending(int32_t no)
+{
+    if (no < 0 || no >= s_loop_count.value())
+        return 0;
+    return (int32_t)s_loops[no]->m_pending.value();
+}
+
+void uv_post(uv_loop_t* loop, AsyncEvent* task)
+{
+    ((UVAsyncThread*)loop->data)->post(task);
+}
 
 void uv_post(AsyncEvent* task)
 {
-    s_afsIO->post(task);
+    uv_post(s_uv_loop, task);
 }
 
-void uv_post(std::function<void(void)> proc)
+void uv_post(uv_loop_t* loop, std::function<void(void)> proc)
 {
     class UVPost : public AsyncEvent {
     public:
@@ -91,18 +149,23 @@ void uv_post(std::function<void(void)> proc)
         std::function<void(void)> m_proc;
     };
 
-    uv_post(new UVPost(proc));
+    uv_post(loop, new UVPost(proc));
 }
 
-int uv_call(std::function<int(void)> proc)
+void uv_post(std::function<void(void)> proc)
+{
+    uv_post(s_uv_loop, proc);
+}
+
+int uv_call(uv_loop_t* loop, std::function<int(void)> proc)
 {
     class UVCall : public AsyncEvent {
     public:
-        UVCall(std::function<int(void)>& proc)
+        UVCall(uv_loop_t* loop, std::function<int(void)>& proc)
             : AsyncEvent(NULL)
             , m_proc(proc)
         {
-            uv_post(this);
+            uv_post(loop, this);
             m_event.wait();
         }
 
@@ -118,12 +181,18 @@ int uv_call(std::function<int(void)> proc)
         exlib::Event m_event;
     };
 
-    UVCall uvc(proc);
+    UVCall uvc(loop, proc);
     return uvc.m_res;
 }
 
+int uv_call(std::function<int(void)> proc)
+{
+    return uv_call(s_uv_loop, proc);
+}
+
 void initializeUVAsyncThread()
 {
-    s_afsIO = new UVAsyncThread();
+    uv_set_loop_count(g_uv_loops);
+    s_uv_loop = &s_loops[0]->m_loop;
 }
 }
\ No newline at end of file
@@ -0,0 +1,511 @@
+/*
+ * AsyncUring.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#ifndef _WIN32
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#include "object.h"
+#include "options.h"
+#include "AsyncUring.h"
+#include "Stat.h"
+#include "utf8.h"
+#include <fcntl.h>
+#include <vector>
+
+#if defined(Linux) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/sysmacros.h>
+
+#if defined(IORING_FEAT_RW_CUR_POS) && defined(__NR_io_uring_setup)
+#define HAVE_IO_URING
+#endif
+#endif
+
+namespace fibjs {
+
+#ifdef HAVE_IO_URING
+
+class AsyncUring : public exlib::OSThread {
+public:
+    class Waiter {
+    public:
+        exlib::Event m_event;
+        int32_t m_res;
+    };
+
+public:
+    AsyncUring()
+        : m_fd(-1)
+        , m_sq(MAP_FAILED)
+        , m_cq(MAP_FAILED)
+        , m_sqes((io_uring_sqe*)MAP_FAILED)
+        , m_inflight(0)
+        , m_ready(0)
+        , m_submitting(false)
+    {
+        memset(m_ops, 0, sizeof(m_ops));
+    }
+
+    ~AsyncUring()
+    {
+        if (m_sqes != MAP_FAILED)
+            munmap(m_sqes, m_sqes_size);
+        if (m_cq != MAP_FAILED && m_cq != m_sq)
+            munmap(m_cq, m_cq_size);
+        if (m_sq != MAP_FAILED)
+            munmap(m_sq, m_sq_size);
+        if (m_fd >= 0)
+            ::close(m_fd);
+    }
+
+public:
+    bool init(uint32_t entries)
+    {
+        io_uring_params p;
+        memset(&p, 0, sizeof(p));
+
+        m_fd = (int32_t)syscall(__NR_io_uring_setup, entries, &p);
+        if (m_fd < 0)
+            return false;
+
+        // reads and writes at the current file position need 5.6
+        if (!(p.features & IORING_FEAT_RW_CUR_POS))
+            return false;
+
+        m_sq_size = p.sq_off.array + p.sq_entries * sizeof(uint32_t);
+        m_cq_size = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        if (p.features & IORING_FEAT_SINGLE_MMAP) {
+            if (m_cq_size > m_sq_size)
+                m_sq_size = m_cq_size;
+            m_cq_size = m_sq_size;
+        }
+
+        m_sq = mmap(NULL, m_sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+        if (m_sq == MAP_FAILED)
+            return false;
+
+        if (p.features & IORING_FEAT_SINGLE_MMAP)
+            m_cq = m_sq;
+        else {
+            m_cq = mmap(NULL, m_cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+            if (m_cq == MAP_FAILED)
+                return false;
+        }
+
+        m_sqes_size = p.sq_entries * sizeof(io_uring_sqe);
+        m_sqes = (io_uring_sqe*)mmap(NULL, m_sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES);
+        if (m_sqes == MAP_FAILED)
+            return false;
+
+        char* sq = (char*)m_sq;
+        m_sq_head = (uint32_t*)(sq + p.sq_off.head);
+        m_sq_tail = (uint32_t*)(sq + p.sq_off.tail);
+        m_sq_mask = *(uint32_t*)(sq + p.sq_off.ring_mask);
+        m_sq_array = (uint32_t*)(sq + p.sq_off.array);
+        m_sq_entries = p.sq_entries;
+
+        char* cq = (char*)m_cq;
+        m_cq_head = (uint32_t*)(cq + p.cq_off.head);
+        m_cq_tail = (uint32_t*)(cq + p.cq_off.tail);
+        m_cq_mask = *(uint32_t*)(cq + p.cq_off.ring_mask);
+        m_cqes = (io_uring_cqe*)(cq + p.cq_off.cqes);
+        m_cq_entries = p.cq_entries;
+
+        // opcodes the kernel does not know are left to the syscalls one by one
+        size_t sz = sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op);
+        std::vector<char> buf(sz, 0);
+        io_uring_probe* probe = (io_uring_probe*)buf.data();
+
+        if (syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_PROBE, probe, 256) < 0)
+            return false;
+
+        for (int32_t i = 0; i < probe->ops_len; i++)
+            if (probe->ops[i].flags & IO_URING_OP_SUPPORTED)
+                m_ops[probe->ops[i].op] = true;
+
+        if (!m_ops[IORING_OP_READ] || !m_ops[IORING_OP_WRITE])
+            return false;
+
+        start();
+        return true;
+    }
+
+    bool support(int32_t op)
+    {
+        return m_ops[op];
+    }
+
+    // queues e and waits for its completion, false when there is no room in the ring
+    // the fiber that finds nobody submitting enters the kernel for everything queued until then,
+    // so fibers calling at the same time are submitted together.
+    bool call(const io_uring_sqe& e, int32_t& res)
+    {
+        Waiter w;
+
+        m_lock.lock();
+
+        uint32_t tail = *m_sq_tail;
+        if (m_inflight >= m_cq_entries || tail - __atomic_load_n(m_sq_head, __ATOMIC_ACQUIRE) >= m_sq_entries) {
+            m_lock.unlock();
+            return false;
+        }
+
+        uint32_t idx = tail & m_sq_mask;
+        io_uring_sqe* sqe = m_sqes + idx;
+
+        *sqe = e;
+        sqe->user_data = (uint64_t)(intptr_t)&w;
+        m_sq_array[idx] = idx;
+        __atomic_store_n(m_sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+        m_inflight++;
+        m_ready++;
+
+        if (!m_submitting) {
+            m_submitting = true;
+
+            while (m_ready) {
+                uint32_t n = m_ready;
+                m_ready = 0;
+                m_lock.unlock();
+
+                int32_t ret = enter(n, 0, 0);
+
+                m_lock.lock();
+                if (ret < (int32_t)n) {
+                    // the kernel leaves what it did not take in the ring, try again
+                    m_ready += n - (ret > 0 ? ret : 0);
+                    if (ret <= 0) {
+                        m_lock.unlock();
+                        exlib::OSThread::sleep(0);
+                        m_lock.lock();
+                    }
+                }
+            }
+
+            m_submitting = false;
+            m_lock.unlock();
+
+            // reads served from the page cache complete inside io_uring_enter
+            reap();
+        } else
+            m_lock.unlock();
+
+        w.m_event.wait();
+        res = w.m_res;
+
+        return true;
+    }
+
+public:
+    virtual void Run()
+    {
+        while (true)
+            if (!reap())
+                enter(0, 1, IORING_ENTER_GETEVENTS);
+    }
+
+private:
+    // hands the completed entries to their fibers, false when there were none
+    bool reap()
+    {
+        m_cq_lock.lock();
+
+        uint32_t head = *m_cq_head;
+        uint32_t tail = __atomic_load_n(m_cq_tail, __ATOMIC_ACQUIRE);
+
+        if (head == tail) {
+            m_cq_lock.unlock();
+            return false;
+        }
+
+        uint32_t n = tail - head;
+        while (head != tail) {
+            io_uring_cqe* cqe = m_cqes + (head & m_cq_mask);
+            Waiter* w = (Waiter*)(intptr_t)cqe->user_data;
+
+            w->m_res = cqe->res;
+            w->m_event.set();
+            head++;
+        }
+        __atomic_store_n(m_cq_head, head, __ATOMIC_RELEASE);
+
+        m_cq_lock.unlock();
+
+        m_lock.lock();
+        m_inflight -= n;
+        m_lock.unlock();
+
+        return true;
+    }
+
+private:
+    int32_t enter(uint32_t to_submit, uint32_t min_complete, uint32_t flags)
+    {
+        return (int32_t)syscall(__NR_io_uring_enter, m_fd, to_submit, min_complete, flags, NULL, 0);
+    }
+
+private:
+    int32_t m_fd;
+    bool m_ops[256];
+
+    void* m_sq;
+    size_t m_sq_size;
+    uint32_t* m_sq_head;
+    uint32_t* m_sq_tail;
+    uint32_t* m_sq_array;
+    uint32_t m_sq_mask;
+    uint32_t m_sq_entries;
+
+    io_uring_sqe* m_sqes;
+    size_t m_sqes_size;
+
+    void* m_cq;
+    size_t m_cq_size;
+    uint32_t* m_cq_head;
+    uint32_t* m_cq_tail;
+    io_uring_cqe* m_cqes;
+    uint32_t m_cq_mask;
+    uint32_t m_cq_entries;
+
+    exlib::spinlock m_lock;
+    exlib::spinlock m_cq_lock;
+    uint32_t m_inflight;
+    uint32_t m_ready;
+    bool m_submitting;
+};
+
+static AsyncUring* s_uring;
+
+static bool uring_call(int32_t op, io_uring_sqe& e, int32_t& res)
+{
+    if (!s_uring || !s_uring->support(op))
+        return false;
+
+    e.opcode = op;
+    return s_uring->call(e, res);
+}
+
+static int32_t uring_result(int32_t res)
+{
+    if (res < 0) {
+        errno = -res;
+        return -1;
+    }
+
+    return res;
+}
+
+static void statx_to_uv(const struct statx& stx, uv_stat_t* statbuf)
+{
+    statbuf->st_dev = makedev(stx.stx_dev_major, stx.stx_dev_minor);
+    statbuf->st_mode = stx.stx_mode;
+    statbuf->st_nlink = stx.stx_nlink;
+    statbuf->st_uid = stx.stx_uid;
+    statbuf->st_gid = stx.stx_gid;
+    statbuf->st_rdev = makedev(stx.stx_rdev_major, stx.stx_rdev_minor);
+    statbuf->st_ino = stx.stx_ino;
+    statbuf->st_size = stx.stx_size;
+    statbuf->st_blksize = stx.stx_blksize;
+    statbuf->st_blocks = stx.stx_blocks;
+    statbuf->st_atim.tv_sec = stx.stx_atime.tv_sec;
+    statbuf->st_atim.tv_nsec = stx.stx_atime.tv_nsec;
+    statbuf->st_mtim.tv_sec = stx.stx_mtime.tv_sec;
+    statbuf->st_mtim.tv_nsec = stx.stx_mtime.tv_nsec;
+    statbuf->st_ctim.tv_sec = stx.stx_ctime.tv_sec;
+    statbuf->st_ctim.tv_nsec = stx.stx_ctime.tv_nsec;
+    statbuf->st_birthtim.tv_sec = stx.stx_btime.tv_sec;
+    statbuf->st_birthtim.tv_nsec = stx.stx_btime.tv_nsec;
+    statbuf->st_flags = 0;
+    statbuf->st_gen = 0;
+}
+
+static bool uring_statx(int32_t dirfd, const char* path, int32_t flags, uv_stat_t* statbuf, int32_t& res)
+{
+    struct statx stx;
+    io_uring_sqe e;
+
+    memset(&e, 0, sizeof(e));
+    e.fd = dirfd;
+    e.addr = (uint64_t)(intptr_t)path;
+    e.len = STATX_BASIC_STATS | STATX_BTIME;
+    e.off = (uint64_t)(intptr_t)&stx;
+    e.statx_flags = flags;
+
+    if (!uring_call(IORING_OP_STATX, e, res))
+        return false;
+
+    if (res == 0)
+        statx_to_uv(stx, statbuf);
+
+    return true;
+}
+
+#endif
+
+void initializeAsyncUring()
+{
+#ifdef HAVE_IO_URING
+    if (!g_io_uring)
+        return;
+
+    AsyncUring* ring = new AsyncUring();
+    if (ring->init(256))
+        s_uring = ring;
+    else
+        delete ring;
+#endif
+}
+
+const char* uring_backend()
+{
+#ifdef HAVE_IO_URING
+    if (s_uring)
+        return "IoUring";
+#endif
+    return "Sync";
+}
+
+int32_t uring_read(int32_t fd, void* buf, int32_t len, int64_t pos)
+{
+#ifdef HAVE_IO_URING
+    io_uring_sqe e;
+    int32_t res;
+
+    memset(&e, 0, sizeof(e));
+    e.fd = fd;
+    e.addr = (uint64_t)(intptr_t)buf;
+    e.len = len;
+    e.off = (uint64_t)pos;
+
+    if (uring_call(IORING_OP_READ, e, res))
+        return uring_result(res);
+#endif
+
+    if (pos < 0)
+        return (int32_t)::_read(fd, buf, len);
+
+#ifdef _WIN32
+    if (_lseeki64(fd, pos, SEEK_SET) < 0)
+        return -1;
+    return (int32_t)::_read(fd, buf, len);
+#else
+    return (int32_t)::pread(fd, buf, len, pos);
+#endif
+}
+
+int32_t uring_write(int32_t fd, const void* buf, int32_t len, int64_t pos)
+{
+#ifdef HAVE_IO_URING
+    io_uring_sqe e;
+    int32_t res;
+
+    memset(&e, 0, sizeof(e));
+    e.fd = fd;
+    e.addr = (uint64_t)(intptr_t)buf;
+    e.len = len;
+    e.off = (uint64_t)pos;
+
+    if (uring_call(IORING_OP_WRITE, e, res))
+        return uring_result(res);
+#endif
+
+    if (pos < 0)
+        return (int32_t)::_write(fd, buf, len);
+
+#ifdef _WIN32
+    if (_lseeki64(fd, pos, SEEK_SET) < 0)
+        return -1;
+    return (int32_t)::_write(fd, buf, len);
+#else
+    return (int32_t)::pwrite(fd, buf, len, pos);
+#endif
+}
+
+int32_t uring_open(const char* path, int32_t flags, int32_t mode)
+{
+#ifdef HAVE_IO_URING
+    io_uring_sqe e;
+    int32_t res;
+
+    memset(&e, 0, sizeof(e));
+    e.fd = AT_FDCWD;
+    e.addr = (uint64_t)(intptr_t)path;
+    e.len = mode;
+    e.open_flags = flags;
+
+    if (uring_call(IORING_OP_OPENAT, e, res))
+        return uring_result(res);
+#endif
+
+#ifdef _WIN32
+    return _wopen(UTF8_W(path), flags, mode);
+#else
+    return ::open(path, flags, mode);
+#endif
+}
+
+int32_t uring_fsync(int32_t fd, bool datasync)
+{
+#ifdef HAVE_IO_URING
+    io_uring_sqe e;
+    int32_t res;
+
+    memset(&e, 0, sizeof(e));
+    e.fd = fd;
+    e.fsync_flags = datasync ? IORING_FSYNC_DATASYNC : 0;
+
+    if (uring_call(IORING_OP_FSYNC, e, res))
+        return res;
+#endif
+
+    AutoReq req;
+    if (datasync)
+        return uv_fs_fdatasync(NULL, &req, fd, NULL);
+    return uv_fs_fsync(NULL, &req, fd, NULL);
+}
+
+int32_t uring_stat(const char* path, bool follow, uv_stat_t* statbuf)
+{
+#ifdef HAVE_IO_URING
+    int32_t res;
+
+    if (uring_statx(AT_FDCWD, path, follow ? 0 : AT_SYMLINK_NOFOLLOW, statbuf, res))
+        return res;
+#endif
+
+    AutoReq req;
+    int32_t ret = follow ? uv_fs_stat(NULL, &req, path, NULL) : uv_fs_lstat(NULL, &req, path, NULL);
+    if (ret < 0)
+        return ret;
+
+    *statbuf = req.statbuf;
+    return 0;
+}
+
+int32_t uring_fstat(int32_t fd, uv_stat_t* statbuf)
+{
+#ifdef HAVE_IO_URING
+    int32_t res;
+
+    if (uring_statx(fd, "", AT_EMPTY_PATH, statbuf, res))
+        return res;
+#endif
+
+    AutoReq req;
+    int32_t ret = uv_fs_fstat(NULL, &req, fd, NULL);
+    if (ret < 0)
+        return ret;
+
+    *statbuf = req.statbuf;
+    return 0;
+}
+
+} /* namespace fibjs */
@@ -13,8 +13,15 @@
 
 #include "ifs/io.h"
 #include "ifs/fs.h"
+#include "ifs/Socket.h"
 #include "File.h"
 #include "Buffer.h"
+#include "UVSocket.h"
+
+#ifdef Linux
+#include <sys/sendfile.h>
+#define SENDFILE_BLOCK_SIZE 0x7ffff000
+#endif
 
 #ifdef _WIN32
 #define pclose _pclose
@@ -65,7 +72,7 @@ result_t File::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
         char* p = strBuf.data();
 
         while (sz) {
-            int32_t n = (int32_t)::_read(m_fd, p, sz > STREAM_BUFF_SIZE ? STREAM_BUFF_SIZE : sz);
+            int32_t n = uring_read(m_fd, p, sz > STREAM_BUFF_SIZE ? STREAM_BUFF_SIZE : sz);
             if (n < 0)
                 return CHECK_ERROR(LastError());
             if (n == 0)
@@ -118,7 +125,7 @@ result_t File::readAll(obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
         char* p = strBuf.data();
 
         while (sz) {
-            int32_t n = (int32_t)::_read(m_fd, p, sz > STREAM_BUFF_SIZE ? STREAM_BUFF_SIZE : sz);
+            int32_t n = uring_read(m_fd, p, sz > STREAM_BUFF_SIZE ? STREAM_BUFF_SIZE : sz);
             if (n < 0)
                 return CHECK_ERROR(LastError());
             if (n == 0)
@@ -145,7 +152,7 @@ result_t File::Write(const char* p, int32_t sz)
         return CHECK_ERROR(CALL_E_INVALID_CALL);
 
     while (sz) {
-        int32_t n = (int32_t)::_write(m_fd, p, sz > STREAM_BUFF_SIZE ? STREAM_BUFF_SIZE : sz);
+        int32_t n = uring_write(m_fd, p, sz > STREAM_BUFF_SIZE ? STREAM_BUFF_SIZE : sz);
         if (n < 0)
             return CHECK_ERROR(LastError());
 
@@ -173,9 +180,168 @@ result_t File::copyTo(Stream_base* stm, int64_t bytes, int64_t& retVal,
     if (m_fd == -1)
         return CHECK_ERROR(CALL_E_INVALID_CALL);
 
+    if (canSendFile(stm)) {
+        if (ac->isSync())
+            return CHECK_ERROR(CALL_E_NOSYNC);
+
+        int64_t pos = _lseeki64(m_fd, 0, SEEK_CUR);
+        if (pos < 0)
+            return CHECK_ERROR(LastError());
+
+        int64_t sz = _lseeki64(m_fd, 0, SEEK_END);
+        if (sz < 0)
+            return CHECK_ERROR(LastError());
+
+        sz = sz > pos ? sz - pos : 0;
+        if (bytes < 0 || bytes > sz)
+            bytes = sz;
+
+        if (_lseeki64(m_fd, pos + bytes, SEEK_SET) < 0)
+            return CHECK_ERROR(LastError());
+
+        return sendTo(stm, pos, bytes, retVal, ac);
+    }
+
     return io_base::copyStream(this, stm, bytes, retVal, ac);
 }
 
+bool File::canSendFile(Stream_base* stm)
+{
+#ifdef Linux
+    // only UVSocket can tell us whether writes are still queued ahead of sendfile
+    return dynamic_cast<UVSocket*>(stm) != NULL;
+#else
+    return false;
+#endif
+}
+
+result_t File::sendTo(Stream_base* stm, int64_t pos, int64_t bytes, int64_t& retVal,
+    AsyncEvent* ac)
+{
+    class asyncSendFile : public AsyncState {
+    public:
+        asyncSendFile(File* pThis, Stream_base* stm, int64_t pos, int64_t bytes,
+            int64_t& retVal, AsyncEvent* ac)
+            : AsyncState(ac)
+            , m_pThis(pThis)
+            , m_stm(stm)
+            , m_pos(pos)
+            , m_bytes(bytes)
+            , m_retVal(retVal)
+            , m_sock(-1)
+            , m_pending(0)
+        {
+            m_retVal = 0;
+            m_stm->get_fd(m_sock);
+            next(check);
+        }
+
+        ON_STATE(asyncSendFile, check)
+        {
+            if (m_bytes == 0)
+                return next();
+
+            // sendfile writes to the fd directly, it must not overtake writes still queued on the stream
+            return ((UVSocket*)(Stream_base*)m_stm)->write_pending(m_pending, next(send));
+        }
+
+        ON_STATE(asyncSendFile, send)
+        {
+            asyncCall(do_transfer, this, CALL_E_LONGSYNC);
+            return next(sent, CALL_E_PENDDING);
+        }
+
+        ON_STATE(asyncSendFile, sent)
+        {
+            if (m_buf)
+                return m_stm->write(m_buf, next(check));
+
+            return next(check);
+        }
+
+    private:
+        static int32_t do_transfer(asyncSendFile* pThis)
+        {
+            pThis->apost(pThis->transfer());
+            return 0;
+        }
+
+        result_t transfer()
+        {
+            m_buf.Release();
+
+#ifdef Linux
+            while (!m_pending && m_sock >= 0 && m_bytes > 0) {
+                off_t off = (off_t)m_pos;
+                ssize_t n = ::sendfile(m_sock, m_pThis->m_fd, &off,
+                    (size_t)(m_bytes > SENDFILE_BLOCK_SIZE ? SENDFILE_BLOCK_SIZE : m_bytes));
+
+                if (n < 0) {
+                    if (errno == EINTR)
+                        continue;
+                    if (errno == EAGAIN || errno == EWOULDBLOCK)
+                        break;
+                    if (errno == EINVAL || errno == ENOSYS) {
+                        m_sock = -1;
+                        break;
+                    }
+                    return CHECK_ERROR(LastError());
+                }
+
+                if (n == 0) {
+                    m_bytes = 0;
+                    return 0;
+                }
+
+                m_pos += n;
+                m_bytes -= n;
+                m_retVal += n;
+            }
+#endif
+
+            if (m_bytes == 0)
+                return 0;
+
+            // the socket is busy or full, hand one block to the stream and let it wait for writable
+            exlib::string strBuf;
+            strBuf.resize(m_bytes > STREAM_BUFF_SIZE ? STREAM_BUFF_SIZE : (size_t)m_bytes);
+
+            int32_t n = uring_read(m_pThis->m_fd, strBuf.data(), (int32_t)strBuf.length(), m_pos);
+            if (n < 0)
+                return CHECK_ERROR(LastError());
+            if (n == 0) {
+                m_bytes = 0;
+                return 0;
+            }
+
+            m_pos += n;
+            m_bytes -= n;
+            m_retVal += n;
+
+            m_buf = new Buffer(strBuf.c_str(), n);
+            return 0;
+        }
+
+    private:
+        obj_ptr<File> m_pThis;
+        obj_ptr<Stream_base> m_stm;
+        int64_t m_pos;
+        int64_t m_bytes;
+        int64_t& m_retVal;
+        int32_t m_sock;
+        int32_t m_pending;
+        obj_ptr<Buffer_base> m_buf;
+    };
+
+    if (m_fd == -1)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new asyncSendFile(this, stm, pos, bytes, retVal, ac))->post(0);
+}
+
 result_t File::open(exlib::string fname, exlib::string flags)
 {
     close();
@@ -24,6 +24,12 @@ namespace fibjs {
 
 DECLARE_MODULE(fs);
 
+result_t fs_base::backend(exlib::string& retVal)
+{
+    retVal = uring_backend();
+    return 0;
+}
+
 result_t FileHandle::get_fd(int32_t& retVal)
 {
     retVal = m_fd;
@@ -323,37 +329,30 @@ result_t fs_base::read(FileHandle_base* fd, Buffer_base* buffer, int32_t offset,
         return Runtime::setError("fs: Length extends beyond buffer");
     }
 
-    if (position > -1) {
-        if (_lseeki64(_fd, position, SEEK_SET) < 0)
-            return CHECK_ERROR(LastError());
-    }
-
-    exlib::string strBuf;
-    if (length > 0) {
-        strBuf.resize(length);
-        int32_t sz = length;
-        char* p = strBuf.data();
-
-        while (sz) {
-            int32_t n = (int32_t)::_read(_fd, p, sz > STREAM_BUFF_SIZE ? STREAM_BUFF_SIZE : sz);
-            if (n < 0)
-                return CHECK_ERROR(LastError());
-            if (n == 0)
-                break;
+    int64_t pos = position;
+    int32_t sz = length;
+    uint8_t* p = Buffer::Cast(buffer)->data() + offset;
 
-            sz -= n;
-            p += n;
-        }
+    while (sz) {
+        int32_t n = uring_read(_fd, p, sz > STREAM_BUFF_SIZE ? STREAM_BUFF_SIZE : sz, pos);
+        if (n < 0)
+            return CHECK_ERROR(LastError());
+        if (n == 0)
+            break;
 
-        strBuf.resize(length - sz);
+        sz -= n;
+        p += n;
+        if (pos > -1)
+            pos += n;
     }
 
-    if (strBuf.length() == 0) {
-        retVal = 0;
-        return 0;
-    }
+    // reading at a position leaves the file position after the data read
+    if (pos > -1 && _lseeki64(_fd, pos, SEEK_SET) < 0)
+        return CHECK_ERROR(LastError());
 
-    return buffer->write(strBuf, offset, (int32_t)strBuf.length(), "utf8", retVal);
+    retVal = length - sz;
+
+    return 0;
 }
 
 result_t fs_base::write(FileHandle_base* fd, Buffer_base* buffer, int32_t offset, int32_t length,
@@ -379,26 +378,24 @@ result_t fs_base::write(FileHandle_base* fd, Buffer_base* buffer, int32_t offset
     if (length < 0)
         length = bufLength - offset;
 
-    if (position > -1) {
-        if (_lseeki64(_fd, position, SEEK_SET) < 0)
-            return CHECK_ERROR(LastError());
-    }
-
-    if (length > 0) {
-        Buffer* buf = Buffer::Cast(buffer);
-        int32_t sz = length;
-        const uint8_t* p = buf->data() + offset;
+    int64_t pos = position;
+    int32_t sz = length;
+    const uint8_t* p = Buffer::Cast(buffer)->data() + offset;
 
-        while (sz) {
-            int32_t n = (int32_t)::_write(_fd, p, sz > STREAM_BUFF_SIZE ? STREAM_BUFF_SIZE : sz);
-            if (n < 0)
-                return CHECK_ERROR(LastError());
+    while (sz) {
+        int32_t n = uring_write(_fd, p, sz > STREAM_BUFF_SIZE ? STREAM_BUFF_SIZE : sz, pos);
+        if (n < 0)
+            return CHECK_ERROR(LastError());
 
-            sz -= n;
-            p += n;
-        }
+        sz -= n;
+        p += n;
+        if (pos > -1)
+            pos += n;
     }
 
+    if (pos > -1 && _lseeki64(_fd, pos, SEEK_SET) < 0)
+        return CHECK_ERROR(LastError());
+
     retVal = length;
 
     return 0;
@@ -436,14 +433,14 @@ result_t fs_base::fstat(FileHandle_base* fd, obj_ptr<Stat_base>& retVal, AsyncEv
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_NOSYNC);
 
-    AutoReq req;
-    int32_t ret = uv_fs_fstat(NULL, &req, _fd, NULL);
+    uv_stat_t statbuf;
+    int32_t ret = uring_fstat(_fd, &statbuf);
     if (ret < 0)
         return ret;
 
     obj_ptr<Stat> pStat = new Stat();
 
-    pStat->fill("", &req.statbuf);
+    pStat->fill("", &statbuf);
     retVal = pStat;
 
     return 0;
@@ -694,8 +691,7 @@ result_t fs_base::fsync(FileHandle_base* fd, AsyncEvent* ac)
     int32_t _fd;
     fd->get_fd(_fd);
 
-    AutoReq req;
-    return uv_fs_fsync(NULL, &req, _fd, NULL);
+    return uring_fsync(_fd);
 }
 
 result_t fs_base::chmod(exlib::string path, int32_t mode, AsyncEvent* ac)
@@ -742,8 +738,7 @@ result_t fs_base::fdatasync(FileHandle_base* fd, AsyncEvent* ac)
     int32_t _fd;
     fd->get_fd(_fd);
 
-    AutoReq req;
-    return uv_fs_fdatasync(NULL, &req, _fd, NULL);
+    return uring_fsync(_fd, true);
 }
 
 result_t fs_base::copyFile(exlib::string from, exlib::string to, int32_t mode, AsyncEvent* ac)
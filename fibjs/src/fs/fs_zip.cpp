@@ -266,14 +266,14 @@ result_t fs_base::lstat(exlib::string path, obj_ptr<Stat_base>& retVal, AsyncEve
     if (!ac->isolate()->m_enable_FileSystem)
         return CHECK_ERROR(CALL_E_INVALID_CALL);
 
-    AutoReq req;
-    int32_t ret = uv_fs_lstat(NULL, &req, safe_name.c_str(), NULL);
+    uv_stat_t statbuf;
+    int32_t ret = uring_stat(safe_name.c_str(), false, &statbuf);
     if (ret < 0)
         return ret;
 
     obj_ptr<Stat> pStat = new Stat();
 
-    pStat->fill(safe_name, &req.statbuf);
+    pStat->fill(safe_name, &statbuf);
     retVal = pStat;
 
     return 0;
@@ -294,14 +294,14 @@ result_t fs_base::stat(exlib::string path, obj_ptr<Stat_base>& retVal, AsyncEven
     if (!ac->isolate()->m_enable_FileSystem)
         return CHECK_ERROR(CALL_E_INVALID_CALL);
 
-    AutoReq req;
-    int32_t ret = uv_fs_stat(NULL, &req, safe_name.c_str(), NULL);
+    uv_stat_t statbuf;
+    int32_t ret = uring_stat(safe_name.c_str(), true, &statbuf);
     if (ret < 0)
         return ret;
 
     obj_ptr<Stat> pStat = new Stat();
 
-    pStat->fill(safe_name, &req.statbuf);
+    pStat->fill(safe_name, &statbuf);
     retVal = pStat;
 
     return 0;
@@ -0,0 +1,577 @@
+/*
+ * Hpack.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "Hpack.h"
+#include <unordered_map>
+
+namespace fibjs {
+
+static const uint32_t s_huff_codes[257] = {
+    0x00001ff8, 0x007fffd8, 0x0fffffe2, 0x0fffffe3, 0x0fffffe4, 0x0fffffe5, 0x0fffffe6, 0x0fffffe7,
+    0x0fffffe8, 0x00ffffea, 0x3ffffffc, 0x0fffffe9, 0x0fffffea, 0x3ffffffd, 0x0fffffeb, 0x0fffffec,
+    0x0fffffed, 0x0fffffee, 0x0fffffef, 0x0ffffff0, 0x0ffffff1, 0x0ffffff2, 0x3ffffffe, 0x0ffffff3,
+    0x0ffffff4, 0x0ffffff5, 0x0ffffff6, 0x0ffffff7, 0x0ffffff8, 0x0ffffff9, 0x0ffffffa, 0x0ffffffb,
+    0x00000014, 0x000003f8, 0x000003f9, 0x00000ffa, 0x00001ff9, 0x00000015, 0x000000f8, 0x000007fa,
+    0x000003fa, 0x000003fb, 0x000000f9, 0x000007fb, 0x000000fa, 0x00000016, 0x00000017, 0x00000018,
+    0x00000000, 0x00000001, 0x00000002, 0x00000019, 0x0000001a, 0x0000001b, 0x0000001c, 0x0000001d,
+    0x0000001e, 0x0000001f, 0x0000005c, 0x000000fb, 0x00007ffc, 0x00000020, 0x00000ffb, 0x000003fc,
+    0x00001ffa, 0x00000021, 0x0000005d, 0x0000005e, 0x0000005f, 0x00000060, 0x00000061, 0x00000062,
+    0x00000063, 0x00000064, 0x00000065, 0x00000066, 0x00000067, 0x00000068, 0x00000069, 0x0000006a,
+    0x0000006b, 0x0000006c, 0x0000006d, 0x0000006e, 0x0000006f, 0x00000070, 0x00000071, 0x00000072,
+    0x000000fc, 0x00000073, 0x000000fd, 0x00001ffb, 0x0007fff0, 0x00001ffc, 0x00003ffc, 0x00000022,
+    0x00007ffd, 0x00000003, 0x00000023, 0x00000004, 0x00000024, 0x00000005, 0x00000025, 0x00000026,
+    0x00000027, 0x00000006, 0x00000074, 0x00000075, 0x00000028, 0x00000029, 0x0000002a, 0x00000007,
+    0x0000002b, 0x00000076, 0x0000002c, 0x00000008, 0x00000009, 0x0000002d, 0x00000077, 0x00000078,
+    0x00000079, 0x0000007a, 0x0000007b, 0x00007ffe, 0x000007fc, 0x00003ffd, 0x00001ffd, 0x0ffffffc,
+    0x000fffe6, 0x003fffd2, 0x000fffe7, 0x000fffe8, 0x003fffd3, 0x003fffd4, 0x003fffd5, 0x007fffd9,
+    0x003fffd6, 0x007fffda, 0x007fffdb, 0x007fffdc, 0x007fffdd, 0x007fffde, 0x00ffffeb, 0x007fffdf,
+    0x00ffffec, 0x00ffffed, 0x003fffd7, 0x007fffe0, 0x00ffffee, 0x007fffe1, 0x007fffe2, 0x007fffe3,
+    0x007fffe4, 0x001fffdc, 0x003fffd8, 0x007fffe5, 0x003fffd9, 0x007fffe6, 0x007fffe7, 0x00ffffef,
+    0x003fffda, 0x001fffdd, 0x000fffe9, 0x003fffdb, 0x003fffdc, 0x007fffe8, 0x007fffe9, 0x001fffde,
+    0x007fffea, 0x003fffdd, 0x003fffde, 0x00fffff0, 0x001fffdf, 0x003fffdf, 0x007fffeb, 0x007fffec,
+    0x001fffe0, 0x001fffe1, 0x003fffe0, 0x001fffe2, 0x007fffed, 0x003fffe1, 0x007fffee, 0x007fffef,
+    0x000fffea, 0x003fffe2, 0x003fffe3, 0x003fffe4, 0x007ffff0, 0x003fffe5, 0x003fffe6, 0x007ffff1,
+    0x03ffffe0, 0x03ffffe1, 0x000fffeb, 0x0007fff1, 0x003fffe7, 0x007ffff2, 0x003fffe8, 0x01ffffec,
+    0x03ffffe2, 0x03ffffe3, 0x03ffffe4, 0x07ffffde, 0x07ffffdf, 0x03ffffe5, 0x00fffff1, 0x01ffffed,
+    0x0007fff2, 0x001fffe3, 0x03ffffe6, 0x07ffffe0, 0x07ffffe1, 0x03ffffe7, 0x07ffffe2, 0x00fffff2,
+    0x001fffe4, 0x001fffe5, 0x03ffffe8, 0x03ffffe9, 0x0ffffffd, 0x07ffffe3, 0x07ffffe4, 0x07ffffe5,
+    0x000fffec, 0x00fffff3, 0x000fffed, 0x001fffe6, 0x003fffe9, 0x001fffe7, 0x001fffe8, 0x007ffff3,
+    0x003fffea, 0x003fffeb, 0x01ffffee, 0x01ffffef, 0x00fffff4, 0x00fffff5, 0x03ffffea, 0x007ffff4,
+    0x03ffffeb, 0x07ffffe6, 0x03ffffec, 0x03ffffed, 0x07ffffe7, 0x07ffffe8, 0x07ffffe9, 0x07ffffea,
+    0x07ffffeb, 0x0ffffffe, 0x07ffffec, 0x07ffffed, 0x07ffffee, 0x07ffffef, 0x07fffff0, 0x03ffffee,
+    0x3fffffff
+};
+
+static const uint8_t s_huff_lens[257] = {
+    13, 23, 28, 28, 28, 28, 28, 28, 28, 24, 30, 28, 28, 30, 28, 28,
+    28, 28, 28, 28, 28, 28, 30, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+    6, 10, 10, 12, 13, 6, 8, 11, 10, 10, 8, 11, 8, 6, 6, 6,
+    5, 5, 5, 6, 6, 6, 6, 6, 6, 6, 7, 8, 15, 6, 12, 10,
+    13, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+    7, 7, 7, 7, 7, 7, 7, 7, 8, 7, 8, 13, 19, 13, 14, 6,
+    15, 5, 6, 5, 6, 5, 6, 6, 6, 5, 7, 7, 6, 6, 6, 5,
+    6, 7, 6, 5, 5, 6, 7, 7, 7, 7, 7, 15, 11, 14, 13, 28,
+    20, 22, 20, 20, 22, 22, 22, 23, 22, 23, 23, 23, 23, 23, 24, 23,
+    24, 24, 22, 23, 24, 23, 23, 23, 23, 21, 22, 23, 22, 23, 23, 24,
+    22, 21, 20, 22, 22, 23, 23, 21, 23, 22, 22, 24, 21, 22, 23, 23,
+    21, 21, 22, 21, 23, 22, 23, 23, 20, 22, 22, 22, 23, 22, 22, 23,
+    26, 26, 20, 19, 22, 23, 22, 25, 26, 26, 26, 27, 27, 26, 24, 25,
+    19, 21, 26, 27, 27, 26, 27, 24, 21, 21, 26, 26, 28, 27, 27, 27,
+    20, 24, 20, 21, 22, 21, 21, 23, 22, 22, 25, 25, 24, 24, 26, 23,
+    26, 27, 26, 26, 27, 27, 27, 27, 27, 28, 27, 27, 27, 27, 27, 26,
+    30
+};
+
+static const struct {
+    const char* name;
+    const char* value;
+} s_static_table[Hpack::HPACK_STATIC_SIZE] = {
+    { ":authority", "" },
+    { ":method", "GET" },
+    { ":method", "POST" },
+    { ":path", "/" },
+    { ":path", "/index.html" },
+    { ":scheme", "http" },
+    { ":scheme", "https" },
+    { ":status", "200" },
+    { ":status", "204" },
+    { ":status", "206" },
+    { ":status", "304" },
+    { ":status", "400" },
+    { ":status", "404" },
+    { ":status", "500" },
+    { "accept-charset", "" },
+    { "accept-encoding", "gzip, deflate" },
+    { "accept-language", "" },
+    { "accept-ranges", "" },
+    { "accept", "" },
+    { "access-control-allow-origin", "" },
+    { "age", "" },
+    { "allow", "" },
+    { "authorization", "" },
+    { "cache-control", "" },
+    { "content-disposition", "" },
+    { "content-encoding", "" },
+    { "content-language", "" },
+    { "content-length", "" },
+    { "content-location", "" },
+    { "content-range", "" },
+    { "content-type", "" },
+    { "cookie", "" },
+    { "date", "" },
+    { "etag", "" },
+    { "expect", "" },
+    { "expires", "" },
+    { "from", "" },
+    { "host", "" },
+    { "if-match", "" },
+    { "if-modified-since", "" },
+    { "if-none-match", "" },
+    { "if-range", "" },
+    { "if-unmodified-since", "" },
+    { "last-modified", "" },
+    { "link", "" },
+    { "location", "" },
+    { "max-forwards", "" },
+    { "proxy-authenticate", "" },
+    { "proxy-authorization", "" },
+    { "range", "" },
+    { "referer", "" },
+    { "refresh", "" },
+    { "retry-after", "" },
+    { "server", "" },
+    { "set-cookie", "" },
+    { "strict-transport-security", "" },
+    { "transfer-encoding", "" },
+    { "user-agent", "" },
+    { "vary", "" },
+    { "via", "" },
+    { "www-authenticate", "" }
+};
+
+class _static_index {
+public:
+    _static_index()
+    {
+        for (int32_t i = Hpack::HPACK_STATIC_SIZE - 1; i >= 0; i--) {
+            exlib::string name(s_static_table[i].name);
+            exlib::string key(name);
+
+            key.append(1, '\0');
+            key.append(s_static_table[i].value);
+
+            m_names[name] = i + 1;
+            m_pairs[key] = i + 1;
+        }
+
+        for (int32_t i = 0; i < Hpack::HPACK_STATIC_SIZE; i++)
+            m_headers.push_back(Hpack::header(s_static_table[i].name, s_static_table[i].value));
+    }
+
+public:
+    std::unordered_map<exlib::string, uint32_t> m_names;
+    std::unordered_map<exlib::string, uint32_t> m_pairs;
+    std::vector<Hpack::header> m_headers;
+};
+
+static _static_index& static_index()
+{
+    static _static_index s_index;
+    return s_index;
+}
+
+// decoding walks a binary tree built from the code table, leaves hold ~symbol
+class _huffman_tree {
+public:
+    _huffman_tree()
+    {
+        m_nodes.push_back(node());
+
+        for (int32_t sym = 0; sym < 257; sym++) {
+            uint32_t code = s_huff_codes[sym];
+            int32_t len = s_huff_lens[sym];
+            int32_t n = 0;
+
+            for (int32_t i = len - 1; i > 0; i--) {
+                int32_t b = (code >> i) & 1;
+
+                if (!m_nodes[n].m_child[b]) {
+                    m_nodes[n].m_child[b] = (int16_t)m_nodes.size();
+                    m_nodes.push_back(node());
+                }
+
+                n = m_nodes[n].m_child[b];
+            }
+
+            m_nodes[n].m_child[code & 1] = (int16_t)~sym;
+        }
+    }
+
+public:
+    class node {
+    public:
+        node()
+        {
+            m_child[0] = m_child[1] = 0;
+        }
+
+    public:
+        int16_t m_child[2];
+    };
+
+    std::vector<node> m_nodes;
+};
+
+static _huffman_tree& huffman_tree()
+{
+    static _huffman_tree s_tree;
+    return s_tree;
+}
+
+void Hpack::encode_int(exlib::string& out, uint8_t prefix, int32_t bits, uint32_t value)
+{
+    uint32_t max = (1 << bits) - 1;
+
+    if (value < max) {
+        out.append(1, (char)(prefix | value));
+        return;
+    }
+
+    out.append(1, (char)(prefix | max));
+    value -= max;
+
+    while (value >= 128) {
+        out.append(1, (char)((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+
+    out.append(1, (char)value);
+}
+
+bool Hpack::decode_int(const uint8_t*& p, const uint8_t* end, int32_t bits, uint32_t& value)
+{
+    uint32_t max = (1 << bits) - 1;
+    int32_t shift = 0;
+
+    if (p >= end)
+        return false;
+
+    value = *p++ & max;
+    if (value < max)
+        return true;
+
+    while (p < end) {
+        uint8_t ch = *p++;
+
+        if (shift > 21)
+            return false;
+
+        value += (uint32_t)(ch & 0x7f) << shift;
+        shift += 7;
+
+        if (!(ch & 0x80))
+            return true;
+    }
+
+    return false;
+}
+
+size_t Hpack::huffman_size(const exlib::string& str)
+{
+    const uint8_t* p = (const uint8_t*)str.c_str();
+    size_t bits = 0;
+
+    for (size_t i = 0; i < str.length(); i++)
+        bits += s_huff_lens[p[i]];
+
+    return (bits + 7) / 8;
+}
+
+void Hpack::huffman_encode(exlib::string& out, const exlib::string& str)
+{
+    const uint8_t* p = (const uint8_t*)str.c_str();
+    uint64_t acc = 0;
+    int32_t bits = 0;
+
+    for (size_t i = 0; i < str.length(); i++) {
+        acc = (acc << s_huff_lens[p[i]]) | s_huff_codes[p[i]];
+        bits += s_huff_lens[p[i]];
+
+        while (bits >= 8) {
+            bits -= 8;
+            out.append(1, (char)(acc >> bits));
+        }
+    }
+
+    // the last byte is padded with the most significant bits of EOS
+    if (bits)
+        out.append(1, (char)((acc << (8 - bits)) | (0xff >> bits)));
+}
+
+bool Hpack::huffman_decode(const uint8_t* p, size_t len, exlib::string& str)
+{
+    const std::vector<_huffman_tree::node>& nodes = huffman_tree().m_nodes;
+    int32_t n = 0;
+    int32_t depth = 0;
+    bool ones = true;
+
+    str.clear();
+
+    for (size_t i = 0; i < len; i++) {
+        uint8_t ch = p[i];
+
+        for (int32_t bit = 7; bit >= 0; bit--) {
+            int32_t b = (ch >> bit) & 1;
+            int32_t next = nodes[n].m_child[b];
+
+            if (next < 0) {
+                int32_t sym = ~next;
+                if (sym == 256)
+                    return false;
+
+                str.append(1, (char)sym);
+                n = 0;
+                depth = 0;
+                ones = true;
+            } else if (next == 0)
+                return false;
+            else {
+                n = next;
+                depth++;
+                ones = ones && b;
+            }
+        }
+    }
+
+    return depth < 8 && ones;
+}
+
+void Hpack::encode_str(exlib::string& out, const exlib::string& str)
+{
+    size_t hsz = huffman_size(str);
+
+    if (hsz < str.length()) {
+        encode_int(out, 0x80, 7, (uint32_t)hsz);
+        huffman_encode(out, str);
+    } else {
+        encode_int(out, 0, 7, (uint32_t)str.length());
+        out.append(str);
+    }
+}
+
+bool Hpack::decode_str(const uint8_t*& p, const uint8_t* end, exlib::string& str)
+{
+    if (p >= end)
+        return false;
+
+    bool huffman = (*p & 0x80) != 0;
+    uint32_t len;
+
+    if (!decode_int(p, end, 7, len))
+        return false;
+
+    if (len > (uint32_t)(end - p))
+        return false;
+
+    if (huffman) {
+        if (!huffman_decode(p, len, str))
+            return false;
+    } else
+        str.assign((const char*)p, len);
+
+    p += len;
+    return true;
+}
+
+const Hpack::header* Hpack::Table::get(uint32_t index) const
+{
+    if (index == 0)
+        return NULL;
+
+    if (index <= HPACK_STATIC_SIZE)
+        return &static_index().m_headers[index - 1];
+
+    index -= HPACK_STATIC_SIZE + 1;
+    if (index >= m_entries.size())
+        return NULL;
+
+    return &m_entries[index];
+}
+
+void Hpack::Table::add(const exlib::string& name, const exlib::string& value)
+{
+    uint32_t sz = (uint32_t)(name.length() + value.length() + HPACK_ENTRY_OVERHEAD);
+
+    // an entry larger than the table empties it and is not added, RFC 7541 4.4
+    if (sz > m_maxSize) {
+        m_entries.clear();
+        m_size = 0;
+        return;
+    }
+
+    while (m_size + sz > m_maxSize) {
+        header& h = m_entries.back();
+        m_size -= (uint32_t)(h.first.length() + h.second.length() + HPACK_ENTRY_OVERHEAD);
+        m_entries.pop_back();
+    }
+
+    m_entries.push_front(header(name, value));
+    m_size += sz;
+}
+
+void Hpack::Table::resize(uint32_t maxSize)
+{
+    m_maxSize = maxSize;
+
+    while (m_size > m_maxSize) {
+        header& h = m_entries.back();
+        m_size -= (uint32_t)(h.first.length() + h.second.length() + HPACK_ENTRY_OVERHEAD);
+        m_entries.pop_back();
+    }
+}
+
+uint32_t Hpack::Table::find(const exlib::string& name, const exlib::string& value, bool& exact) const
+{
+    _static_index& si = static_index();
+    exlib::string key(name);
+    uint32_t index = 0;
+
+    key.append(1, '\0');
+    key.append(value);
+
+    exact = false;
+
+    std::unordered_map<exlib::string, uint32_t>::const_iterator it = si.m_pairs.find(key);
+    if (it != si.m_pairs.end()) {
+        exact = true;
+        return it->second;
+    }
+
+    it = si.m_names.find(name);
+    if (it != si.m_names.end())
+        index = it->second;
+
+    for (size_t i = 0; i < m_entries.size(); i++) {
+        const header& h = m_entries[i];
+
+        if (h.first == name) {
+            if (h.second == value) {
+                exact = true;
+                return (uint32_t)(i + HPACK_STATIC_SIZE + 1);
+            }
+
+            if (!index)
+                index = (uint32_t)(i + HPACK_STATIC_SIZE + 1);
+        }
+    }
+
+    return index;
+}
+
+void Hpack::Encoder::set_max_size(uint32_t maxSize)
+{
+    // the table never grows past the default, a larger peer setting only allows it
+    if (maxSize > HPACK_DEFAULT_SIZE)
+        maxSize = HPACK_DEFAULT_SIZE;
+
+    if (maxSize != m_limit) {
+        m_limit = maxSize;
+        m_pending = true;
+    }
+}
+
+void Hpack::Encoder::encode(const exlib::string& name, const exlib::string& value, exlib::string& out)
+{
+    bool exact;
+    uint32_t index = m_table.find(name, value, exact);
+
+    if (exact) {
+        encode_int(out, 0x80, 7, index);
+        return;
+    }
+
+    // credentials are never indexed, so that they cannot be probed through the table
+    bool sensitive = !qstrcmp(name.c_str(), "authorization") || !qstrcmp(name.c_str(), "proxy-authorization")
+        || (!qstrcmp(name.c_str(), "cookie") && value.length() < 20);
+    uint32_t sz = (uint32_t)(name.length() + value.length() + HPACK_ENTRY_OVERHEAD);
+
+    if (sensitive)
+        encode_int(out, 0x10, 4, index);
+    else if (sz > m_table.m_maxSize / 2)
+        encode_int(out, 0, 4, index);
+    else
+        encode_int(out, 0x40, 6, index);
+
+    if (!index)
+        encode_str(out, name);
+    encode_str(out, value);
+
+    if (!sensitive && sz <= m_table.m_maxSize / 2)
+        m_table.add(name, value);
+}
+
+void Hpack::Encoder::encode(const std::vector<header>& headers, exlib::string& out)
+{
+    if (m_pending) {
+        m_pending = false;
+        m_table.resize(m_limit);
+        encode_int(out, 0x20, 5, m_limit);
+    }
+
+    for (size_t i = 0; i < headers.size(); i++)
+        encode(headers[i].first, headers[i].second, out);
+}
+
+result_t Hpack::Decoder::decode(const uint8_t* data, size_t len, std::vector<header>& headers, size_t maxSize)
+{
+    const uint8_t* p = data;
+    const uint8_t* end = data + len;
+    size_t total = 0;
+    bool first = true;
+
+    while (p < end) {
+        uint8_t ch = *p;
+        uint32_t index;
+        exlib::string name;
+        exlib::string value;
+
+        if (ch & 0x80) {
+            if (!decode_int(p, end, 7, index))
+                return CHECK_ERROR(Runtime::setError("Hpack: invalid integer."));
+
+            const header* h = m_table.get(index);
+            if (!h)
+                return CHECK_ERROR(Runtime::setError("Hpack: invalid index."));
+
+            name = h->first;
+            value = h->second;
+        } else if ((ch & 0xe0) == 0x20) {
+            // size updates are only allowed at the start of a header block
+            if (!first)
+                return CHECK_ERROR(Runtime::setError("Hpack: unexpected table size update."));
+
+            if (!decode_int(p, end, 5, index) || index > m_limit)
+                return CHECK_ERROR(Runtime::setError("Hpack: invalid table size."));
+
+            m_table.resize(index);
+            continue;
+        } else {
+            bool indexing = (ch & 0xc0) == 0x40;
+
+            if (!decode_int(p, end, indexing ? 6 : 4, index))
+                return CHECK_ERROR(Runtime::setError("Hpack: invalid integer."));
+
+            if (index) {
+                const header* h = m_table.get(index);
+                if (!h)
+                    return CHECK_ERROR(Runtime::setError("Hpack: invalid index."));
+
+                name = h->first;
+            } else if (!decode_str(p, end, name))
+                return CHECK_ERROR(Runtime::setError("Hpack: invalid string."));
+
+            if (!decode_str(p, end, value))
+                return CHECK_ERROR(Runtime::setError("Hpack: invalid string."));
+
+            if (indexing)
+                m_table.add(name, value);
+        }
+
+        first = false;
+
+        total += name.length() + value.length() + HPACK_ENTRY_OVERHEAD;
+        if (maxSize && total > maxSize)
+            return CHECK_ERROR(Runtime::setError("Hpack: header list too large."));
+
+        headers.push_back(header(name, value));
+    }
+
+    return 0;
+}
+
+} /* namespace fibjs */
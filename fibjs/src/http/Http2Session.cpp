@@ -0,0 +1,1433 @@
+/*
+ * Http2Session.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "Http2Session.h"
+#include "HttpRequest.h"
+#include "HttpResponse.h"
+#include "MemoryStream.h"
+#include "Buffer.h"
+#include <inttypes.h>
+
+namespace fibjs {
+
+static const char s_preface[] = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+
+static inline uint32_t get_u32(const uint8_t* p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static inline void put_u32(exlib::string& out, uint32_t v)
+{
+    out.append(1, (char)(v >> 24));
+    out.append(1, (char)(v >> 16));
+    out.append(1, (char)(v >> 8));
+    out.append(1, (char)v);
+}
+
+// connection specific headers are not allowed in HTTP/2, RFC 9113 8.2.2
+static bool is_connection_header(const exlib::string& name)
+{
+    return name == "connection" || name == "keep-alive" || name == "proxy-connection"
+        || name == "transfer-encoding" || name == "upgrade";
+}
+
+void Http2Session::frame(exlib::string& out, int32_t type, int32_t flags, int32_t id,
+    const char* data, size_t len)
+{
+    out.append(1, (char)(len >> 16));
+    out.append(1, (char)(len >> 8));
+    out.append(1, (char)len);
+    out.append(1, (char)type);
+    out.append(1, (char)flags);
+    put_u32(out, (uint32_t)id & 0x7fffffff);
+
+    if (len)
+        out.append(data, len);
+}
+
+void Http2Session::settings(exlib::string& out, int32_t id, uint32_t value)
+{
+    out.append(1, (char)(id >> 8));
+    out.append(1, (char)id);
+    put_u32(out, value);
+}
+
+void Http2Session::send_rst(int32_t id, int32_t code)
+{
+    exlib::string payload;
+
+    put_u32(payload, code);
+    frame(m_frames, FRAME_RST_STREAM, 0, id, payload.c_str(), payload.length());
+}
+
+void Http2Session::send_goaway(int32_t code)
+{
+    exlib::string payload;
+
+    put_u32(payload, m_lastPeerId);
+    put_u32(payload, code);
+    frame(m_frames, FRAME_GOAWAY, 0, 0, payload.c_str(), payload.length());
+}
+
+void Http2Session::send_headers(Stream* s, exlib::string& block)
+{
+    size_t pos = 0;
+    size_t len = block.length();
+    int32_t type = FRAME_HEADERS;
+    int32_t endStream = s->m_out.empty() && s->m_outEnd ? FLAG_END_STREAM : 0;
+
+    // a header block larger than one frame continues in CONTINUATION frames
+    do {
+        size_t sz = len - pos;
+        if (sz > (size_t)m_peerMaxFrameSize)
+            sz = m_peerMaxFrameSize;
+
+        int32_t flags = pos + sz == len ? FLAG_END_HEADERS : 0;
+        if (type == FRAME_HEADERS)
+            flags |= endStream;
+
+        frame(m_frames, type, flags, s->m_id, block.c_str() + pos, sz);
+
+        pos += sz;
+        type = FRAME_CONTINUATION;
+    } while (pos < len);
+
+    if (endStream)
+        end_local(s);
+}
+
+class asyncH2Send : public AsyncState {
+public:
+    asyncH2Send(Http2Session* pThis, Stream_base* conn)
+        : AsyncState(NULL)
+        , m_pThis(pThis)
+        , m_conn(conn)
+    {
+        next(send);
+    }
+
+    ON_STATE(asyncH2Send, send)
+    {
+        exlib::string out;
+        bool bMore = m_pThis->pull(out);
+
+        m_pThis->done();
+
+        if (!bMore) {
+            if (m_pThis->m_closed)
+                return m_conn->close(next());
+            return next();
+        }
+
+        m_buffer = new Buffer(out.c_str(), out.length());
+        return m_conn->write(m_buffer, next(send));
+    }
+
+    virtual int32_t error(int32_t v)
+    {
+        m_pThis->m_lock.lock();
+        m_pThis->m_writing = false;
+        m_pThis->m_lock.unlock();
+
+        m_pThis->shutdown(Runtime::errMessage());
+        return v;
+    }
+
+private:
+    obj_ptr<Http2Session> m_pThis;
+    obj_ptr<Stream_base> m_conn;
+    obj_ptr<Buffer_base> m_buffer;
+};
+
+class asyncH2Read : public AsyncState {
+public:
+    asyncH2Read(Http2Session* pThis, Stream_base* conn)
+        : AsyncState(NULL)
+        , m_pThis(pThis)
+        , m_conn(conn)
+    {
+        next(read);
+    }
+
+    ON_STATE(asyncH2Read, read)
+    {
+        if (m_pThis->m_closed) {
+            m_pThis->shutdown("Http2Session: session closed.");
+            return next();
+        }
+
+        return m_conn->read(-1, m_buffer, next(parse));
+    }
+
+    ON_STATE(asyncH2Read, parse)
+    {
+        if (n == CALL_RETURN_NULL)
+            return CHECK_ERROR(Runtime::setError("Http2Session: connection closed."));
+
+        Buffer* buf = Buffer::Cast(m_buffer);
+        result_t hr = m_pThis->feed(buf->data(), buf->length());
+        m_buffer.Release();
+
+        if (hr < 0)
+            return hr;
+
+        return next(read);
+    }
+
+    virtual int32_t error(int32_t v)
+    {
+        m_pThis->shutdown(Runtime::errMessage());
+        return v;
+    }
+
+private:
+    obj_ptr<Http2Session> m_pThis;
+    obj_ptr<Stream_base> m_conn;
+    obj_ptr<Buffer_base> m_buffer;
+};
+
+void Http2Session::start()
+{
+    m_last.now();
+
+    m_lock.lock();
+
+    exlib::string payload;
+
+    if (m_server)
+        settings(payload, SETTINGS_MAX_CONCURRENT_STREAMS, m_maxStreams);
+    else {
+        m_frames.append(s_preface, sizeof(s_preface) - 1);
+        settings(payload, SETTINGS_ENABLE_PUSH, 0);
+    }
+
+    // a smaller table only binds the peer once it has acknowledged our settings
+    if (m_tableSize != Hpack::HPACK_DEFAULT_SIZE) {
+        settings(payload, SETTINGS_HEADER_TABLE_SIZE, m_tableSize);
+        if (m_tableSize > Hpack::HPACK_DEFAULT_SIZE)
+            m_decoder.set_limit(m_tableSize);
+    }
+
+    settings(payload, SETTINGS_INITIAL_WINDOW_SIZE, STREAM_WINDOW);
+    settings(payload, SETTINGS_MAX_HEADER_LIST_SIZE, max_header_list());
+    frame(m_frames, FRAME_SETTINGS, 0, 0, payload.c_str(), payload.length());
+
+    payload.clear();
+    put_u32(payload, SESSION_WINDOW - DEFAULT_WINDOW);
+    frame(m_frames, FRAME_WINDOW_UPDATE, 0, 0, payload.c_str(), payload.length());
+
+    m_lock.unlock();
+
+    flush();
+    (new asyncH2Read(this, m_conn))->apost(0);
+}
+
+result_t Http2Session::serve(bool bPreface, AsyncEvent* ac)
+{
+    if (bPreface)
+        m_preface = sizeof(s_preface) - 1;
+    m_closeAc = ac;
+
+    start();
+
+    return CALL_E_PENDDING;
+}
+
+void Http2Session::close()
+{
+    m_lock.lock();
+    if (!m_closed)
+        send_goaway(NO_ERROR);
+    m_lock.unlock();
+
+    shutdown("Http2Session: session closed.");
+}
+
+bool Http2Session::idle(date_t d, double timeout)
+{
+    bool bIdle;
+
+    m_lock.lock();
+    bIdle = !m_closed && m_streams.empty() && m_pending.empty() && d.diff(m_last) >= timeout;
+    m_lock.unlock();
+
+    return bIdle;
+}
+
+size_t Http2Session::max_header_list()
+{
+    return (size_t)m_maxHeadersCount * (m_maxHeaderSize + Hpack::HPACK_ENTRY_OVERHEAD);
+}
+
+void Http2Session::flush()
+{
+    bool bSend = false;
+
+    m_lock.lock();
+    if (!m_writing)
+        m_writing = bSend = true;
+    m_lock.unlock();
+
+    if (bSend)
+        (new asyncH2Send(this, m_conn))->apost(0);
+}
+
+bool Http2Session::pull(exlib::string& out)
+{
+    m_lock.lock();
+
+    out.swap(m_frames);
+    m_frames.clear();
+
+    // one DATA frame per stream and pass keeps streams sharing the connection window fairly
+    bool bProgress = true;
+    while (bProgress && !m_sending.empty() && out.length() < 65536) {
+        size_t cnt = m_sending.size();
+
+        bProgress = false;
+        while (cnt--) {
+            obj_ptr<Stream> s = m_sending.front();
+            m_sending.pop_front();
+
+            size_t remain = s->m_out.length() - s->m_outPos;
+            if (remain == 0) {
+                frame(out, FRAME_DATA, FLAG_END_STREAM, s->m_id, NULL, 0);
+                end_local(s);
+                bProgress = true;
+                continue;
+            }
+
+            int32_t sz = (int32_t)(remain > (size_t)m_peerMaxFrameSize ? m_peerMaxFrameSize : remain);
+            if (sz > m_sendWindow)
+                sz = m_sendWindow;
+            if (sz > s->m_sendWindow)
+                sz = s->m_sendWindow;
+
+            if (sz <= 0) {
+                m_sending.push_back(s);
+                continue;
+            }
+
+            bool bEnd = (size_t)sz == remain;
+
+            frame(out, FRAME_DATA, bEnd ? FLAG_END_STREAM : 0, s->m_id, s->m_out.c_str() + s->m_outPos, sz);
+            s->m_outPos += sz;
+            s->m_sendWindow -= sz;
+            m_sendWindow -= sz;
+            bProgress = true;
+
+            if (bEnd) {
+                s->m_out.clear();
+                s->m_outPos = 0;
+                end_local(s);
+            } else
+                m_sending.push_back(s);
+        }
+    }
+
+    if (out.empty())
+        m_writing = false;
+
+    m_lock.unlock();
+
+    return !out.empty();
+}
+
+result_t Http2Session::request(HttpRequest_base* req, SeekableStream_base* response_body,
+    obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac)
+{
+    class asyncRequest : public AsyncState {
+    public:
+        asyncRequest(Http2Session* pThis, HttpRequest_base* req, SeekableStream_base* response_body,
+            obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac)
+            : AsyncState(ac)
+            , m_pThis(pThis)
+            , m_req(req)
+            , m_response_body(response_body)
+            , m_retVal(retVal)
+        {
+            next(body);
+        }
+
+        ON_STATE(asyncRequest, body)
+        {
+            int64_t len = 0;
+
+            m_req->get_length(len);
+            if (len <= 0)
+                return next(submit);
+
+            m_req->get_body(m_body);
+            m_body->rewind();
+            return m_body->readAll(m_buffer, next(submit));
+        }
+
+        ON_STATE(asyncRequest, submit)
+        {
+            obj_ptr<Stream> s = new Stream(0, 0);
+
+            s->m_outEnd = true;
+            if (m_buffer) {
+                Buffer* buf = Buffer::Cast(m_buffer);
+                s->m_out.assign((const char*)buf->data(), buf->length());
+            }
+
+            exlib::string method;
+            m_req->get_method(method);
+            s->m_noBody = !qstricmp(method.c_str(), "head");
+
+            result_t hr = Http2Session::build(m_req, s->m_headers);
+            if (hr < 0)
+                return hr;
+
+            if (!s->m_out.empty()) {
+                char len[32];
+                snprintf(len, sizeof(len), "%zu", s->m_out.length());
+                s->m_headers.push_back(Hpack::header("content-length", len));
+            }
+
+            s->m_body = m_response_body;
+            s->m_retVal = &m_retVal;
+            s->m_ac = next(done);
+
+            return m_pThis->submit(s);
+        }
+
+        ON_STATE(asyncRequest, done)
+        {
+            return next();
+        }
+
+    private:
+        obj_ptr<Http2Session> m_pThis;
+        obj_ptr<HttpRequest_base> m_req;
+        obj_ptr<SeekableStream_base> m_response_body;
+        obj_ptr<HttpResponse_base>& m_retVal;
+        obj_ptr<SeekableStream_base> m_body;
+        obj_ptr<Buffer_base> m_buffer;
+    };
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new asyncRequest(this, req, response_body, retVal, ac))->post(0);
+}
+
+result_t Http2Session::build(HttpRequest_base* req, std::vector<Hpack::header>& headers)
+{
+    obj_ptr<HttpCollection_base> _hdrs;
+    exlib::string method;
+    exlib::string authority;
+    exlib::string path;
+    exlib::string query;
+
+    req->get_headers(_hdrs);
+    HttpCollection* hdrs = _hdrs.As<HttpCollection>();
+
+    hdrs->first("Host", authority);
+    if (authority.empty())
+        return CHECK_ERROR(Runtime::setError("Http2Session: missing Host header."));
+
+    req->get_method(method);
+    req->get_address(path);
+    req->get_queryString(query);
+    if (!query.empty()) {
+        path.append(1, '?');
+        path.append(query);
+    }
+    if (path.empty())
+        path.assign(1, '/');
+
+    headers.push_back(Hpack::header(":method", method));
+    headers.push_back(Hpack::header(":scheme", "https"));
+    headers.push_back(Hpack::header(":authority", authority));
+    headers.push_back(Hpack::header(":path", path));
+
+    for (size_t i = 0; i < hdrs->count(); i++) {
+        const std::pair<exlib::string, exlib::string>& h = hdrs->at(i);
+        exlib::string name(h.first);
+
+        exlib::qstrlwr(name);
+        if (name == "host" || name == "content-length" || is_connection_header(name))
+            continue;
+
+        headers.push_back(Hpack::header(name, h.second));
+    }
+
+    return 0;
+}
+
+result_t Http2Session::submit(Stream* s)
+{
+    bool bQueued = false;
+    result_t hr = 0;
+
+    m_lock.lock();
+    if (m_closed || m_goaway)
+        hr = Runtime::setError("Http2Session: session closed.");
+    else if (m_nextId < 0 || m_nextId > MAX_WINDOW - 2) {
+        m_goaway = true;
+        hr = Runtime::setError("Http2Session: stream ids exhausted.");
+    } else if ((int32_t)m_streams.size() >= m_peerMaxStreams) {
+        m_pending.push_back(s);
+        bQueued = true;
+    } else
+        open(s);
+    m_lock.unlock();
+
+    if (hr < 0)
+        return CHECK_ERROR(hr);
+
+    if (!bQueued)
+        flush();
+
+    return CALL_E_PENDDING;
+}
+
+result_t Http2Session::respond(Stream* s, HttpResponse_base* rep, bool bHead, AsyncEvent* ac)
+{
+    class asyncRespond : public AsyncState {
+    public:
+        asyncRespond(Http2Session* pThis, Stream* s, HttpResponse_base* rep, bool bHead, AsyncEvent* ac)
+            : AsyncState(ac)
+            , m_pThis(pThis)
+            , m_s(s)
+            , m_rep((HttpResponse*)rep)
+            , m_head(bHead)
+        {
+            next(body);
+        }
+
+        ON_STATE(asyncRespond, body)
+        {
+            int64_t len = 0;
+
+            m_rep->get_length(len);
+            if (m_head || len <= 0)
+                return next(submit);
+
+            m_rep->get_body(m_body);
+            m_body->rewind();
+            return m_body->readAll(m_buffer, next(submit));
+        }
+
+        ON_STATE(asyncRespond, submit)
+        {
+            std::vector<Hpack::header> headers;
+            exlib::string body;
+            int64_t len = 0;
+            char buf[32];
+
+            m_rep->flushCookies();
+
+            snprintf(buf, sizeof(buf), "%d", m_rep->m_statusCode);
+            headers.push_back(Hpack::header(":status", buf));
+
+            HttpCollection* hdrs = m_rep->m_message->m_headers;
+            for (size_t i = 0; i < hdrs->count(); i++) {
+                const std::pair<exlib::string, exlib::string>& h = hdrs->at(i);
+                exlib::string name(h.first);
+
+                exlib::qstrlwr(name);
+                if (name == "content-length" || is_connection_header(name))
+                    continue;
+
+                headers.push_back(Hpack::header(name, h.second));
+            }
+
+            if (m_buffer) {
+                Buffer* _buf = Buffer::Cast(m_buffer);
+                body.assign((const char*)_buf->data(), _buf->length());
+            }
+
+            if (m_head)
+                m_rep->get_length(len);
+            else
+                len = body.length();
+
+            snprintf(buf, sizeof(buf), "%" PRId64, len);
+            headers.push_back(Hpack::header("content-length", buf));
+
+            return m_pThis->reply(m_s, headers, body, next(done));
+        }
+
+        ON_STATE(asyncRespond, done)
+        {
+            return next();
+        }
+
+    private:
+        obj_ptr<Http2Session> m_pThis;
+        obj_ptr<Stream> m_s;
+        obj_ptr<HttpResponse> m_rep;
+        bool m_head;
+        obj_ptr<SeekableStream_base> m_body;
+        obj_ptr<Buffer_base> m_buffer;
+    };
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new asyncRespond(this, s, rep, bHead, ac))->post(0);
+}
+
+result_t Http2Session::reply(Stream* s, std::vector<Hpack::header>& headers, exlib::string& body, AsyncEvent* ac)
+{
+    result_t hr = 0;
+
+    m_lock.lock();
+
+    // a stream reset by the peer or a session gone away has nobody left to answer
+    std::unordered_map<int32_t, obj_ptr<Stream>>::iterator it = m_streams.find(s->m_id);
+    if (!m_closed && it != m_streams.end() && it->second == s) {
+        exlib::string block;
+
+        m_encoder.encode(headers, block);
+
+        s->m_out.swap(body);
+        s->m_outEnd = true;
+        send_headers(s, block);
+
+        if (!s->m_localClosed) {
+            s->m_ac = ac;
+            m_sending.push_back(s);
+            hr = CALL_E_PENDDING;
+        }
+    }
+
+    m_lock.unlock();
+
+    flush();
+    done();
+
+    return hr;
+}
+
+void Http2Session::open(Stream* s)
+{
+    exlib::string block;
+
+    s->m_id = m_nextId;
+    m_nextId += 2;
+    s->m_sendWindow = m_peerInitialWindow;
+
+    m_encoder.encode(s->m_headers, block);
+    s->m_headers.clear();
+
+    m_streams[s->m_id] = s;
+    send_headers(s, block);
+
+    if (!s->m_localClosed)
+        m_sending.push_back(s);
+}
+
+void Http2Session::release(Stream* s)
+{
+    m_streams.erase(s->m_id);
+
+    for (size_t i = 0; i < m_sending.size(); i++)
+        if (m_sending[i] == s) {
+            m_sending.erase(m_sending.begin() + i);
+            break;
+        }
+
+    if (m_streams.empty()) {
+        m_last.now();
+
+        // a session told to go away is closed once its last stream is done
+        if (m_goaway)
+            m_closed = true;
+    }
+
+    while (!m_pending.empty() && !m_goaway && !m_closed
+        && (int32_t)m_streams.size() < m_peerMaxStreams) {
+        obj_ptr<Stream> p = m_pending.front();
+        m_pending.pop_front();
+        open(p);
+    }
+}
+
+void Http2Session::end_local(Stream* s)
+{
+    s->m_localClosed = true;
+    if (!m_server)
+        return;
+
+    // a response sent before the whole request arrived cuts the request short, RFC 9113 8.1
+    if (!s->m_remoteClosed)
+        send_rst(s->m_id, NO_ERROR);
+
+    release(s);
+
+    _job job;
+    job.m_stream = s;
+    m_jobs.push_back(job);
+}
+
+void Http2Session::end_remote(Stream* s)
+{
+    s->m_remoteClosed = true;
+
+    if (!m_server) {
+        finish(s);
+        return;
+    }
+
+    _job job;
+    job.m_stream = s;
+    job.m_dispatch = true;
+    m_jobs.push_back(job);
+}
+
+void Http2Session::finish(Stream* s)
+{
+    // the response is complete, whatever the request still had to send is dropped
+    if (!s->m_localClosed)
+        send_rst(s->m_id, CANCEL);
+
+    release(s);
+
+    _job job;
+    job.m_stream = s;
+    m_jobs.push_back(job);
+}
+
+void Http2Session::fail(Stream* s, exlib::string msg)
+{
+    if (s->m_id)
+        release(s);
+
+    _job job;
+    job.m_stream = s;
+    job.m_error = msg;
+    m_jobs.push_back(job);
+}
+
+void Http2Session::shutdown(exlib::string msg)
+{
+    AsyncEvent* ac;
+
+    m_lock.lock();
+
+    if (!m_closed) {
+        m_closed = true;
+
+        for (auto& it : m_streams) {
+            _job job;
+            job.m_stream = it.second;
+            job.m_error = msg;
+            m_jobs.push_back(job);
+        }
+        m_streams.clear();
+        m_sending.clear();
+
+        for (auto& s : m_pending) {
+            _job job;
+            job.m_stream = s;
+            job.m_error = msg;
+            m_jobs.push_back(job);
+        }
+        m_pending.clear();
+    }
+
+    ac = m_closeAc;
+    m_closeAc = NULL;
+
+    m_lock.unlock();
+
+    flush();
+    done();
+
+    if (ac)
+        ac->post(0);
+}
+
+class asyncH2Finish : public AsyncState {
+public:
+    asyncH2Finish(Http2Session* pThis, Http2Session::Stream* s)
+        : AsyncState(s->m_request ? NULL : s->m_ac)
+        , m_pThis(pThis)
+        , m_s(s)
+    {
+        next(write);
+    }
+
+    ON_STATE(asyncH2Finish, write)
+    {
+        if (!m_s->m_body)
+            m_s->m_body = new MemoryStream();
+
+        if (m_s->m_data.empty())
+            return next(body);
+
+        m_buffer = new Buffer(m_s->m_data.c_str(), m_s->m_data.length());
+        m_s->m_data.clear();
+
+        return m_s->m_body->write(m_buffer, next(body));
+    }
+
+    ON_STATE(asyncH2Finish, body)
+    {
+        m_s->m_body->rewind();
+
+        // a request received by a server goes on to its handler
+        if (m_s->m_request) {
+            m_s->m_request->set_body(m_s->m_body);
+            m_pThis->m_dispatcher->dispatch(m_pThis, m_s);
+            return next();
+        }
+
+        m_s->m_response->set_body(m_s->m_body);
+        *m_s->m_retVal = m_s->m_response;
+
+        return next();
+    }
+
+private:
+    obj_ptr<Http2Session> m_pThis;
+    obj_ptr<Http2Session::Stream> m_s;
+    obj_ptr<Buffer_base> m_buffer;
+};
+
+void Http2Session::done()
+{
+    std::vector<_job> jobs;
+
+    m_lock.lock();
+    jobs.swap(m_jobs);
+    m_lock.unlock();
+
+    for (size_t i = 0; i < jobs.size(); i++) {
+        _job& job = jobs[i];
+        Stream* s = job.m_stream;
+
+        if (job.m_dispatch)
+            (new asyncH2Finish(this, s))->post(0);
+        else if (!s->m_ac)
+            continue;
+        else if (!job.m_error.empty()) {
+            Runtime::setError(job.m_error);
+            s->m_ac->post(CALL_E_EXCEPTION);
+        } else if (m_server)
+            s->m_ac->post(0);
+        else
+            (new asyncH2Finish(this, s))->post(0);
+    }
+}
+
+result_t Http2Session::feed(const uint8_t* data, size_t len)
+{
+    result_t hr = 0;
+
+    m_in.append((const char*)data, len);
+
+    m_lock.lock();
+
+    // a server first takes the client connection preface, RFC 9113 3.4
+    while (m_preface && m_inPos < m_in.length()) {
+        if (m_in[m_inPos] != s_preface[sizeof(s_preface) - 1 - m_preface]) {
+            hr = Runtime::setError("Http2Session: bad connection preface.");
+            break;
+        }
+
+        m_inPos++;
+        m_preface--;
+    }
+
+    while (hr >= 0 && m_in.length() - m_inPos >= FRAME_HEADER_SIZE) {
+        const uint8_t* p = (const uint8_t*)m_in.c_str() + m_inPos;
+        size_t sz = ((size_t)p[0] << 16) | ((size_t)p[1] << 8) | p[2];
+
+        if (sz > DEFAULT_FRAME_SIZE) {
+            send_goaway(FRAME_SIZE_ERROR);
+            hr = Runtime::setError("Http2Session: frame too large.");
+            break;
+        }
+
+        if (m_in.length() - m_inPos < FRAME_HEADER_SIZE + sz)
+            break;
+
+        hr = on_frame(p[3], p[4], get_u32(p + 5) & 0x7fffffff, p + FRAME_HEADER_SIZE, sz);
+        if (hr < 0)
+            break;
+
+        m_inPos += FRAME_HEADER_SIZE + sz;
+    }
+
+    if (m_inPos == m_in.length()) {
+        m_in.clear();
+        m_inPos = 0;
+    } else if (m_inPos > 65536) {
+        m_in = m_in.substr(m_inPos);
+        m_inPos = 0;
+    }
+    m_lock.unlock();
+
+    flush();
+    done();
+
+    return hr < 0 ? CHECK_ERROR(hr) : 0;
+}
+
+result_t Http2Session::protocol_error(int32_t code, const char* msg)
+{
+    send_goaway(code);
+    return Runtime::setError(exlib::string("Http2Session: ") + msg);
+}
+
+result_t Http2Session::on_frame(int32_t type, int32_t flags, int32_t id, const uint8_t* p, size_t len)
+{
+    // nothing may interleave with a header block, RFC 9113 6.10
+    if (m_headerStream) {
+        if (type != FRAME_CONTINUATION || id != m_headerStream)
+            return protocol_error(PROTOCOL_ERROR, "header block interrupted.");
+
+        m_headerBlock.append((const char*)p, len);
+        if (m_headerBlock.length() > max_header_list())
+            return protocol_error(ENHANCE_YOUR_CALM, "header block too large.");
+
+        if (!(flags & FLAG_END_HEADERS))
+            return 0;
+
+        int32_t stream = m_headerStream;
+        m_headerStream = 0;
+
+        return on_headers(stream, m_headerBlock, (m_headerFlags & FLAG_END_STREAM) != 0);
+    }
+
+    switch (type) {
+    case FRAME_DATA:
+        if (id == 0)
+            return protocol_error(PROTOCOL_ERROR, "DATA on stream 0.");
+        return on_data(flags, id, p, len);
+    case FRAME_HEADERS: {
+        if (id == 0)
+            return protocol_error(PROTOCOL_ERROR, "HEADERS on stream 0.");
+
+        size_t pad = 0;
+        if (flags & FLAG_PADDED) {
+            if (len < 1)
+                return protocol_error(FRAME_SIZE_ERROR, "bad HEADERS frame.");
+            pad = p[0];
+            p++;
+            len--;
+        }
+
+        if (flags & FLAG_PRIORITY) {
+            if (len < 5)
+                return protocol_error(FRAME_SIZE_ERROR, "bad HEADERS frame.");
+            p += 5;
+            len -= 5;
+        }
+
+        if (pad > len)
+            return protocol_error(PROTOCOL_ERROR, "bad HEADERS padding.");
+        len -= pad;
+
+        m_headerBlock.assign((const char*)p, len);
+        if (!(flags & FLAG_END_HEADERS)) {
+            m_headerStream = id;
+            m_headerFlags = flags;
+            return 0;
+        }
+
+        return on_headers(id, m_headerBlock, (flags & FLAG_END_STREAM) != 0);
+    }
+    case FRAME_PRIORITY:
+        if (len != 5)
+            return protocol_error(FRAME_SIZE_ERROR, "bad PRIORITY frame.");
+        return 0;
+    case FRAME_RST_STREAM:
+        return on_rst(id, p, len);
+    case FRAME_SETTINGS:
+        if (id != 0)
+            return protocol_error(PROTOCOL_ERROR, "SETTINGS on a stream.");
+        return on_settings(flags, p, len);
+    case FRAME_PUSH_PROMISE:
+        return protocol_error(PROTOCOL_ERROR, m_server ? "PUSH_PROMISE from a client." : "server push is disabled.");
+    case FRAME_PING:
+        if (id != 0)
+            return protocol_error(PROTOCOL_ERROR, "PING on a stream.");
+        if (len != 8)
+            return protocol_error(FRAME_SIZE_ERROR, "bad PING frame.");
+        if (!(flags & FLAG_ACK))
+            frame(m_frames, FRAME_PING, FLAG_ACK, 0, (const char*)p, len);
+        return 0;
+    case FRAME_GOAWAY:
+        return on_goaway(p, len);
+    case FRAME_WINDOW_UPDATE:
+        return on_window_update(id, p, len);
+    case FRAME_CONTINUATION:
+        return protocol_error(PROTOCOL_ERROR, "unexpected CONTINUATION frame.");
+    }
+
+    // unknown frame types are ignored, RFC 9113 4.1
+    return 0;
+}
+
+result_t Http2Session::on_data(int32_t flags, int32_t id, const uint8_t* p, size_t len)
+{
+    // padding counts against flow control like the payload does
+    m_recvUnacked += (int32_t)len;
+    if (m_recvUnacked > SESSION_WINDOW)
+        return protocol_error(FLOW_CONTROL_ERROR, "connection window exceeded.");
+
+    if (m_recvUnacked >= SESSION_WINDOW / 2) {
+        exlib::string payload;
+        put_u32(payload, m_recvUnacked);
+        frame(m_frames, FRAME_WINDOW_UPDATE, 0, 0, payload.c_str(), payload.length());
+        m_recvUnacked = 0;
+    }
+
+    std::unordered_map<int32_t, obj_ptr<Stream>>::iterator it = m_streams.find(id);
+    if (it == m_streams.end()) {
+        if (is_idle(id))
+            return protocol_error(PROTOCOL_ERROR, "DATA on an idle stream.");
+        return 0;
+    }
+
+    Stream* s = it->second;
+
+    if (flags & FLAG_PADDED) {
+        if (len < 1 || p[0] >= len)
+            return protocol_error(PROTOCOL_ERROR, "bad DATA padding.");
+        len -= p[0] + 1;
+        p++;
+    }
+
+    if (!m_server && !s->m_response) {
+        send_rst(id, PROTOCOL_ERROR);
+        fail(s, "Http2Session: DATA before HEADERS.");
+        return 0;
+    }
+
+    if (s->m_remoteClosed) {
+        send_rst(id, STREAM_CLOSED);
+        fail(s, "Http2Session: DATA after END_STREAM.");
+        return 0;
+    }
+
+    s->m_recvUnacked += (int32_t)len;
+    if (s->m_recvUnacked > STREAM_WINDOW) {
+        send_rst(id, FLOW_CONTROL_ERROR);
+        fail(s, "Http2Session: stream window exceeded.");
+        return 0;
+    }
+
+    if (!s->m_noBody) {
+        s->m_data.append((const char*)p, len);
+
+        if (m_maxBodySize >= 0 && s->m_data.length() > (size_t)m_maxBodySize * 1024 * 1024) {
+            send_rst(id, CANCEL);
+            fail(s, "Http2Session: body is too huge.");
+            return 0;
+        }
+    }
+
+    if (flags & FLAG_END_STREAM) {
+        end_remote(s);
+        return 0;
+    }
+
+    if (s->m_recvUnacked >= STREAM_WINDOW / 2) {
+        exlib::string payload;
+        put_u32(payload, s->m_recvUnacked);
+        frame(m_frames, FRAME_WINDOW_UPDATE, 0, id, payload.c_str(), payload.length());
+        s->m_recvUnacked = 0;
+    }
+
+    return 0;
+}
+
+result_t Http2Session::on_headers(int32_t id, exlib::string& block, bool endStream)
+{
+    std::vector<Hpack::header> headers;
+
+    // the block is decoded even for a stream we gave up on, the dynamic table must stay in sync
+    result_t hr = m_decoder.decode((const uint8_t*)block.c_str(), block.length(), headers, max_header_list());
+    block.clear();
+    if (hr < 0) {
+        exlib::string msg = Runtime::errMessage();
+
+        send_goaway(COMPRESSION_ERROR);
+        return Runtime::setError(msg);
+    }
+
+    if (m_server)
+        return on_request(id, headers, endStream);
+    return on_response(id, headers, endStream);
+}
+
+result_t Http2Session::on_response(int32_t id, std::vector<Hpack::header>& headers, bool endStream)
+{
+    std::unordered_map<int32_t, obj_ptr<Stream>>::iterator it = m_streams.find(id);
+    if (it == m_streams.end()) {
+        if (is_idle(id))
+            return protocol_error(PROTOCOL_ERROR, "HEADERS on an idle stream.");
+        return 0;
+    }
+
+    Stream* s = it->second;
+
+    // trailers carry nothing the response object can hold
+    if (s->m_response) {
+        if (!endStream) {
+            send_rst(id, PROTOCOL_ERROR);
+            fail(s, "Http2Session: trailers without END_STREAM.");
+            return 0;
+        }
+
+        end_remote(s);
+        return 0;
+    }
+
+    int32_t status = 0;
+    bool bRegular = false;
+    obj_ptr<HttpResponse> resp = new HttpResponse();
+    HttpCollection* hdrs = resp->m_message->m_headers;
+
+    for (size_t i = 0; i < headers.size(); i++) {
+        exlib::string& name = headers[i].first;
+
+        if (name.c_str()[0] == ':') {
+            if (bRegular || name != ":status" || status) {
+                send_rst(id, PROTOCOL_ERROR);
+                fail(s, "Http2Session: bad pseudo header " + name + ".");
+                return 0;
+            }
+
+            status = atoi(headers[i].second.c_str());
+            continue;
+        }
+
+        bRegular = true;
+        if ((int32_t)hdrs->count() >= m_maxHeadersCount) {
+            send_rst(id, CANCEL);
+            fail(s, "Http2Session: too many headers.");
+            return 0;
+        }
+
+        if ((int32_t)(name.length() + headers[i].second.length()) > m_maxHeaderSize) {
+            send_rst(id, CANCEL);
+            fail(s, "Http2Session: header is too long.");
+            return 0;
+        }
+
+        hdrs->add(name, headers[i].second);
+    }
+
+    if (status < 100 || status > 999) {
+        send_rst(id, PROTOCOL_ERROR);
+        fail(s, "Http2Session: bad status.");
+        return 0;
+    }
+
+    // informational responses precede the real one
+    if (status < 200) {
+        if (endStream) {
+            send_rst(id, PROTOCOL_ERROR);
+            fail(s, "Http2Session: stream ended with an informational response.");
+        }
+        return 0;
+    }
+
+    resp->set_protocol("HTTP/2.0");
+    resp->set_statusCode(status);
+    resp->m_message->m_bNoBody = s->m_noBody;
+    resp->set_maxHeadersCount(m_maxHeadersCount);
+    resp->set_maxHeaderSize(m_maxHeaderSize);
+    resp->set_maxBodySize(m_maxBodySize);
+    s->m_response = resp;
+
+    if (endStream)
+        end_remote(s);
+
+    return 0;
+}
+
+result_t Http2Session::on_request(int32_t id, std::vector<Hpack::header>& headers, bool endStream)
+{
+    std::unordered_map<int32_t, obj_ptr<Stream>>::iterator it = m_streams.find(id);
+    if (it != m_streams.end()) {
+        Stream* s = it->second;
+
+        // trailers end the request body, there is nowhere to keep them
+        if (s->m_remoteClosed) {
+            send_rst(id, STREAM_CLOSED);
+            fail(s, "Http2Session: HEADERS after END_STREAM.");
+            return 0;
+        }
+
+        if (!endStream) {
+            send_rst(id, PROTOCOL_ERROR);
+            fail(s, "Http2Session: trailers without END_STREAM.");
+            return 0;
+        }
+
+        end_remote(s);
+        return 0;
+    }
+
+    if (!(id & 1))
+        return protocol_error(PROTOCOL_ERROR, "HEADERS on a server stream.");
+    if (!is_idle(id))
+        return protocol_error(STREAM_CLOSED, "HEADERS on a closed stream.");
+    m_lastPeerId = id;
+
+    if (m_goaway || (int32_t)m_streams.size() >= m_maxStreams) {
+        send_rst(id, REFUSED_STREAM);
+        return 0;
+    }
+
+    obj_ptr<HttpRequest> req = new HttpRequest();
+    obj_ptr<HttpCollection_base> _hdrs;
+    exlib::string method, scheme, authority, path, cookie;
+    bool bRegular = false;
+
+    req->get_headers(_hdrs);
+    HttpCollection* hdrs = _hdrs.As<HttpCollection>();
+
+    for (size_t i = 0; i < headers.size(); i++) {
+        exlib::string& name = headers[i].first;
+        exlib::string& value = headers[i].second;
+
+        if (name.c_str()[0] == ':') {
+            exlib::string* pv = NULL;
+
+            if (name == ":method")
+                pv = &method;
+            else if (name == ":scheme")
+                pv = &scheme;
+            else if (name == ":authority")
+                pv = &authority;
+            else if (name == ":path")
+                pv = &path;
+
+            if (bRegular || !pv || !pv->empty()) {
+                send_rst(id, PROTOCOL_ERROR);
+                return 0;
+            }
+
+            *pv = value;
+            continue;
+        }
+
+        bRegular = true;
+
+        // field names are lowercase on the wire, RFC 9113 8.2.1
+        for (size_t j = 0; j < name.length(); j++)
+            if (qisupper(name[j])) {
+                send_rst(id, PROTOCOL_ERROR);
+                return 0;
+            }
+
+        if (is_connection_header(name) || (name == "te" && value != "trailers")) {
+            send_rst(id, PROTOCOL_ERROR);
+            return 0;
+        }
+
+        if ((int32_t)hdrs->count() >= m_maxHeadersCount
+            || (int32_t)(name.length() + value.length()) > m_maxHeaderSize) {
+            send_rst(id, REFUSED_STREAM);
+            return 0;
+        }
+
+        // cookies may arrive split, they are joined back for HTTP/1.1 style parsing, RFC 9113 8.2.3
+        if (name == "cookie") {
+            if (!cookie.empty())
+                cookie.append("; ", 2);
+            cookie.append(value);
+            continue;
+        }
+
+        hdrs->add(name, value);
+    }
+
+    if (method.empty() || scheme.empty() || path.empty()) {
+        send_rst(id, PROTOCOL_ERROR);
+        return 0;
+    }
+
+    if (!cookie.empty())
+        hdrs->add("cookie", cookie);
+
+    exlib::string host;
+    if (!authority.empty() && hdrs->first("host", host) == CALL_RETURN_NULL)
+        hdrs->add("host", authority);
+
+    size_t pos = path.find('?');
+    if (pos != exlib::string::npos) {
+        req->set_queryString(path.substr(pos + 1));
+        path.resize(pos);
+    }
+    req->set_address(path);
+    req->set_value(path);
+
+    req->set_method(method);
+    req->set_protocol("HTTP/2.0");
+
+    obj_ptr<Stream> s = new Stream(id, m_peerInitialWindow);
+    s->m_request = req;
+    m_streams[id] = s;
+
+    if (endStream)
+        end_remote(s);
+
+    return 0;
+}
+
+result_t Http2Session::on_settings(int32_t flags, const uint8_t* p, size_t len)
+{
+    if (flags & FLAG_ACK) {
+        if (len)
+            return protocol_error(FRAME_SIZE_ERROR, "bad SETTINGS ack.");
+
+        if (m_tableSize < Hpack::HPACK_DEFAULT_SIZE)
+            m_decoder.set_limit(m_tableSize);
+        return 0;
+    }
+
+    if (len % 6)
+        return protocol_error(FRAME_SIZE_ERROR, "bad SETTINGS frame.");
+
+    for (size_t i = 0; i < len; i += 6) {
+        int32_t id = (p[i] << 8) | p[i + 1];
+        uint32_t value = get_u32(p + i + 2);
+
+        switch (id) {
+        case SETTINGS_HEADER_TABLE_SIZE:
+            m_encoder.set_max_size(value < (uint32_t)m_tableSize ? value : m_tableSize);
+            break;
+        case SETTINGS_ENABLE_PUSH:
+            if (value > 1)
+                return protocol_error(PROTOCOL_ERROR, "bad SETTINGS_ENABLE_PUSH.");
+            break;
+        case SETTINGS_MAX_CONCURRENT_STREAMS:
+            m_peerMaxStreams = value > (uint32_t)MAX_WINDOW ? MAX_WINDOW : (int32_t)value;
+            break;
+        case SETTINGS_INITIAL_WINDOW_SIZE: {
+            if (value > (uint32_t)MAX_WINDOW)
+                return protocol_error(FLOW_CONTROL_ERROR, "bad SETTINGS_INITIAL_WINDOW_SIZE.");
+
+            // the change applies to every open stream, windows may even go negative
+            int64_t delta = (int64_t)value - m_peerInitialWindow;
+            for (auto& it : m_streams) {
+                int64_t w = it.second->m_sendWindow + delta;
+                if (w > MAX_WINDOW)
+                    return protocol_error(FLOW_CONTROL_ERROR, "stream window overflow.");
+                it.second->m_sendWindow = (int32_t)w;
+            }
+            m_peerInitialWindow = (int32_t)value;
+            break;
+        }
+        case SETTINGS_MAX_FRAME_SIZE:
+            if (value < DEFAULT_FRAME_SIZE || value > 16777215)
+                return protocol_error(PROTOCOL_ERROR, "bad SETTINGS_MAX_FRAME_SIZE.");
+            m_peerMaxFrameSize = (int32_t)value;
+            break;
+        }
+    }
+
+    frame(m_frames, FRAME_SETTINGS, FLAG_ACK, 0, NULL, 0);
+
+    while (!m_pending.empty() && !m_goaway && (int32_t)m_streams.size() < m_peerMaxStreams) {
+        obj_ptr<Stream> s = m_pending.front();
+        m_pending.pop_front();
+        open(s);
+    }
+
+    return 0;
+}
+
+result_t Http2Session::on_window_update(int32_t id, const uint8_t* p, size_t len)
+{
+    if (len != 4)
+        return protocol_error(FRAME_SIZE_ERROR, "bad WINDOW_UPDATE frame.");
+
+    int32_t inc = (int32_t)(get_u32(p) & 0x7fffffff);
+
+    if (id == 0) {
+        if (inc == 0)
+            return protocol_error(PROTOCOL_ERROR, "zero WINDOW_UPDATE.");
+        if ((int64_t)m_sendWindow + inc > MAX_WINDOW)
+            return protocol_error(FLOW_CONTROL_ERROR, "connection window overflow.");
+
+        m_sendWindow += inc;
+        return 0;
+    }
+
+    std::unordered_map<int32_t, obj_ptr<Stream>>::iterator it = m_streams.find(id);
+    if (it == m_streams.end())
+        return 0;
+
+    Stream* s = it->second;
+
+    if (inc == 0 || (int64_t)s->m_sendWindow + inc > MAX_WINDOW) {
+        send_rst(id, inc ? FLOW_CONTROL_ERROR : PROTOCOL_ERROR);
+        fail(s, "Http2Session: bad WINDOW_UPDATE.");
+        return 0;
+    }
+
+    s->m_sendWindow += inc;
+    return 0;
+}
+
+result_t Http2Session::on_rst(int32_t id, const uint8_t* p, size_t len)
+{
+    if (id == 0)
+        return protocol_error(PROTOCOL_ERROR, "RST_STREAM on stream 0.");
+    if (len != 4)
+        return protocol_error(FRAME_SIZE_ERROR, "bad RST_STREAM frame.");
+
+    std::unordered_map<int32_t, obj_ptr<Stream>>::iterator it = m_streams.find(id);
+    if (it == m_streams.end())
+        return 0;
+
+    char msg[64];
+    snprintf(msg, sizeof(msg), "Http2Session: stream reset with code %u.", get_u32(p));
+    fail(it->second, msg);
+
+    return 0;
+}
+
+result_t Http2Session::on_goaway(const uint8_t* p, size_t len)
+{
+    if (len < 8)
+        return protocol_error(FRAME_SIZE_ERROR, "bad GOAWAY frame.");
+
+    int32_t last = (int32_t)(get_u32(p) & 0x7fffffff);
+    std::vector<obj_ptr<Stream>> refused;
+
+    m_goaway = true;
+
+    // a client going away leaves the streams it already sent to be answered
+    if (m_server) {
+        if (m_streams.empty())
+            m_closed = true;
+        return 0;
+    }
+
+    // streams above last were never processed by the peer and are safe to retry elsewhere
+    for (auto& it : m_streams)
+        if (it.first > last)
+            refused.push_back(it.second);
+
+    for (size_t i = 0; i < refused.size(); i++)
+        fail(refused[i], "Http2Session: stream refused by GOAWAY.");
+
+    while (!m_pending.empty()) {
+        obj_ptr<Stream> s = m_pending.front();
+        m_pending.pop_front();
+        fail(s, "Http2Session: stream refused by GOAWAY.");
+    }
+
+    return 0;
+}
+
+} /* namespace fibjs */
@@ -0,0 +1,324 @@
+/*
+ * HttpBodyStream.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "HttpBodyStream.h"
+#include "Buffer.h"
+#include "parse.h"
+#include "ifs/fs.h"
+#include "ifs/io.h"
+
+namespace fibjs {
+
+result_t HttpBodyStream::_read(int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
+{
+    class asyncRead : public AsyncState {
+    public:
+        asyncRead(HttpBodyStream* pThis, int32_t bytes, obj_ptr<Buffer_base>& retVal,
+            AsyncEvent* ac)
+            : AsyncState(ac)
+            , m_pThis(pThis)
+            , m_bytes(bytes)
+            , m_retVal(retVal)
+            , m_got(0)
+        {
+            next(check);
+        }
+
+        ON_STATE(asyncRead, check)
+        {
+            if (m_pThis->m_end || m_got == m_bytes || (m_bytes < 0 && m_got > 0))
+                return done();
+
+            if (m_pThis->m_left > 0) {
+                int64_t sz = m_pThis->m_left;
+
+                if (m_bytes < 0) {
+                    if (sz > STREAM_BUFF_SIZE)
+                        sz = STREAM_BUFF_SIZE;
+                } else if (sz > m_bytes - m_got)
+                    sz = m_bytes - m_got;
+
+                m_buf.Release();
+                return m_pThis->m_stm->read((int32_t)sz, m_buf, next(data));
+            }
+
+            return m_pThis->m_stm->readLine(m_pThis->m_maxLineSize, m_line, next(chunk_head));
+        }
+
+        ON_STATE(asyncRead, data)
+        {
+            if (n == CALL_RETURN_NULL)
+                return CHECK_ERROR(Runtime::setError("HttpMessage: body is not complete."));
+
+            int32_t len = (int32_t)Buffer::Cast(m_buf)->length();
+
+            m_pThis->m_left -= len;
+            m_pThis->m_pos += len;
+            m_got += len;
+            m_data.push_back(m_buf);
+
+            if (m_pThis->m_left > 0)
+                return next(check);
+
+            if (m_pThis->m_length >= 0) {
+                m_pThis->m_end = true;
+                return next(check);
+            }
+
+            return m_pThis->m_stm->readLine(m_pThis->m_maxLineSize, m_line, next(chunk_end));
+        }
+
+        ON_STATE(asyncRead, chunk_head)
+        {
+            if (n == CALL_RETURN_NULL)
+                return CHECK_ERROR(Runtime::setError("HttpMessage: body is not complete."));
+
+            _parser p(m_line);
+            char ch;
+            int64_t sz = 0;
+
+            p.skipSpace();
+
+            if (!qisxdigit(p.get()))
+                return CHECK_ERROR(Runtime::setError("HttpMessage: bad chunk size."));
+
+            while (qisxdigit(ch = p.get())) {
+                if (sz > (INT64_MAX >> 4))
+                    return CHECK_ERROR(Runtime::setError("HttpMessage: bad chunk size."));
+
+                sz = (sz << 4) + qhex(ch);
+                p.skip();
+            }
+
+            if (sz == 0)
+                return m_pThis->m_stm->readLine(m_pThis->m_maxLineSize, m_line, next(trailer));
+
+            if (m_pThis->m_limit >= 0 && m_pThis->m_pos + sz > m_pThis->m_limit)
+                return CHECK_ERROR(Runtime::setError("HttpMessage: body is too huge."));
+
+            m_pThis->m_left = sz;
+            return next(check);
+        }
+
+        ON_STATE(asyncRead, chunk_end)
+        {
+            if (n == CALL_RETURN_NULL || !m_line.empty())
+                return CHECK_ERROR(Runtime::setError("HttpMessage: bad chunk end."));
+
+            return next(check);
+        }
+
+        ON_STATE(asyncRead, trailer)
+        {
+            if (n == CALL_RETURN_NULL)
+                return CHECK_ERROR(Runtime::setError("HttpMessage: body is not complete."));
+
+            // trailer fields are read and dropped
+            if (!m_line.empty())
+                return m_pThis->m_stm->readLine(m_pThis->m_maxLineSize, m_line, this);
+
+            m_pThis->m_end = true;
+            return next(check);
+        }
+
+        result_t done()
+        {
+            if (m_data.empty())
+                return next(CALL_RETURN_NULL);
+
+            if (m_data.size() == 1) {
+                m_retVal = m_data[0];
+                return next();
+            }
+
+            obj_ptr<Buffer> buf = new Buffer(NULL, m_got);
+            uint8_t* p = buf->data();
+
+            for (size_t i = 0; i < m_data.size(); i++) {
+                Buffer* b = Buffer::Cast(m_data[i]);
+
+                memcpy(p, b->data(), b->length());
+                p += b->length();
+            }
+
+            m_retVal = buf;
+            return next();
+        }
+
+        virtual int32_t error(int32_t v)
+        {
+            // the connection is out of step with the body once a read fails
+            m_pThis->m_error = v;
+            return v;
+        }
+
+    private:
+        obj_ptr<HttpBodyStream> m_pThis;
+        int32_t m_bytes;
+        obj_ptr<Buffer_base>& m_retVal;
+        int64_t m_got;
+        obj_ptr<Buffer_base> m_buf;
+        std::vector<obj_ptr<Buffer_base>> m_data;
+        exlib::string m_line;
+    };
+
+    if (m_error < 0)
+        return m_error;
+
+    if (m_end)
+        return CALL_RETURN_NULL;
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new asyncRead(this, bytes, retVal, ac))->post(0);
+}
+
+result_t HttpBodyStream::get_fd(int32_t& retVal)
+{
+    return m_stm->get_fd(retVal);
+}
+
+result_t HttpBodyStream::read(int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
+{
+    if (m_closed)
+        return CHECK_ERROR(CALL_E_CLOSED);
+
+    if (bytes == 0)
+        return CALL_RETURN_NULL;
+
+    return _read(bytes, retVal, ac);
+}
+
+result_t HttpBodyStream::write(Buffer_base* data, AsyncEvent* ac)
+{
+    return CHECK_ERROR(CALL_E_INVALID_CALL);
+}
+
+result_t HttpBodyStream::flush(AsyncEvent* ac)
+{
+    return 0;
+}
+
+result_t HttpBodyStream::close(AsyncEvent* ac)
+{
+    m_closed = true;
+    return 0;
+}
+
+result_t HttpBodyStream::copyTo(Stream_base* stm, int64_t bytes, int64_t& retVal, AsyncEvent* ac)
+{
+    if (m_closed)
+        return CHECK_ERROR(CALL_E_CLOSED);
+
+    return io_base::copyStream(this, stm, bytes, retVal, ac);
+}
+
+result_t HttpBodyStream::seek(int64_t offset, int32_t whence)
+{
+    switch (whence) {
+    case fs_base::C_SEEK_SET:
+        break;
+    case fs_base::C_SEEK_CUR:
+        offset += m_pos;
+        break;
+    case fs_base::C_SEEK_END:
+        if (m_length < 0)
+            return CHECK_ERROR(CALL_E_INVALID_CALL);
+        offset += m_length;
+        break;
+    default:
+        return CHECK_ERROR(CALL_E_INVALIDARG);
+    }
+
+    if (offset != m_pos)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    return 0;
+}
+
+result_t HttpBodyStream::tell(int64_t& retVal)
+{
+    retVal = m_pos;
+    return 0;
+}
+
+result_t HttpBodyStream::rewind()
+{
+    return seek(0, fs_base::C_SEEK_SET);
+}
+
+result_t HttpBodyStream::size(int64_t& retVal)
+{
+    // a chunked body has no size until it has been read to the end
+    retVal = m_length < 0 && m_end ? m_pos : m_length;
+    return 0;
+}
+
+result_t HttpBodyStream::readAll(obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
+{
+    if (m_closed)
+        return CHECK_ERROR(CALL_E_CLOSED);
+
+    return _read(INT32_MAX, retVal, ac);
+}
+
+result_t HttpBodyStream::truncate(int64_t bytes, AsyncEvent* ac)
+{
+    return CHECK_ERROR(CALL_E_INVALID_CALL);
+}
+
+result_t HttpBodyStream::eof(bool& retVal)
+{
+    retVal = m_end;
+    return 0;
+}
+
+result_t HttpBodyStream::stat(obj_ptr<Stat_base>& retVal, AsyncEvent* ac)
+{
+    return CHECK_ERROR(CALL_E_INVALID_CALL);
+}
+
+result_t HttpBodyStream::drain(AsyncEvent* ac)
+{
+    class asyncDrain : public AsyncState {
+    public:
+        asyncDrain(HttpBodyStream* pThis, AsyncEvent* ac)
+            : AsyncState(ac)
+            , m_pThis(pThis)
+        {
+            next(read);
+        }
+
+        ON_STATE(asyncDrain, read)
+        {
+            if (m_pThis->m_end)
+                return next();
+
+            m_buf.Release();
+            return m_pThis->_read(-1, m_buf, this);
+        }
+
+    private:
+        obj_ptr<HttpBodyStream> m_pThis;
+        obj_ptr<Buffer_base> m_buf;
+    };
+
+    if (m_error < 0)
+        return m_error;
+
+    if (m_end)
+        return 0;
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new asyncDrain(this, ac))->post(0);
+}
+
+} /* namespace fibjs */
@@ -22,6 +22,19 @@
 
 namespace fibjs {
 
+// only the codings this build can decode are advertised
+#ifdef HAVE_BROTLI
+#define ACCEPT_BR ",br"
+#else
+#define ACCEPT_BR ""
+#endif
+
+#ifdef HAVE_ZSTD
+#define ACCEPT_ZSTD ",zstd"
+#else
+#define ACCEPT_ZSTD ""
+#endif
+
 result_t HttpClient_base::_new(obj_ptr<HttpClient_base>& retVal, v8::Local<v8::Object> This)
 {
     Isolate* isolate = Isolate::current(This);
@@ -95,6 +108,22 @@ result_t HttpClient::init(v8::Local<v8::Object> options)
     if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
         return hr;
 
+    hr = GetConfigValue(isolate, options, "maxConnsPerHost", m_maxConnsPerHost);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+    if (m_maxConnsPerHost < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    hr = GetConfigValue(isolate, options, "pipelining", m_pipelining);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+    if (m_pipelining < 1)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    hr = GetConfigValue(isolate, options, "enableHttp2", m_enableHttp2);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
     hr = GetConfigValue(isolate, options, "http_proxy", m_http_proxy);
     if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
         return hr;
@@ -244,6 +273,48 @@ result_t HttpClient::set_poolTimeout(int32_t newVal)
     return 0;
 }
 
+result_t HttpClient::get_maxConnsPerHost(int32_t& retVal)
+{
+    retVal = m_maxConnsPerHost;
+    return 0;
+}
+
+result_t HttpClient::set_maxConnsPerHost(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    m_maxConnsPerHost = newVal;
+    return 0;
+}
+
+result_t HttpClient::get_pipelining(int32_t& retVal)
+{
+    retVal = m_pipelining;
+    return 0;
+}
+
+result_t HttpClient::set_pipelining(int32_t newVal)
+{
+    if (newVal < 1)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    m_pipelining = newVal;
+    return 0;
+}
+
+result_t HttpClient::get_enableHttp2(bool& retVal)
+{
+    retVal = m_enableHttp2;
+    return 0;
+}
+
+result_t HttpClient::set_enableHttp2(bool newVal)
+{
+    m_enableHttp2 = newVal;
+    return 0;
+}
+
 result_t HttpClient::get_http_proxy(exlib::string& retVal)
 {
     retVal = m_http_proxy;
@@ -478,30 +549,44 @@ result_t HttpClient::get_cookie(exlib::string url, exlib::string& retVal)
     return 0;
 }
 
-result_t HttpClient::request(Stream_base* conn, HttpRequest_base* req, SeekableStream_base* response_body,
-    obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac)
+result_t HttpClient::_request(Stream_base* conn, Conn* pc, int32_t ticket, HttpRequest_base* req,
+    SeekableStream_base* response_body, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac)
 {
     class asyncRequest : public AsyncState {
     public:
-        asyncRequest(HttpClient* hc, Stream_base* conn, HttpRequest_base* req, SeekableStream_base* response_body,
-            obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac)
+        asyncRequest(HttpClient* hc, Stream_base* conn, Conn* pc, int32_t ticket, HttpRequest_base* req,
+            SeekableStream_base* response_body, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac)
             : AsyncState(ac)
             , m_hc(hc)
             , m_conn(conn)
+            , m_pc(pc)
+            , m_ticket(ticket)
             , m_req(req)
             , m_response_body(response_body)
             , m_retVal(retVal)
         {
-            next(send);
+            next(m_pc ? send_turn : send);
 
             exlib::string method;
             m_req->get_method(method);
             m_bNoBody = !qstricmp(method.c_str(), "head", 4);
         }
 
+        // pipelined requests share the connection, each one waits for its turn to send and then to read
+        ON_STATE(asyncRequest, send_turn)
+        {
+            return m_pc->wait_send(m_ticket, next(send));
+        }
+
         ON_STATE(asyncRequest, send)
         {
-            return m_req->sendTo(m_conn, next(recv));
+            return m_req->sendTo(m_conn, next(m_pc ? sent : recv));
+        }
+
+        ON_STATE(asyncRequest, sent)
+        {
+            m_pc->sent();
+            return m_pc->wait_recv(m_ticket, next(recv));
         }
 
         ON_STATE(asyncRequest, recv)
@@ -516,12 +601,21 @@ result_t HttpClient::request(Stream_base* conn, HttpRequest_base* req, SeekableS
             m_retVal->set_maxHeadersCount(m_hc->m_maxHeadersCount);
             m_retVal->set_maxHeaderSize(m_hc->m_maxHeaderSize);
             m_retVal->set_maxBodySize(m_hc->m_maxBodySize);
+            if (m_pc)
+                return m_retVal->readFrom(m_pc->m_bs, next(recved));
+
             m_bs = new BufferedStream(m_conn);
             m_bs->set_EOL("\r\n");
 
             return m_retVal->readFrom(m_bs, next(m_hc->m_enableEncoding ? unzip : close));
         }
 
+        ON_STATE(asyncRequest, recved)
+        {
+            m_pc->received();
+            return next(m_hc->m_enableEncoding ? unzip : close);
+        }
+
         ON_STATE(asyncRequest, unzip)
         {
             exlib::string hdr;
@@ -538,6 +632,12 @@ result_t HttpClient::request(Stream_base* conn, HttpRequest_base* req, SeekableS
                 else if (hdr == "deflate")
                     return zlib_base::inflateRawTo(m_body, m_unzip,
                         m_hc->m_maxBodySize, next(close));
+                else if (hdr == "br")
+                    return zlib_base::brotliDecompressTo(m_body, m_unzip,
+                        m_hc->m_maxBodySize, next(close));
+                else if (hdr == "zstd")
+                    return zlib_base::zstdDecompressTo(m_body, m_unzip,
+                        m_hc->m_maxBodySize, next(close));
             }
 
             return next(close);
@@ -556,6 +656,8 @@ result_t HttpClient::request(Stream_base* conn, HttpRequest_base* req, SeekableS
     private:
         obj_ptr<HttpClient> m_hc;
         Stream_base* m_conn;
+        obj_ptr<Conn> m_pc;
+        int32_t m_ticket;
         HttpRequest_base* m_req;
         obj_ptr<BufferedStream> m_bs;
         obj_ptr<MemoryStream> m_unzip;
@@ -568,7 +670,13 @@ result_t HttpClient::request(Stream_base* conn, HttpRequest_base* req, SeekableS
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_NOSYNC);
 
-    return (new asyncRequest(this, conn, req, response_body, retVal, ac))->post(0);
+    return (new asyncRequest(this, conn, pc, ticket, req, response_body, retVal, ac))->post(0);
+}
+
+result_t HttpClient::request(Stream_base* conn, HttpRequest_base* req, SeekableStream_base* response_body,
+    obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac)
+{
+    return _request(conn, NULL, 0, req, response_body, retVal, ac);
 }
 
 result_t HttpClient::request(Stream_base* conn, HttpRequest_base* req,
@@ -594,6 +702,11 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
             , m_opts(opts)
             , m_retVal(retVal)
             , m_hc(hc)
+            , m_reuse(false)
+            , m_idempotent(false)
+            , m_ticket(0)
+            , m_slot(false)
+            , m_negotiate(false)
         {
             m_u->toString(m_url);
             if (m_response_body)
@@ -648,7 +761,7 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
             bool enableEncoding = false;
             m_hc->get_enableEncoding(enableEncoding);
             if (enableEncoding)
-                m_req->addHeader("Accept-Encoding", "gzip,deflate");
+                m_req->addHeader("Accept-Encoding", "gzip,deflate" ACCEPT_BR ACCEPT_ZSTD);
 
             bool enableCookie = false;
             m_hc->get_enableCookie(enableCookie);
@@ -682,14 +795,59 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
             else
                 m_sslhost.clear();
 
+            if (m_http_proxy.empty() || m_http_proxy.c_str()[0] == 's' || m_ssl)
+                m_poolKey = m_connUrl;
+            else
+                m_poolKey = m_http_proxy;
+
+            // only requests that can be replayed safely are allowed to share a connection in flight
+            bool bUpgrade = false;
+            m_req->hasHeader("Upgrade", bUpgrade);
+            m_idempotent = !m_body && !bUpgrade
+                && (!qstricmp(m_method.c_str(), "GET") || !qstricmp(m_method.c_str(), "HEAD"));
+
             m_reuse = false;
-            if (m_hc->get_conn(m_connUrl, m_conn)) {
+            if (m_ssl && m_http_proxy.empty() && m_hc->m_enableHttp2)
+                return next(h2_acquire);
+
+            return m_hc->acquire(m_poolKey, m_idempotent, m_pc, m_ticket, next(acquired));
+        }
+
+        ON_STATE(asyncRequest, h2_acquire)
+        {
+            result_t hr = m_hc->h2_acquire(m_poolKey, m_h2, m_negotiate, next(h2_acquire));
+            if (hr == CALL_E_PENDDING)
+                return hr;
+
+            if (m_h2) {
                 m_reuse = true;
+                return next(h2_request);
+            }
+
+            return m_hc->acquire(m_poolKey, m_idempotent, m_pc, m_ticket, next(acquired));
+        }
+
+        ON_STATE(asyncRequest, acquired)
+        {
+            m_slot = true;
+
+            if (m_pc) {
+                if (m_negotiate) {
+                    m_negotiate = false;
+                    m_hc->h2_finish(m_poolKey, NULL, false);
+                }
+
+                m_reuse = true;
+                m_conn = m_pc->conn;
                 return next(connected);
             }
 
+            m_connStart.now();
+
             if (m_http_proxy.empty()) {
-                if (m_ssl)
+                if (m_negotiate)
+                    return net_base::connect("tcp://" + m_connUrl.substr(6), m_hc->m_timeout, m_conn, next(ssl_handshake));
+                else if (m_ssl)
                     return tls_base::connect(m_connUrl, m_hc->m_context, m_hc->m_timeout, m_conn, next(connected));
                 else
                     return net_base::connect(m_connUrl, m_hc->m_timeout, m_conn, next(connected));
@@ -709,11 +867,6 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
                         m_reqConn->addHeader("User-Agent", a);
                 }
 
-                if (m_hc->get_conn(m_http_proxy, m_conn)) {
-                    m_reuse = true;
-                    return next(m_ssl ? ssl_connect : connected);
-                }
-
                 obj_ptr<Url> u = new Url();
                 exlib::string connUrl;
                 const char* def_port;
@@ -865,6 +1018,17 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
             obj_ptr<TLSSocket> ss = new TLSSocket();
             ss->init(m_hc->m_context);
 
+            if (m_negotiate) {
+                std::vector<exlib::string> protocols;
+
+                protocols.push_back("h2");
+                protocols.push_back("http/1.1");
+
+                result_t hr = ss->set_alpn(protocols);
+                if (hr < 0)
+                    return hr;
+            }
+
             obj_ptr<Stream_base> conn = m_conn;
             m_conn = ss;
 
@@ -873,10 +1037,83 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
 
         ON_STATE(asyncRequest, connected)
         {
+            if (m_negotiate) {
+                exlib::string alpn;
+
+                m_negotiate = false;
+                m_conn.As<TLSSocket>()->getALPNProtocol(alpn);
+
+                if (alpn == "h2") {
+                    m_h2 = new Http2Session(m_conn);
+                    m_h2->m_maxHeadersCount = m_hc->m_maxHeadersCount;
+                    m_h2->m_maxHeaderSize = m_hc->m_maxHeaderSize;
+                    m_h2->m_maxBodySize = m_hc->m_maxBodySize;
+                    m_h2->start();
+
+                    // the session lives outside the pool, its connection slot is returned at once
+                    m_slot = false;
+                    m_hc->release(m_poolKey, NULL, false);
+                    m_hc->h2_finish(m_poolKey, m_h2, false);
+
+                    return next(h2_request);
+                }
+
+                m_hc->h2_finish(m_poolKey, NULL, true);
+            }
+
+            if (!m_pc) {
+                date_t d;
+
+                d.now();
+                m_hc->attach(m_poolKey, m_conn, m_idempotent, d.diff(m_connStart), m_pc);
+                m_ticket = 0;
+            }
+
             if (!m_ssl)
                 m_conn.As<Socket_base>()->set_timeout(m_hc->m_timeout);
 
-            return m_hc->request(m_conn, m_req, m_response_body, m_retVal, next(requested));
+            return m_hc->_request(m_conn, m_pc, m_ticket, m_req, m_response_body, m_retVal, next(requested));
+        }
+
+        ON_STATE(asyncRequest, h2_request)
+        {
+            return m_h2->request(m_req, m_response_body, m_retVal, next(h2_unzip));
+        }
+
+        ON_STATE(asyncRequest, h2_unzip)
+        {
+            exlib::string hdr;
+
+            if (m_hc->m_enableEncoding && !m_response_body
+                && m_retVal->firstHeader("Content-Encoding", hdr) != CALL_RETURN_NULL) {
+                obj_ptr<SeekableStream_base> body;
+
+                m_retVal->removeHeader("Content-Encoding");
+                m_retVal->get_body(body);
+                m_unzip = new MemoryStream();
+
+                if (hdr == "gzip")
+                    return zlib_base::gunzipTo(body, m_unzip, m_hc->m_maxBodySize, next(h2_unzipped));
+                else if (hdr == "deflate")
+                    return zlib_base::inflateRawTo(body, m_unzip, m_hc->m_maxBodySize, next(h2_unzipped));
+                else if (hdr == "br")
+                    return zlib_base::brotliDecompressTo(body, m_unzip, m_hc->m_maxBodySize, next(h2_unzipped));
+                else if (hdr == "zstd")
+                    return zlib_base::zstdDecompressTo(body, m_unzip, m_hc->m_maxBodySize, next(h2_unzipped));
+            }
+
+            return next(h2_unzipped);
+        }
+
+        ON_STATE(asyncRequest, h2_unzipped)
+        {
+            if (m_unzip) {
+                m_unzip->rewind();
+                m_retVal->set_body(m_unzip);
+                m_unzip.Release();
+            }
+
+            return next(requested);
         }
 
         ON_STATE(asyncRequest, requested)
@@ -889,21 +1126,24 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
                 m_hc->update_cookies(m_url, cookies);
             }
 
+            // streams of an h2 session need nothing returned to the pool
+            if (m_h2) {
+                m_h2.Release();
+                return next(closed);
+            }
+
             bool upgrade;
             m_retVal->get_upgrade(upgrade);
-            if (upgrade)
-                return next(closed);
 
             bool keepalive;
             m_retVal->get_keepAlive(keepalive);
-            if (keepalive) {
-                if (m_http_proxy.empty() || m_http_proxy.c_str()[0] == 's' || !m_sslhost.empty())
-                    m_hc->save_conn(m_connUrl, m_conn);
-                else
-                    m_hc->save_conn(m_http_proxy, m_conn);
 
+            m_slot = false;
+            m_hc->release(m_poolKey, m_pc, keepalive && !upgrade);
+            m_pc.Release();
+
+            if (upgrade || keepalive)
                 return next(closed);
-            }
 
             return m_conn->close(next(closed));
         }
@@ -942,7 +1182,32 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
 
         virtual int32_t error(int32_t v)
         {
-            if (m_reuse && (at(ssl_connect) || at(connected))) {
+            if (m_negotiate) {
+                m_negotiate = false;
+                m_hc->h2_finish(m_poolKey, NULL, false);
+            }
+
+            if (m_slot) {
+                m_slot = false;
+                m_hc->release(m_poolKey, m_pc, false);
+                m_pc.Release();
+            }
+
+            if (m_h2) {
+                // a request on a session that went away is tried once more on a new one
+                bool bRetry = m_reuse && at(h2_request) && m_h2->closed();
+
+                m_h2.Release();
+                if (bRetry) {
+                    m_reuse = false;
+                    next(prepare);
+                    return 0;
+                }
+
+                return v;
+            }
+
+            if (m_reuse && at(connected)) {
                 m_reuse = false;
                 next(prepare);
                 return 0;
@@ -971,6 +1236,15 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
         obj_ptr<HttpClient> m_hc;
         obj_ptr<Buffer_base> m_buffer;
         bool m_reuse;
+        exlib::string m_poolKey;
+        bool m_idempotent;
+        obj_ptr<Conn> m_pc;
+        int32_t m_ticket;
+        bool m_slot;
+        date_t m_connStart;
+        bool m_negotiate;
+        obj_ptr<Http2Session> m_h2;
+        obj_ptr<MemoryStream> m_unzip;
     };
 
     if (ac->isSync())
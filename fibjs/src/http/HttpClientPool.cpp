@@ -0,0 +1,504 @@
+/*
+ * HttpClientPool.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "HttpClient.h"
+#include "BufferedStream.h"
+
+namespace fibjs {
+
+result_t HttpClient::Conn::wait(int32_t& turn, std::unordered_map<int32_t, AsyncEvent*>& waits,
+    int32_t ticket, AsyncEvent* ac)
+{
+    m_lock.lock();
+
+    if (m_broken) {
+        m_lock.unlock();
+        return CALL_E_CLOSED;
+    }
+
+    if (turn == ticket) {
+        m_lock.unlock();
+        return 0;
+    }
+
+    waits[ticket] = ac;
+    m_lock.unlock();
+
+    return CALL_E_PENDDING;
+}
+
+void HttpClient::Conn::pass(int32_t& turn, std::unordered_map<int32_t, AsyncEvent*>& waits)
+{
+    AsyncEvent* ac = NULL;
+
+    m_lock.lock();
+    turn++;
+
+    std::unordered_map<int32_t, AsyncEvent*>::iterator it = waits.find(turn);
+    if (it != waits.end()) {
+        ac = it->second;
+        waits.erase(it);
+    }
+    m_lock.unlock();
+
+    if (ac)
+        ac->apost(0);
+}
+
+result_t HttpClient::Conn::wait_send(int32_t ticket, AsyncEvent* ac)
+{
+    return wait(m_sent, m_sendWaits, ticket, ac);
+}
+
+result_t HttpClient::Conn::wait_recv(int32_t ticket, AsyncEvent* ac)
+{
+    return wait(m_read, m_recvWaits, ticket, ac);
+}
+
+void HttpClient::Conn::sent()
+{
+    pass(m_sent, m_sendWaits);
+}
+
+void HttpClient::Conn::received()
+{
+    pass(m_read, m_recvWaits);
+}
+
+void HttpClient::Conn::fail()
+{
+    std::vector<AsyncEvent*> acs;
+
+    m_lock.lock();
+    m_broken = true;
+
+    for (std::unordered_map<int32_t, AsyncEvent*>::iterator it = m_sendWaits.begin(); it != m_sendWaits.end(); it++)
+        acs.push_back(it->second);
+    for (std::unordered_map<int32_t, AsyncEvent*>::iterator it = m_recvWaits.begin(); it != m_recvWaits.end(); it++)
+        acs.push_back(it->second);
+
+    m_sendWaits.clear();
+    m_recvWaits.clear();
+    m_lock.unlock();
+
+    for (size_t i = 0; i < acs.size(); i++)
+        acs[i]->apost(CALL_E_CLOSED);
+}
+
+void HttpClient::take(Pool* pool, Conn* conn, bool idempotent, int32_t& ticket)
+{
+    if (conn->m_requests == 0)
+        conn->m_idempotent = idempotent;
+    else
+        conn->m_idempotent = conn->m_idempotent && idempotent;
+
+    ticket = conn->m_tickets++;
+    conn->m_requests++;
+
+    pool->m_requests++;
+}
+
+HttpClient::Conn* HttpClient::pipe(Pool* pool)
+{
+    Conn* best = NULL;
+
+    if (m_pipelining <= 1)
+        return NULL;
+
+    for (size_t i = 0; i < pool->m_busy.size(); i++) {
+        Conn* conn = pool->m_busy[i];
+
+        if (conn->m_reusable && conn->m_idempotent && conn->m_requests < m_pipelining
+            && (!best || conn->m_requests < best->m_requests))
+            best = conn;
+    }
+
+    return best;
+}
+
+void HttpClient::dispatch(Pool* pool, std::vector<AsyncEvent*>& wakes)
+{
+    while (!pool->m_waiters.empty()) {
+        Pool::waiter& w = pool->m_waiters.front();
+
+        if (!pool->m_idle.empty()) {
+            obj_ptr<Conn> conn = pool->m_idle.back();
+            pool->m_idle.pop_back();
+            pool->m_busy.push_back(conn);
+
+            take(pool, conn, w.m_idempotent, *w.m_ticket);
+            pool->m_reused++;
+            *w.m_conn = conn;
+        } else {
+            Conn* conn = w.m_idempotent ? pipe(pool) : NULL;
+
+            if (conn) {
+                take(pool, conn, true, *w.m_ticket);
+                pool->m_reused++;
+                pool->m_pipelined++;
+                *w.m_conn = conn;
+            } else if (m_maxConnsPerHost <= 0 || pool->m_active < m_maxConnsPerHost) {
+                pool->m_active++;
+                pool->m_requests++;
+                *w.m_ticket = 0;
+            } else
+                break;
+        }
+
+        wakes.push_back(w.m_ac);
+        pool->m_waiters.pop_front();
+    }
+}
+
+void HttpClient::sweep(date_t d, std::vector<obj_ptr<Conn>>& expired)
+{
+    std::unordered_map<exlib::string, obj_ptr<Pool>>::iterator it = m_pools.begin();
+
+    while (it != m_pools.end()) {
+        Pool* pool = it->second;
+
+        while (pool->m_idle.size() && d.diff(pool->m_idle.front()->d) >= (double)m_poolTimeout) {
+            expired.push_back(pool->m_idle.front());
+            pool->m_idle.pop_front();
+            pool->m_active--;
+        }
+
+        if (pool->m_active == 0 && pool->m_waiters.empty()) {
+            m_retired.add(*pool);
+            it = m_pools.erase(it);
+        } else
+            it++;
+    }
+}
+
+void HttpClient::clean_coon(date_t d)
+{
+    std::vector<obj_ptr<Conn>> expired;
+    std::vector<obj_ptr<Http2Session>> idle;
+
+    m_lock.lock();
+    sweep(d, expired);
+
+    std::unordered_map<exlib::string, obj_ptr<H2Host>>::iterator it = m_h2.begin();
+    while (it != m_h2.end()) {
+        H2Host* host = it->second;
+
+        if (host->m_session && (host->m_session->closed() || host->m_session->idle(d, m_poolTimeout))) {
+            idle.push_back(host->m_session);
+            host->m_session.Release();
+        }
+
+        if (!host->m_session && !host->m_connecting && !host->m_h1)
+            it = m_h2.erase(it);
+        else
+            it++;
+    }
+    m_lock.unlock();
+
+    for (size_t i = 0; i < idle.size(); i++)
+        idle[i]->close();
+}
+
+result_t HttpClient::h2_acquire(exlib::string key, obj_ptr<Http2Session>& session, bool& negotiate, AsyncEvent* ac)
+{
+    session.Release();
+    negotiate = false;
+
+    m_lock.lock();
+
+    obj_ptr<H2Host>& host = m_h2[key];
+    if (!host)
+        host = new H2Host();
+
+    if (host->m_session && host->m_session->closed())
+        host->m_session.Release();
+
+    if (host->m_session)
+        session = host->m_session;
+    else if (host->m_connecting) {
+        // one request negotiates per host, the rest wait to share its session
+        host->m_waiters.push_back(ac);
+        m_lock.unlock();
+        return CALL_E_PENDDING;
+    } else if (!host->m_h1)
+        host->m_connecting = negotiate = true;
+
+    m_lock.unlock();
+    return 0;
+}
+
+void HttpClient::h2_finish(exlib::string key, Http2Session* session, bool h1)
+{
+    std::vector<AsyncEvent*> wakes;
+
+    m_lock.lock();
+
+    obj_ptr<H2Host>& host = m_h2[key];
+    if (!host)
+        host = new H2Host();
+
+    host->m_connecting = false;
+    host->m_session = session;
+    if (h1)
+        host->m_h1 = true;
+    wakes.swap(host->m_waiters);
+
+    m_lock.unlock();
+
+    for (size_t i = 0; i < wakes.size(); i++)
+        wakes[i]->apost(0);
+}
+
+result_t HttpClient::acquire(exlib::string key, bool idempotent, obj_ptr<Conn>& conn, int32_t& ticket, AsyncEvent* ac)
+{
+    std::vector<obj_ptr<Conn>> expired;
+    date_t d;
+
+    d.now();
+    conn.Release();
+
+    m_lock.lock();
+    sweep(d, expired);
+
+    obj_ptr<Pool>& pool = m_pools[key];
+    if (!pool)
+        pool = new Pool();
+
+    // waiters are served strictly in arrival order, a newcomer never overtakes them
+    if (pool->m_waiters.empty()) {
+        if (!pool->m_idle.empty()) {
+            conn = pool->m_idle.back();
+            pool->m_idle.pop_back();
+            pool->m_busy.push_back(conn);
+
+            take(pool, conn, idempotent, ticket);
+            pool->m_reused++;
+
+            m_lock.unlock();
+            return 0;
+        }
+
+        Conn* pc = idempotent ? pipe(pool) : NULL;
+        if (pc) {
+            conn = pc;
+
+            take(pool, conn, true, ticket);
+            pool->m_reused++;
+            pool->m_pipelined++;
+
+            m_lock.unlock();
+            return 0;
+        }
+
+        if (m_maxConnsPerHost <= 0 || pool->m_active < m_maxConnsPerHost) {
+            pool->m_active++;
+            pool->m_requests++;
+            ticket = 0;
+
+            m_lock.unlock();
+            return 0;
+        }
+    }
+
+    Pool::waiter w;
+
+    w.m_ac = ac;
+    w.m_conn = &conn;
+    w.m_ticket = &ticket;
+    w.m_idempotent = idempotent;
+    pool->m_waiters.push_back(w);
+
+    m_lock.unlock();
+
+    return CALL_E_PENDDING;
+}
+
+void HttpClient::attach(exlib::string key, Stream_base* stream, bool idempotent, double connectTime,
+    obj_ptr<Conn>& conn)
+{
+    obj_ptr<BufferedStream> bs = new BufferedStream(stream);
+    int32_t ticket;
+
+    bs->set_EOL("\r\n");
+
+    conn = new Conn(stream);
+    conn->m_bs = bs;
+
+    m_lock.lock();
+
+    obj_ptr<Pool>& pool = m_pools[key];
+    if (!pool)
+        pool = new Pool();
+
+    // the request was already counted when its connection slot was granted
+    take(pool, conn, idempotent, ticket);
+    pool->m_requests--;
+
+    pool->m_busy.push_back(conn);
+    pool->m_connects++;
+    pool->m_connectTime += connectTime;
+
+    m_lock.unlock();
+}
+
+void HttpClient::release(exlib::string key, Conn* conn, bool keepAlive)
+{
+    std::vector<AsyncEvent*> wakes;
+    std::vector<obj_ptr<Conn>> expired;
+    obj_ptr<Conn> dropped;
+    bool bFail = false;
+    date_t d;
+
+    d.now();
+
+    m_lock.lock();
+
+    obj_ptr<Pool>& pool = m_pools[key];
+    if (!pool)
+        pool = new Pool();
+
+    if (conn) {
+        conn->m_requests--;
+        if (!keepAlive)
+            conn->m_reusable = false;
+
+        if (conn->m_requests == 0) {
+            for (size_t i = 0; i < pool->m_busy.size(); i++)
+                if (pool->m_busy[i] == conn) {
+                    pool->m_busy.erase(pool->m_busy.begin() + i);
+                    break;
+                }
+
+            if (conn->m_reusable && (int32_t)pool->m_idle.size() < m_poolSize) {
+                conn->d = d;
+                pool->m_idle.push_back(conn);
+            } else {
+                dropped = conn;
+                pool->m_active--;
+            }
+        } else if (!keepAlive)
+            bFail = true;
+    } else
+        pool->m_active--;
+
+    dispatch(pool, wakes);
+    sweep(d, expired);
+
+    m_lock.unlock();
+
+    if (bFail)
+        conn->fail();
+
+    for (size_t i = 0; i < wakes.size(); i++)
+        wakes[i]->apost(0);
+}
+
+class _pool_stat {
+public:
+    _pool_stat()
+        : idle(0)
+        , active(0)
+        , waiters(0)
+        , requests(0)
+        , reused(0)
+        , pipelined(0)
+        , connects(0)
+        , connectTime(0)
+    {
+    }
+
+public:
+    void add(const _pool_stat& s)
+    {
+        idle += s.idle;
+        active += s.active;
+        waiters += s.waiters;
+        requests += s.requests;
+        reused += s.reused;
+        pipelined += s.pipelined;
+        connects += s.connects;
+        connectTime += s.connectTime;
+    }
+
+    v8::Local<v8::Object> toObject(Isolate* isolate)
+    {
+        v8::Local<v8::Context> context = isolate->context();
+        v8::Local<v8::Object> o = v8::Object::New(isolate->m_isolate);
+
+        o->Set(context, isolate->NewString("idle"), v8::Number::New(isolate->m_isolate, idle)).IsJust();
+        o->Set(context, isolate->NewString("active"), v8::Number::New(isolate->m_isolate, active)).IsJust();
+        o->Set(context, isolate->NewString("waiters"), v8::Number::New(isolate->m_isolate, waiters)).IsJust();
+        o->Set(context, isolate->NewString("requests"), v8::Number::New(isolate->m_isolate, (double)requests)).IsJust();
+        o->Set(context, isolate->NewString("reused"), v8::Number::New(isolate->m_isolate, (double)reused)).IsJust();
+        o->Set(context, isolate->NewString("pipelined"), v8::Number::New(isolate->m_isolate, (double)pipelined)).IsJust();
+        o->Set(context, isolate->NewString("connects"), v8::Number::New(isolate->m_isolate, (double)connects)).IsJust();
+        o->Set(context, isolate->NewString("reuseRatio"),
+             v8::Number::New(isolate->m_isolate, requests ? (double)reused / requests : 0))
+            .IsJust();
+        o->Set(context, isolate->NewString("connectLatency"),
+             v8::Number::New(isolate->m_isolate, connects ? connectTime / connects : 0))
+            .IsJust();
+
+        return o;
+    }
+
+public:
+    int32_t idle;
+    int32_t active;
+    int32_t waiters;
+    int64_t requests;
+    int64_t reused;
+    int64_t pipelined;
+    int64_t connects;
+    double connectTime;
+};
+
+result_t HttpClient::stats(v8::Local<v8::Object>& retVal)
+{
+    Isolate* isolate = Isolate::current();
+    v8::Local<v8::Context> context = isolate->context();
+    v8::Local<v8::Object> hosts = v8::Object::New(isolate->m_isolate);
+    std::vector<std::pair<exlib::string, _pool_stat>> stats;
+    _pool_stat total;
+
+    m_lock.lock();
+    total.requests = m_retired.m_requests;
+    total.reused = m_retired.m_reused;
+    total.pipelined = m_retired.m_pipelined;
+    total.connects = m_retired.m_connects;
+    total.connectTime = m_retired.m_connectTime;
+
+    for (std::unordered_map<exlib::string, obj_ptr<Pool>>::iterator it = m_pools.begin(); it != m_pools.end(); it++) {
+        Pool* pool = it->second;
+        _pool_stat s;
+
+        s.idle = (int32_t)pool->m_idle.size();
+        s.active = pool->m_active - s.idle;
+        s.waiters = (int32_t)pool->m_waiters.size();
+        s.requests = pool->m_requests;
+        s.reused = pool->m_reused;
+        s.pipelined = pool->m_pipelined;
+        s.connects = pool->m_connects;
+        s.connectTime = pool->m_connectTime;
+
+        stats.push_back(std::pair<exlib::string, _pool_stat>(it->first, s));
+    }
+    m_lock.unlock();
+
+    for (size_t i = 0; i < stats.size(); i++) {
+        hosts->Set(context, isolate->NewString(stats[i].first), stats[i].second.toObject(isolate)).IsJust();
+        total.add(stats[i].second);
+    }
+
+    retVal = total.toObject(isolate);
+    retVal->Set(context, isolate->NewString("hosts"), hosts).IsJust();
+
+    return 0;
+}
+
+} /* namespace fibjs */
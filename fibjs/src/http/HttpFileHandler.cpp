@@ -11,6 +11,7 @@
 #include "ifs/os.h"
 #include "path.h"
 #include "HttpFileHandler.h"
+#include "HttpHandler.h"
 #include "RangeStream.h"
 #include "HttpRequest.h"
 #include "Url.h"
@@ -1135,17 +1136,185 @@ static const MimeType s_mimeTypes[] = {
 };
 
 result_t http_base::fileHandler(exlib::string root, v8::Local<v8::Object> mimes,
-    bool autoIndex, obj_ptr<Handler_base>& retVal)
+    bool autoIndex, v8::Local<v8::Object> cache, obj_ptr<Handler_base>& retVal)
 {
     obj_ptr<HttpFileHandler> hdlr = new HttpFileHandler(root, autoIndex);
     result_t hr = hdlr->set_mimes(mimes);
     if (hr < 0)
         return hr;
 
+    hr = hdlr->set_cache(cache);
+    if (hr < 0)
+        return hr;
+
     retVal = hdlr;
     return 0;
 }
 
+exlib::atomic HttpFileHandler::s_cache_hits;
+exlib::atomic HttpFileHandler::s_cache_misses;
+exlib::atomic HttpFileHandler::s_cache_entries;
+
+HttpFileHandler::CacheEntry::~CacheEntry()
+{
+    for (size_t i = 0; i < m_fds.size(); i++)
+        asyncCall(::_close, m_fds[i]);
+}
+
+int32_t HttpFileHandler::CacheEntry::acquire()
+{
+    int32_t fd = -1;
+
+    m_lock.lock();
+    if (m_fds.size() > 0) {
+        fd = m_fds.back();
+        m_fds.pop_back();
+    }
+    m_lock.unlock();
+
+    if (fd != -1 && _lseeki64(fd, 0, SEEK_SET) < 0) {
+        ::_close(fd);
+        fd = -1;
+    }
+
+    if (fd == -1 && file_open(m_path, "r", 0666, fd) < 0)
+        return -1;
+
+    // the file may have been rewritten within the ttl, the cached headers are only good for the same content
+    uv_stat_t statbuf;
+    if (uring_fstat(fd, &statbuf) < 0 || !same_file(&statbuf)) {
+        ::_close(fd);
+        invalidate();
+        return -1;
+    }
+
+    return fd;
+}
+
+bool HttpFileHandler::CacheEntry::same_file(const uv_stat_t* statbuf)
+{
+    Stat* st = dynamic_cast<Stat*>((Stat_base*)m_stat);
+    if (!st)
+        return false;
+
+    obj_ptr<Stat> cur = new Stat();
+    cur->fill(m_path, statbuf);
+
+    return cur->size == st->size
+        && cur->mtime.diff(st->mtime) == 0 && cur->mtimeNs == st->mtimeNs
+        && cur->ctime.diff(st->ctime) == 0 && cur->ctimeNs == st->ctimeNs;
+}
+
+void HttpFileHandler::CacheEntry::release(int32_t fd)
+{
+    m_lock.lock();
+    if (m_valid && m_fds.size() < 8) {
+        m_fds.push_back(fd);
+        fd = -1;
+    }
+    m_lock.unlock();
+
+    if (fd != -1)
+        asyncCall(::_close, fd);
+}
+
+void HttpFileHandler::CacheEntry::invalidate()
+{
+    std::vector<int32_t> fds;
+
+    m_lock.lock();
+    m_valid = false;
+    fds.swap(m_fds);
+    m_lock.unlock();
+
+    for (size_t i = 0; i < fds.size(); i++)
+        asyncCall(::_close, fds[i]);
+}
+
+HttpFileHandler::~HttpFileHandler()
+{
+    for (size_t i = 0; i < m_cacheList.size(); i++)
+        s_cache_entries.dec();
+}
+
+result_t HttpFileHandler::set_cache(v8::Local<v8::Object> cache)
+{
+    Isolate* isolate = holder();
+    result_t hr;
+
+    hr = GetConfigValue(isolate, cache, "size", m_cacheSize);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+    if (m_cacheSize < 0)
+        return CHECK_ERROR(Runtime::setError("HttpFileHandler: cache size must be greater than or equal to 0."));
+
+    hr = GetConfigValue(isolate, cache, "ttl", m_cacheTTL);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+    if (m_cacheTTL < 0)
+        return CHECK_ERROR(Runtime::setError("HttpFileHandler: cache ttl must be greater than or equal to 0."));
+
+    return 0;
+}
+
+obj_ptr<HttpFileHandler::CacheEntry> HttpFileHandler::cache_get(exlib::string path)
+{
+    obj_ptr<CacheEntry> entry;
+    date_t now;
+
+    now.now();
+
+    m_cacheLock.lock();
+    auto it = m_cache.find(path);
+    if (it != m_cache.end()) {
+        if (now.diff((*it->second)->m_check) < m_cacheTTL) {
+            entry = *it->second;
+            m_cacheList.splice(m_cacheList.begin(), m_cacheList, it->second);
+        } else {
+            (*it->second)->invalidate();
+            m_cacheList.erase(it->second);
+            m_cache.erase(it);
+            s_cache_entries.dec();
+        }
+    }
+    m_cacheLock.unlock();
+
+    if (entry)
+        s_cache_hits.inc();
+    else
+        s_cache_misses.inc();
+
+    return entry;
+}
+
+void HttpFileHandler::cache_put(CacheEntry* entry)
+{
+    m_cacheLock.lock();
+
+    auto it = m_cache.find(entry->m_path);
+    if (it != m_cache.end()) {
+        (*it->second)->invalidate();
+        m_cacheList.erase(it->second);
+        m_cache.erase(it);
+        s_cache_entries.dec();
+    }
+
+    m_cacheList.push_front(entry);
+    m_cache.insert(std::make_pair(entry->m_path, m_cacheList.begin()));
+    s_cache_entries.inc();
+
+    while ((int32_t)m_cacheList.size() > m_cacheSize) {
+        obj_ptr<CacheEntry>& last = m_cacheList.back();
+
+        last->invalidate();
+        m_cache.erase(last->m_path);
+        m_cacheList.pop_back();
+        s_cache_entries.dec();
+    }
+
+    m_cacheLock.unlock();
+}
+
 result_t HttpFileHandler::set_mimes(v8::Local<v8::Object> mimes)
 {
     JSArray keys = mimes->GetPropertyNames(mimes->GetCreationContextChecked());
@@ -1178,6 +1347,9 @@ static int32_t mt_cmp(const void* p, const void* q)
     return qstricmp(*(const char**)p, *(const char**)q);
 }
 
+static const char* s_encodings[] = { "br", "gzip" };
+static const char* s_encodingExts[] = { ".br", ".gz" };
+
 result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
     AsyncEvent* ac)
 {
@@ -1191,6 +1363,9 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
             , m_autoIndex(autoIndex)
             , m_index(false)
             , m_dirPos(0)
+            , m_accept(0)
+            , m_variant(0)
+            , m_fd(-1)
         {
             req->get_response(m_rep);
             m_req->get_value(m_value);
@@ -1226,7 +1401,96 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
                 m_index = true;
             }
 
-            return fs_base::openFile(m_path, "r", m_file, next(open));
+            exlib::string hdr;
+            bool bRange = false;
+
+            m_req->hasHeader("Range", bRange);
+            if (!bRange && m_req->firstHeader("Accept-Encoding", hdr) != CALL_RETURN_NULL)
+                m_accept = HttpHandler::accept_encoding(hdr, s_encodings, (int32_t)ARRAYSIZE(s_encodings));
+
+            return next(variant);
+        }
+
+        ON_STATE(asyncInvoke, variant)
+        {
+            while (m_variant < (int32_t)ARRAYSIZE(s_encodings)) {
+                int32_t i = m_variant++;
+
+                if (!(m_accept & (1 << i)))
+                    continue;
+
+                m_encoding = s_encodings[i];
+                m_filePath = m_path + s_encodingExts[i];
+
+                int32_t r = check_cache();
+                if (r > 0)
+                    return next(acquire);
+                if (r < 0)
+                    continue;
+
+                return fs_base::openFile(m_filePath, "r", m_file, next(open));
+            }
+
+            m_encoding.clear();
+            m_filePath = m_path;
+            return next(plain);
+        }
+
+        ON_STATE(asyncInvoke, plain)
+        {
+            if (check_cache() > 0)
+                return next(acquire);
+
+            return fs_base::openFile(m_filePath, "r", m_file, next(open));
+        }
+
+        // 1: cached, -1: known to be missing, 0: not cached
+        int32_t check_cache()
+        {
+            if (m_pThis->m_cacheSize <= 0)
+                return 0;
+
+            m_entry = m_pThis->cache_get(m_filePath);
+            if (!m_entry)
+                return 0;
+
+            if (!m_entry->m_stat) {
+                m_entry.Release();
+                return -1;
+            }
+
+            return 1;
+        }
+
+        ON_STATE(asyncInvoke, acquire)
+        {
+            asyncCall(do_acquire, this, CALL_E_LONGSYNC);
+            return next(acquired, CALL_E_PENDDING);
+        }
+
+        static int32_t do_acquire(asyncInvoke* pThis)
+        {
+            pThis->m_fd = pThis->m_entry->acquire();
+            pThis->apost(0);
+            return 0;
+        }
+
+        ON_STATE(asyncInvoke, acquired)
+        {
+            if (m_fd == -1) {
+                m_entry.Release();
+                return fs_base::openFile(m_filePath, "r", m_file, next(open));
+            }
+
+            m_file = new HttpFileHandler::CachedFile(m_entry, m_fd);
+
+            if (!m_entry->m_type.empty())
+                m_rep->addHeader("Content-Type", m_entry->m_type);
+            if (m_entry->m_ranges)
+                m_rep->addHeader("Accept-Ranges", "bytes");
+
+            m_stat = m_entry->m_stat;
+            return next(stat);
         }
 
         ON_STATE(asyncInvoke, stop)
@@ -1328,9 +1592,10 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
         {
             exlib::string ext;
 
-            if (m_index)
-                m_rep->addHeader("Content-Type", "text/html");
-            else {
+            if (m_index) {
+                m_type = "text/html";
+                m_rep->addHeader("Content-Type", m_type);
+            } else {
                 path_base::extname(m_url, ext);
 
                 if (ext.length() > 0) {
@@ -1339,7 +1604,7 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
                     std::unordered_map<exlib::string, exlib::string>::iterator it = _mimes.find(pKey);
 
                     if (it != _mimes.end())
-                        m_rep->addHeader("Content-Type", it->second);
+                        m_type = it->second;
                     else {
                         const MimeType* pMimeType = (const MimeType*)bsearch(&pKey,
                             &s_mimeTypes, ARRAYSIZE(s_mimeTypes), sizeof(s_defType), mt_cmp);
@@ -1347,8 +1612,10 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
                         if (!pMimeType)
                             pMimeType = &s_defType;
 
-                        m_rep->addHeader("Content-Type", pMimeType->type);
+                        m_type = pMimeType->type;
                     }
+
+                    m_rep->addHeader("Content-Type", m_type);
                 }
                 m_rep->addHeader("Accept-Ranges", "bytes");
             }
@@ -1359,17 +1626,41 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
         ON_STATE(asyncInvoke, stat)
         {
             date_t d;
-            exlib::string str;
+            exlib::string lastModified;
+
+            if (!m_encoding.empty()) {
+                m_rep->addHeader("Content-Encoding", m_encoding);
+                m_rep->addHeader("Vary", "Accept-Encoding");
+            }
 
-            m_stat->get_mtime(d);
+            if (m_entry) {
+                d = m_entry->m_mtime;
+                lastModified = m_entry->m_lastModified;
+            } else {
+                m_stat->get_mtime(d);
+                d.toGMTString(lastModified);
 
-            exlib::string lastModified;
-            if (m_req->firstHeader("If-Modified-Since", lastModified)
+                if (m_pThis->m_cacheSize > 0 && File_base::class_info().isInstance(m_file->Classinfo())) {
+                    obj_ptr<HttpFileHandler::CacheEntry> entry = new HttpFileHandler::CacheEntry(m_filePath);
+
+                    entry->m_type = m_type;
+                    entry->m_ranges = !m_index;
+                    entry->m_lastModified = lastModified;
+                    entry->m_stat = m_stat;
+                    entry->m_mtime = d;
+                    entry->m_check.now();
+
+                    m_pThis->cache_put(entry);
+                }
+            }
+
+            exlib::string ifModifiedSince;
+            if (m_req->firstHeader("If-Modified-Since", ifModifiedSince)
                 != CALL_RETURN_NULL) {
                 date_t d1;
                 double diff;
 
-                d1.parse(lastModified);
+                d1.parse(ifModifiedSince);
                 diff = d.diff(d1);
 
                 if (diff > -1000 && diff < 1000) {
@@ -1378,8 +1669,6 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
                 }
             }
 
-            d.toGMTString(lastModified);
-
             m_rep->addHeader("Last-Modified", lastModified);
 
             exlib::string range;
@@ -1423,7 +1712,18 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
 
         virtual int32_t error(int32_t v)
         {
-            if (at(start)) {
+            if (at(variant) || (at(acquired) && !m_encoding.empty())) {
+                if (m_pThis->m_cacheSize > 0) {
+                    obj_ptr<HttpFileHandler::CacheEntry> entry = new HttpFileHandler::CacheEntry(m_filePath);
+
+                    entry->m_check.now();
+                    m_pThis->cache_put(entry);
+                }
+
+                return next(variant);
+            }
+
+            if (at(plain) || at(acquired)) {
                 if (m_index) {
                     m_index = false;
 
@@ -1442,6 +1742,10 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
         obj_ptr<HttpResponse_base> m_rep;
         obj_ptr<SeekableStream_base> m_file;
         obj_ptr<Stat_base> m_stat;
+        obj_ptr<HttpFileHandler::CacheEntry> m_entry;
+        exlib::string m_type;
+        exlib::string m_encoding;
+        exlib::string m_filePath;
         exlib::string m_value;
         exlib::string m_url;
         exlib::string m_path;
@@ -1449,6 +1753,9 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
         bool m_index;
         obj_ptr<NArray> m_dir;
         int32_t m_dirPos;
+        int32_t m_accept;
+        int32_t m_variant;
+        int32_t m_fd;
     };
 
     if (ac->isSync())
@@ -16,6 +16,14 @@
 #include "version.h"
 #include "ifs/zlib.h"
 #include "ifs/console.h"
+#include "ifs/File.h"
+#include "AsyncUring.h"
+#include "ifs/TLSSocket.h"
+#include "Http2Session.h"
+#include "parse.h"
+#include <unordered_map>
+#include <list>
+#include <inttypes.h>
 
 namespace fibjs {
 
@@ -586,6 +594,143 @@ static int32_t mt_cmp(const void* p, const void* q)
     return qstricmp(*(const char**)p, *(const char**)q);
 }
 
+// content codings in the order the server prefers them, the index + 1 is the encoding type.
+static const char* s_encodings[] = {
+    "br",
+    "zstd",
+    "gzip",
+    "deflate"
+};
+
+// returns a mask of the codings in names the client accepts, bit i for names[i].
+// a coding with q=0 is refused, other weights are not ranked.
+int32_t HttpHandler::accept_encoding(exlib::string& hdr, const char* const* names, int32_t count)
+{
+    _parser p(hdr);
+    int32_t mask = 0;
+
+    while (!p.end()) {
+        exlib::string name;
+        bool refused = false;
+
+        p.skipSpace();
+        p.getWord(name, ',', ';');
+
+        while (p.want(';')) {
+            exlib::string param;
+
+            p.skipSpace();
+            p.getWord(param, ',', ';');
+            if (!qstricmp(param.c_str(), "q=", 2) && atof(param.c_str() + 2) <= 0)
+                refused = true;
+        }
+
+        p.skipUntil(',');
+        p.skip();
+
+        if (!refused)
+            for (int32_t i = 0; i < count; i++)
+                if (!qstricmp(name.c_str(), names[i])) {
+                    mask |= 1 << i;
+                    break;
+                }
+    }
+
+    return mask;
+}
+
+// returns the preferred coding the client accepts, 0 if none.
+static int32_t preferred_encoding(exlib::string& hdr)
+{
+    int32_t mask = HttpHandler::accept_encoding(hdr, s_encodings, (int32_t)ARRAYSIZE(s_encodings));
+
+    // never pick a coding this build cannot produce
+#ifndef HAVE_BROTLI
+    mask &= ~1;
+#endif
+#ifndef HAVE_ZSTD
+    mask &= ~2;
+#endif
+
+    for (int32_t i = 0; i < (int32_t)ARRAYSIZE(s_encodings); i++)
+        if (mask & (1 << i))
+            return i + 1;
+
+    return 0;
+}
+
+#define ZIP_CACHE_SIZE (32 * 1024 * 1024)
+
+// brotli at its default quality 11 is far too slow to run per response, 5 still beats gzip on text.
+#define BROTLI_QUALITY 5
+
+exlib::atomic HttpHandler::s_zip_hits;
+exlib::atomic HttpHandler::s_zip_misses;
+
+static exlib::spinlock s_zip_lock;
+// cached bodies share the slices of the MemoryStream they were compressed into, nobody writes them again
+static std::list<std::pair<exlib::string, MemoryStream::Rope>> s_zip_list;
+static std::unordered_map<exlib::string, std::list<std::pair<exlib::string, MemoryStream::Rope>>::iterator> s_zip_cache;
+static size_t s_zip_bytes = 0;
+
+bool HttpHandler::zip_get(const exlib::string& key, MemoryStream::Rope& retVal)
+{
+    bool bFound = false;
+
+    s_zip_lock.lock();
+    auto it = s_zip_cache.find(key);
+    if (it != s_zip_cache.end()) {
+        s_zip_list.splice(s_zip_list.begin(), s_zip_list, it->second);
+        retVal = it->second->second;
+        bFound = true;
+    }
+    s_zip_lock.unlock();
+
+    if (bFound)
+        s_zip_hits.inc();
+    else
+        s_zip_misses.inc();
+
+    return bFound;
+}
+
+void HttpHandler::zip_put(const exlib::string& key, const MemoryStream::Rope& data)
+{
+    if (data.size() > ZIP_CACHE_SIZE / 8)
+        return;
+
+    s_zip_lock.lock();
+
+    auto it = s_zip_cache.find(key);
+    if (it != s_zip_cache.end()) {
+        s_zip_bytes -= (size_t)it->second->second.size();
+        s_zip_list.erase(it->second);
+        s_zip_cache.erase(it);
+    }
+
+    s_zip_list.push_front(std::make_pair(key, data));
+    s_zip_cache.insert(std::make_pair(key, s_zip_list.begin()));
+    s_zip_bytes += (size_t)data.size();
+
+    while (s_zip_bytes > ZIP_CACHE_SIZE) {
+        auto& last = s_zip_list.back();
+
+        s_zip_bytes -= (size_t)last.second.size();
+        s_zip_cache.erase(last.first);
+        s_zip_list.pop_back();
+    }
+
+    s_zip_lock.unlock();
+}
+
+void HttpHandler::zip_info(int64_t& entries, int64_t& size)
+{
+    s_zip_lock.lock();
+    entries = (int64_t)s_zip_list.size();
+    size = (int64_t)s_zip_bytes;
+    s_zip_lock.unlock();
+}
+
 result_t HttpHandler_base::_new(Handler_base* hdlr, obj_ptr<HttpHandler_base>& retVal,
     v8::Local<v8::Object> This)
 {
@@ -604,11 +749,258 @@ HttpHandler::HttpHandler()
     , m_maxHeaderSize(8192)
     , m_maxBodySize(64)
     , m_enableEncoding(false)
+    , m_enableHttp2(false)
+    , m_maxConcurrentStreams(100)
+    , m_headerTableSize(4096)
+    , m_streamBody(false)
 {
     m_serverName = "fibjs/";
     m_serverName.append(fibjs_version);
 }
 
+bool HttpHandler::cross_origin(HttpRequest_base* req, HttpResponse_base* rep)
+{
+    if (!m_crossDomain)
+        return false;
+
+    exlib::string origin;
+
+    if (req->firstHeader("origin", origin) == CALL_RETURN_NULL)
+        return false;
+
+    rep->setHeader("Access-Control-Allow-Credentials", "true");
+    rep->setHeader("Access-Control-Allow-Origin", origin);
+
+    exlib::string method;
+
+    req->get_method(method);
+    if (qstricmp(method.c_str(), "options"))
+        return false;
+
+    rep->setHeader("Access-Control-Allow-Methods", "*");
+    rep->setHeader("Access-Control-Allow-Headers", m_allowHeaders);
+    rep->setHeader("Access-Control-Max-Age", "1728000");
+
+    return true;
+}
+
+void HttpHandler::fix_headers(HttpResponse_base* rep, bool options)
+{
+    int32_t s;
+    bool t = false;
+    exlib::string str;
+
+    if (rep->firstHeader("Server", str) == CALL_RETURN_NULL)
+        rep->addHeader("Server", m_serverName);
+
+    rep->get_statusCode(s);
+    if (s == 200 && !options) {
+        rep->hasHeader("Last-Modified", t);
+        if (!t && (rep->firstHeader("Cache-Control", str) == CALL_RETURN_NULL)) {
+            rep->addHeader("Cache-Control", "no-cache, no-store");
+            rep->addHeader("Expires", "-1");
+        }
+    }
+}
+
+result_t HttpHandler::encode(HttpRequest_base* req, HttpResponse_base* rep, obj_ptr<SeekableStream_base>& body,
+    obj_ptr<MemoryStream>& zip, exlib::string& zipKey, AsyncEvent* ac)
+{
+    int64_t len;
+
+    rep->get_length(len);
+
+    if (!m_enableEncoding || len <= 128 || len >= 1024 * 1024 * 64)
+        return CALL_RETURN_NULL;
+
+    exlib::string hdr;
+
+    if (req->firstHeader("Accept-Encoding", hdr) == CALL_RETURN_NULL)
+        return CALL_RETURN_NULL;
+
+    int32_t type = preferred_encoding(hdr);
+
+    if (type != 0) {
+        if (rep->firstHeader("Content-Type", hdr) != CALL_RETURN_NULL) {
+            const char* pKey = hdr.c_str();
+            if (qstricmp(hdr.c_str(), "text/", 5)
+                && !bsearch(&pKey, &s_zipTypes, ARRAYSIZE(s_zipTypes),
+                    sizeof(pKey), mt_cmp))
+                type = 0;
+        } else
+            type = 0;
+    }
+
+    if (type != 0) {
+        if (rep->firstHeader("Content-Encoding", hdr) != CALL_RETURN_NULL)
+            type = 0;
+    }
+
+    if (type == 0)
+        return CALL_RETURN_NULL;
+
+    rep->addHeader("Content-Encoding", s_encodings[type - 1]);
+    rep->addHeader("Vary", "Accept-Encoding");
+
+    rep->get_body(body);
+    body->rewind();
+
+    // static files are identified by inode, size and the ns mtime/ctime of the open fd, reuse their compressed body.
+    zipKey.clear();
+    int32_t fd = -1;
+    uv_stat_t statbuf;
+    if (File_base::class_info().isInstance(body->Classinfo())
+        && body->get_fd(fd) == 0 && fd >= 0 && uring_fstat(fd, &statbuf) == 0) {
+        char s[256];
+
+        snprintf(s, sizeof(s), "%" PRIu64 ":%" PRIu64 ":%" PRIu64 ":%" PRId64 ".%09ld:%" PRId64 ".%09ld:%d",
+            (uint64_t)statbuf.st_dev, (uint64_t)statbuf.st_ino, (uint64_t)statbuf.st_size,
+            (int64_t)statbuf.st_mtim.tv_sec, (long)statbuf.st_mtim.tv_nsec,
+            (int64_t)statbuf.st_ctim.tv_sec, (long)statbuf.st_ctim.tv_nsec, type);
+        zipKey = s;
+
+        MemoryStream::Rope data;
+        if (HttpHandler::zip_get(zipKey, data)) {
+            date_t d;
+
+            d.now();
+            rep->set_body(new MemoryStream::CloneStream(data, d));
+            return CALL_RETURN_NULL;
+        }
+    }
+
+    zip = new MemoryStream();
+
+    switch (type) {
+    case 1:
+        return zlib_base::brotliCompressTo(body, zip, BROTLI_QUALITY, ac);
+    case 2:
+        return zlib_base::zstdCompressTo(body, zip, -1, ac);
+    case 3:
+        return zlib_base::gzipTo(body, zip, ac);
+    default:
+        return zlib_base::deflateTo(body, zip, -1, ac);
+    }
+}
+
+void HttpHandler::encoded(HttpResponse_base* rep, MemoryStream* zip, const exlib::string& zipKey)
+{
+    if (!zipKey.empty())
+        HttpHandler::zip_put(zipKey, zip->rope());
+
+    rep->set_body(zip);
+}
+
+class asyncH2Invoke : public AsyncState {
+public:
+    asyncH2Invoke(HttpHandler* pThis, Http2Session* session, Http2Session::Stream* s)
+        : AsyncState(NULL)
+        , m_pThis(pThis)
+        , m_session(session)
+        , m_s(s)
+        , m_req(s->m_request)
+        , m_options(false)
+    {
+        m_req->get_response(m_rep);
+        m_rep->set_protocol("HTTP/2.0");
+
+        next(invoke);
+    }
+
+    ON_STATE(asyncH2Invoke, invoke)
+    {
+        if (m_pThis->cross_origin(m_req, m_rep)) {
+            m_options = true;
+            return next(send);
+        }
+
+        obj_ptr<Handler_base> hdlr;
+
+        m_pThis->get_handler(hdlr);
+        return mq_base::invoke(hdlr, m_req, next(send));
+    }
+
+    ON_STATE(asyncH2Invoke, send)
+    {
+        exlib::string str;
+
+        m_pThis->fix_headers(m_rep, m_options);
+
+        m_req->get_method(str);
+        m_head = !qstricmp(str.c_str(), "head");
+
+        if (!m_head) {
+            result_t hr = m_pThis->encode(m_req, m_rep, m_body, m_zip, m_zipKey, next(zip));
+            if (hr != CALL_RETURN_NULL)
+                return hr;
+        }
+
+        return m_session->respond(m_s, m_rep, m_head, next(end));
+    }
+
+    ON_STATE(asyncH2Invoke, zip)
+    {
+        m_pThis->encoded(m_rep, m_zip, m_zipKey);
+        return m_session->respond(m_s, m_rep, m_head, next(end));
+    }
+
+    ON_STATE(asyncH2Invoke, end)
+    {
+        if (!m_body)
+            m_rep->get_body(m_body);
+
+        if (!m_body)
+            return next();
+
+        return m_body->close(next());
+    }
+
+    virtual int32_t error(int32_t v)
+    {
+        if (at(invoke)) {
+            exlib::string err = getResultMessage(v);
+
+            m_req->set_lastError(err);
+            errorLog("HttpHandler: " + err);
+
+            m_rep->set_statusCode(500);
+            return 0;
+        }
+
+        return next();
+    }
+
+private:
+    obj_ptr<HttpHandler> m_pThis;
+    obj_ptr<Http2Session> m_session;
+    obj_ptr<Http2Session::Stream> m_s;
+    obj_ptr<HttpRequest_base> m_req;
+    obj_ptr<HttpResponse_base> m_rep;
+    obj_ptr<MemoryStream> m_zip;
+    exlib::string m_zipKey;
+    obj_ptr<SeekableStream_base> m_body;
+    bool m_options;
+    bool m_head;
+};
+
+// every stream of an HTTP/2 connection runs through the handler on its own
+class H2Dispatcher : public Http2Session::Dispatcher {
+public:
+    H2Dispatcher(HttpHandler* hdlr)
+        : m_hdlr(hdlr)
+    {
+    }
+
+public:
+    virtual void dispatch(Http2Session* session, Http2Session::Stream* s)
+    {
+        (new asyncH2Invoke(m_hdlr, session, s))->post(0);
+    }
+
+private:
+    obj_ptr<HttpHandler> m_hdlr;
+};
+
 result_t HttpHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
     AsyncEvent* ac)
 {
@@ -619,6 +1011,7 @@ result_t HttpHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
             , m_pThis(pThis)
             , m_stm(stm)
             , m_options(false)
+            , m_preface(false)
         {
             m_stmBuffered = new BufferedStream(stm);
             m_stmBuffered->set_EOL("\r\n");
@@ -628,6 +1021,20 @@ result_t HttpHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
 
             m_req->set_maxHeadersCount(pThis->m_maxHeadersCount);
             m_req->set_maxBodySize(pThis->m_maxBodySize);
+            m_req->set_streamBody(pThis->m_streamBody);
+
+            // h2 negotiated in the TLS handshake starts with the client preface
+            if (pThis->m_enableHttp2) {
+                obj_ptr<TLSSocket_base> tls = TLSSocket_base::getInstance(stm);
+                exlib::string alpn;
+
+                if (tls && tls->getALPNProtocol(alpn) == 0 && alpn == "h2") {
+                    m_conn = stm;
+                    m_preface = true;
+                    next(h2);
+                    return;
+                }
+            }
 
             next(read);
         }
@@ -658,6 +1065,17 @@ result_t HttpHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
             exlib::string str;
 
             m_req->get_protocol(str);
+
+            // h2c with prior knowledge, the request line was the first half of the preface
+            if (m_pThis->m_enableHttp2 && str == "HTTP/2.0") {
+                exlib::string method, address;
+
+                m_req->get_method(method);
+                m_req->get_address(address);
+                if (method == "PRI" && address == "*")
+                    return m_stmBuffered->read(6, m_buf, next(h2c));
+            }
+
             m_rep->set_protocol(str);
 
             bool bKeepAlive;
@@ -667,28 +1085,9 @@ result_t HttpHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
 
             m_d.now();
 
-            if (m_pThis->m_crossDomain) {
-                m_req->get_address(str);
-
-                exlib::string origin;
-
-                if (m_req->firstHeader("origin", origin) != CALL_RETURN_NULL) {
-                    m_rep->setHeader("Access-Control-Allow-Credentials", "true");
-                    m_rep->setHeader("Access-Control-Allow-Origin", origin);
-
-                    m_req->get_method(str);
-
-                    if (!qstricmp(str.c_str(), "options")) {
-                        m_options = true;
-
-                        m_rep->setHeader("Access-Control-Allow-Methods", "*");
-                        m_rep->setHeader("Access-Control-Allow-Headers",
-                            m_pThis->m_allowHeaders);
-                        m_rep->setHeader("Access-Control-Max-Age", "1728000");
-
-                        return next(send);
-                    }
-                }
+            if (m_pThis->cross_origin(m_req, m_rep)) {
+                m_options = true;
+                return next(send);
             }
 
             return mq_base::invoke(m_pThis->m_hdlr, m_req, next(send));
@@ -696,24 +1095,9 @@ result_t HttpHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
 
         ON_STATE(asyncInvoke, send)
         {
-            int32_t s;
-            bool t = false;
-            date_t d;
             exlib::string str;
 
-            if (m_rep->firstHeader("Server", str) == CALL_RETURN_NULL)
-                m_rep->addHeader("Server", m_pThis->m_serverName);
-
-            d.now();
-
-            m_rep->get_statusCode(s);
-            if (s == 200 && !m_options) {
-                m_rep->hasHeader("Last-Modified", t);
-                if (!t && (m_rep->firstHeader("Cache-Control", str) == CALL_RETURN_NULL)) {
-                    m_rep->addHeader("Cache-Control", "no-cache, no-store");
-                    m_rep->addHeader("Expires", "-1");
-                }
-            }
+            m_pThis->fix_headers(m_rep, m_options);
 
             m_req->get_method(str);
             bool headOnly = !qstricmp(str.c_str(), "head");
@@ -723,71 +1107,72 @@ result_t HttpHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
                 return m_rep->sendHeader(m_stm, next(end));
             }
 
-            int64_t len;
-
-            m_rep->get_length(len);
+            result_t hr = m_pThis->encode(m_req, m_rep, m_body, m_zip, m_zipKey, next(zip));
+            if (hr != CALL_RETURN_NULL)
+                return hr;
 
-            if (m_pThis->m_enableEncoding && len > 128 && len < 1024 * 1024 * 64) {
-                exlib::string hdr;
-
-                if (m_req->firstHeader("Accept-Encoding", hdr) != CALL_RETURN_NULL) {
-                    int32_t type = 0;
+            return m_rep->sendTo(m_stm, next(end));
+        }
 
-                    if (qstristr(hdr.c_str(), "gzip"))
-                        type = 1;
-                    else if (qstristr(hdr.c_str(), "deflate"))
-                        type = 2;
+        ON_STATE(asyncInvoke, zip)
+        {
+            m_pThis->encoded(m_rep, m_zip, m_zipKey);
+            return m_rep->sendTo(m_stm, next(end));
+        }
 
-                    if (type != 0) {
-                        if (m_rep->firstHeader("Content-Type", hdr) != CALL_RETURN_NULL) {
-                            const char* pKey = hdr.c_str();
-                            if (qstricmp(hdr.c_str(), "text/", 5)
-                                && !bsearch(&pKey, &s_zipTypes, ARRAYSIZE(s_zipTypes),
-                                    sizeof(pKey), mt_cmp))
-                                type = 0;
-                        } else
-                            type = 0;
-                    }
+        ON_STATE(asyncInvoke, end)
+        {
+            if (!m_body)
+                m_rep->get_body(m_body);
 
-                    if (type != 0) {
-                        if (m_rep->firstHeader("Content-Encoding", hdr) != CALL_RETURN_NULL)
-                            type = 0;
-                    }
+            if (!m_body)
+                return next(drain);
 
-                    if (type != 0) {
-                        m_rep->addHeader("Content-Encoding", type == 1 ? "gzip" : "deflate");
+            return m_body->close(next(drain));
+        }
 
-                        m_rep->get_body(m_body);
-                        m_body->rewind();
+        ON_STATE(asyncInvoke, drain)
+        {
+            HttpBodyStream* body = m_req->bodyStream();
+            bool bKeepAlive = false;
 
-                        m_zip = new MemoryStream();
+            m_rep->get_keepAlive(bKeepAlive);
 
-                        if (type == 1)
-                            return zlib_base::gzipTo(m_body, m_zip, next(zip));
-                        else
-                            return zlib_base::deflateTo(m_body, m_zip, -1, next(zip));
-                    }
-                }
-            }
+            // whatever the handler left of a streamed body is still in front of the next request
+            if (bKeepAlive && body && !body->ended())
+                return body->drain(next(read));
 
-            return m_rep->sendTo(m_stm, next(end));
+            return next(read);
         }
 
-        ON_STATE(asyncInvoke, zip)
+        ON_STATE(asyncInvoke, h2c)
         {
-            m_rep->set_body(m_zip);
-            return m_rep->sendTo(m_stm, next(end));
+            Buffer* buf = m_buf ? Buffer::Cast(m_buf) : NULL;
+
+            if (!buf || buf->length() != 6 || memcmp(buf->data(), "SM\r\n\r\n", 6))
+                return CHECK_ERROR(Runtime::setError("HttpHandler: bad HTTP/2 connection preface."));
+
+            // whatever the client sent after the preface is still buffered
+            m_conn = m_stmBuffered;
+            return next(h2);
         }
 
-        ON_STATE(asyncInvoke, end)
+        ON_STATE(asyncInvoke, h2)
         {
-            if (!m_body)
-                m_rep->get_body(m_body);
+            m_session = new Http2Session(m_conn, new H2Dispatcher(m_pThis));
 
-            if (!m_body)
-                return next(read);
+            m_session->m_maxHeadersCount = m_pThis->m_maxHeadersCount;
+            m_session->m_maxHeaderSize = m_pThis->m_maxHeaderSize;
+            m_session->m_maxBodySize = m_pThis->m_maxBodySize;
+            m_session->m_maxStreams = m_pThis->m_maxConcurrentStreams;
+            m_session->m_tableSize = m_pThis->m_headerTableSize;
 
-            return m_body->close(next(read));
+            return m_session->serve(m_preface, next(h2_end));
+        }
+
+        ON_STATE(asyncInvoke, h2_end)
+        {
+            return next(CALL_RETURN_NULL);
         }
 
         virtual int32_t error(int32_t v)
@@ -820,12 +1205,18 @@ result_t HttpHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
         obj_ptr<HttpHandler> m_pThis;
         obj_ptr<Stream_base> m_stm;
         obj_ptr<BufferedStream_base> m_stmBuffered;
-        obj_ptr<HttpRequest_base> m_req;
+        obj_ptr<HttpRequest> m_req;
         obj_ptr<HttpResponse_base> m_rep;
         obj_ptr<MemoryStream> m_zip;
+        exlib::string m_zipKey;
         obj_ptr<SeekableStream_base> m_body;
         date_t m_d;
         bool m_options;
+
+        obj_ptr<Buffer_base> m_buf;
+        obj_ptr<Stream_base> m_conn;
+        obj_ptr<Http2Session> m_session;
+        bool m_preface;
     };
 
     if (ac->isSync())
@@ -905,6 +1296,60 @@ result_t HttpHandler::set_enableEncoding(bool newVal)
     return 0;
 }
 
+result_t HttpHandler::get_enableHttp2(bool& retVal)
+{
+    retVal = m_enableHttp2;
+    return 0;
+}
+
+result_t HttpHandler::set_enableHttp2(bool newVal)
+{
+    m_enableHttp2 = newVal;
+    return 0;
+}
+
+result_t HttpHandler::get_maxConcurrentStreams(int32_t& retVal)
+{
+    retVal = m_maxConcurrentStreams;
+    return 0;
+}
+
+result_t HttpHandler::set_maxConcurrentStreams(int32_t newVal)
+{
+    if (newVal < 1)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    m_maxConcurrentStreams = newVal;
+    return 0;
+}
+
+result_t HttpHandler::get_headerTableSize(int32_t& retVal)
+{
+    retVal = m_headerTableSize;
+    return 0;
+}
+
+result_t HttpHandler::set_headerTableSize(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    m_headerTableSize = newVal;
+    return 0;
+}
+
+result_t HttpHandler::get_streamBody(bool& retVal)
+{
+    retVal = m_streamBody;
+    return 0;
+}
+
+result_t HttpHandler::set_streamBody(bool newVal)
+{
+    m_streamBody = newVal;
+    return 0;
+}
+
 result_t HttpHandler::get_serverName(exlib::string& retVal)
 {
     retVal = m_serverName;
@@ -0,0 +1,358 @@
+/*
+ * HttpHead.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "HttpHead.h"
+#include "Buffer.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE4_2__)
+#include <nmmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace fibjs {
+
+static class _tchar_map {
+public:
+    _tchar_map()
+    {
+        const char* s = "!#$%&'*+-.^_`|~";
+        int32_t i;
+
+        memset(m_map, 0, sizeof(m_map));
+        for (i = '0'; i <= '9'; i++)
+            m_map[i] = true;
+        for (i = 'a'; i <= 'z'; i++)
+            m_map[i] = m_map[i - 'a' + 'A'] = true;
+        while (*s)
+            m_map[(unsigned char)*s++] = true;
+    }
+
+    bool operator[](char ch) const
+    {
+        return m_map[(unsigned char)ch];
+    }
+
+private:
+    bool m_map[256];
+} s_tchar;
+
+inline int32_t first_bit(uint32_t m)
+{
+#ifdef _MSC_VER
+    unsigned long n;
+    _BitScanForward(&n, m);
+    return (int32_t)n;
+#else
+    return __builtin_ctz(m);
+#endif
+}
+
+// first control character in [p, end), the line ends there or the line is bad.
+// tab is allowed in values, bytes over 0x7f are passed through as obs-text.
+static const char* find_ctl(const char* p, const char* end)
+{
+#if defined(__AVX2__)
+    const __m256i ctl = _mm256_set1_epi8(0x1f);
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i del = _mm256_set1_epi8(0x7f);
+
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)p);
+        __m256i r = _mm256_cmpeq_epi8(_mm256_min_epu8(v, ctl), v);
+
+        r = _mm256_andnot_si256(_mm256_cmpeq_epi8(v, tab), r);
+        r = _mm256_or_si256(r, _mm256_cmpeq_epi8(v, del));
+
+        uint32_t m = (uint32_t)_mm256_movemask_epi8(r);
+        if (m)
+            return p + first_bit(m);
+        p += 32;
+    }
+#elif defined(__SSE4_2__)
+    // 0x00-0x08, 0x0a-0x1f and 0x7f
+    alignas(16) static const char ranges[16] = "\000\010\012\037\177\177";
+    const __m128i r = _mm_load_si128((const __m128i*)ranges);
+
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+        int32_t n = _mm_cmpestri(r, 6, v, 16,
+            _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_LEAST_SIGNIFICANT);
+
+        if (n != 16)
+            return p + n;
+        p += 16;
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128i ctl = _mm_set1_epi8(0x1f);
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i del = _mm_set1_epi8(0x7f);
+
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+        __m128i r = _mm_cmpeq_epi8(_mm_min_epu8(v, ctl), v);
+
+        r = _mm_andnot_si128(_mm_cmpeq_epi8(v, tab), r);
+        r = _mm_or_si128(r, _mm_cmpeq_epi8(v, del));
+
+        uint32_t m = (uint32_t)_mm_movemask_epi8(r);
+        if (m)
+            return p + first_bit(m);
+        p += 16;
+    }
+#endif
+
+    while (p < end) {
+        unsigned char ch = (unsigned char)*p;
+        if ((ch < 0x20 && ch != '\t') || ch == 0x7f)
+            return p;
+        p++;
+    }
+
+    return end;
+}
+
+// line ends at eol, the next line starts at next
+static result_t end_of_line(const char* p, const char* end, const char*& eol, const char*& next)
+{
+    eol = find_ctl(p, end);
+    if (eol == end)
+        return CALL_E_PENDDING;
+
+    if (*eol == '\n') {
+        next = eol + 1;
+        return 0;
+    }
+
+    if (*eol == '\r') {
+        if (eol + 1 == end)
+            return CALL_E_PENDDING;
+
+        if (eol[1] == '\n') {
+            next = eol + 2;
+            return 0;
+        }
+    }
+
+    return CALL_E_INVALID_DATA;
+}
+
+static result_t bad_header(const char* p, const char* end)
+{
+    const char* eol = find_ctl(p, end);
+    return CHECK_ERROR(Runtime::setError("HttpMessage: bad header: " + exlib::string(p, eol - p)));
+}
+
+result_t HttpHead::parse(const char* buf, int32_t len)
+{
+    const char* p = buf;
+    const char* end = buf + len;
+    const char* eol;
+    const char* next;
+    result_t hr;
+
+    m_fields.clear();
+
+    // empty lines before the start line are ignored, RFC 9112 section 2.2
+    while (p < end && (*p == '\r' || *p == '\n'))
+        p++;
+
+    hr = end_of_line(p, end, eol, next);
+    if (hr == CALL_E_PENDDING) {
+        if (m_maxLineSize > 0 && end - buf > m_maxLineSize)
+            return CHECK_ERROR(Runtime::setError("HttpMessage: header is too long."));
+        return hr;
+    }
+
+    if (hr < 0)
+        return CHECK_ERROR(Runtime::setError("HttpMessage: bad start line."));
+
+    if (m_maxLineSize > 0 && eol - p > m_maxLineSize)
+        return CHECK_ERROR(Runtime::setError("HttpMessage: header is too long."));
+
+    m_line = p;
+    m_szLine = (int32_t)(eol - p);
+    p = next;
+
+    while (true) {
+        if (p == end)
+            return CALL_E_PENDDING;
+
+        if (*p == '\n')
+            return (int32_t)(p + 1 - buf);
+
+        if (*p == '\r') {
+            if (p + 1 == end)
+                return CALL_E_PENDDING;
+            if (p[1] == '\n')
+                return (int32_t)(p + 2 - buf);
+            return bad_header(p, end);
+        }
+
+        const char* name = p;
+        while (p < end && s_tchar[*p])
+            p++;
+
+        if (p < end && (p == name || *p != ':'))
+            return bad_header(name, end);
+
+        if (p < end) {
+            const char* name_end = p;
+            const char* value;
+            const char* value_end;
+
+            for (p++; p < end && (*p == ' ' || *p == '\t'); p++)
+                ;
+
+            value = p;
+            hr = end_of_line(value, end, eol, next);
+            if (hr == CALL_E_INVALID_DATA)
+                return bad_header(name, end);
+
+            if (hr == 0) {
+                if (m_maxLineSize > 0 && eol - name > m_maxLineSize)
+                    return CHECK_ERROR(Runtime::setError("HttpMessage: header is too long."));
+
+                value_end = eol;
+                while (value_end > value && (value_end[-1] == ' ' || value_end[-1] == '\t'))
+                    value_end--;
+
+                Field f = { name, (int32_t)(name_end - name), value, (int32_t)(value_end - value) };
+                m_fields.push_back(f);
+
+                if (m_maxFields >= 0 && (int32_t)m_fields.size() > m_maxFields)
+                    return CHECK_ERROR(Runtime::setError("HttpMessage: too many headers."));
+
+                p = next;
+                continue;
+            }
+        }
+
+        if (m_maxLineSize > 0 && end - name > m_maxLineSize)
+            return CHECK_ERROR(Runtime::setError("HttpMessage: header is too long."));
+
+        return CALL_E_PENDDING;
+    }
+}
+
+result_t HttpHead::read(BufferedStream* stm, int32_t maxLineSize, int32_t maxFields, AsyncEvent* ac)
+{
+    class asyncRead : public AsyncState {
+    public:
+        asyncRead(HttpHead* pThis, BufferedStream* stm, AsyncEvent* ac)
+            : AsyncState(ac)
+            , m_pThis(pThis)
+            , m_stm(stm)
+            , m_streamEnd(false)
+        {
+            next(parse);
+        }
+
+        ON_STATE(asyncRead, parse)
+        {
+            exlib::string& data = m_pThis->m_data;
+            const char* buf;
+            int32_t len;
+
+            // parse in place while the head fits in the first buffer the stream holds,
+            // copy it out only when it spans more than one.
+            if (data.empty())
+                buf = m_stm->peek(len);
+            else {
+                buf = data.c_str();
+                len = (int32_t)data.length();
+            }
+
+            if (len > 0) {
+                result_t hr = m_pThis->parse(buf, len);
+                if (hr >= 0) {
+                    if (data.empty()) {
+                        m_pThis->m_store = m_stm->m_bufs.front().m_store;
+                        m_stm->skip(hr);
+                    } else if (hr < len) {
+                        int32_t rest = len - hr;
+                        Buffer* last = Buffer::Cast(m_last);
+
+                        // what follows the head came with the last read, hand it back without copying
+                        if (last && rest <= (int32_t)last->length()) {
+                            const Buffer::store& st = last->get_store();
+                            obj_ptr<Buffer_base> tail = new Buffer(st.m_store,
+                                st.m_offset + st.m_length - rest, rest);
+                            m_stm->push(tail);
+                        } else {
+                            obj_ptr<Buffer_base> tail = new Buffer(buf + hr, rest);
+                            m_stm->push(tail);
+                        }
+                    }
+
+                    return next();
+                }
+
+                if (hr != CALL_E_PENDDING)
+                    return hr;
+            }
+
+            if (m_streamEnd) {
+                if (len == 0)
+                    return next(CALL_RETURN_NULL);
+                return CHECK_ERROR(Runtime::setError("HttpMessage: header is not complete."));
+            }
+
+            if (data.empty() && m_stm->m_size > 0) {
+                int32_t size = m_stm->m_size;
+
+                data.resize(size);
+                m_stm->copy(data.data(), size);
+                m_stm->clear();
+
+                if (size > len)
+                    return next(parse);
+            }
+
+            return m_stm->m_stm->read(-1, m_buf, next(ready));
+        }
+
+        ON_STATE(asyncRead, ready)
+        {
+            if (n == CALL_RETURN_NULL)
+                m_streamEnd = true;
+            else if (m_pThis->m_data.empty())
+                m_stm->push(m_buf);
+            else {
+                Buffer* buf = Buffer::Cast(m_buf);
+
+                m_pThis->m_data.append((const char*)buf->data(), buf->length());
+                m_last = m_buf;
+            }
+
+            m_buf.Release();
+            return next(parse);
+        }
+
+    public:
+        HttpHead* m_pThis;
+        obj_ptr<BufferedStream> m_stm;
+        obj_ptr<Buffer_base> m_buf;
+        obj_ptr<Buffer_base> m_last;
+        bool m_streamEnd;
+    };
+
+    m_maxLineSize = maxLineSize;
+    m_maxFields = maxFields;
+    m_line = NULL;
+    m_szLine = 0;
+    m_fields.clear();
+    m_data.clear();
+    m_store.reset();
+
+    return (new asyncRead(this, stm, ac))->post(0);
+}
+
+} /* namespace fibjs */
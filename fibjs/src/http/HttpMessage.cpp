@@ -185,67 +185,76 @@ result_t HttpMessage::sendHeader(Stream_base* stm, exlib::string& strCommand,
     return (new asyncSendTo(this, stm, strCommand, ac, true))->post(0);
 }
 
-result_t HttpMessage::readFrom(Stream_base* stm, AsyncEvent* ac)
+result_t HttpMessage::readFrom(BufferedStream* stm, HttpHead& head, AsyncEvent* ac)
 {
     class asyncReadFrom : public AsyncState {
     public:
-        asyncReadFrom(HttpMessage* pThis, BufferedStream_base* stm,
+        asyncReadFrom(HttpMessage* pThis, BufferedStream* stm, HttpHead& head,
             AsyncEvent* ac)
             : AsyncState(ac)
             , m_pThis(pThis)
             , m_stm(stm)
+            , m_head(head)
             , m_contentLength(-1)
             , m_bChunked(false)
             , m_headCount(0)
         {
-            next(begin);
+            next(header);
         }
 
-        ON_STATE(asyncReadFrom, begin)
+        result_t addField(HttpHead::Field& f)
         {
-            return m_stm->readLine(m_pThis->m_maxHeaderSize, m_strLine, next(header));
+            if (f.m_szName == 14 && !qstricmp(f.m_name, "content-length", 14)) {
+                const char* p = f.m_value;
+                const char* end = p + f.m_szValue;
+
+                if (p == end)
+                    return CHECK_ERROR(Runtime::setError("HttpMessage: bad content-length."));
+
+                for (m_contentLength = 0; p < end; p++) {
+                    if (!qisdigit(*p) || m_contentLength > (INT64_MAX - 9) / 10)
+                        return CHECK_ERROR(Runtime::setError("HttpMessage: bad content-length."));
+                    m_contentLength = m_contentLength * 10 + (*p - '0');
+                }
+
+                if (m_pThis->m_maxBodySize >= 0
+                    && m_contentLength > (int64_t)m_pThis->m_maxBodySize * 1024 * 1024)
+                    return CHECK_ERROR(Runtime::setError("HttpMessage: body is too huge."));
+
+                if (!m_pThis->m_bNoBody)
+                    return 0;
+            } else if (f.m_szName == 17 && !qstricmp(f.m_name, "transfer-encoding", 17)) {
+                if (f.m_szValue != 7 || qstricmp(f.m_value, "chunked", 7))
+                    return CHECK_ERROR(Runtime::setError("HttpMessage: unknown transfer-encoding."));
+
+                m_bChunked = true;
+                return 0;
+            }
+
+            m_pThis->addHeader(f.m_name, f.m_szName, f.m_value, f.m_szValue);
+            if (++m_headCount > m_pThis->m_maxHeadersCount)
+                return CHECK_ERROR(Runtime::setError("HttpMessage: too many headers."));
+
+            return 0;
         }
 
-        ON_STATE(asyncReadFrom, header)
+        result_t stream(int64_t length)
         {
-            if (m_strLine.length() > 0) {
-                if (!qstricmp(m_strLine.c_str(), "content-length:", 15)) {
-                    m_contentLength = atoi(m_strLine.c_str() + 15);
-
-                    if ((m_contentLength < 0)
-                        || (m_pThis->m_maxBodySize >= 0
-                            && m_contentLength > (int64_t)m_pThis->m_maxBodySize * 1024 * 1024))
-                        return CHECK_ERROR(Runtime::setError("HttpMessage: body is too huge."));
-
-                    if (m_pThis->m_bNoBody) {
-                        result_t hr = m_pThis->addHeader(m_strLine);
-                        if (hr < 0)
-                            return hr;
-
-                        m_headCount++;
-                    }
-                } else if (!qstricmp(m_strLine.c_str(),
-                               "transfer-encoding:", 18)) {
-                    _parser p(m_strLine.c_str() + 18,
-                        (int32_t)m_strLine.length() - 18);
-
-                    p.skipSpace();
-                    if (qstricmp(p.now(), "chunked"))
-                        return CHECK_ERROR(Runtime::setError("HttpMessage: unknown transfer-encoding."));
-
-                    m_bChunked = true;
-                } else {
-                    result_t hr = m_pThis->addHeader(m_strLine);
-                    if (hr < 0)
-                        return hr;
-
-                    m_headCount++;
-                }
+            m_pThis->m_bodyStream = new HttpBodyStream(m_stm, length,
+                m_pThis->m_maxBodySize, m_pThis->m_maxHeaderSize);
+            m_pThis->set_body(m_pThis->m_bodyStream);
+
+            return next();
+        }
 
-                if (m_headCount > m_pThis->m_maxHeadersCount)
-                    return CHECK_ERROR(Runtime::setError("HttpMessage: too many headers."));
+        ON_STATE(asyncReadFrom, header)
+        {
+            std::vector<HttpHead::Field>& fields = m_head.m_fields;
 
-                return m_stm->readLine(m_pThis->m_maxHeaderSize, m_strLine, this);
+            for (size_t i = 0; i < fields.size(); i++) {
+                result_t hr = addField(fields[i]);
+                if (hr < 0)
+                    return hr;
             }
 
             if (m_bChunked) {
@@ -256,11 +265,17 @@ result_t HttpMessage::readFrom(Stream_base* stm, AsyncEvent* ac)
                     return CHECK_ERROR(CALL_E_INVALID_DATA);
                 m_contentLength = 0;
 
+                if (m_pThis->m_streamBody)
+                    return stream(-1);
+
                 m_pThis->get_body(m_body);
                 return next(chunk_head);
             }
 
             if (!m_pThis->m_bNoBody && (m_contentLength > 0 || (m_pThis->m_bResponse && !m_pThis->m_keepAlive && m_contentLength == -1))) {
+                if (m_pThis->m_streamBody && m_contentLength > 0)
+                    return stream(m_contentLength);
+
                 m_pThis->get_body(m_body);
                 return m_stm->copyTo(m_body, m_contentLength, m_copySize, next(body));
             }
@@ -322,7 +337,8 @@ result_t HttpMessage::readFrom(Stream_base* stm, AsyncEvent* ac)
 
     public:
         HttpMessage* m_pThis;
-        obj_ptr<BufferedStream_base> m_stm;
+        obj_ptr<BufferedStream> m_stm;
+        HttpHead& m_head;
         obj_ptr<SeekableStream_base> m_body;
         exlib::string m_strLine;
         int64_t m_contentLength;
@@ -334,45 +350,28 @@ result_t HttpMessage::readFrom(Stream_base* stm, AsyncEvent* ac)
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_NOSYNC);
 
-    obj_ptr<BufferedStream_base> _stm = BufferedStream_base::getInstance(stm);
-    if (!_stm)
-        return CHECK_ERROR(Runtime::setError("HttpMessage: only accept BufferedStream object."));
+    stm->get_stream(m_socket);
+    m_stm = stm;
 
-    _stm->get_stream(m_socket);
-    m_stm = _stm;
-
-    return (new asyncReadFrom(this, _stm, ac))->post(0);
+    return (new asyncReadFrom(this, stm, head, ac))->post(0);
 }
 
 void HttpMessage::addHeader(const char* name, int32_t szName, const char* value,
     int32_t szValue)
 {
     if (szName == 10 && !qstricmp(name, "connection", szName)) {
-        if (qstristr(value, "upgrade")) {
+        // value may point into the receive buffer, it is not terminated
+        exlib::string v(value, szValue);
+
+        if (qstristr(v.c_str(), "upgrade")) {
             m_upgrade = true;
             m_keepAlive = true;
         } else
-            m_keepAlive = !!qstristr(value, "keep-alive");
+            m_keepAlive = !!qstristr(v.c_str(), "keep-alive");
     } else
         m_headers->add(name, szName, value, szValue);
 }
 
-result_t HttpMessage::addHeader(exlib::string& strLine)
-{
-    int32_t p2;
-    _parser p(strLine);
-
-    p.skipWord(':');
-    p2 = p.pos;
-    if (0 == p2 || !p.want(':'))
-        return CHECK_ERROR(Runtime::setError("HttpMessage: bad header: " + strLine));
-
-    p.skipSpace();
-    addHeader(p.string, p2, p.now(), p.left());
-
-    return 0;
-}
-
 size_t HttpMessage::size()
 {
     size_t sz = 2 + m_headers->size();
@@ -626,6 +625,7 @@ result_t HttpMessage::clear()
 
     m_stm.Release();
     m_socket.Release();
+    m_bodyStream.Release();
 
     return 0;
 }
@@ -291,7 +291,7 @@ result_t HttpRequest::readFrom(Stream_base* stm, AsyncEvent* ac)
 {
     class asyncReadFrom : public AsyncState {
     public:
-        asyncReadFrom(HttpRequest* pThis, BufferedStream_base* stm,
+        asyncReadFrom(HttpRequest* pThis, BufferedStream* stm,
             AsyncEvent* ac)
             : AsyncState(ac)
             , m_pThis(pThis)
@@ -302,7 +302,10 @@ result_t HttpRequest::readFrom(Stream_base* stm, AsyncEvent* ac)
 
         ON_STATE(asyncReadFrom, begin)
         {
-            return m_stm->readLine(m_pThis->m_message->m_maxHeaderSize, m_strLine, next(command));
+            HttpMessage* msg = m_pThis->m_message;
+
+            // content-length and transfer-encoding are not counted by HttpMessage
+            return m_head.read(m_stm, msg->m_maxHeaderSize, msg->m_maxHeadersCount + 2, next(command));
         }
 
         ON_STATE(asyncReadFrom, command)
@@ -310,6 +313,8 @@ result_t HttpRequest::readFrom(Stream_base* stm, AsyncEvent* ac)
             if (n == CALL_RETURN_NULL)
                 return CHECK_ERROR(CALL_E_CLOSED);
 
+            m_strLine.assign(m_head.m_line, m_head.m_szLine);
+
             _parser p(m_strLine);
             result_t hr;
 
@@ -342,12 +347,13 @@ result_t HttpRequest::readFrom(Stream_base* stm, AsyncEvent* ac)
             if (hr < 0)
                 return hr;
 
-            return m_pThis->m_message->readFrom(m_stm, next());
+            return m_pThis->m_message->readFrom(m_stm, m_head, next());
         }
 
     public:
         obj_ptr<HttpRequest> m_pThis;
-        obj_ptr<BufferedStream_base> m_stm;
+        obj_ptr<BufferedStream> m_stm;
+        HttpHead m_head;
         exlib::string m_strLine;
     };
 
@@ -358,7 +364,7 @@ result_t HttpRequest::readFrom(Stream_base* stm, AsyncEvent* ac)
     if (!_stm)
         return CHECK_ERROR(Runtime::setError("HttpRequest: only accept BufferedStream object."));
 
-    return (new asyncReadFrom(this, _stm, ac))->post(0);
+    return (new asyncReadFrom(this, BufferedStream::Cast(_stm), ac))->post(0);
 }
 
 result_t HttpRequest::get_method(exlib::string& retVal)
@@ -453,12 +459,15 @@ result_t HttpRequest::get_form(obj_ptr<HttpCollection_base>& retVal)
 
             get_body(_body);
             _body->rewind();
-            result_t hr = _body->cc_read((int32_t)len, buf);
+
+            // a streamed chunked body does not know its length up front
+            result_t hr = _body->cc_readAll(buf);
             if (hr < 0)
                 return hr;
 
             exlib::string strForm;
-            buf->toString(strForm);
+            if (buf)
+                buf->toString(strForm);
 
             if (bUpload) {
                 obj_ptr<HttpUploadCollection> col = new HttpUploadCollection();
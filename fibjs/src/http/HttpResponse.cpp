@@ -315,33 +315,39 @@ result_t http_base::get_STATUS_CODES(v8::Local<v8::Object>& retVal)
     return 0;
 }
 
-result_t HttpResponse::sendTo(Stream_base* stm, AsyncEvent* ac)
+void HttpResponse::flushCookies()
 {
-    if (ac->isSync())
-        return CHECK_ERROR(CALL_E_NOSYNC);
+    if (!m_cookies)
+        return;
 
-    if (m_cookies) {
-        int32_t len, i;
+    int32_t len, i;
 
-        len = m_cookies->length();
+    len = m_cookies->length();
 
-        for (i = 0; i < len; i++) {
-            Variant v;
-            obj_ptr<object_base> cookie;
-            exlib::string str;
+    for (i = 0; i < len; i++) {
+        Variant v;
+        obj_ptr<object_base> cookie;
+        exlib::string str;
 
-            m_cookies->_indexed_getter(i, v);
-            cookie = v.object();
+        m_cookies->_indexed_getter(i, v);
+        cookie = v.object();
 
-            if (cookie) {
-                cookie->toString(str);
-                addHeader("Set-Cookie", str);
-            }
+        if (cookie) {
+            cookie->toString(str);
+            addHeader("Set-Cookie", str);
         }
-
-        m_cookies.Release();
     }
 
+    m_cookies.Release();
+}
+
+result_t HttpResponse::sendTo(Stream_base* stm, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    flushCookies();
+
     exlib::string strCommand;
     exlib::string statusMessage;
 
@@ -379,7 +385,7 @@ result_t HttpResponse::readFrom(Stream_base* stm, AsyncEvent* ac)
 {
     class asyncReadFrom : public AsyncState {
     public:
-        asyncReadFrom(HttpResponse* pThis, BufferedStream_base* stm,
+        asyncReadFrom(HttpResponse* pThis, BufferedStream* stm,
             AsyncEvent* ac)
             : AsyncState(ac)
             , m_pThis(pThis)
@@ -390,7 +396,10 @@ result_t HttpResponse::readFrom(Stream_base* stm, AsyncEvent* ac)
 
         ON_STATE(asyncReadFrom, begin)
         {
-            return m_stm->readLine(m_pThis->m_message->m_maxHeaderSize, m_strLine, next(command));
+            HttpMessage* msg = m_pThis->m_message;
+
+            // content-length and transfer-encoding are not counted by HttpMessage
+            return m_head.read(m_stm, msg->m_maxHeaderSize, msg->m_maxHeadersCount + 2, next(command));
         }
 
         ON_STATE(asyncReadFrom, command)
@@ -398,6 +407,8 @@ result_t HttpResponse::readFrom(Stream_base* stm, AsyncEvent* ac)
             if (n == CALL_RETURN_NULL)
                 return CHECK_ERROR(CALL_E_CLOSED);
 
+            m_strLine.assign(m_head.m_line, m_head.m_szLine);
+
             result_t hr;
             const char* c_str = m_strLine.c_str();
             int32_t len = (int32_t)m_strLine.length();
@@ -415,12 +426,13 @@ result_t HttpResponse::readFrom(Stream_base* stm, AsyncEvent* ac)
             if (hr < 0)
                 return hr;
 
-            return m_pThis->m_message->readFrom(m_stm, next());
+            return m_pThis->m_message->readFrom(m_stm, m_head, next());
         }
 
     public:
         obj_ptr<HttpResponse> m_pThis;
-        obj_ptr<BufferedStream_base> m_stm;
+        obj_ptr<BufferedStream> m_stm;
+        HttpHead m_head;
         exlib::string m_strLine;
     };
 
@@ -431,7 +443,7 @@ result_t HttpResponse::readFrom(Stream_base* stm, AsyncEvent* ac)
     if (!_stm)
         return CHECK_ERROR(Runtime::setError("HttpResponse: only accept BufferedStream object."));
 
-    return (new asyncReadFrom(this, _stm, ac))->post(0);
+    return (new asyncReadFrom(this, BufferedStream::Cast(_stm), ac))->post(0);
 }
 
 result_t HttpResponse::get_stream(obj_ptr<Stream_base>& retVal)
@@ -559,27 +571,7 @@ result_t HttpResponse::sendHeader(Stream_base* stm, AsyncEvent* ac)
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_NOSYNC);
 
-    if (m_cookies) {
-        int32_t len, i;
-
-        len = m_cookies->length();
-
-        for (i = 0; i < len; i++) {
-            Variant v;
-            obj_ptr<object_base> cookie;
-            exlib::string str;
-
-            m_cookies->_indexed_getter(i, v);
-            cookie = v.object();
-
-            if (cookie) {
-                cookie->toString(str);
-                addHeader("Set-Cookie", str);
-            }
-        }
-
-        m_cookies.Release();
-    }
+    flushCookies();
 
     int32_t pos = shortcut[m_statusCode / 100 - 1] + m_statusCode % 100;
     exlib::string strCommand;
@@ -33,6 +33,31 @@ result_t HttpServer_base::_new(exlib::string addr, int32_t port, Handler_base* h
     return 0;
 }
 
+result_t HttpServer_base::_new(v8::Local<v8::Object> options, Handler_base* hdlr,
+    obj_ptr<HttpServer_base>& retVal, v8::Local<v8::Object> This)
+{
+    Isolate* isolate = Isolate::current(This);
+    exlib::string addr;
+    int32_t port = 0;
+    int32_t backlog = 1024;
+    bool reusePort = false;
+    result_t hr;
+
+    hr = TcpServer::load_options(isolate, options, addr, port, backlog, reusePort);
+    if (hr < 0)
+        return hr;
+
+    obj_ptr<HttpServer> svr = new HttpServer();
+    svr->wrap(This);
+
+    hr = svr->create(addr, port, hdlr, backlog, reusePort);
+    if (hr < 0)
+        return hr;
+
+    retVal = svr;
+    return 0;
+}
+
 result_t HttpServer_base::_new(exlib::string addr, Handler_base* hdlr,
     obj_ptr<HttpServer_base>& retVal, v8::Local<v8::Object> This)
 {
@@ -43,7 +68,8 @@ result_t HttpServer_base::_new(exlib::string addr, Handler_base* hdlr,
     return _new(addr, 0, hdlr, retVal, This);
 }
 
-result_t HttpServer::create(exlib::string addr, int32_t port, Handler_base* hdlr)
+result_t HttpServer::create(exlib::string addr, int32_t port, Handler_base* hdlr,
+    int32_t backlog, bool reusePort)
 {
     result_t hr;
     obj_ptr<TcpServer> _server;
@@ -61,7 +87,7 @@ result_t HttpServer::create(exlib::string addr, int32_t port, Handler_base* hdlr
     SetPrivate("server", _server->wrap());
     m_server = _server;
 
-    return _server->create(addr, port, _handler);
+    return _server->create(addr, port, _handler, backlog, reusePort);
 }
 
 result_t HttpServer::start()
@@ -134,6 +160,46 @@ result_t HttpServer::set_enableEncoding(bool newVal)
     return m_hdlr->set_enableEncoding(newVal);
 }
 
+result_t HttpServer::get_enableHttp2(bool& retVal)
+{
+    return m_hdlr->get_enableHttp2(retVal);
+}
+
+result_t HttpServer::set_enableHttp2(bool newVal)
+{
+    return m_hdlr->set_enableHttp2(newVal);
+}
+
+result_t HttpServer::get_maxConcurrentStreams(int32_t& retVal)
+{
+    return m_hdlr->get_maxConcurrentStreams(retVal);
+}
+
+result_t HttpServer::set_maxConcurrentStreams(int32_t newVal)
+{
+    return m_hdlr->set_maxConcurrentStreams(newVal);
+}
+
+result_t HttpServer::get_headerTableSize(int32_t& retVal)
+{
+    return m_hdlr->get_headerTableSize(retVal);
+}
+
+result_t HttpServer::set_headerTableSize(int32_t newVal)
+{
+    return m_hdlr->set_headerTableSize(newVal);
+}
+
+result_t HttpServer::get_streamBody(bool& retVal)
+{
+    return m_hdlr->get_streamBody(retVal);
+}
+
+result_t HttpServer::set_streamBody(bool newVal)
+{
+    return m_hdlr->set_streamBody(newVal);
+}
+
 result_t HttpServer::get_serverName(exlib::string& retVal)
 {
     return m_hdlr->get_serverName(retVal);
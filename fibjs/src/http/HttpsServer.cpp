@@ -9,7 +9,7 @@
 #include "HttpsServer.h"
 #include "ifs/http.h"
 #include "ifs/tls.h"
-#include "ifs/TLSServer.h"
+#include "TLSServer.h"
 
 namespace fibjs {
 
@@ -44,29 +44,39 @@ result_t HttpsServer_base::_new(v8::Local<v8::Object> options, Handler_base* hdl
 
     Isolate* isolate = Isolate::current(This);
     exlib::string address;
-    hr = GetConfigValue(isolate, options, "address", address, true);
-    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+    int32_t port = 0;
+    int32_t backlog = 1024;
+    bool reusePort = false;
+
+    hr = TcpServer::load_options(isolate, options, address, port, backlog, reusePort);
+    if (hr < 0)
         return hr;
 
-    int32_t port;
-    hr = GetConfigValue(isolate, options, "port", port, true);
+    obj_ptr<HttpsServer> svr = new HttpsServer();
+    svr->wrap(This);
+
+    hr = svr->create(ctx, address, port, hdlr, backlog, reusePort);
     if (hr < 0)
         return hr;
 
-    return _new(ctx, address, port, hdlr, retVal, This);
+    retVal = svr;
+
+    return 0;
 }
 
-result_t HttpsServer::create(SecureContext_base* context, exlib::string addr, int32_t port, Handler_base* hdlr)
+result_t HttpsServer::create(SecureContext_base* context, exlib::string addr, int32_t port, Handler_base* hdlr,
+    int32_t backlog, bool reusePort)
 {
     result_t hr;
-    obj_ptr<TLSServer_base> _server;
+    obj_ptr<TLSServer> _server;
     obj_ptr<HttpHandler_base> _handler;
 
     hr = HttpHandler_base::_new(hdlr, _handler);
     if (hr < 0)
         return hr;
 
-    hr = TLSServer_base::_new(context, addr, port, _handler, _server);
+    _server = new TLSServer();
+    hr = _server->create(context, addr, port, _handler, backlog, reusePort);
     if (hr < 0)
         return hr;
 
@@ -149,6 +159,58 @@ result_t HttpsServer::set_enableEncoding(bool newVal)
     return m_handler->set_enableEncoding(newVal);
 }
 
+result_t HttpsServer::get_enableHttp2(bool& retVal)
+{
+    return m_handler->get_enableHttp2(retVal);
+}
+
+result_t HttpsServer::set_enableHttp2(bool newVal)
+{
+    result_t hr = m_handler->set_enableHttp2(newVal);
+    if (hr < 0)
+        return hr;
+
+    // h2 is only spoken when the client picks it in the TLS handshake
+    std::vector<exlib::string> alpn;
+    if (newVal) {
+        alpn.push_back("h2");
+        alpn.push_back("http/1.1");
+    }
+    m_server->set_alpn(alpn);
+
+    return 0;
+}
+
+result_t HttpsServer::get_maxConcurrentStreams(int32_t& retVal)
+{
+    return m_handler->get_maxConcurrentStreams(retVal);
+}
+
+result_t HttpsServer::set_maxConcurrentStreams(int32_t newVal)
+{
+    return m_handler->set_maxConcurrentStreams(newVal);
+}
+
+result_t HttpsServer::get_headerTableSize(int32_t& retVal)
+{
+    return m_handler->get_headerTableSize(retVal);
+}
+
+result_t HttpsServer::set_headerTableSize(int32_t newVal)
+{
+    return m_handler->set_headerTableSize(newVal);
+}
+
+result_t HttpsServer::get_streamBody(bool& retVal)
+{
+    return m_handler->get_streamBody(retVal);
+}
+
+result_t HttpsServer::set_streamBody(bool newVal)
+{
+    return m_handler->set_streamBody(newVal);
+}
+
 result_t HttpsServer::get_serverName(exlib::string& retVal)
 {
     return m_handler->get_serverName(retVal);
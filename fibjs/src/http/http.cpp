@@ -13,6 +13,8 @@
 #include "HttpRequest.h"
 #include "HttpClient.h"
 #include "BufferedStream.h"
+#include "HttpFileHandler.h"
+#include "HttpHandler.h"
 #include <unordered_map>
 #include "Isolate.h"
 #include "ifs/zlib.h"
@@ -151,6 +153,36 @@ result_t http_base::set_poolTimeout(int32_t newVal)
     return get_httpClient()->set_poolTimeout(newVal);
 }
 
+result_t http_base::get_maxConnsPerHost(int32_t& retVal)
+{
+    return get_httpClient()->get_maxConnsPerHost(retVal);
+}
+
+result_t http_base::set_maxConnsPerHost(int32_t newVal)
+{
+    return get_httpClient()->set_maxConnsPerHost(newVal);
+}
+
+result_t http_base::get_pipelining(int32_t& retVal)
+{
+    return get_httpClient()->get_pipelining(retVal);
+}
+
+result_t http_base::set_pipelining(int32_t newVal)
+{
+    return get_httpClient()->set_pipelining(newVal);
+}
+
+result_t http_base::get_enableHttp2(bool& retVal)
+{
+    return get_httpClient()->get_enableHttp2(retVal);
+}
+
+result_t http_base::set_enableHttp2(bool newVal)
+{
+    return get_httpClient()->set_enableHttp2(newVal);
+}
+
 result_t http_base::get_http_proxy(exlib::string& retVal)
 {
     return get_httpClient()->get_http_proxy(retVal);
@@ -171,6 +203,53 @@ result_t http_base::set_https_proxy(exlib::string newVal)
     return get_httpClient()->set_https_proxy(newVal);
 }
 
+result_t http_base::stats(v8::Local<v8::Object>& retVal)
+{
+    Isolate* isolate = Isolate::current();
+    v8::Local<v8::Context> context = isolate->context();
+    v8::Local<v8::Object> info = v8::Object::New(isolate->m_isolate);
+    v8::Local<v8::Object> fileCache = v8::Object::New(isolate->m_isolate);
+    v8::Local<v8::Object> zipCache = v8::Object::New(isolate->m_isolate);
+    int64_t entries, size;
+
+    fileCache->Set(context, isolate->NewString("hits"),
+                 v8::Number::New(isolate->m_isolate, (double)HttpFileHandler::s_cache_hits.value()))
+        .IsJust();
+    fileCache->Set(context, isolate->NewString("misses"),
+                 v8::Number::New(isolate->m_isolate, (double)HttpFileHandler::s_cache_misses.value()))
+        .IsJust();
+    fileCache->Set(context, isolate->NewString("entries"),
+                 v8::Number::New(isolate->m_isolate, (double)HttpFileHandler::s_cache_entries.value()))
+        .IsJust();
+
+    info->Set(context, isolate->NewString("fileCache"), fileCache).IsJust();
+
+    HttpHandler::zip_info(entries, size);
+
+    zipCache->Set(context, isolate->NewString("hits"),
+                v8::Number::New(isolate->m_isolate, (double)HttpHandler::s_zip_hits.value()))
+        .IsJust();
+    zipCache->Set(context, isolate->NewString("misses"),
+                v8::Number::New(isolate->m_isolate, (double)HttpHandler::s_zip_misses.value()))
+        .IsJust();
+    zipCache->Set(context, isolate->NewString("entries"),
+                v8::Number::New(isolate->m_isolate, (double)entries))
+        .IsJust();
+    zipCache->Set(context, isolate->NewString("size"),
+                v8::Number::New(isolate->m_isolate, (double)size))
+        .IsJust();
+
+    info->Set(context, isolate->NewString("zipCache"), zipCache).IsJust();
+
+    v8::Local<v8::Object> client;
+    get_httpClient(isolate)->stats(client);
+    info->Set(context, isolate->NewString("client"), client).IsJust();
+
+    retVal = info;
+
+    return 0;
+}
+
 result_t http_base::request(Stream_base* conn, HttpRequest_base* req,
     obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac)
 {
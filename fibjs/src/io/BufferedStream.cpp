@@ -30,11 +30,6 @@ public:
     ON_STATE(asyncBuffer, read)
     {
         result_t hr = process(m_streamEnd);
-        if (m_pThis->m_pos == (int32_t)m_pThis->m_buf.length()) {
-            m_pThis->m_buf.clear();
-            m_pThis->m_pos = 0;
-        }
-
         if (hr != CALL_E_PENDDING)
             return next(hr);
 
@@ -43,11 +38,8 @@ public:
 
     ON_STATE(asyncBuffer, ready)
     {
-        m_pThis->m_buf.clear();
-        m_pThis->m_pos = 0;
-
         if (n != CALL_RETURN_NULL) {
-            m_buf->toString(m_pThis->m_buf);
+            m_pThis->push(m_buf);
             m_buf.Release();
         } else
             m_streamEnd = true;
@@ -69,6 +61,61 @@ result_t BufferedStream_base::_new(Stream_base* stm,
     return 0;
 }
 
+void BufferedStream::copy(char* p, int32_t n)
+{
+    int32_t pos = m_pos;
+
+    for (size_t i = 0; n > 0; i++) {
+        Buffer::store& data = m_bufs[i];
+        int32_t sz = (int32_t)data.length() - pos;
+
+        if (sz > n)
+            sz = n;
+
+        memcpy(p, data.data() + pos, sz);
+        p += sz;
+        n -= sz;
+        pos = 0;
+    }
+}
+
+void BufferedStream::skip(int32_t n)
+{
+    m_size -= n;
+    n += m_pos;
+
+    while (!m_bufs.empty() && n >= (int32_t)m_bufs.front().length()) {
+        n -= (int32_t)m_bufs.front().length();
+        m_bufs.pop_front();
+    }
+
+    m_pos = n;
+}
+
+void BufferedStream::take(int32_t n, obj_ptr<Buffer_base>& retVal)
+{
+    int32_t len;
+
+    peek(len);
+    if (len >= n) {
+        Buffer::store& data = m_bufs.front();
+        retVal = new Buffer(data.m_store, data.m_offset + m_pos, n);
+    } else {
+        obj_ptr<Buffer> buf = new Buffer(NULL, n);
+        copy((char*)buf->data(), n);
+        retVal = buf;
+    }
+
+    skip(n);
+}
+
+void BufferedStream::take(int32_t n, exlib::string& retVal)
+{
+    retVal.resize(n);
+    copy(retVal.data(), n);
+    skip(n);
+}
+
 result_t BufferedStream::get_fd(int32_t& retVal)
 {
     return m_stm->get_fd(retVal);
@@ -90,26 +137,19 @@ result_t BufferedStream::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
         static result_t process(BufferedStream* pThis, int32_t bytes,
             obj_ptr<Buffer_base>& retVal, bool streamEnd)
         {
-            int32_t n = bytes - (int32_t)pThis->m_strbuf.size();
-            int32_t n1 = (int32_t)pThis->m_buf.length() - pThis->m_pos;
-
-            if (n > n1)
-                n = n1;
-
-            pThis->append(n);
-
-            if (streamEnd || bytes == (int32_t)pThis->m_strbuf.size()) {
-                exlib::string s = pThis->m_strbuf.str();
-
-                if (s.length() == 0)
-                    return CALL_RETURN_NULL;
+            int32_t n = bytes;
 
-                retVal = new Buffer(s.c_str(), s.length());
-
-                return 0;
+            if (pThis->m_size < n) {
+                if (!streamEnd)
+                    return CHECK_ERROR(CALL_E_PENDDING);
+                n = pThis->m_size;
             }
 
-            return CHECK_ERROR(CALL_E_PENDDING);
+            if (n == 0)
+                return CALL_RETURN_NULL;
+
+            pThis->take(n, retVal);
+            return 0;
         }
 
         virtual result_t process(bool streamEnd)
@@ -123,11 +163,10 @@ result_t BufferedStream::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
     };
 
     if (bytes < 0) {
-        int32_t n = (int32_t)m_buf.length() - m_pos;
-        if (n > 0) {
-            retVal = new Buffer(m_buf.c_str() + m_pos, n);
-            m_pos += n;
+        int32_t n;
 
+        if (peek(n)) {
+            take(n, retVal);
             return 0;
         } else
             return m_stm->read(bytes, retVal, ac);
@@ -180,26 +219,25 @@ result_t BufferedStream::readText(int32_t size, exlib::string& retVal,
         static result_t process(BufferedStream* pThis, int32_t size,
             exlib::string& retVal, bool streamEnd)
         {
-            int32_t n = size - (int32_t)pThis->m_strbuf.size();
-            int32_t n1 = (int32_t)pThis->m_buf.length() - pThis->m_pos;
-
-            if (n > n1)
-                n = n1;
+            int32_t n = size;
 
-            pThis->append(n);
+            if (pThis->m_size < n) {
+                if (!streamEnd)
+                    return CHECK_ERROR(CALL_E_PENDDING);
+                n = pThis->m_size;
+            }
 
-            if (streamEnd || size == (int32_t)pThis->m_strbuf.size()) {
-                result_t hr = pThis->m_iconv.decode(pThis->m_strbuf.str(), retVal);
-                if (hr < 0)
-                    return hr;
+            exlib::string s;
+            pThis->take(n, s);
 
-                if (retVal.length() == 0)
-                    return CALL_RETURN_NULL;
+            result_t hr = pThis->m_iconv.decode(s, retVal);
+            if (hr < 0)
+                return hr;
 
-                return 0;
-            }
+            if (retVal.length() == 0)
+                return CALL_RETURN_NULL;
 
-            return CHECK_ERROR(CALL_E_PENDDING);
+            return 0;
         }
 
         virtual result_t process(bool streamEnd)
@@ -259,6 +297,71 @@ result_t BufferedStream::readLines(int32_t maxlines, v8::Local<v8::Array>& retVa
     return 0;
 }
 
+// 1 when mk starts at off in m_bufs[i], 0 when it does not, -1 when more data is needed to tell
+static int32_t match_at(std::deque<Buffer::store>& bufs, size_t i, size_t off,
+    const char* mk, int32_t mklen)
+{
+    while (mklen > 0) {
+        if (i == bufs.size())
+            return -1;
+
+        Buffer::store& data = bufs[i];
+        size_t n = data.length() - off;
+
+        if (n > (size_t)mklen)
+            n = mklen;
+
+        if (memcmp(data.data() + off, mk, n))
+            return 0;
+
+        mk += n;
+        mklen -= (int32_t)n;
+        i++;
+        off = 0;
+    }
+
+    return 1;
+}
+
+// offset of mk from the read position, or -1. the search goes on from m_temp,
+// nothing before it can start a match, and m_temp is left where the next search should start.
+static int32_t find_mark(BufferedStream* pThis, const char* mk, int32_t mklen)
+{
+    std::deque<Buffer::store>& bufs = pThis->m_bufs;
+    int32_t base = 0;
+
+    for (size_t i = 0; i < bufs.size(); i++) {
+        Buffer::store& data = bufs[i];
+        const char* p = (const char*)data.data();
+        const char* s = p + (i == 0 ? pThis->m_pos : 0);
+        const char* end = p + data.length();
+        int32_t len = (int32_t)(end - s);
+
+        if (pThis->m_temp < base + len) {
+            if (pThis->m_temp > base)
+                s += pThis->m_temp - base;
+
+            // memchr is the vectorized search of the C library
+            while ((s = (const char*)memchr(s, mk[0], end - s)) != NULL) {
+                int32_t r = match_at(bufs, i, s - p, mk, mklen);
+                int32_t at = base + len - (int32_t)(end - s);
+
+                if (r != 0) {
+                    pThis->m_temp = at;
+                    return r > 0 ? at : -1;
+                }
+
+                s++;
+            }
+        }
+
+        base += len;
+    }
+
+    pThis->m_temp = base;
+    return -1;
+}
+
 result_t BufferedStream::readUntil(exlib::string mk, int32_t maxlen,
     exlib::string& retVal, AsyncEvent* ac)
 {
@@ -274,64 +377,36 @@ result_t BufferedStream::readUntil(exlib::string mk, int32_t maxlen,
         {
         }
 
-        static result_t process(BufferedStream* pThis, exlib::string mk,
+        static result_t process(BufferedStream* pThis, exlib::string& mk,
             int32_t maxlen, exlib::string& retVal, bool streamEnd)
         {
-            int32_t pos = pThis->m_pos;
             int32_t mklen = (int32_t)mk.length();
+            int32_t pos = find_mark(pThis, mk.c_str(), mklen);
+            int32_t n = pos >= 0 ? pos : pThis->m_size;
 
-            if (mklen == 0)
-                mklen = 1;
-
-            while ((pos < (int32_t)pThis->m_buf.length())
-                && (pThis->m_temp < mklen)) {
-                if (pThis->m_temp == 0) {
-                    char ch = mk.c_str()[0];
-
-                    while (pos < (int32_t)pThis->m_buf.length())
-                        if (pThis->m_buf.c_str()[pos++] == ch) {
-                            pThis->m_temp++;
-                            break;
-                        }
-                }
-
-                if (pThis->m_temp > 0) {
-                    while ((pos < (int32_t)pThis->m_buf.length())
-                        && (pThis->m_temp < mklen)) {
-                        if (pThis->m_buf.c_str()[pos] != mk.c_str()[pThis->m_temp]) {
-                            pThis->m_temp = 0;
-                            break;
-                        }
-
-                        pos++;
-                        pThis->m_temp++;
-                    }
-                }
+            if (maxlen > 0 && n > maxlen + (pos >= 0 ? 0 : mklen)) {
+                pThis->m_temp = 0;
+                return CHECK_ERROR(Runtime::setError("readUntil: input data too long"));
             }
 
-            if (maxlen > 0
-                && ((int32_t)pThis->m_strbuf.size() + (pos - pThis->m_pos)
-                    > maxlen + mklen))
-                return CHECK_ERROR(Runtime::setError("readUntil: input data too long"));
+            if (pos < 0 && !streamEnd)
+                return CHECK_ERROR(CALL_E_PENDDING);
 
-            pThis->append(pos - pThis->m_pos);
+            exlib::string s;
 
-            if (streamEnd || (pThis->m_temp == mklen)) {
-                result_t hr = pThis->m_iconv.decode(pThis->m_strbuf.str(), retVal);
-                if (hr < 0)
-                    return hr;
+            pThis->take(n, s);
+            if (pos >= 0)
+                pThis->skip(mklen);
+            pThis->m_temp = 0;
 
-                if (pThis->m_temp == mklen) {
-                    retVal.resize(retVal.length() - pThis->m_temp);
-                    pThis->m_temp = 0;
-                    return 0;
-                }
+            result_t hr = pThis->m_iconv.decode(s, retVal);
+            if (hr < 0)
+                return hr;
 
-                pThis->m_temp = 0;
-                return streamEnd && (retVal.length() == 0) ? CALL_RETURN_NULL : 0;
-            }
+            if (pos >= 0)
+                return 0;
 
-            return CHECK_ERROR(CALL_E_PENDDING);
+            return retVal.length() == 0 ? CALL_RETURN_NULL : 0;
         }
 
         virtual result_t process(bool streamEnd)
@@ -339,12 +414,22 @@ result_t BufferedStream::readUntil(exlib::string mk, int32_t maxlen,
             return process(m_pThis, m_mk, m_maxlen, m_retVal, streamEnd);
         }
 
+        virtual int32_t error(int32_t v)
+        {
+            m_pThis->m_temp = 0;
+            return v;
+        }
+
     public:
         exlib::string m_mk;
         int32_t m_maxlen;
         exlib::string& m_retVal;
     };
 
+    // an empty mark stands for the terminating zero, as it always has
+    if (mk.empty())
+        mk.assign("", 1);
+
     result_t hr = asyncRead::process(this, mk, maxlen, retVal, false);
     if (hr != CALL_E_PENDDING)
         return hr;
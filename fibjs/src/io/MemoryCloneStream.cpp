@@ -21,30 +21,7 @@ result_t MemoryStream::CloneStream::get_fd(int32_t& retVal)
 result_t MemoryStream::CloneStream::read(int32_t bytes,
     obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
 {
-    exlib::string strBuf;
-
-    int32_t sz;
-    sz = (int32_t)m_buffer.length() - m_pos;
-
-    if (bytes < 0 || bytes > sz)
-        bytes = sz;
-
-    if (bytes > 0) {
-        if (m_pos == 0 && bytes == sz) {
-            strBuf = m_buffer;
-            m_pos = (int32_t)m_buffer.length();
-        } else {
-            strBuf = m_buffer.substr(m_pos, bytes);
-            m_pos += bytes;
-        }
-    }
-
-    if (strBuf.length() == 0)
-        return CALL_RETURN_NULL;
-
-    retVal = new Buffer(strBuf.c_str(), strBuf.length());
-
-    return 0;
+    return m_buffer.read(m_pos, bytes, retVal);
 }
 
 result_t MemoryStream::CloneStream::readAll(obj_ptr<Buffer_base>& retVal,
@@ -60,7 +37,7 @@ result_t MemoryStream::CloneStream::truncate(int64_t bytes, AsyncEvent* ac)
 
 result_t MemoryStream::CloneStream::eof(bool& retVal)
 {
-    retVal = m_pos == (int32_t)m_buffer.length();
+    retVal = m_pos >= m_buffer.size();
     return 0;
 }
 
@@ -83,7 +60,7 @@ result_t MemoryStream::CloneStream::close(AsyncEvent* ac)
 result_t MemoryStream::CloneStream::copyTo(Stream_base* stm, int64_t bytes,
     int64_t& retVal, AsyncEvent* ac)
 {
-    return io_base::copyStream(this, stm, bytes, retVal, ac);
+    return m_buffer.copyTo(m_pos, stm, bytes, retVal, ac);
 }
 
 result_t MemoryStream::CloneStream::stat(obj_ptr<Stat_base>& retVal,
@@ -104,18 +81,18 @@ result_t MemoryStream::CloneStream::stat(obj_ptr<Stat_base>& retVal,
 result_t MemoryStream::CloneStream::seek(int64_t offset, int32_t whence)
 {
     if (whence == fs_base::C_SEEK_SET)
-        m_pos = (int32_t)offset;
+        m_pos = offset;
     else if (whence == fs_base::C_SEEK_CUR)
-        m_pos += (int32_t)offset;
+        m_pos += offset;
     else if (whence == fs_base::C_SEEK_END)
-        m_pos = (int32_t)offset + (int32_t)m_buffer.length();
+        m_pos = offset + m_buffer.size();
     else
         return CHECK_ERROR(CALL_E_INVALIDARG);
 
     if (m_pos < 0)
         m_pos = 0;
-    else if (m_pos > (int32_t)m_buffer.length())
-        m_pos = (int32_t)m_buffer.length();
+    else if (m_pos > m_buffer.size())
+        m_pos = m_buffer.size();
 
     return 0;
 }
@@ -134,7 +111,7 @@ result_t MemoryStream::CloneStream::rewind()
 
 result_t MemoryStream::CloneStream::size(int64_t& retVal)
 {
-    retVal = m_buffer.length();
+    retVal = m_buffer.size();
     return 0;
 }
 
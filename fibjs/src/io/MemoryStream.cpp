@@ -13,53 +13,258 @@
 
 namespace fibjs {
 
-result_t MemoryStream_base::_new(obj_ptr<MemoryStream_base>& retVal, v8::Local<v8::Object> This)
+// writes shorter than this are packed into a block, longer ones get a slice of their own
+#define ROPE_PACK_SIZE 4096
+#define ROPE_BLOCK_SIZE 65536
+
+size_t MemoryStream::Rope::find(int64_t pos)
 {
-    retVal = new MemoryStream();
-    return 0;
+    size_t lo = 0;
+    size_t hi = m_segs.size();
+
+    while (hi - lo > 1) {
+        size_t mid = (lo + hi) / 2;
+
+        if (m_segs[mid].m_start <= pos)
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    return lo;
 }
 
-result_t MemoryStream::get_fd(int32_t& retVal)
+void MemoryStream::Rope::append(Buffer::store& data)
 {
-    return CALL_E_INVALID_CALL;
+    Segment seg = { data, m_size };
+
+    m_segs.push_back(seg);
+    m_size += data.length();
+    m_tail = 0;
 }
 
-result_t MemoryStream::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
-    AsyncEvent* ac)
+void MemoryStream::Rope::write(int64_t pos, Buffer* buf)
 {
-    exlib::string strBuf;
+    Buffer::store data(buf->get_store());
+    size_t len = data.length();
+
+    if (len == 0)
+        return;
+
+    if (len < ROPE_PACK_SIZE) {
+        if (pos == m_size) {
+            if (m_tail < len) {
+                size_t sz = (size_t)m_size;
+
+                if (sz < 256)
+                    sz = 256;
+                else if (sz > ROPE_BLOCK_SIZE)
+                    sz = ROPE_BLOCK_SIZE;
+                if (sz < len)
+                    sz = len;
+
+                Buffer::store blk(NULL, sz);
+                blk.m_length = 0;
+                append(blk);
+                m_tail = sz;
+            }
+
+            Buffer::store& last = m_segs.back().m_data;
+
+            memcpy(last.data() + last.m_length, data.data(), len);
+            last.m_length += len;
+            m_size += len;
+            m_tail -= len;
+            return;
+        }
+    }
+
+    // the caller keeps its buffer, so the slice gets a copy
+    data = Buffer::store(data.data(), len);
 
-    int64_t sz;
-    int64_t p = m_buffer.tellg();
+    if (pos == m_size) {
+        append(data);
+        return;
+    }
+
+    int64_t end = pos + len;
+    size_t i = find(pos);
+    std::vector<Segment> segs(m_segs.begin(), m_segs.begin() + i);
 
-    m_buffer.seekg(0, std::ios::end);
-    int64_t p1 = m_buffer.tellg();
-    sz = p1 - p;
-    m_buffer.seekg(p, std::ios::beg);
+    if (m_segs[i].m_start < pos) {
+        Segment head = m_segs[i];
+
+        head.m_data.m_length = (size_t)(pos - head.m_start);
+        segs.push_back(head);
+    }
+
+    Segment seg = { data, pos };
+    segs.push_back(seg);
+
+    if (end < m_size) {
+        size_t j = find(end);
+        Segment rest = m_segs[j];
+        size_t cut = (size_t)(end - rest.m_start);
+
+        rest.m_data.m_offset += cut;
+        rest.m_data.m_length -= cut;
+        rest.m_start = end;
+        segs.push_back(rest);
+        segs.insert(segs.end(), m_segs.begin() + j + 1, m_segs.end());
+    } else {
+        m_size = end;
+        m_tail = 0;
+    }
+
+    m_segs.swap(segs);
+}
+
+void MemoryStream::Rope::truncate(int64_t bytes)
+{
+    if (bytes <= 0) {
+        clear();
+        return;
+    }
+
+    if (bytes < m_size) {
+        size_t i = find(bytes - 1);
+
+        m_segs.erase(m_segs.begin() + i + 1, m_segs.end());
+        m_segs.back().m_data.m_length = (size_t)(bytes - m_segs.back().m_start);
+        m_size = bytes;
+        m_tail = 0;
+    } else if (bytes > m_size) {
+        Buffer::store blk(NULL, (size_t)(bytes - m_size));
+
+        memset(blk.data(), 0, blk.length());
+        append(blk);
+    }
+}
+
+void MemoryStream::Rope::clear()
+{
+    m_segs.clear();
+    m_size = 0;
+    m_tail = 0;
+}
+
+result_t MemoryStream::Rope::read(int64_t& pos, int32_t bytes, obj_ptr<Buffer_base>& retVal)
+{
+    int64_t sz = m_size - pos;
 
     if (bytes < 0 || bytes > sz)
         bytes = (int32_t)sz;
 
-    if (bytes > 0) {
-        if (p == 0 && bytes == (int32_t)sz) {
-            strBuf = m_buffer.str();
-            m_buffer.seekg(sz, std::ios::beg);
-        } else {
-            strBuf.resize(bytes);
-            m_buffer.read(strBuf.data(), bytes);
-        }
+    if (bytes <= 0)
+        return CALL_RETURN_NULL;
+
+    // the caller may modify what it reads, so it gets a copy
+    size_t i = find(pos);
+    size_t off = (size_t)(pos - m_segs[i].m_start);
+    obj_ptr<Buffer> buf = new Buffer(NULL, bytes);
+    uint8_t* p = buf->data();
+    size_t left = bytes;
 
-        m_buffer.seekp(m_buffer.tellg(), std::ios::beg);
+    while (left > 0) {
+        Buffer::store& seg = m_segs[i++].m_data;
+        size_t n = seg.length() - off;
+
+        if (n > left)
+            n = left;
+
+        memcpy(p, seg.data() + off, n);
+        p += n;
+        left -= n;
+        off = 0;
     }
 
-    if (strBuf.length() == 0)
-        return CALL_RETURN_NULL;
+    retVal = buf;
+
+    pos += bytes;
+    return 0;
+}
+
+result_t MemoryStream::Rope::copyTo(int64_t& pos, Stream_base* stm, int64_t bytes,
+    int64_t& retVal, AsyncEvent* ac)
+{
+    class asyncCopy : public AsyncState {
+    public:
+        asyncCopy(Stream_base* stm, int64_t& retVal, AsyncEvent* ac)
+            : AsyncState(ac)
+            , m_stm(stm)
+            , m_retVal(retVal)
+            , m_idx(0)
+        {
+            m_retVal = 0;
+            next(write);
+        }
+
+        ON_STATE(asyncCopy, write)
+        {
+            if (m_idx == m_bufs.size())
+                return next();
+
+            Buffer_base* buf = m_bufs[m_idx++];
+
+            m_retVal += Buffer::Cast(buf)->length();
+            return m_stm->write(buf, this);
+        }
+
+    public:
+        obj_ptr<Stream_base> m_stm;
+        int64_t& m_retVal;
+        std::vector<obj_ptr<Buffer_base>> m_bufs;
+        size_t m_idx;
+    };
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    // the slices go to the target as they are, nothing is copied
+    asyncCopy* copy = new asyncCopy(stm, retVal, ac);
+    int64_t sz = m_size - pos;
+
+    if (bytes < 0 || bytes > sz)
+        bytes = sz;
+
+    if (bytes > 0) {
+        size_t i = find(pos);
+        size_t off = (size_t)(pos - m_segs[i].m_start);
+
+        while (bytes > 0) {
+            Buffer::store& data = m_segs[i++].m_data;
+            size_t n = data.length() - off;
 
-    retVal = new Buffer(strBuf.c_str(), strBuf.length());
+            if ((int64_t)n > bytes)
+                n = (size_t)bytes;
 
+            copy->m_bufs.push_back(new Buffer(data.m_store, data.m_offset + off, n));
+            pos += n;
+            bytes -= n;
+            off = 0;
+        }
+    }
+
+    return copy->post(0);
+}
+
+result_t MemoryStream_base::_new(obj_ptr<MemoryStream_base>& retVal, v8::Local<v8::Object> This)
+{
+    retVal = new MemoryStream();
     return 0;
 }
 
+result_t MemoryStream::get_fd(int32_t& retVal)
+{
+    return CALL_E_INVALID_CALL;
+}
+
+result_t MemoryStream::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
+    AsyncEvent* ac)
+{
+    return m_buffer.read(m_pos, bytes, retVal);
+}
+
 result_t MemoryStream::readAll(obj_ptr<Buffer_base>& retVal,
     AsyncEvent* ac)
 {
@@ -68,9 +273,9 @@ result_t MemoryStream::readAll(obj_ptr<Buffer_base>& retVal,
 
 result_t MemoryStream::truncate(int64_t bytes, AsyncEvent* ac)
 {
-    std::string str = m_buffer.str();
-    str.resize((size_t)bytes);
-    m_buffer.str(str);
+    m_buffer.truncate(bytes);
+    if (m_pos > m_buffer.size())
+        m_pos = m_buffer.size();
 
     m_time.now();
 
@@ -79,7 +284,7 @@ result_t MemoryStream::truncate(int64_t bytes, AsyncEvent* ac)
 
 result_t MemoryStream::eof(bool& retVal)
 {
-    retVal = m_buffer.eof();
+    retVal = m_pos >= m_buffer.size();
     return 0;
 }
 
@@ -91,13 +296,12 @@ result_t MemoryStream::flush(AsyncEvent* ac)
 result_t MemoryStream::write(Buffer_base* data, AsyncEvent* ac)
 {
     Buffer* buf = Buffer::Cast(data);
-    int64_t sz1, sz2;
+    int64_t sz1 = m_buffer.size();
 
-    size(sz1);
-    m_buffer.write((const char*)buf->data(), buf->length());
-    m_buffer.seekg(m_buffer.tellp(), std::ios::beg);
-    size(sz2);
+    m_buffer.write(m_pos, buf);
+    m_pos += buf->length();
 
+    int64_t sz2 = m_buffer.size();
     if (sz2 > sz1)
         extMemory((int32_t)(sz2 - sz1));
 
@@ -114,7 +318,7 @@ result_t MemoryStream::close(AsyncEvent* ac)
 result_t MemoryStream::copyTo(Stream_base* stm, int64_t bytes, int64_t& retVal,
     AsyncEvent* ac)
 {
-    return io_base::copyStream(this, stm, bytes, retVal, ac);
+    return m_buffer.copyTo(m_pos, stm, bytes, retVal, ac);
 }
 
 result_t MemoryStream::stat(obj_ptr<Stat_base>& retVal, AsyncEvent* ac)
@@ -136,12 +340,10 @@ result_t MemoryStream::seek(int64_t offset, int32_t whence)
     if (whence < fs_base::C_SEEK_SET || whence > fs_base::C_SEEK_END)
         return CHECK_ERROR(CALL_E_INVALIDARG);
 
-    int64_t p = m_buffer.tellg();
-    m_buffer.seekg(0, std::ios::end);
-    int64_t sz = m_buffer.tellg();
+    int64_t sz = m_buffer.size();
 
     if (whence == fs_base::C_SEEK_CUR)
-        offset += p;
+        offset += m_pos;
     else if (whence == fs_base::C_SEEK_END)
         offset += sz;
 
@@ -150,35 +352,26 @@ result_t MemoryStream::seek(int64_t offset, int32_t whence)
     else if (offset > sz)
         offset = sz;
 
-    m_buffer.seekg((int64_t)offset, std::ios::beg);
-    m_buffer.seekp((int64_t)offset, std::ios::beg);
+    m_pos = offset;
 
     return 0;
 }
 
 result_t MemoryStream::tell(int64_t& retVal)
 {
-    retVal = m_buffer.tellg();
+    retVal = m_pos;
     return 0;
 }
 
 result_t MemoryStream::rewind()
 {
-    m_buffer.seekg(0, std::ios::beg);
-    m_buffer.seekp(0, std::ios::beg);
+    m_pos = 0;
     return 0;
 }
 
 result_t MemoryStream::size(int64_t& retVal)
 {
-    int64_t p = m_buffer.tellg();
-
-    m_buffer.seekg(0, std::ios::end);
-    retVal = m_buffer.tellg();
-    if (retVal < 0)
-        retVal = 0;
-    m_buffer.seekg(p, std::ios::beg);
-
+    retVal = m_buffer.size();
     return 0;
 }
 
@@ -190,14 +383,14 @@ result_t MemoryStream::setTime(date_t d)
 
 result_t MemoryStream::clone(obj_ptr<MemoryStream_base>& retVal)
 {
-    retVal = new CloneStream(m_buffer.str(), m_time);
+    retVal = new CloneStream(m_buffer, m_time);
     return 0;
 }
 
 result_t MemoryStream::clear()
 {
-    rewind();
-    m_buffer.str("");
+    m_buffer.clear();
+    m_pos = 0;
 
     m_time.now();
 
@@ -8,6 +8,7 @@
 
 #include "object.h"
 #include "RangeStream.h"
+#include "File.h"
 #include "Buffer.h"
 
 namespace fibjs {
@@ -201,6 +202,22 @@ result_t RangeStream::copyTo(Stream_base* stm, int64_t bytes, int64_t& retVal, A
     if (!m_stream)
         return CALL_E_CLOSED;
 
+    File* file = dynamic_cast<File*>((SeekableStream_base*)m_stream);
+    if (file && File::canSendFile(stm)) {
+        if (ac->isSync())
+            return CALL_E_NOSYNC;
+
+        int64_t pos = real_pos;
+        int64_t rest = valid_end() - pos;
+        if (rest < 0)
+            rest = 0;
+        if (bytes < 0 || bytes > rest)
+            bytes = rest;
+
+        real_pos += bytes;
+        return file->sendTo(stm, pos, bytes, retVal, ac);
+    }
+
     return io_base::copyStream(this, stm, bytes, retVal, ac);
 }
 
@@ -33,14 +33,74 @@ result_t Routing_base::_new(exlib::string method, v8::Local<v8::Object> map,
 }
 
 #define RE_SIZE 64
-result_t Routing::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
-    AsyncEvent* ac)
+bool Routing::match_rule(rule* r, Message_base* msg, exlib::string& test, bool isHost)
 {
     int32_t i, j;
     int32_t rc = 0;
-    obj_ptr<Message_base> msg = Message_base::getInstance(v);
     int32_t ovector[RE_SIZE];
 
+    rc = pcre_exec(r->m_re, NULL, test.c_str(), (int32_t)test.length(),
+        0, 0, ovector, RE_SIZE);
+    if (rc <= 0)
+        return false;
+
+    obj_ptr<NArray> list;
+
+    msg->get_params(list);
+    list->resize(0);
+
+    if (rc > 1) {
+        int32_t levelCount[RE_SIZE] = { 0 };
+        int32_t level[RE_SIZE] = { 0 };
+        int32_t p = 1;
+
+        levelCount[0] = 1;
+
+        for (i = 1; i < rc; i++) {
+            for (j = i - 1; j >= 0; j--)
+                if (ovector[i * 2] < ovector[j * 2 + 1]) {
+                    level[i] = level[j] + 1;
+                    break;
+                }
+            levelCount[level[i]]++;
+        }
+
+        if (r->m_bSub) {
+            i = rc - 1;
+            if (!isHost)
+                msg->set_value(test.substr(ovector[i * 2], ovector[i * 2 + 1] - ovector[i * 2]));
+        } else {
+            if (levelCount[1] == 1) {
+                if (!isHost)
+                    msg->set_value(test.substr(ovector[2], ovector[3] - ovector[2]));
+                if (levelCount[2] > 0)
+                    p = 2;
+            } else if (!isHost)
+                msg->set_value("");
+
+            if (levelCount[p]) {
+                Variant vUndefined;
+                for (i = 0; i < rc; i++)
+                    if (level[i] == p) {
+                        if (ovector[i * 2 + 1] - ovector[i * 2] > 0) {
+                            exlib::string p;
+                            Url::decodeURI(test.substr(ovector[i * 2], ovector[i * 2 + 1] - ovector[i * 2]), p);
+                            list->append(p);
+                        } else
+                            list->append(vUndefined);
+                    }
+            }
+        }
+    }
+
+    return true;
+}
+
+result_t Routing::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
+    AsyncEvent* ac)
+{
+    obj_ptr<Message_base> msg = Message_base::getInstance(v);
+
     if (msg == NULL)
         return CHECK_ERROR(CALL_E_BADVARTYPE);
 
@@ -54,9 +114,45 @@ result_t Routing::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
     if (htmsg)
         htmsg->get_method(method);
 
-    for (i = (int32_t)m_array.size() - 1; i >= 0; i--) {
-        obj_ptr<rule>& r = m_array[i];
-        exlib::string& test = value;
+    obj_ptr<tree> t;
+    get_tree(t);
+
+    const char* s = value.c_str();
+    size_t len = value.length();
+    node::match m;
+
+    // pcre's '$' also matches before a final newline, leave such values to the regex scan.
+    bool bTree = !t->m_trees.empty() && !memchr(s, '\r', len) && !memchr(s, '\n', len);
+
+    if (bTree) {
+        std::map<exlib::string, node*>::const_iterator it;
+
+        if (htmsg) {
+            exlib::string key(method);
+            char* p = key.data();
+
+            for (size_t i = 0; i < key.length(); i++)
+                p[i] = qtoupper(p[i]);
+
+            it = t->m_trees.find(key);
+            if (it != t->m_trees.end())
+                it->second->find(s, len, 0, m);
+
+            it = t->m_trees.find("*");
+            if (it != t->m_trees.end())
+                it->second->find(s, len, 0, m);
+        } else
+            for (it = t->m_trees.begin(); it != t->m_trees.end(); it++)
+                it->second->find(s, len, 0, m);
+    }
+
+    size_t cnt = bTree ? t->m_regex.size() : t->m_order.size();
+    for (size_t k = 0; k < cnt; k++) {
+        int32_t no = bTree ? t->m_regex[k] : (int32_t)k;
+        if (m.m_order >= 0 && no > m.m_order)
+            break;
+
+        rule* r = t->m_order[no];
         bool isHost = false;
 
         if (htmsg) {
@@ -72,7 +168,6 @@ result_t Routing::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
                     }
                 }
 
-                test = host;
                 isHost = true;
             } else {
                 if (r->m_method != "*" && qstricmp(method.c_str(), r->m_method.c_str()))
@@ -80,66 +175,217 @@ result_t Routing::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
             }
         }
 
-        rc = pcre_exec(r->m_re, NULL, test.c_str(), (int32_t)test.length(),
-            0, 0, ovector, RE_SIZE);
-        if (rc > 0) {
-            obj_ptr<NArray> list;
-
-            msg->get_params(list);
-            list->resize(0);
+        if (match_rule(r, msg, isHost ? host : value, isHost)) {
+            retVal = r->m_hdlr;
+            return 0;
+        }
+    }
 
-            if (rc > 1) {
-                int32_t levelCount[RE_SIZE] = { 0 };
-                int32_t level[RE_SIZE] = { 0 };
-                int32_t p = 1;
+    if (m.m_order >= 0) {
+        rule* r = t->m_order[m.m_order];
+        obj_ptr<NArray> list;
 
-                levelCount[0] = 1;
+        msg->get_params(list);
+        list->resize(0);
 
-                for (i = 1; i < rc; i++) {
-                    for (j = i - 1; j >= 0; j--)
-                        if (ovector[i * 2] < ovector[j * 2 + 1]) {
-                            level[i] = level[j] + 1;
-                            break;
-                        }
-                    levelCount[level[i]]++;
-                }
+        if (r->m_bSub)
+            msg->set_value(value.substr(m.m_rest));
+        else if (m.m_params.size() > 0) {
+            if (m.m_params.size() == 1)
+                msg->set_value(value.substr(m.m_params[0].first, m.m_params[0].second));
+            else
+                msg->set_value("");
 
-                if (r->m_bSub) {
-                    i = rc - 1;
-                    if (!isHost)
-                        msg->set_value(test.substr(ovector[i * 2], ovector[i * 2 + 1] - ovector[i * 2]));
-                } else {
-                    if (levelCount[1] == 1) {
-                        if (!isHost)
-                            msg->set_value(test.substr(ovector[2], ovector[3] - ovector[2]));
-                        if (levelCount[2] > 0)
-                            p = 2;
-                    } else if (!isHost)
-                        msg->set_value("");
-
-                    if (levelCount[p]) {
-                        Variant vUndefined;
-                        for (i = 0; i < rc; i++)
-                            if (level[i] == p) {
-                                if (ovector[i * 2 + 1] - ovector[i * 2] > 0) {
-                                    exlib::string p;
-                                    Url::decodeURI(test.substr(ovector[i * 2], ovector[i * 2 + 1] - ovector[i * 2]), p);
-                                    list->append(p);
-                                } else
-                                    list->append(vUndefined);
-                            }
-                    }
-                }
+            for (size_t i = 0; i < m.m_params.size(); i++) {
+                exlib::string p;
+                Url::decodeURI(value.substr(m.m_params[i].first, m.m_params[i].second), p);
+                list->append(p);
             }
-
-            retVal = r->m_hdlr;
-            return 0;
         }
+
+        retVal = r->m_hdlr;
+        return 0;
     }
 
     return CHECK_ERROR(Runtime::setError("Routing: unknown routing: " + value));
 }
 
+Routing::node* Routing::node::add(const exlib::string& key, size_t pos)
+{
+    const char* kp = key.c_str();
+    size_t len = key.length();
+
+    if (pos == len)
+        return this;
+
+    for (size_t i = 0; i < m_childs.size(); i++) {
+        node* c = m_childs[i];
+        const char* k = c->m_key.c_str();
+        size_t klen = c->m_key.length();
+        size_t n = 0;
+
+        while (n < klen && pos + n < len && k[n] == kp[pos + n])
+            n++;
+
+        if (n == 0)
+            continue;
+
+        if (n < klen) {
+            node* mid = new node();
+
+            mid->m_key = c->m_key.substr(0, n);
+            c->m_key = c->m_key.substr(n);
+            mid->m_childs.push_back(c);
+            m_childs[i] = mid;
+            c = mid;
+        }
+
+        return c->add(key, pos + n);
+    }
+
+    node* c = new node();
+    c->m_key = key.substr(pos);
+    m_childs.push_back(c);
+
+    return c;
+}
+
+Routing::node* Routing::node::param()
+{
+    if (m_param == NULL)
+        m_param = new node();
+    return m_param;
+}
+
+int32_t Routing::node::update()
+{
+    int32_t v;
+
+    m_min = m_end;
+    if (m_sub >= 0 && (m_min < 0 || m_sub < m_min))
+        m_min = m_sub;
+
+    for (size_t i = 0; i < m_childs.size(); i++) {
+        v = m_childs[i]->update();
+        if (v >= 0 && (m_min < 0 || v < m_min))
+            m_min = v;
+    }
+
+    if (m_param) {
+        v = m_param->update();
+        if (v >= 0 && (m_min < 0 || v < m_min))
+            m_min = v;
+    }
+
+    return m_min;
+}
+
+void Routing::node::find(const char* s, size_t len, size_t pos, match& m)
+{
+    if (m_min < 0 || (m.m_order >= 0 && m_min >= m.m_order))
+        return;
+
+    if (m_sub >= 0 && (m.m_order < 0 || m_sub < m.m_order)) {
+        m.m_order = m_sub;
+        m.m_rest = pos;
+        m.m_params = m.m_stack;
+    }
+
+    if (m_end >= 0 && (m.m_order < 0 || m_end < m.m_order)
+        && (pos == len || (pos + 1 == len && s[pos] == '/'))) {
+        m.m_order = m_end;
+        m.m_params = m.m_stack;
+    }
+
+    for (size_t i = 0; i < m_childs.size(); i++) {
+        node* c = m_childs[i];
+        const char* k = c->m_key.c_str();
+        size_t klen = c->m_key.length();
+        size_t n = 0;
+
+        if (klen > len - pos)
+            continue;
+
+        while (n < klen && k[n] == qtolower(s[pos + n]))
+            n++;
+
+        if (n == klen)
+            c->find(s, len, pos + klen, m);
+    }
+
+    if (m_param && pos < len && s[pos] != '/') {
+        size_t e = pos + 1;
+
+        while (e < len && s[e] != '/')
+            e++;
+
+        m.m_stack.push_back(std::pair<size_t, size_t>(pos, e - pos));
+        m_param->find(s, len, e, m);
+        m.m_stack.pop_back();
+    }
+}
+
+void Routing::tree::build(const std::vector<obj_ptr<rule>>& rules)
+{
+    int32_t i, no = 0;
+
+    for (i = (int32_t)rules.size() - 1; i >= 0; i--, no++) {
+        rule* r = rules[i];
+
+        m_order.push_back(r);
+        if (r->m_bTree) {
+            exlib::string key(r->m_method);
+            char* p = key.data();
+
+            for (size_t j = 0; j < key.length(); j++)
+                p[j] = qtoupper(p[j]);
+
+            node*& root = m_trees[key];
+            if (root == NULL)
+                root = new node();
+
+            node* n = root;
+            for (size_t j = 0; j < r->m_path.size(); j++) {
+                if (j > 0)
+                    n = n->param();
+                n = n->add(r->m_path[j], 0);
+            }
+
+            int32_t& v = r->m_bSub ? n->m_sub : n->m_end;
+            if (v < 0)
+                v = no;
+        } else
+            m_regex.push_back(no);
+    }
+
+    std::map<exlib::string, node*>::iterator it;
+    for (it = m_trees.begin(); it != m_trees.end(); it++)
+        it->second->update();
+}
+
+// runs on the js thread after the rules change, invoke keeps using the tree it took
+// until it returns, the old tree is freed by whoever drops it last.
+void Routing::build_tree()
+{
+    obj_ptr<tree> t = new tree();
+
+    t->build(m_array);
+
+    obj_ptr<tree> old;
+
+    m_lock.lock();
+    old = m_tree;
+    m_tree = t;
+    m_lock.unlock();
+}
+
+void Routing::get_tree(obj_ptr<tree>& retVal)
+{
+    m_lock.lock();
+    retVal = m_tree;
+    m_lock.unlock();
+}
+
 result_t Routing::_append(exlib::string method, v8::Local<v8::Object> map,
     obj_ptr<Routing_base>& retVal)
 {
@@ -154,20 +400,66 @@ result_t Routing::_append(exlib::string method, v8::Local<v8::Object> map,
         JSValue k = ks->Get(context, i);
         JSValue v = map->Get(context, k);
         obj_ptr<Handler_base> hdlr;
-        obj_ptr<Routing_base> r;
 
         hr = GetArgumentValue(isolate, v, hdlr);
         if (hr < 0)
             return hr;
 
-        append(method, isolate->toString(k), hdlr, r);
+        add_rule(method, isolate->toString(k), hdlr);
     }
 
+    build_tree();
     retVal = this;
 
     return 0;
 }
 
+bool Routing::path2Tree(exlib::string pattern, bool bSub, std::vector<exlib::string>& path)
+{
+    size_t len = pattern.length();
+
+    if (len > 0 && pattern.c_str()[len - 1] == '/')
+        pattern.resize(--len);
+
+    const char* s = pattern.c_str();
+    exlib::string lit;
+    size_t i = 0;
+
+    path.clear();
+    while (i < len) {
+        char ch = s[i];
+
+        if (ch == ':') {
+            // only whole-segment params without modifiers are compiled into the tree
+            if (lit.empty() || lit.c_str()[lit.length() - 1] != '/')
+                return false;
+
+            i++;
+            while (i < len && (qisascii(s[i]) || qisdigit(s[i]) || s[i] == '_'))
+                i++;
+            if (i < len && s[i] != '/')
+                return false;
+
+            path.push_back(lit);
+            lit.clear();
+        } else if ((unsigned char)ch < 0x20 || (unsigned char)ch >= 0x80
+            || strchr("\\()[]{}*?+|^$", ch))
+            return false;
+        else {
+            lit.append(1, qtolower(ch));
+            i++;
+        }
+    }
+
+    path.push_back(lit);
+
+    // a sub routing ending with a param takes "(.*)" as its regex, leave it to pcre.
+    if (bSub && path.size() > 1 && lit.empty())
+        return false;
+
+    return path.size() < RE_SIZE / 3;
+}
+
 exlib::string Routing::path2RegExp(exlib::string pattern)
 {
     size_t len = pattern.length();
@@ -289,20 +581,22 @@ exlib::string Routing::host2RegExp(exlib::string pattern)
     return res;
 }
 
-result_t Routing::append(exlib::string method, exlib::string pattern, Handler_base* hdlr,
-    obj_ptr<Routing_base>& retVal)
+result_t Routing::add_rule(exlib::string method, exlib::string pattern, Handler_base* hdlr)
 {
     int32_t opt = PCRE_JAVASCRIPT_COMPAT | PCRE_NEWLINE_ANYCRLF | PCRE_UCP | PCRE_CASELESS;
     const char* error;
     int32_t erroffset;
     pcre* re;
     bool bSub = false;
+    bool bTree = false;
+    std::vector<exlib::string> path;
 
     if (pattern.length() > 0 && pattern.c_str()[0] != '^') {
         if (!qstricmp(method.c_str(), "HOST"))
             pattern = host2RegExp(pattern);
         else {
             obj_ptr<Routing_base> rt = Routing_base::getInstance(hdlr);
+            bTree = path2Tree(pattern, rt != NULL, path);
             if (rt) {
                 int32_t len = (int32_t)pattern.length();
                 if (len > 0 && pattern.c_str()[len - 1] == '/')
@@ -331,8 +625,24 @@ result_t Routing::append(exlib::string method, exlib::string pattern, Handler_ba
     SetPrivate(strBuf, hdlr->wrap());
 
     obj_ptr<rule> r = new rule(method, re, hdlr, bSub);
+    if (bTree) {
+        r->m_path = path;
+        r->m_bTree = true;
+    }
+
     m_array.insert(m_array.begin(), r);
 
+    return 0;
+}
+
+result_t Routing::append(exlib::string method, exlib::string pattern, Handler_base* hdlr,
+    obj_ptr<Routing_base>& retVal)
+{
+    result_t hr = add_rule(method, pattern, hdlr);
+    if (hr < 0)
+        return hr;
+
+    build_tree();
     retVal = this;
 
     return 0;
@@ -356,6 +666,8 @@ result_t Routing::append(Routing_base* route, obj_ptr<Routing_base>& retVal)
     }
 
     r_obj->m_array.resize(0);
+    r_obj->build_tree();
+    build_tree();
 
     retVal = this;
 
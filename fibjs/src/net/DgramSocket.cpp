@@ -15,6 +15,24 @@
 #include "EventInfo.h"
 #include <fcntl.h>
 
+#ifdef Linux
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+
+#define GSO_MAX_SEGMENTS 64
+#define GSO_MAX_SIZE 65507
+#define MMSG_MAX_BATCH 64
+#endif
+
+#define DGRAM_MAX_SIZE (64 * 1024)
+#define DGRAM_MAX_BATCH 20
+#define DGRAM_SLAB_SIZE (64 * 1024)
+
 namespace fibjs {
 
 DECLARE_MODULE(dgram);
@@ -81,6 +99,17 @@ result_t dgram_base::createSocket(v8::Local<v8::Object> opts, obj_ptr<DgramSocke
         return CHECK_ERROR(CALL_E_INVALIDARG);
 
     obj_ptr<DgramSocket> s = new DgramSocket();
+
+    hr = GetConfigValue(isolate, opts, "recvBatch", s->m_recv_batch);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+    if (s->m_recv_batch < 1 || s->m_recv_batch > DGRAM_MAX_BATCH)
+        return Runtime::setError("dgram: recvBatch must be between 1 and 20");
+
+    hr = GetConfigValue(isolate, opts, "gso", s->m_gso);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
     hr = s->create(family, (reuseAddr ? UV_UDP_REUSEADDR : 0) | (ipv6Only ? UV_UDP_IPV6ONLY : 0));
     if (hr < 0)
         return hr;
@@ -116,15 +145,42 @@ result_t DgramSocket::create(int32_t family, int32_t flags)
     m_flags = flags;
     m_family = family;
 
-    return uv_call([&] {
-        return uv_udp_init_ex(s_uv_loop, &m_udp, 0);
+    uint32_t uv_flags = 0;
+#if UV_VERSION_HEX >= 0x012800
+    if (m_recv_batch > 1)
+        uv_flags |= UV_UDP_RECVMMSG;
+#endif
+
+    return uv_call(m_loop, [&] {
+        return uv_udp_init_ex(m_loop, &m_udp, uv_flags);
     });
 }
 
+obj_ptr<Buffer> DgramSocket::slab(const char* data, size_t length)
+{
+    if (length > DGRAM_SLAB_SIZE / 8)
+        return new Buffer(data, length);
+
+    if (!m_slab || m_slab_used + length > DGRAM_SLAB_SIZE) {
+        m_slab = NewBackingStore(DGRAM_SLAB_SIZE);
+        m_slab_used = 0;
+    }
+
+    memcpy((char*)m_slab->Data() + m_slab_used, data, length);
+    obj_ptr<Buffer> buf = new Buffer(m_slab, m_slab_used, length);
+    m_slab_used += (length + 7) & ~7;
+
+    return buf;
+}
+
 void DgramSocket::on_alloc(uv_handle_t* handle, size_t suggested_size, uv_buf_t* buf)
 {
     DgramSocket* pThis = container_of(handle, DgramSocket, m_handle);
 
+    // libuv only uses recvmmsg when the buffer holds at least two datagrams of the largest size
+    if (pThis->m_recv_batch > 1)
+        suggested_size = pThis->m_recv_batch * DGRAM_MAX_SIZE;
+
     pThis->m_buf.resize(suggested_size);
     *buf = uv_buf_init(pThis->m_buf.data(), (int32_t)pThis->m_buf.length());
 }
@@ -133,11 +189,11 @@ void DgramSocket::on_recv(uv_udp_t* handle, ssize_t nread, const uv_buf_t* buf,
 {
     DgramSocket* pThis = container_of(handle, DgramSocket, m_udp);
 
-    pThis->m_buf.resize(nread);
-    if (addr) {
+    // a recvmmsg batch ends with a call that carries no datagram
+    if (nread >= 0 && addr) {
         Variant v[2];
 
-        obj_ptr<Buffer> _buf = new Buffer(pThis->m_buf.c_str(), pThis->m_buf.length());
+        obj_ptr<Buffer> _buf = pThis->slab(buf->base, nread);
         v[0] = _buf;
 
         inetAddr& _addr = *(inetAddr*)addr;
@@ -197,7 +253,7 @@ result_t DgramSocket::bind(int32_t port, exlib::string addr, AsyncEvent* ac)
     m_bound = true;
     isolate_ref();
 
-    return uv_call([&] {
+    return uv_call(m_loop, [&] {
         return uv_udp_recv_start(&m_udp, on_alloc, on_recv);
     });
 }
@@ -235,6 +291,27 @@ result_t DgramSocket::bind(v8::Local<v8::Object> opts, AsyncEvent* ac)
     return bind(port, addr, ac);
 }
 
+result_t DgramSocket::resolve(int32_t port, exlib::string address, inetAddr& retVal)
+{
+    retVal.init(m_family);
+    retVal.setPort(port);
+
+    if (address.empty())
+        address = m_family == net_base::C_AF_INET6 ? "::1" : "127.0.0.1";
+
+    if (retVal.addr(address.c_str()) < 0) {
+        exlib::string strAddr;
+        result_t hr = net_base::cc_resolve(address, m_family, strAddr);
+        if (hr < 0)
+            return hr;
+
+        if (retVal.addr(strAddr.c_str()) < 0)
+            return CHECK_ERROR(CALL_E_INVALIDARG);
+    }
+
+    return 0;
+}
+
 result_t DgramSocket::send(Buffer_base* msg, int32_t port, exlib::string address,
     int32_t& retVal, AsyncEvent* ac)
 {
@@ -282,22 +359,9 @@ result_t DgramSocket::send(Buffer_base* msg, int32_t port, exlib::string address
         return CHECK_ERROR(CALL_E_NOSYNC);
 
     inetAddr addr_info;
-
-    addr_info.init(m_family);
-    addr_info.setPort(port);
-
-    if (address.empty())
-        address = m_family == net_base::C_AF_INET6 ? "::1" : "127.0.0.1";
-
-    if (addr_info.addr(address.c_str()) < 0) {
-        exlib::string strAddr;
-        hr = net_base::cc_resolve(address, m_family, strAddr);
-        if (hr < 0)
-            return hr;
-
-        if (addr_info.addr(strAddr.c_str()) < 0)
-            return CHECK_ERROR(CALL_E_INVALIDARG);
-    }
+    hr = resolve(port, address, addr_info);
+    if (hr < 0)
+        return hr;
 
     AsyncSend* _send = new AsyncSend(msg, port, retVal, ac);
     int32_t status = uv_udp_try_send(&m_udp, &_send->m_buf, 1, (sockaddr*)&addr_info);
@@ -308,7 +372,7 @@ result_t DgramSocket::send(Buffer_base* msg, int32_t port, exlib::string address
     } else if (status != UV_ENOSYS && status != UV_EAGAIN)
         return CHECK_ERROR(status);
 
-    return uv_async([&] {
+    return uv_async(m_loop, [&] {
         return uv_udp_send(_send, &m_udp, &_send->m_buf, 1, (sockaddr*)&addr_info, AsyncSend::callback);
     });
 }
@@ -335,6 +399,237 @@ result_t DgramSocket::send(Buffer_base* msg, int32_t offset, int32_t length, int
     return send(msg1, port, address, retVal, ac);
 }
 
+#ifdef Linux
+// sends as many of bufs as the socket takes without blocking, in as few sendmmsg calls as possible.
+// with gso, a run of equal sized messages, where only the last may be shorter, goes out as one
+// UDP_SEGMENT send that the kernel or the nic splits again.
+// returns the number of messages sent
+int32_t DgramSocket::send_mmsg(std::vector<uv_buf_t>& bufs, inetAddr& addr, int32_t& bytes)
+{
+    uv_os_fd_t fd;
+    if (uv_fileno(&m_handle, &fd) < 0)
+        return 0;
+
+    // sends libuv still has queued must go first
+    if (uv_udp_get_send_queue_count(&m_udp))
+        return 0;
+
+    mmsghdr hdrs[MMSG_MAX_BATCH];
+    char ctrl[MMSG_MAX_BATCH][CMSG_SPACE(sizeof(uint16_t))];
+    size_t pos = 0;
+
+    while (pos < bufs.size()) {
+        int32_t cnt = 0;
+        size_t p = pos;
+
+        memset(hdrs, 0, sizeof(hdrs));
+        while (p < bufs.size() && cnt < MMSG_MAX_BATCH) {
+            msghdr& h = hdrs[cnt].msg_hdr;
+            size_t seg = bufs[p].len;
+            size_t total = seg;
+            size_t n = 1;
+
+            if (m_gso && seg > 0)
+                while (p + n < bufs.size() && n < GSO_MAX_SEGMENTS
+                    && bufs[p + n].len > 0 && bufs[p + n].len <= seg
+                    && total + bufs[p + n].len <= GSO_MAX_SIZE) {
+                    total += bufs[p + n].len;
+                    n++;
+
+                    if (bufs[p + n - 1].len < seg)
+                        break;
+                }
+
+            h.msg_name = &addr;
+            h.msg_namelen = addr.size();
+            h.msg_iov = (iovec*)&bufs[p];
+            h.msg_iovlen = n;
+
+            if (n > 1) {
+                h.msg_control = ctrl[cnt];
+                h.msg_controllen = sizeof(ctrl[cnt]);
+
+                cmsghdr* cm = CMSG_FIRSTHDR(&h);
+                cm->cmsg_level = SOL_UDP;
+                cm->cmsg_type = UDP_SEGMENT;
+                cm->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+                *(uint16_t*)CMSG_DATA(cm) = (uint16_t)seg;
+            }
+
+            p += n;
+            cnt++;
+        }
+
+        int32_t ret;
+        do
+            ret = sendmmsg(fd, hdrs, cnt, 0);
+        while (ret < 0 && errno == EINTR);
+
+        if (ret < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+
+            // the kernel or the route refuses gso, send the datagrams one by one from now on
+            if (m_gso && (errno == EIO || errno == EINVAL || errno == ENOPROTOOPT)) {
+                m_gso = false;
+                continue;
+            }
+
+            if (pos == 0)
+                return -errno;
+            break;
+        }
+
+        for (int32_t i = 0; i < ret; i++) {
+            pos += hdrs[i].msg_hdr.msg_iovlen;
+            bytes += hdrs[i].msg_len;
+        }
+
+        if (ret < cnt)
+            break;
+    }
+
+    return (int32_t)pos;
+}
+#endif
+
+result_t DgramSocket::sendBatch(v8::Local<v8::Array> msgs, int32_t port, exlib::string address,
+    int32_t& retVal, AsyncEvent* ac)
+{
+    class AsyncSendBatch {
+    public:
+        class req : public uv_udp_send_t {
+        public:
+            AsyncSendBatch* m_batch;
+            uv_buf_t m_buf;
+        };
+
+    public:
+        AsyncSendBatch(NArray* msgs, std::vector<uv_buf_t>& bufs, size_t pos, int32_t& retVal, AsyncEvent* ac)
+            : m_msgs(msgs)
+            , m_reqs(bufs.size() - pos)
+            , m_pending(0)
+            , m_error(0)
+            , m_retVal(retVal)
+            , m_ac(ac)
+        {
+            for (size_t i = 0; i < m_reqs.size(); i++) {
+                m_reqs[i].m_batch = this;
+                m_reqs[i].m_buf = bufs[pos + i];
+            }
+        }
+
+        int32_t start(uv_udp_t* udp, inetAddr& addr)
+        {
+            for (size_t i = 0; i < m_reqs.size(); i++) {
+                int32_t ret = uv_udp_send(&m_reqs[i], udp, &m_reqs[i].m_buf, 1, (sockaddr*)&addr, callback);
+                if (ret < 0) {
+                    if (m_pending == 0) {
+                        delete this;
+                        return ret;
+                    }
+
+                    m_error = ret;
+                    break;
+                }
+
+                m_pending++;
+            }
+
+            return 0;
+        }
+
+        static void callback(uv_udp_send_t* r, int status)
+        {
+            req* pReq = (req*)r;
+            AsyncSendBatch* pThis = pReq->m_batch;
+
+            if (status < 0) {
+                if (pThis->m_error == 0)
+                    pThis->m_error = status;
+            } else
+                pThis->m_retVal += (int32_t)pReq->m_buf.len;
+
+            if (--pThis->m_pending == 0) {
+                pThis->m_ac->apost(pThis->m_error);
+                delete pThis;
+            }
+        }
+
+    public:
+        obj_ptr<NArray> m_msgs;
+        std::vector<req> m_reqs;
+        int32_t m_pending;
+        int32_t m_error;
+        int32_t& m_retVal;
+        AsyncEvent* m_ac;
+    };
+
+    result_t hr;
+
+    if (ac->isSync()) {
+        obj_ptr<NArray> _msgs = new NArray();
+
+        hr = _msgs->append_array<obj_ptr<Buffer_base>>(msgs);
+        if (hr < 0)
+            return hr;
+
+        ac->m_ctxo = _msgs;
+    }
+
+    if (!m_bound) {
+        hr = bind(0, "", ac);
+        if (hr < 0)
+            return hr;
+    }
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    inetAddr addr_info;
+    hr = resolve(port, address, addr_info);
+    if (hr < 0)
+        return hr;
+
+    obj_ptr<NArray> _msgs = ac->m_ctxo.As<NArray>();
+    std::vector<uv_buf_t> bufs(_msgs->m_array.size());
+
+    for (size_t i = 0; i < bufs.size(); i++) {
+        Buffer* buf = Buffer::Cast((Buffer_base*)_msgs->m_array[i].object());
+        bufs[i] = uv_buf_init((char*)buf->data(), (int32_t)buf->length());
+    }
+
+    retVal = 0;
+    size_t pos = 0;
+
+#ifdef Linux
+    int32_t sent = send_mmsg(bufs, addr_info, retVal);
+    if (sent < 0)
+        return CHECK_ERROR(sent);
+    pos = sent;
+#endif
+
+    while (pos < bufs.size()) {
+        int32_t status = uv_udp_try_send(&m_udp, &bufs[pos], 1, (sockaddr*)&addr_info);
+        if (status < 0) {
+            if (status != UV_ENOSYS && status != UV_EAGAIN)
+                return CHECK_ERROR(status);
+            break;
+        }
+
+        retVal += status;
+        pos++;
+    }
+
+    if (pos == bufs.size())
+        return 0;
+
+    AsyncSendBatch* _send = new AsyncSendBatch(_msgs, bufs, pos, retVal, ac);
+    return uv_async(m_loop, [&] {
+        return _send->start(&m_udp, addr_info);
+    });
+}
+
 result_t DgramSocket::address(obj_ptr<NObject>& retVal)
 {
     inetAddr addr_info;
@@ -366,7 +661,7 @@ result_t DgramSocket::close()
     if (uv_is_closing(&m_handle))
         return CALL_E_INVALID_CALL;
 
-    return uv_call([&] {
+    return uv_call(m_loop, [&] {
         uv_close(&m_handle, on_close);
         return 0;
     });
@@ -0,0 +1,597 @@
+/*
+ * Resolver.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "ifs/net.h"
+#include "Resolver.h"
+#include "Timer.h"
+#include "inetAddr.h"
+#include "AsyncUV.h"
+#include <unordered_map>
+
+namespace fibjs {
+
+int32_t Resolver::s_ttl = 60;
+int32_t Resolver::s_negative_ttl = 5;
+
+typedef std::pair<std::vector<exlib::string>*, AsyncEvent*> _waiter;
+
+class _entry {
+public:
+    _entry()
+        : m_valid(false)
+        , m_pending(false)
+        , m_error(0)
+        , m_expires(0)
+    {
+    }
+
+public:
+    bool m_valid;
+    bool m_pending;
+    result_t m_error;
+    double m_expires;
+    std::vector<exlib::string> m_addrs;
+
+    // lookups waiting for the query in flight
+    std::vector<_waiter> m_waiters;
+};
+
+static exlib::spinlock s_lock;
+static std::unordered_map<exlib::string, _entry> s_cache;
+static Resolver::Stats s_stats;
+
+static double now_ms()
+{
+    date_t d;
+
+    d.now();
+    return d.date();
+}
+
+static double stale_ms()
+{
+    return (double)Resolver::s_ttl * 1000;
+}
+
+// called with s_lock held, drops what can no longer be served first
+static void purge(double now)
+{
+    std::unordered_map<exlib::string, _entry>::iterator it;
+
+    for (it = s_cache.begin(); it != s_cache.end();) {
+        _entry& e = it->second;
+
+        if (!e.m_pending && now >= e.m_expires + (e.m_error < 0 ? 0 : stale_ms()))
+            it = s_cache.erase(it);
+        else
+            it++;
+    }
+
+    for (it = s_cache.begin(); it != s_cache.end() && s_cache.size() > Resolver::MAX_ENTRIES / 2;) {
+        if (!it->second.m_pending)
+            it = s_cache.erase(it);
+        else
+            it++;
+    }
+}
+
+static void on_result(exlib::string name, result_t status, std::vector<exlib::string>& addrs)
+{
+    std::vector<_waiter> waiters;
+    std::vector<exlib::string> result;
+    result_t hr;
+    double now = now_ms();
+
+    s_lock.lock();
+
+    _entry& e = s_cache[name];
+
+    e.m_pending = false;
+
+    // a failed refresh keeps the old addresses until they are too old to be served
+    if (status >= 0 || !e.m_valid || e.m_error < 0 || now >= e.m_expires + stale_ms()) {
+        e.m_valid = true;
+        e.m_error = status;
+        e.m_addrs = addrs;
+        e.m_expires = now + (double)(status < 0 ? Resolver::s_negative_ttl : Resolver::s_ttl) * 1000;
+    }
+
+    waiters.swap(e.m_waiters);
+    hr = e.m_error;
+    if (waiters.size() > 0 && hr >= 0)
+        result = e.m_addrs;
+
+    if (s_cache.size() > Resolver::MAX_ENTRIES)
+        purge(now);
+    s_stats.m_entries = s_cache.size();
+
+    s_lock.unlock();
+
+    // this runs on the uv thread, apost moves the waiters back to the fiber pool
+    for (size_t i = 0; i < waiters.size(); i++) {
+        if (hr >= 0)
+            *waiters[i].first = result;
+        waiters[i].second->apost(hr);
+    }
+}
+
+static result_t query(exlib::string name)
+{
+    class resolve_data : public uv_getaddrinfo_t {
+    public:
+        resolve_data(exlib::string name)
+            : _name(name)
+        {
+        }
+
+    public:
+        exlib::string _name;
+    };
+
+    addrinfo hints = { 0, AF_UNSPEC, SOCK_STREAM, IPPROTO_TCP, 0, 0, 0, 0 };
+
+    resolve_data* resolver = new resolve_data(name);
+    int r = uv_getaddrinfo(
+        s_uv_loop, resolver,
+        [](uv_getaddrinfo_t* _resolver, int status, struct addrinfo* res) {
+            resolve_data* resolver = (resolve_data*)_resolver;
+            std::vector<exlib::string> addrs;
+
+            if (status >= 0)
+                for (struct addrinfo* ptr = res; ptr != NULL; ptr = ptr->ai_next) {
+                    inetAddr addr_info;
+                    addr_info.init(ptr->ai_addr);
+                    addrs.push_back(addr_info.str());
+                }
+
+            uv_freeaddrinfo(res);
+
+            on_result(resolver->_name, status, addrs);
+            delete resolver;
+        },
+        name.c_str(), NULL, &hints);
+
+    if (r < 0) {
+        delete resolver;
+        return r;
+    }
+
+    return 0;
+}
+
+result_t Resolver::resolve(exlib::string name, std::vector<exlib::string>& retVal, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    std::vector<exlib::string> empty;
+    double now = now_ms();
+    bool bQuery;
+    result_t hr;
+
+    s_lock.lock();
+
+    _entry& e = s_cache[name];
+
+    if (e.m_valid && now < e.m_expires) {
+        if (e.m_error < 0)
+            s_stats.m_negative++;
+        else {
+            s_stats.m_hits++;
+            retVal = e.m_addrs;
+        }
+
+        hr = e.m_error;
+        s_lock.unlock();
+
+        return hr;
+    }
+
+    if (e.m_valid && e.m_error >= 0 && now < e.m_expires + stale_ms()) {
+        s_stats.m_stale++;
+        retVal = e.m_addrs;
+
+        bQuery = !e.m_pending;
+        e.m_pending = true;
+
+        s_lock.unlock();
+
+        if (bQuery) {
+            hr = query(name);
+            if (hr < 0)
+                on_result(name, hr, empty);
+        }
+
+        return 0;
+    }
+
+    s_stats.m_misses++;
+    e.m_waiters.push_back(_waiter(&retVal, ac));
+
+    bQuery = !e.m_pending;
+    e.m_pending = true;
+
+    s_stats.m_entries = s_cache.size();
+
+    s_lock.unlock();
+
+    if (bQuery) {
+        hr = query(name);
+        if (hr < 0) {
+            // nothing has been posted yet, this call fails directly and the other waiters through on_result
+            s_lock.lock();
+
+            std::vector<_waiter>& waiters = s_cache[name].m_waiters;
+            for (size_t i = 0; i < waiters.size(); i++)
+                if (waiters[i].second == ac) {
+                    waiters.erase(waiters.begin() + i);
+                    break;
+                }
+
+            s_lock.unlock();
+
+            on_result(name, hr, empty);
+            return CHECK_ERROR(hr);
+        }
+    }
+
+    return CALL_E_PENDDING;
+}
+
+void Resolver::stats(Stats& retVal)
+{
+    s_lock.lock();
+    retVal = s_stats;
+    retVal.m_entries = s_cache.size();
+    s_lock.unlock();
+}
+
+static bool is_ipv6(const exlib::string& addr)
+{
+    return addr.find(':') != exlib::string::npos;
+}
+
+// one connection attempt per address, a new one starts every CONNECT_ATTEMPT_DELAY ms
+// or as soon as the previous one fails. the first socket connected wins and the others are closed.
+class HappyEyeballs : public obj_base {
+public:
+    class DelayTimer : public Timer {
+    public:
+        DelayTimer(HappyEyeballs* race, size_t idx)
+            : Timer(Resolver::CONNECT_ATTEMPT_DELAY)
+            , m_race(race)
+            , m_idx(idx)
+        {
+        }
+
+    public:
+        virtual void on_timer()
+        {
+            m_race->attempt(m_idx);
+        }
+
+    private:
+        obj_ptr<HappyEyeballs> m_race;
+        size_t m_idx;
+    };
+
+    class asyncAttempt : public AsyncState {
+    public:
+        asyncAttempt(HappyEyeballs* race, Socket_base* sock, exlib::string addr)
+            : AsyncState(NULL)
+            , m_race(race)
+            , m_sock(sock)
+            , m_addr(addr)
+        {
+            next(connect);
+        }
+
+        ON_STATE(asyncAttempt, connect)
+        {
+            return m_sock->connect(m_addr, m_race->m_port, m_race->m_timeout, next(connected));
+        }
+
+        ON_STATE(asyncAttempt, connected)
+        {
+            if (!m_race->won(m_sock))
+                m_sock->cc_close();
+
+            return next();
+        }
+
+        virtual int32_t error(int32_t v)
+        {
+            m_race->failed(m_sock, v);
+            return v;
+        }
+
+    private:
+        obj_ptr<HappyEyeballs> m_race;
+        obj_ptr<Socket_base> m_sock;
+        exlib::string m_addr;
+    };
+
+public:
+    HappyEyeballs(std::vector<exlib::string>& addrs, int32_t port, int32_t timeout)
+        : m_port(port)
+        , m_timeout(timeout)
+        , m_next(0)
+        , m_running(0)
+        , m_done(false)
+        , m_starting(false)
+        , m_hr(0)
+        , m_ac(NULL)
+    {
+        // RFC 8305 section 4, alternate the families starting with the one getaddrinfo preferred
+        std::vector<exlib::string> first, second;
+        bool v6 = is_ipv6(addrs[0]);
+        size_t i;
+
+        for (i = 0; i < addrs.size(); i++)
+            (is_ipv6(addrs[i]) == v6 ? first : second).push_back(addrs[i]);
+
+        for (i = 0; i < first.size() || i < second.size(); i++) {
+            if (i < first.size())
+                m_addrs.push_back(first[i]);
+            if (i < second.size())
+                m_addrs.push_back(second[i]);
+        }
+    }
+
+public:
+    result_t start(AsyncEvent* ac)
+    {
+        bool bDone;
+
+        m_ac = ac;
+        m_starting = true;
+
+        attempt(0);
+
+        m_lock.lock();
+        m_starting = false;
+        bDone = m_done;
+        m_lock.unlock();
+
+        if (!bDone)
+            return CALL_E_PENDDING;
+
+        return result();
+    }
+
+    void attempt(size_t idx)
+    {
+        exlib::string addr;
+        obj_ptr<DelayTimer> timer, old;
+        obj_ptr<Socket_base> sock;
+        result_t hr;
+
+        m_lock.lock();
+
+        if (m_done || m_next != idx || idx >= m_addrs.size()) {
+            m_lock.unlock();
+            return;
+        }
+
+        addr = m_addrs[m_next++];
+        m_running++;
+
+        old = m_timer;
+        if (m_next < m_addrs.size()) {
+            timer = new DelayTimer(this, m_next);
+            m_timer = timer;
+        } else
+            m_timer.Release();
+
+        m_lock.unlock();
+
+        if (old)
+            old->clear();
+
+        hr = Socket_base::_new(is_ipv6(addr) ? net_base::C_AF_INET6 : net_base::C_AF_INET, sock);
+        if (hr < 0) {
+            failed(NULL, hr);
+            return;
+        }
+
+        m_lock.lock();
+        m_socks.push_back(sock);
+        m_lock.unlock();
+
+        if (timer)
+            timer->sleep();
+
+        (new asyncAttempt(this, sock, addr))->post(0);
+    }
+
+    bool won(Socket_base* sock)
+    {
+        std::vector<obj_ptr<Socket_base>> socks;
+        obj_ptr<DelayTimer> timer;
+        bool bPost;
+
+        m_lock.lock();
+
+        if (m_done) {
+            m_lock.unlock();
+            return false;
+        }
+
+        m_done = true;
+        m_sock = sock;
+        bPost = !m_starting;
+        socks.swap(m_socks);
+        timer = m_timer;
+        m_timer.Release();
+
+        m_lock.unlock();
+
+        if (timer)
+            timer->clear();
+
+        if (bPost)
+            m_ac->post(0);
+
+        for (size_t i = 0; i < socks.size(); i++)
+            if (socks[i] != sock)
+                socks[i]->cc_close();
+
+        return true;
+    }
+
+    void failed(Socket_base* sock, result_t hr)
+    {
+        exlib::string msg;
+        obj_ptr<DelayTimer> timer;
+        bool bNext, bLast;
+        bool bPost = false;
+        size_t idx;
+
+        if (hr == CALL_E_EXCEPTION)
+            msg = Runtime::errMessage();
+
+        m_lock.lock();
+
+        for (size_t i = 0; i < m_socks.size(); i++)
+            if (m_socks[i] == sock) {
+                m_socks.erase(m_socks.begin() + i);
+                break;
+            }
+
+        m_running--;
+
+        if (m_done) {
+            m_lock.unlock();
+            return;
+        }
+
+        m_hr = hr;
+        m_msg = msg;
+
+        idx = m_next;
+        bNext = m_next < m_addrs.size();
+        bLast = !bNext && m_running == 0;
+
+        if (bLast) {
+            m_done = true;
+            bPost = !m_starting;
+            timer = m_timer;
+            m_timer.Release();
+        }
+
+        m_lock.unlock();
+
+        if (bNext)
+            attempt(idx);
+        else if (bLast) {
+            if (timer)
+                timer->clear();
+
+            if (bPost)
+                m_ac->post(result());
+        }
+    }
+
+    result_t result()
+    {
+        if (m_sock)
+            return 0;
+
+        if (m_hr == CALL_E_EXCEPTION)
+            return Runtime::setError(m_msg);
+
+        return m_hr;
+    }
+
+public:
+    int32_t m_port;
+    int32_t m_timeout;
+    obj_ptr<Socket_base> m_sock;
+
+private:
+    exlib::spinlock m_lock;
+    std::vector<exlib::string> m_addrs;
+    size_t m_next;
+    int32_t m_running;
+    bool m_done;
+    bool m_starting;
+    result_t m_hr;
+    exlib::string m_msg;
+    AsyncEvent* m_ac;
+    obj_ptr<DelayTimer> m_timer;
+    std::vector<obj_ptr<Socket_base>> m_socks;
+};
+
+result_t Resolver::connect(exlib::string host, int32_t port, int32_t timeout,
+    obj_ptr<Stream_base>& retVal, AsyncEvent* ac)
+{
+    class asyncConnect : public AsyncState {
+    public:
+        asyncConnect(exlib::string host, int32_t port, int32_t timeout,
+            obj_ptr<Stream_base>& retVal, AsyncEvent* ac)
+            : AsyncState(ac)
+            , m_host(host)
+            , m_port(port)
+            , m_timeout(timeout)
+            , m_retVal(retVal)
+        {
+            next(resolve);
+        }
+
+        ON_STATE(asyncConnect, resolve)
+        {
+            return Resolver::resolve(m_host, m_addrs, next(race));
+        }
+
+        ON_STATE(asyncConnect, race)
+        {
+            if (m_addrs.empty())
+                return CHECK_ERROR(CALL_E_INVALIDARG);
+
+            m_race = new HappyEyeballs(m_addrs, m_port, m_timeout);
+            return m_race->start(next(connected));
+        }
+
+        ON_STATE(asyncConnect, connected)
+        {
+            m_retVal = m_race->m_sock;
+            return next();
+        }
+
+    private:
+        exlib::string m_host;
+        int32_t m_port;
+        int32_t m_timeout;
+        obj_ptr<Stream_base>& m_retVal;
+        std::vector<exlib::string> m_addrs;
+        obj_ptr<HappyEyeballs> m_race;
+    };
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    bool bIPv4, bIPv6;
+
+    net_base::isIPv4(host, bIPv4);
+    net_base::isIPv6(host, bIPv6);
+
+    if (bIPv4 || bIPv6) {
+        obj_ptr<Socket_base> socket;
+
+        result_t hr = Socket_base::_new(bIPv6 ? net_base::C_AF_INET6 : net_base::C_AF_INET, socket);
+        if (hr < 0)
+            return hr;
+
+        retVal = socket;
+        return socket->connect(host, port, timeout, ac);
+    }
+
+    return (new asyncConnect(host, port, timeout, retVal, ac))->post(0);
+}
+
+} /* namespace fibjs */
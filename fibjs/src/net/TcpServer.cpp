@@ -41,6 +41,31 @@ result_t TcpServer_base::_new(exlib::string addr, int32_t port,
     return _new_tcpServer(addr, port, listener, retVal, This);
 }
 
+result_t TcpServer_base::_new(v8::Local<v8::Object> options, Handler_base* listener,
+    obj_ptr<TcpServer_base>& retVal, v8::Local<v8::Object> This)
+{
+    Isolate* isolate = Isolate::current(This);
+    exlib::string addr;
+    int32_t port = 0;
+    int32_t backlog = 1024;
+    bool reusePort = false;
+
+    result_t hr = TcpServer::load_options(isolate, options, addr, port, backlog, reusePort);
+    if (hr < 0)
+        return hr;
+
+    obj_ptr<TcpServer> svr = new TcpServer();
+    svr->wrap(This);
+
+    hr = svr->create(addr, port, listener, backlog, reusePort);
+    if (hr < 0)
+        return hr;
+
+    retVal = svr;
+
+    return 0;
+}
+
 result_t TcpServer_base::_new(exlib::string addr, Handler_base* listener,
     obj_ptr<TcpServer_base>& retVal, v8::Local<v8::Object> This)
 {
@@ -56,8 +81,36 @@ TcpServer::TcpServer()
     m_running = false;
 }
 
+result_t TcpServer::load_options(Isolate* isolate, v8::Local<v8::Object> options,
+    exlib::string& addr, int32_t& port, int32_t& backlog, bool& reusePort)
+{
+    result_t hr;
+
+    hr = GetConfigValue(isolate, options, "address", addr, true);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    hr = GetConfigValue(isolate, options, "port", port, true);
+    if (hr == CALL_E_PARAMNOTOPTIONAL && !addr.empty())
+        port = 0;
+    else if (hr < 0)
+        return hr;
+
+    hr = GetConfigValue(isolate, options, "backlog", backlog, true);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+    if (backlog <= 0)
+        return CHECK_ERROR(Runtime::setError("TcpServer: backlog must be greater than 0."));
+
+    hr = GetConfigValue(isolate, options, "reusePort", reusePort, true);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    return 0;
+}
+
 result_t TcpServer::create(exlib::string addr, int32_t port,
-    Handler_base* listener)
+    Handler_base* listener, int32_t backlog, bool reusePort)
 {
     result_t hr;
     bool ipv4 = false;
@@ -76,11 +129,27 @@ result_t TcpServer::create(exlib::string addr, int32_t port,
     if (hr < 0)
         return hr;
 
+    if (reusePort && (ipv4 || ipv6)) {
+#ifdef SO_REUSEPORT
+        int32_t fd;
+        int32_t on = 1;
+
+        hr = m_socket->get_fd(fd);
+        if (hr < 0)
+            return hr;
+
+        if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, (const char*)&on, sizeof(on)) < 0)
+            return CHECK_ERROR(SocketError());
+#else
+        return CHECK_ERROR(Runtime::setError("TcpServer: reusePort is not supported on this platform."));
+#endif
+    }
+
     hr = m_socket->bind(addr, port, false);
     if (hr < 0)
         return hr;
 
-    hr = m_socket->listen(1024);
+    hr = m_socket->listen(backlog);
     if (hr < 0)
         return hr;
 
@@ -10,6 +10,11 @@
 #include "UVSocket.h"
 #include "Buffer.h"
 
+#ifndef _WIN32
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
 namespace fibjs {
 
 result_t UVSocket::create(int32_t family, obj_ptr<Socket_base>& retVal)
@@ -19,13 +24,14 @@ result_t UVSocket::create(int32_t family, obj_ptr<Socket_base>& retVal)
         && family != net_base::C_AF_UNIX)
         return CHECK_ERROR(CALL_E_INVALIDARG);
 
-    obj_ptr<UVSocket> sock = new UVSocket(family);
+    obj_ptr<UVSocket> sock = new UVSocket(family, uv_select_loop());
 
-    result_t hr = uv_call([&] {
+    result_t hr = uv_call(sock->m_loop, [&] {
         if (family == net_base::C_AF_UNIX)
-            return uv_pipe_init(s_uv_loop, &sock->m_pipe, 0);
+            return uv_pipe_init(sock->m_loop, &sock->m_pipe, 0);
         else
-            return uv_tcp_init(s_uv_loop, &sock->m_tcp);
+            return uv_tcp_init_ex(sock->m_loop, &sock->m_tcp,
+                family == net_base::C_AF_INET6 ? AF_INET6 : AF_INET);
     });
     if (hr < 0)
         return hr;
@@ -141,13 +147,13 @@ result_t UVSocket::bind(int32_t port, bool allowIPv4)
 
 void UVSocket::on_listen(int status)
 {
-    obj_ptr<UVSocket> sock = new UVSocket(m_family);
+    obj_ptr<UVSocket> sock = new UVSocket(m_family, m_loop);
     int32_t ret;
 
     if (sock->m_family == net_base::C_AF_UNIX)
-        uv_pipe_init(s_uv_loop, &sock->m_pipe, 0);
+        uv_pipe_init(m_loop, &sock->m_pipe, 0);
     else
-        uv_tcp_init(s_uv_loop, &sock->m_tcp);
+        uv_tcp_init(m_loop, &sock->m_tcp);
 
     ret = uv_accept(&m_stream, &sock->m_stream);
     if (ret < 0) {
@@ -155,6 +161,44 @@ void UVSocket::on_listen(int status)
         return;
     }
 
+#ifndef _WIN32
+    uv_loop_t* loop = uv_select_loop();
+    uv_os_fd_t fd;
+
+    // hand the connection over to another loop, the accepting handle is closed with sock.
+    if (loop != m_loop && uv_fileno(&sock->m_handle, &fd) == 0 && (fd = fcntl(fd, F_DUPFD_CLOEXEC, 0)) >= 0) {
+        obj_ptr<UVSocket> self = this;
+        obj_ptr<UVSocket> sock1 = new UVSocket(m_family, loop);
+
+        uv_post(loop, [self, sock1, fd] {
+            int32_t ret;
+
+            if (sock1->m_family == net_base::C_AF_UNIX) {
+                uv_pipe_init(sock1->m_loop, &sock1->m_pipe, 0);
+                ret = uv_pipe_open(&sock1->m_pipe, fd);
+            } else {
+                uv_tcp_init(sock1->m_loop, &sock1->m_tcp);
+                ret = uv_tcp_open(&sock1->m_tcp, fd);
+            }
+
+            if (ret < 0) {
+                ::close(fd);
+                puts(uv_strerror(ret));
+                return;
+            }
+
+            self->on_accept(sock1);
+        });
+
+        return;
+    }
+#endif
+
+    on_accept(sock);
+}
+
+void UVSocket::on_accept(UVSocket* sock)
+{
     m_lock.lock();
 
     if (m_accepts.size() > 0) {
@@ -179,7 +223,7 @@ void UVSocket::on_listen(uv_stream_t* server, int status)
 
 result_t UVSocket::listen(int32_t backlog)
 {
-    return uv_call([&] {
+    return uv_call(m_loop, [&] {
         return uv_listen(&m_stream, backlog, on_listen);
     });
 }
@@ -211,7 +255,7 @@ result_t UVSocket::connect(exlib::string host, int32_t port, int32_t timeout, As
         return CHECK_ERROR(CALL_E_NOSYNC);
 
     if (m_family == net_base::C_AF_UNIX) {
-        return uv_async([&] {
+        return uv_async(m_loop, [&] {
             uv_pipe_connect(new AsyncConnect(this, timeout, ac), &m_pipe, host.c_str(), AsyncConnect::callback);
             return 0;
         });
@@ -230,7 +274,7 @@ result_t UVSocket::connect(exlib::string host, int32_t port, int32_t timeout, As
                 return CHECK_ERROR(CALL_E_INVALIDARG);
         }
 
-        return uv_async([&] {
+        return uv_async(m_loop, [&] {
             return uv_tcp_connect(new AsyncConnect(this, timeout, ac), &m_tcp, (sockaddr*)&addr_info, AsyncConnect::callback);
         });
     }
@@ -270,7 +314,7 @@ result_t UVSocket::recv(int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent*
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_NOSYNC);
 
-    uv_post(new AsyncRead(this, false, bytes, retVal, ac));
+    uv_post(m_loop, new AsyncRead(this, false, bytes, retVal, ac));
     return CALL_E_PENDDING;
 }
 }
@@ -15,6 +15,8 @@
 #include "Url.h"
 #include "options.h"
 #include "AsyncUV.h"
+#include "Resolver.h"
+#include <vector>
 
 #ifndef INET6_ADDRSTRLEN
 #define INET6_ADDRSTRLEN 46
@@ -24,114 +26,111 @@ namespace fibjs {
 
 DECLARE_MODULE(dns);
 
-result_t dns_base::resolve(exlib::string name, obj_ptr<NArray>& retVal, AsyncEvent* ac)
+result_t dns_base::get_ttl(int32_t& retVal)
 {
-    class resolve_data : public uv_getaddrinfo_t {
-    public:
-        resolve_data(obj_ptr<NArray>& retVal, AsyncEvent* ac)
-            : _retVal(retVal)
-            , _ac(ac)
-        {
-        }
-
-    public:
-        obj_ptr<NArray>& _retVal;
-        AsyncEvent* _ac;
-    };
-
-    if (ac->isSync())
-        return CHECK_ERROR(CALL_E_NOSYNC);
-
-    addrinfo hints = { 0, AF_UNSPEC, SOCK_STREAM, IPPROTO_TCP, 0, 0, 0, 0 };
+    retVal = Resolver::s_ttl;
+    return 0;
+}
 
-    resolve_data* resolver = new resolve_data(retVal, ac);
-    int r = uv_getaddrinfo(
-        s_uv_loop, resolver,
-        [](uv_getaddrinfo_t* _resolver, int status, struct addrinfo* res) {
-            resolve_data* resolver = (resolve_data*)_resolver;
+result_t dns_base::set_ttl(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
 
-            if (status < 0) {
-                uv_freeaddrinfo(res);
-                delete resolver;
+    Resolver::s_ttl = newVal;
+    return 0;
+}
 
-                resolver->_ac->post(status);
-                return;
-            }
+result_t dns_base::get_negativeTtl(int32_t& retVal)
+{
+    retVal = Resolver::s_negative_ttl;
+    return 0;
+}
 
-            obj_ptr<NArray> arr = new NArray();
-            for (struct addrinfo* ptr = res; ptr != NULL; ptr = ptr->ai_next) {
-                inetAddr addr_info;
-                addr_info.init(ptr->ai_addr);
-                arr->append(addr_info.str());
-            }
-
-            resolver->_retVal = arr;
-            resolver->_ac->post(0);
-
-            uv_freeaddrinfo(res);
-            delete resolver;
-        },
-        name.c_str(), NULL, &hints);
-
-    if (r < 0) {
-        delete resolver;
-        return CHECK_ERROR(r);
-    }
+result_t dns_base::set_negativeTtl(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
 
-    return CALL_E_PENDDING;
+    Resolver::s_negative_ttl = newVal;
+    return 0;
 }
 
-result_t dns_base::lookup(exlib::string name, exlib::string& retVal, AsyncEvent* ac)
+result_t dns_base::resolve(exlib::string name, obj_ptr<NArray>& retVal, AsyncEvent* ac)
 {
-    class resolve_data : public uv_getaddrinfo_t {
+    class asyncResolve : public AsyncState {
     public:
-        resolve_data(exlib::string& retVal, AsyncEvent* ac)
-            : _retVal(retVal)
-            , _ac(ac)
+        asyncResolve(exlib::string name, obj_ptr<NArray>& retVal, AsyncEvent* ac)
+            : AsyncState(ac)
+            , m_name(name)
+            , m_retVal(retVal)
         {
+            next(resolve);
         }
 
-    public:
-        exlib::string& _retVal;
-        AsyncEvent* _ac;
+        ON_STATE(asyncResolve, resolve)
+        {
+            return Resolver::resolve(m_name, m_addrs, next(ready));
+        }
+
+        ON_STATE(asyncResolve, ready)
+        {
+            obj_ptr<NArray> arr = new NArray();
+            for (size_t i = 0; i < m_addrs.size(); i++)
+                arr->append(m_addrs[i]);
+
+            m_retVal = arr;
+            return next();
+        }
+
+    private:
+        exlib::string m_name;
+        obj_ptr<NArray>& m_retVal;
+        std::vector<exlib::string> m_addrs;
     };
 
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_NOSYNC);
 
-    addrinfo hints = { 0, AF_UNSPEC, SOCK_STREAM, IPPROTO_TCP, 0, 0, 0, 0 };
-
-    resolve_data* resolver = new resolve_data(retVal, ac);
-    int r = uv_getaddrinfo(
-        s_uv_loop, resolver,
-        [](uv_getaddrinfo_t* _resolver, int status, struct addrinfo* res) {
-            resolve_data* resolver = (resolve_data*)_resolver;
+    return (new asyncResolve(name, retVal, ac))->post(0);
+}
 
-            if (status < 0) {
-                uv_freeaddrinfo(res);
-                delete resolver;
+result_t dns_base::lookup(exlib::string name, exlib::string& retVal, AsyncEvent* ac)
+{
+    class asyncLookup : public AsyncState {
+    public:
+        asyncLookup(exlib::string name, exlib::string& retVal, AsyncEvent* ac)
+            : AsyncState(ac)
+            , m_name(name)
+            , m_retVal(retVal)
+        {
+            next(resolve);
+        }
 
-                resolver->_ac->post(status);
-                return;
-            }
+        ON_STATE(asyncLookup, resolve)
+        {
+            return Resolver::resolve(m_name, m_addrs, next(ready));
+        }
 
-            inetAddr addr_info;
-            addr_info.init(res->ai_addr);
+        ON_STATE(asyncLookup, ready)
+        {
+            if (m_addrs.empty())
+                return CHECK_ERROR(CALL_E_INVALIDARG);
 
-            resolver->_retVal = addr_info.str();
-            resolver->_ac->post(0);
+            m_retVal = m_addrs[0];
+            return next();
+        }
 
-            uv_freeaddrinfo(res);
-            delete resolver;
-        },
-        name.c_str(), NULL, &hints);
+    private:
+        exlib::string m_name;
+        exlib::string& m_retVal;
+        std::vector<exlib::string> m_addrs;
+    };
 
-    if (r < 0) {
-        delete resolver;
-        return CHECK_ERROR(r);
-    }
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
 
-    return CALL_E_PENDDING;
+    return (new asyncLookup(name, retVal, ac))->post(0);
 }
 
 DECLARE_MODULE(net);
@@ -148,81 +147,128 @@ result_t net_base::set_use_uv_socket(bool newVal)
     return 0;
 }
 
+result_t net_base::get_uv_loops(int32_t& retVal)
+{
+    retVal = uv_loop_count();
+    return 0;
+}
+
+result_t net_base::set_uv_loops(int32_t newVal)
+{
+    return uv_set_loop_count(newVal);
+}
+
 result_t net_base::info(v8::Local<v8::Object>& retVal)
 {
     return os_base::networkInterfaces(retVal);
 }
 
+result_t net_base::stats(v8::Local<v8::Object>& retVal)
+{
+    std::vector<std::pair<int32_t, uint32_t>> counts;
+    uv_loop_t* uv_loop;
+
+    // loops dropped by a smaller uv_loops keep serving their sockets, report them too.
+    // active_handles belongs to the loop thread, read it there.
+    for (int32_t i = 0; (uv_loop = uv_get_loop(i)) != NULL; i++) {
+        uint32_t handles = 0;
+
+        uv_call(uv_loop, [&] {
+            handles = uv_loop->active_handles;
+            return 0;
+        });
+
+        counts.push_back(std::make_pair(uv_loop_pending(i), handles));
+    }
+
+    Isolate* isolate = Isolate::current();
+    v8::Local<v8::Context> context = isolate->context();
+    v8::Local<v8::Object> info = v8::Object::New(isolate->m_isolate);
+    v8::Local<v8::Array> loops = v8::Array::New(isolate->m_isolate);
+
+    for (int32_t i = 0; i < (int32_t)counts.size(); i++) {
+        v8::Local<v8::Object> loop = v8::Object::New(isolate->m_isolate);
+
+        loop->Set(context, isolate->NewString("pending"),
+                v8::Number::New(isolate->m_isolate, counts[i].first))
+            .IsJust();
+        loop->Set(context, isolate->NewString("handles"),
+                v8::Number::New(isolate->m_isolate, counts[i].second))
+            .IsJust();
+
+        loops->Set(context, i, loop).IsJust();
+    }
+
+    info->Set(context, isolate->NewString("loops"), loops).IsJust();
+
+    Resolver::Stats st;
+    v8::Local<v8::Object> dns = v8::Object::New(isolate->m_isolate);
+
+    Resolver::stats(st);
+
+    dns->Set(context, isolate->NewString("hits"), v8::Number::New(isolate->m_isolate, (double)st.m_hits)).IsJust();
+    dns->Set(context, isolate->NewString("misses"), v8::Number::New(isolate->m_isolate, (double)st.m_misses)).IsJust();
+    dns->Set(context, isolate->NewString("stale"), v8::Number::New(isolate->m_isolate, (double)st.m_stale)).IsJust();
+    dns->Set(context, isolate->NewString("negative"), v8::Number::New(isolate->m_isolate, (double)st.m_negative)).IsJust();
+    dns->Set(context, isolate->NewString("entries"), v8::Number::New(isolate->m_isolate, (double)st.m_entries)).IsJust();
+
+    info->Set(context, isolate->NewString("dns"), dns).IsJust();
+
+    retVal = info;
+
+    return 0;
+}
+
 result_t net_base::resolve(exlib::string name, int32_t family,
     exlib::string& retVal, AsyncEvent* ac)
 {
     if (family != net_base::C_AF_INET && family != net_base::C_AF_INET6)
         return CHECK_ERROR(CALL_E_INVALIDARG);
 
-    class resolve_data : public uv_getaddrinfo_t {
+    class asyncResolve : public AsyncState {
     public:
-        resolve_data(int32_t family, exlib::string& retVal, AsyncEvent* ac)
-            : _family(family)
-            , _retVal(retVal)
-            , _ac(ac)
+        asyncResolve(exlib::string name, int32_t family, exlib::string& retVal, AsyncEvent* ac)
+            : AsyncState(ac)
+            , m_name(name)
+            , m_family(family)
+            , m_retVal(retVal)
         {
+            next(resolve);
         }
 
-    public:
-        int32_t _family;
-        exlib::string& _retVal;
-        AsyncEvent* _ac;
-    };
+        ON_STATE(asyncResolve, resolve)
+        {
+            return Resolver::resolve(m_name, m_addrs, next(ready));
+        }
 
-    if (ac->isSync())
-        return CHECK_ERROR(CALL_E_NOSYNC);
+        ON_STATE(asyncResolve, ready)
+        {
+            bool bIPv6 = m_family == net_base::C_AF_INET6;
 
-    addrinfo hints = { 0, AF_UNSPEC, SOCK_STREAM, IPPROTO_TCP, 0, 0, 0, 0 };
-
-    resolve_data* resolver = new resolve_data(family, retVal, ac);
-    int r = uv_getaddrinfo(
-        s_uv_loop, resolver,
-        [](uv_getaddrinfo_t* _resolver, int status, struct addrinfo* res) {
-            resolve_data* resolver = (resolve_data*)_resolver;
-
-            if (status < 0) {
-                uv_freeaddrinfo(res);
-                delete resolver;
-
-                resolver->_ac->post(status);
-                return;
-            }
-
-            struct addrinfo* ptr = NULL;
-            for (ptr = res; ptr != NULL; ptr = ptr->ai_next) {
-                if (ptr->ai_family == resolver->_family) {
-                    inetAddr addr_info;
-                    addr_info.init(ptr->ai_addr);
-                    resolver->_retVal = addr_info.str();
-                    break;
+            for (size_t i = 0; i < m_addrs.size(); i++)
+                if ((m_addrs[i].find(':') != exlib::string::npos) == bIPv6) {
+                    m_retVal = m_addrs[i];
+                    return next();
                 }
-            }
 
-            if (ptr == NULL) {
 #ifdef _WIN32
-                resolver->_ac->post(-WSAHOST_NOT_FOUND);
+            return -WSAHOST_NOT_FOUND;
 #else
-                resolver->_ac->post(-ETIME);
+            return -ETIME;
 #endif
-            } else
-                resolver->_ac->post(0);
+        }
 
-            uv_freeaddrinfo(res);
-            delete resolver;
-        },
-        name.c_str(), NULL, &hints);
+    private:
+        exlib::string m_name;
+        int32_t m_family;
+        exlib::string& m_retVal;
+        std::vector<exlib::string> m_addrs;
+    };
 
-    if (r < 0) {
-        delete resolver;
-        return CHECK_ERROR(r);
-    }
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
 
-    return CALL_E_PENDDING;
+    return (new asyncResolve(name, family, retVal, ac))->post(0);
 }
 
 result_t net_base::ip(exlib::string name, exlib::string& retVal,
@@ -260,16 +306,8 @@ result_t net_base::connect(exlib::string url, int32_t timeout, obj_ptr<Stream_ba
             return CHECK_ERROR(CALL_E_INVALIDARG);
 
         int32_t nPort = atoi(u->m_port.c_str());
-        int32_t family = u->m_ipv6 ? net_base::C_AF_INET6 : net_base::C_AF_INET;
 
-        obj_ptr<Socket_base> socket;
-
-        hr = Socket_base::_new(family, socket);
-        if (hr < 0)
-            return hr;
-
-        retVal = socket;
-        return socket->connect(u->m_hostname, nPort, timeout, ac);
+        return Resolver::connect(u->m_hostname, nPort, timeout, retVal, ac);
     } else {
         obj_ptr<Socket_base> socket;
 
@@ -9,6 +9,7 @@
 #include "ifs/crypto.h"
 #include "SecureContext.h"
 #include "X509Certificate.h"
+#include "TLSSocket.h"
 
 namespace fibjs {
 
@@ -78,6 +79,8 @@ void SecureContext::init_ctx(const SSL_METHOD* method)
 
     SSL_CTX_set_session_cache_mode(m_ctx,
         SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_NO_INTERNAL | SSL_SESS_CACHE_NO_AUTO_CLEAR);
+
+    SSL_CTX_set_alpn_select_cb(m_ctx, TLSSocket::select_alpn, nullptr);
 }
 
 result_t SecureContext::set_ca(v8::Local<v8::Object> options, bool isServer)
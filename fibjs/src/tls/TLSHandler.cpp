@@ -45,6 +45,15 @@ result_t TLSHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
             m_socket = new TLSSocket();
             m_socket->init(m_pThis->m_ctx);
 
+            std::vector<exlib::string> alpn;
+
+            m_pThis->m_lock.lock();
+            alpn = m_pThis->m_alpn;
+            m_pThis->m_lock.unlock();
+
+            if (!alpn.empty())
+                m_socket->set_alpn(alpn);
+
             next(accept);
         }
 
@@ -42,29 +42,39 @@ result_t TLSServer_base::_new(v8::Local<v8::Object> options, Handler_base* liste
 
     Isolate* isolate = Isolate::current(This);
     exlib::string address;
-    hr = GetConfigValue(isolate, options, "address", address, true);
-    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+    int32_t port = 0;
+    int32_t backlog = 1024;
+    bool reusePort = false;
+
+    hr = TcpServer::load_options(isolate, options, address, port, backlog, reusePort);
+    if (hr < 0)
         return hr;
 
-    int32_t port;
-    hr = GetConfigValue(isolate, options, "port", port, true);
+    obj_ptr<TLSServer> svr = new TLSServer();
+    svr->wrap(This);
+
+    hr = svr->create(ctx, address, port, listener, backlog, reusePort);
     if (hr < 0)
         return hr;
 
-    return _new(ctx, address, port, listener, retVal, This);
+    retVal = svr;
+
+    return 0;
 }
 
-result_t TLSServer::create(SecureContext_base* context, exlib::string addr, int32_t port, Handler_base* listener)
+result_t TLSServer::create(SecureContext_base* context, exlib::string addr, int32_t port, Handler_base* listener,
+    int32_t backlog, bool reusePort)
 {
     result_t hr;
-    obj_ptr<TcpServer_base> _server;
+    obj_ptr<TcpServer> _server;
     obj_ptr<TLSHandler_base> _handler;
 
     hr = TLSHandler_base::_new(context, listener, _handler);
     if (hr < 0)
         return hr;
 
-    hr = TcpServer_base::_new(addr, port, _handler, _server);
+    _server = new TcpServer();
+    hr = _server->create(addr, port, _handler, backlog, reusePort);
     if (hr < 0)
         return hr;
 
@@ -99,6 +99,42 @@ result_t TLSSocket::init(SecureContext_base* context)
     return 0;
 }
 
+result_t TLSSocket::set_alpn(const std::vector<exlib::string>& protocols)
+{
+    exlib::string wire;
+
+    for (const exlib::string& p : protocols) {
+        if (p.empty() || p.length() > 255)
+            return CHECK_ERROR(Runtime::setError("TLSSocket: invalid ALPN protocol."));
+
+        wire.append(1, (char)p.length());
+        wire.append(p);
+    }
+
+    m_alpn = wire;
+
+    if (SSL_set_alpn_protos(m_tls, (const unsigned char*)wire.c_str(), (unsigned int)wire.length()))
+        return CHECK_ERROR(Runtime::setError("TLSSocket: failed to set ALPN protocols."));
+
+    return 0;
+}
+
+int TLSSocket::select_alpn(SSL* ssl, const unsigned char** out, unsigned char* outlen,
+    const unsigned char* in, unsigned int inlen, void* arg)
+{
+    TLSSocket* sock = FromBIO(SSL_get_rbio(ssl));
+    if (!sock || sock->m_alpn.empty())
+        return SSL_TLSEXT_ERR_NOACK;
+
+    // the first protocol of ours the client also offers wins
+    if (SSL_select_next_proto((unsigned char**)out, outlen, (const unsigned char*)sock->m_alpn.c_str(),
+            (unsigned int)sock->m_alpn.length(), in, inlen)
+        != OPENSSL_NPN_NEGOTIATED)
+        return SSL_TLSEXT_ERR_NOACK;
+
+    return SSL_TLSEXT_ERR_OK;
+}
+
 class AsyncHandshake : public AsyncState {
 public:
     AsyncHandshake(TLSSocket* sock, Stream_base* socket, bool is_server, exlib::string server_name, AsyncEvent* ac)
@@ -221,6 +257,20 @@ result_t TLSSocket::getProtocol(exlib::string& retVal)
     return 0;
 }
 
+result_t TLSSocket::getALPNProtocol(exlib::string& retVal)
+{
+    const unsigned char* data = nullptr;
+    unsigned int len = 0;
+
+    SSL_get0_alpn_selected(m_tls, &data, &len);
+    if (data == nullptr || len == 0)
+        return CALL_RETURN_UNDEFINED;
+
+    retVal.assign((const char*)data, len);
+
+    return 0;
+}
+
 result_t TLSSocket::getX509Certificate(obj_ptr<X509Certificate_base>& retVal)
 {
     if (!m_cert) {
@@ -10,6 +10,7 @@
 #include "ifs/crypto.h"
 #include "ifs/Socket.h"
 #include "TLSSocket.h"
+#include "Resolver.h"
 #include "Url.h"
 #include "options.h"
 #include "openssl/provider.h"
@@ -41,12 +42,11 @@ result_t tls_base::connect(exlib::string url, SecureContext_base* secureContext,
 {
     class asyncConnect : public AsyncState {
     public:
-        asyncConnect(const exlib::string host, int32_t port, bool ipv6, SecureContext_base* ctx,
+        asyncConnect(const exlib::string host, int32_t port, SecureContext_base* ctx,
             int32_t timeout, obj_ptr<Stream_base>& retVal, AsyncEvent* ac)
             : AsyncState(ac)
             , m_host(host)
             , m_port(port)
-            , m_ipv6(ipv6)
             , m_ctx(ctx)
             , m_timeout(timeout)
             , m_retVal(retVal)
@@ -56,8 +56,7 @@ result_t tls_base::connect(exlib::string url, SecureContext_base* secureContext,
 
         ON_STATE(asyncConnect, connect)
         {
-            Socket_base::_new(m_ipv6 ? net_base::C_AF_INET6 : net_base::C_AF_INET, m_sock);
-            return m_sock->connect(m_host, m_port, m_timeout, next(handshake));
+            return Resolver::connect(m_host, m_port, m_timeout, m_sock, next(handshake));
         }
 
         ON_STATE(asyncConnect, handshake)
@@ -76,11 +75,10 @@ result_t tls_base::connect(exlib::string url, SecureContext_base* secureContext,
     private:
         const exlib::string m_host;
         int32_t m_port;
-        bool m_ipv6;
         obj_ptr<SecureContext_base> m_ctx;
         int32_t m_timeout;
         obj_ptr<Stream_base>& m_retVal;
-        obj_ptr<Socket_base> m_sock;
+        obj_ptr<Stream_base> m_sock;
         obj_ptr<TLSSocket> m_ssl_sock;
     };
 
@@ -101,7 +99,7 @@ result_t tls_base::connect(exlib::string url, SecureContext_base* secureContext,
 
     int32_t nPort = atoi(u->m_port.c_str());
 
-    return (new asyncConnect(u->m_hostname, nPort, u->m_ipv6, secureContext, timeout, retVal, ac))
+    return (new asyncConnect(u->m_hostname, nPort, secureContext, timeout, retVal, ac))
         ->post(0);
 }
 
@@ -21,6 +21,12 @@
 #include <unicode/uchar.h>
 #include <unicode/uvernum.h>
 #include <msgpack/version.hpp>
+#ifdef HAVE_BROTLI
+#include <brotli/encode.h>
+#endif
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
 #include "addons/node_api/node_version.h"
 
 #ifdef Linux
@@ -105,6 +111,11 @@ public:
         {
             char str[64];
 
+#ifdef HAVE_BROTLI
+            uint32_t bv = BrotliEncoderVersion();
+            snprintf(str, sizeof(str), "%d.%d.%d", bv >> 24, (bv >> 12) & 0xfff, bv & 0xfff);
+            g_vender->add("brotli", str);
+#endif
             g_vender->add("ev", STR(EV_VERSION_MAJOR) "." STR(EV_VERSION_MINOR));
             g_vender->add("expat", STR(XML_MAJOR_VERSION) "." STR(XML_MINOR_VERSION) "." STR(XML_MICRO_VERSION));
             g_vender->add("gumbo", "0.10.0");
@@ -131,6 +142,9 @@ public:
             g_vender->add("v8-snapshot", (bool)v8::internal::Snapshot::DefaultSnapshotBlob());
 
             g_vender->add("zlib", ZLIB_VERSION);
+#ifdef HAVE_ZSTD
+            g_vender->add("zstd", ZSTD_VERSION_STRING);
+#endif
         }
     }
 
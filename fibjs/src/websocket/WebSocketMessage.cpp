@@ -157,10 +157,16 @@ result_t WebSocketMessage::copy(Stream_base* from, Stream_base* to, int64_t byte
                 int32_t i, n;
                 uint8_t* mask = (uint8_t*)&m_mask;
 
+                // the data read may share memory with the source stream, mask into a new buffer
                 n = (int32_t)buf->length();
-                uint8_t* _strBuffer = buf->data();
+                obj_ptr<Buffer> out = new Buffer(NULL, n);
+                const uint8_t* _srcBuffer = buf->data();
+                uint8_t* _strBuffer = out->data();
                 for (i = 0; i < n; i++)
-                    _strBuffer[i] ^= mask[(m_copyed + i) & 3];
+                    _strBuffer[i] = _srcBuffer[i] ^ mask[(m_copyed + i) & 3];
+
+                m_buf = out;
+                buf = out;
             }
 
             blen = buf->length();
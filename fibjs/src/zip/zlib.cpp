@@ -191,4 +191,268 @@ result_t zlib_base::inflateRawTo(Stream_base* src, Stream_base* stm, int32_t max
 
     return (new infraw(stm, maxSize))->process(src, ac);
 }
+
+#ifdef HAVE_BROTLI
+
+result_t zlib_base::createBrotliCompress(Stream_base* to, obj_ptr<Stream_base>& retVal)
+{
+    retVal = new brotli_enc(to);
+    return 0;
+}
+
+result_t zlib_base::createBrotliDecompress(Stream_base* to, int32_t maxSize, obj_ptr<Stream_base>& retVal)
+{
+    retVal = new brotli_dec(to, maxSize);
+    return 0;
+}
+
+result_t zlib_base::brotliCompress(Buffer_base* data, int32_t level, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new brotli_enc(NULL, level))->process(data, retVal, ac);
+}
+
+result_t zlib_base::brotliCompressTo(Buffer_base* data, Stream_base* stm, int32_t level, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new brotli_enc(stm, level))->process(data, ac);
+}
+
+result_t zlib_base::brotliCompressTo(Stream_base* src, Stream_base* stm, int32_t level, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new brotli_enc(stm, level))->process(src, ac);
+}
+
+result_t zlib_base::brotliDecompress(Buffer_base* data, int32_t maxSize, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new brotli_dec(NULL, maxSize))->process(data, retVal, ac);
+}
+
+result_t zlib_base::brotliDecompressTo(Buffer_base* data, Stream_base* stm, int32_t maxSize, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new brotli_dec(stm, maxSize))->process(data, ac);
+}
+
+result_t zlib_base::brotliDecompressTo(Stream_base* src, Stream_base* stm, int32_t maxSize, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new brotli_dec(stm, maxSize))->process(src, ac);
+}
+
+#else
+
+#define NO_BROTLI CHECK_ERROR(Runtime::setError("zlib: brotli is not available in this build."))
+
+result_t zlib_base::createBrotliCompress(Stream_base* to, obj_ptr<Stream_base>& retVal)
+{
+    return NO_BROTLI;
+}
+
+result_t zlib_base::createBrotliDecompress(Stream_base* to, int32_t maxSize, obj_ptr<Stream_base>& retVal)
+{
+    return NO_BROTLI;
+}
+
+result_t zlib_base::brotliCompress(Buffer_base* data, int32_t level, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
+{
+    return NO_BROTLI;
+}
+
+result_t zlib_base::brotliCompressTo(Buffer_base* data, Stream_base* stm, int32_t level, AsyncEvent* ac)
+{
+    return NO_BROTLI;
+}
+
+result_t zlib_base::brotliCompressTo(Stream_base* src, Stream_base* stm, int32_t level, AsyncEvent* ac)
+{
+    return NO_BROTLI;
+}
+
+result_t zlib_base::brotliDecompress(Buffer_base* data, int32_t maxSize, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
+{
+    return NO_BROTLI;
+}
+
+result_t zlib_base::brotliDecompressTo(Buffer_base* data, Stream_base* stm, int32_t maxSize, AsyncEvent* ac)
+{
+    return NO_BROTLI;
+}
+
+result_t zlib_base::brotliDecompressTo(Stream_base* src, Stream_base* stm, int32_t maxSize, AsyncEvent* ac)
+{
+    return NO_BROTLI;
+}
+
+#endif
+
+#ifdef HAVE_ZSTD
+
+result_t zlib_base::createZstdCompress(Stream_base* to, obj_ptr<Stream_base>& retVal)
+{
+    retVal = new zstd_enc(to);
+    return 0;
+}
+
+result_t zlib_base::createZstdCompress(Stream_base* to, Buffer_base* dict, obj_ptr<Stream_base>& retVal)
+{
+    retVal = new zstd_enc(to, -1, dict);
+    return 0;
+}
+
+result_t zlib_base::createZstdDecompress(Stream_base* to, int32_t maxSize, obj_ptr<Stream_base>& retVal)
+{
+    retVal = new zstd_dec(to, maxSize);
+    return 0;
+}
+
+result_t zlib_base::createZstdDecompress(Stream_base* to, Buffer_base* dict, int32_t maxSize, obj_ptr<Stream_base>& retVal)
+{
+    retVal = new zstd_dec(to, maxSize, dict);
+    return 0;
+}
+
+result_t zlib_base::zstdCompress(Buffer_base* data, int32_t level, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new zstd_enc(NULL, level))->process(data, retVal, ac);
+}
+
+result_t zlib_base::zstdCompress(Buffer_base* data, Buffer_base* dict, int32_t level, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new zstd_enc(NULL, level, dict))->process(data, retVal, ac);
+}
+
+result_t zlib_base::zstdCompressTo(Buffer_base* data, Stream_base* stm, int32_t level, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new zstd_enc(stm, level))->process(data, ac);
+}
+
+result_t zlib_base::zstdCompressTo(Stream_base* src, Stream_base* stm, int32_t level, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new zstd_enc(stm, level))->process(src, ac);
+}
+
+result_t zlib_base::zstdDecompress(Buffer_base* data, int32_t maxSize, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new zstd_dec(NULL, maxSize))->process(data, retVal, ac);
+}
+
+result_t zlib_base::zstdDecompress(Buffer_base* data, Buffer_base* dict, int32_t maxSize, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new zstd_dec(NULL, maxSize, dict))->process(data, retVal, ac);
+}
+
+result_t zlib_base::zstdDecompressTo(Buffer_base* data, Stream_base* stm, int32_t maxSize, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new zstd_dec(stm, maxSize))->process(data, ac);
+}
+
+result_t zlib_base::zstdDecompressTo(Stream_base* src, Stream_base* stm, int32_t maxSize, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new zstd_dec(stm, maxSize))->process(src, ac);
+}
+
+#else
+
+#define NO_ZSTD CHECK_ERROR(Runtime::setError("zlib: zstd is not available in this build."))
+
+result_t zlib_base::createZstdCompress(Stream_base* to, obj_ptr<Stream_base>& retVal)
+{
+    return NO_ZSTD;
+}
+
+result_t zlib_base::createZstdCompress(Stream_base* to, Buffer_base* dict, obj_ptr<Stream_base>& retVal)
+{
+    return NO_ZSTD;
+}
+
+result_t zlib_base::createZstdDecompress(Stream_base* to, int32_t maxSize, obj_ptr<Stream_base>& retVal)
+{
+    return NO_ZSTD;
+}
+
+result_t zlib_base::createZstdDecompress(Stream_base* to, Buffer_base* dict, int32_t maxSize, obj_ptr<Stream_base>& retVal)
+{
+    return NO_ZSTD;
+}
+
+result_t zlib_base::zstdCompress(Buffer_base* data, int32_t level, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
+{
+    return NO_ZSTD;
+}
+
+result_t zlib_base::zstdCompress(Buffer_base* data, Buffer_base* dict, int32_t level, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
+{
+    return NO_ZSTD;
+}
+
+result_t zlib_base::zstdCompressTo(Buffer_base* data, Stream_base* stm, int32_t level, AsyncEvent* ac)
+{
+    return NO_ZSTD;
+}
+
+result_t zlib_base::zstdCompressTo(Stream_base* src, Stream_base* stm, int32_t level, AsyncEvent* ac)
+{
+    return NO_ZSTD;
+}
+
+result_t zlib_base::zstdDecompress(Buffer_base* data, int32_t maxSize, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
+{
+    return NO_ZSTD;
+}
+
+result_t zlib_base::zstdDecompress(Buffer_base* data, Buffer_base* dict, int32_t maxSize, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
+{
+    return NO_ZSTD;
+}
+
+result_t zlib_base::zstdDecompressTo(Buffer_base* data, Stream_base* stm, int32_t maxSize, AsyncEvent* ac)
+{
+    return NO_ZSTD;
+}
+
+result_t zlib_base::zstdDecompressTo(Stream_base* src, Stream_base* stm, int32_t maxSize, AsyncEvent* ac)
+{
+    return NO_ZSTD;
+}
+
+#endif
 }
@@ -80,6 +80,21 @@ declare class Class_DgramSocket extends Class_EventEmitter {
 
     send(msg: Class_Buffer, offset: number, length: number, port: number, address?: string, callback?: (err: Error | undefined | null, retVal: number)=>any): void;
 
+    /**
+     * @description 在 socket 上向同一目的地址批量发送一组数据包
+     * 
+     *      在 Linux 上使用 sendmmsg 一次系统调用发送多个数据包。创建 socket 时指定 gso 为 true 时，
+     *      连续的等长数据包会合并为一次 UDP GSO 发送，由内核或网卡重新切分，内核不支持时自动关闭。
+     *      @param msgs 指定发送的数据包数组
+     *      @param port 指定发送的目的端口
+     *      @param address 指定发送的目的地址
+     *      @return 返回发送的总尺寸
+     *     
+     */
+    sendBatch(msgs: any[], port: number, address?: string): number;
+
+    sendBatch(msgs: any[], port: number, address?: string, callback?: (err: Error | undefined | null, retVal: number)=>any): void;
+
     /**
      * @description 返回一个包含 socket 地址信息的对象。对于 UDP socket，该对象将包含 address、family 和 port 属性。 
      *      @return 返回对象绑定地址
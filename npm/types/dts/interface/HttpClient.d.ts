@@ -71,8 +71,11 @@ declare class Class_HttpClient extends Class_object {
      *      - maxHeaderSize: 指定最大请求头长度
      *      - maxBodySize: 指定 body 最大尺寸
      *      - userAgent: 指定浏览器标识
-     *      - poolSize: 指定 keep-alive 最大缓存连接数
+     *      - poolSize: 指定每个主机保留的 keep-alive 空闲连接数
      *      - poolTimeout: 指定 keep-alive 缓存连接超时时间
+     *      - maxConnsPerHost: 指定每个主机的最大连接数
+     *      - pipelining: 指定每个连接上同时发送的请求数
+     *      - enableHttp2: 指定是否通过 ALPN 协商使用 HTTP/2
      *      - http_proxy: 指定 http 代理地址
      *      - https_Proxy: 指定 https 代理地址
      * 
@@ -127,7 +130,7 @@ declare class Class_HttpClient extends Class_object {
     userAgent: string;
 
     /**
-     * @description 查询和设置 keep-alive 最大缓存连接数，缺省 128 
+     * @description 查询和设置每个主机保留的 keep-alive 空闲连接数，缺省 128 
      */
     poolSize: number;
 
@@ -136,6 +139,30 @@ declare class Class_HttpClient extends Class_object {
      */
     poolTimeout: number;
 
+    /**
+     * @description 查询和设置每个主机的最大连接数，缺省为 0，不限制
+     * 
+     *      连接数达到上限后，新的请求将按照到达的顺序排队，等待已有连接空闲或者关闭
+     *      
+     */
+    maxConnsPerHost: number;
+
+    /**
+     * @description 查询和设置每个连接上同时发送的请求数，缺省为 1，不启用 http 管线
+     * 
+     *      大于 1 时，没有 body 的 GET 和 HEAD 请求可以在尚未返回的连接上继续发送，响应按照发送的顺序读取。连接中途断开时，管线中的请求将重新发送
+     *      
+     */
+    pipelining: number;
+
+    /**
+     * @description 查询和设置是否启用 HTTP/2，缺省为 false
+     * 
+     *      启用后，https 请求在 tls 握手时通过 ALPN 协商 h2，服务器支持时同一主机的请求复用一个连接，以多路流的方式并发发送，不受 maxConnsPerHost 和 pipelining 限制。服务器不支持 h2 时自动回退到 HTTP/1.1。使用 https 代理时不启用 HTTP/2
+     *      
+     */
+    enableHttp2: boolean;
+
     /**
      * @description 查询和设置 http 请求代理，支持 http/https/socks5 代理 
      */
@@ -440,5 +467,12 @@ declare class Class_HttpClient extends Class_object {
 
     head(url: string, opts?: FIBJS.GeneralObject, callback?: (err: Error | undefined | null, retVal: Class_HttpResponse)=>any): void;
 
+    /**
+     * @description 查询连接池的运行统计
+     *      @return 返回统计信息，包括空闲连接数 idle，使用中的连接数 active，排队等待的请求数 waiters，请求总数 requests，复用连接的请求数 reused，管线发送的请求数 pipelined，新建连接数 connects，连接复用率 reuseRatio 以及平均建立连接耗时 connectLatency，hosts 按照主机分别给出以上统计，已回收的主机连接池的计数仍计入总数
+     *     
+     */
+    stats(): FIBJS.GeneralObject;
+
 }
 
@@ -48,6 +48,32 @@ declare class Class_HttpHandler extends Class_Handler {
      */
     enableEncoding: boolean;
 
+    /**
+     * @description 查询和设置是否启用 HTTP/2，缺省为 false
+     * 
+     *      启用后，HttpsServer 在 tls 握手时通过 ALPN 与客户端协商 h2，HttpServer 接受以 prior knowledge 方式发起的 h2c 连接。每个流作为一个独立的 HttpRequest 交给同一个处理器链处理，未协商 h2 的连接仍按 HTTP/1.1 处理
+     *      
+     */
+    enableHttp2: boolean;
+
+    /**
+     * @description 查询和设置 HTTP/2 连接上允许同时打开的流数量，缺省为 100 
+     */
+    maxConcurrentStreams: number;
+
+    /**
+     * @description 查询和设置 HTTP/2 连接的 HPACK 动态表尺寸，以字节为单位，缺省为 4096 
+     */
+    headerTableSize: number;
+
+    /**
+     * @description 查询和设置是否以流的方式读取请求 body，缺省为 false
+     * 
+     *      启用后，处理器在收到请求头后即被调用，request.body 直接从连接读取数据，content-length 和 chunked 编码在读取时解码，maxBodySize 随读取逐步检查。body 只能向前读取，无法 seek 到已读过的位置。处理器未读完的 body 会在发送响应后被读出丢弃，以保证 keep-alive 连接上的下一个请求。HTTP/2 请求不受此设置影响
+     *      
+     */
+    streamBody: boolean;
+
     /**
      * @description 查询和设置服务器名称，缺省为：fibjs/0.x.0 
      */
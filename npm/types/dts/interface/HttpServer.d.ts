@@ -43,6 +43,21 @@ declare class Class_HttpServer extends Class_TcpServer {
      */
     constructor(addr: string, port: number, hdlr: Class_Handler);
 
+    /**
+     * @description HttpServer 构造函数
+     * 
+     *      options 支持以下属性：
+     *      - address: 指定监听的地址，可选，默认在所有地址监听
+     *      - port: 指定监听的端口，address 为 unix socket 或者 Windows pipe 时可省略
+     *      - backlog: 指定侦听队列的长度，缺省为 1024
+     *      - reusePort: 是否开启 SO_REUSEPORT，开启后多个 Worker 可以侦听同一端口，由内核分配连接，缺省为 false
+     * 
+     *      @param options 指定服务器侦听选项
+     *      @param hdlr http 内置消息处理器，处理函数，链式处理数组，路由对象，详见 mq.Handler
+     *    
+     */
+    constructor(options: FIBJS.GeneralObject, hdlr: Class_Handler);
+
     /**
      * @description HttpServer 构造函数
      *     @param addr 指定 http 服务器侦听地址，为 "" 则在本机所有地址侦听
@@ -78,6 +93,32 @@ declare class Class_HttpServer extends Class_TcpServer {
      */
     enableEncoding: boolean;
 
+    /**
+     * @description 查询和设置是否启用 HTTP/2，缺省为 false
+     * 
+     *      启用后，HttpsServer 在 tls 握手时通过 ALPN 与客户端协商 h2，HttpServer 接受以 prior knowledge 方式发起的 h2c 连接。每个流作为一个独立的 HttpRequest 交给同一个处理器链处理，未协商 h2 的连接仍按 HTTP/1.1 处理
+     *      
+     */
+    enableHttp2: boolean;
+
+    /**
+     * @description 查询和设置 HTTP/2 连接上允许同时打开的流数量，缺省为 100 
+     */
+    maxConcurrentStreams: number;
+
+    /**
+     * @description 查询和设置 HTTP/2 连接的 HPACK 动态表尺寸，以字节为单位，缺省为 4096 
+     */
+    headerTableSize: number;
+
+    /**
+     * @description 查询和设置是否以流的方式读取请求 body，缺省为 false
+     * 
+     *      启用后，处理器在收到请求头后即被调用，request.body 直接从连接读取数据，content-length 和 chunked 编码在读取时解码，maxBodySize 随读取逐步检查。body 只能向前读取，无法 seek 到已读过的位置。处理器未读完的 body 会在发送响应后被读出丢弃，以保证 keep-alive 连接上的下一个请求。HTTP/2 请求不受此设置影响
+     *      
+     */
+    streamBody: boolean;
+
     /**
      * @description 查询和设置服务器名称，缺省为：fibjs/0.x.0 
      */
@@ -60,6 +60,8 @@ declare class Class_HttpsServer extends Class_HttpServer {
      *      options 除用于创建 SecureContext 的属性之外，还需提供以下属性：
      *      - address: 指定监听的地址，可选，默认在所有地址监听
      *      - port: 指定监听的端口，必须提供
+     *      - backlog: 指定侦听队列的长度，可选，缺省为 1024
+     *      - reusePort: 是否开启 SO_REUSEPORT，开启后多个 Worker 可以侦听同一端口，可选，缺省为 false
      * 
      *      @param options 使用 tls.createSecureContext 创建安全上下文需要的选项
      *      @param hdlr http 内置消息处理器，处理函数，链式处理数组，路由对象
@@ -5,6 +5,7 @@
 /// <reference path="../interface/RedisList.d.ts" />
 /// <reference path="../interface/RedisSet.d.ts" />
 /// <reference path="../interface/RedisSortedSet.d.ts" />
+/// <reference path="../interface/RedisPipeline.d.ts" />
 /**
  * @description Redis 数据库客户端对象
  * 
@@ -379,6 +380,20 @@ declare class Class_Redis extends Class_object {
      */
     getSortedSet(key: Class_Buffer): Class_RedisSortedSet;
 
+    /**
+     * @description 创建一个命令管道对象，管道中的命令在调用 exec 时通过一次写入发送给服务器
+     *      @return 返回新创建的管道对象 
+     */
+    pipeline(): Class_RedisPipeline;
+
+    /**
+     * @description 查询和设置自动管道模式，缺省为 false
+     * 
+     *      开启后，多个 fiber 同时发出的命令会被合并为一次 socket 写入，服务器的回复按发送顺序分发给各个调用者，调用方式不变。
+     *      
+     */
+    autoPipelining: boolean;
+
     /**
      * @description 序列化给定 key ，并返回被序列化的值，使用 restore 命令可以将这个值反序列化为 Redis 键
      *      @param key 指定要序列化的 key
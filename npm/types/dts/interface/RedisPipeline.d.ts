@@ -0,0 +1,43 @@
+/// <reference path="../_import/_fibjs.d.ts" />
+/// <reference path="../interface/object.d.ts" />
+/**
+ * @description Redis 命令管道对象，此对象缓存命令，只有调用 exec 才会将全部命令一次性发送给服务器
+ * 
+ *  用以减少批量操作时的网络往返次数，创建方法：
+ *  ```JavaScript
+ *  var db = require("db");
+ *  var rdb = new db.openRedis("redis-server");
+ *  var pipe = rdb.pipeline();
+ * 
+ *  pipe.command("set", "a", "100")
+ *      .command("incr", "a")
+ *      .command("get", "a");
+ * 
+ *  var r = pipe.exec();
+ *  ```
+ * 
+ */
+declare class Class_RedisPipeline extends Class_object {
+    /**
+     * @description 向管道中添加一条命令，命令在调用 exec 之前不会被发送
+     *      @param cmd 指定发送的命令
+     *      @param args 指定发送的参数
+     *      @return 返回管道对象本身，以便链式调用 
+     */
+    command(cmd: string, ...args: any[]): Class_RedisPipeline;
+
+    /**
+     * @description 查询管道中尚未发送的命令数量 
+     */
+    readonly length: number;
+
+    /**
+     * @description 将管道中的全部命令通过一次写入发送给服务器，并按顺序读取全部结果
+     * 
+     *      执行完成后管道被清空，可以继续添加新的命令。如果有命令执行出错，exec 将在读取全部结果之后抛出第一个错误。
+     *      @return 返回各命令的结果数组，顺序与添加顺序一致 
+     */
+    exec(): any[];
+
+}
+
@@ -63,6 +63,20 @@
  * var res = conn.execute(`select rowid, distance from vindex where vec_search(title, "${JSON.stringify(key)}:10")`);
  * ``` 
  * 
+ * vec_index 默认逐条比较全部向量，结果精确但检索时间与数据量成正比。数据量较大时，可以在创建时指定 index=hnsw，使用 HNSW 图索引进行近似检索，并通过 M，efConstruction 和 efSearch 调整图的连接数，构建精度和检索精度，例如：
+ * 
+ * ``` JavaScript
+ * conn.execute('create virtual table vindex using vec_index(title(128), index=hnsw, M=16, efConstruction=200, efSearch=64)');
+ * ``` 
+ * 
+ * HNSW 图与向量数据一同保存在数据库中，插入，修改和删除时增量维护。
+ * 
+ * 为降低内存占用和读写量，可以使用 quantize 选项对存储的向量进行量化：quantize=int8 将每个维度保存为 8 位整数，quantize=binary 仅保存每个维度的符号位，并使用汉明距离检索。量化会损失一定精度，可以同时指定 rerank=n，先按量化距离取出 n 倍的候选结果，再使用原始向量重新计算距离并排序，例如：
+ * 
+ * ``` JavaScript
+ * conn.execute('create virtual table vindex using vec_index(title(1024), quantize=binary, rerank=8)');
+ * ``` 
+ * 
  */
 declare class Class_SQLite extends Class_DbConnection {
     /**
@@ -63,6 +63,13 @@ declare class Class_TLSSocket extends Class_Stream {
      */
     getProtocol(): string;
 
+    /**
+     * @description 当前连接通过 ALPN 协商的应用层协议，如 h2 或 http/1.1
+     *      @return 返回协商的协议，未协商时返回 undefined
+     *     
+     */
+    getALPNProtocol(): string;
+
     /**
      * @description 当前连接协商的本地证书
      *      @return 返回本地证书
@@ -48,6 +48,21 @@ declare class Class_TcpServer extends Class_object {
      */
     constructor(addr: string, port: number, listener: Class_Handler);
 
+    /**
+     * @description TcpServer 构造函数
+     * 
+     *      options 支持以下属性：
+     *      - address: 指定监听的地址，可选，默认在所有地址监听
+     *      - port: 指定监听的端口，address 为 unix socket 或者 Windows pipe 时可省略
+     *      - backlog: 指定侦听队列的长度，缺省为 1024
+     *      - reusePort: 是否开启 SO_REUSEPORT，开启后多个 Worker 可以侦听同一端口，由内核分配连接，缺省为 false
+     * 
+     *      @param options 指定服务器侦听选项
+     *      @param listener 指定 tcp 接收到的连接的内置消息处理器，处理函数，链式处理数组，路由对象，详见 mq.Handler
+     *    
+     */
+    constructor(options: FIBJS.GeneralObject, listener: Class_Handler);
+
     /**
      * @description TcpServer 构造函数
      *     @param addr 指定 unix socket 或者 Windows pipe 服务器侦听地址
@@ -76,10 +76,13 @@ declare class Class_Worker extends Class_EventEmitter {
 
     /**
      * @description 向 Master 或 Worker 发送消息，
+     * 
+     *      消息使用结构化克隆算法传递，支持 Map，Set，Date，RegExp，BigInt，TypedArray 以及循环引用。Buffer 与原对象共享内存，SharedArrayBuffer 在线程之间共享，transfer 中列出的 ArrayBuffer 将移交给接收方，发送后在当前线程中不可再使用。
      *      @param data 指定发送的消息内容
+     *      @param transfer 指定需要移交所有权的 ArrayBuffer 列表
      *      
      */
-    postMessage(data: any): void;
+    postMessage(data: any, transfer?: any[]): void;
 
     /**
      * @description 查询和绑定接受 load 消息事件，相当于 on("load", func); 
@@ -120,6 +120,13 @@ declare module 'coroutine' {
 
     function sleep(ms?: number, callback?: (err: Error | undefined | null)=>any): void;
 
+    /**
+     * @description 查询异步调用工作池的运行统计
+     *      @return 返回统计信息，async 为短时异步调用的 worker fiber 池，包含分片数量 pools、worker 数量 workers 和空闲数量 idle；blocking 为长时阻塞调用的线程池，包含线程数量 threads、空闲数量 idle、排队数量 queued 和窃取任务的次数 steals。两者的 latency 为排队时间直方图，第 i 项为排队时间小于 2^i 微秒的调用数量，最后一项为其余的调用数量
+     *     
+     */
+    function stats(): FIBJS.GeneralObject;
+
     /**
      * @description 返回当前正在运行的全部 fiber 数组 
      */
@@ -95,6 +95,11 @@ declare module 'db' {
 
     /**
      * @description 打开一个 Redis 数据库
+     * 
+     *      connString 支持三种形式：
+     *      - redis://server:port 或者 "server"，连接单个 Redis 服务器
+     *      - redis-cluster://host1:port1,host2:port2?poolSize=N，连接 Redis 集群。客户端从种子节点读取槽位表，按 CRC16 将命令路由到对应节点，自动处理 MOVED/ASK 重定向，mget/del/exists/mset 等多键命令按槽位拆分后并发执行并合并结果，keys/dbsize 会发往所有主节点。每个节点最多保持 poolSize 个连接，缺省为 1。集群模式不支持订阅
+     *      - redis-sentinel://host1:26379,host2:26379/mastername，向 sentinel 查询主节点地址后连接。主从切换后不会自动重连，需要重新打开
      *      @param connString 数据库描述，如：redis://server:port 或者 "server"
      *      @return 返回数据库连接对象
      *      
@@ -54,7 +54,9 @@ declare module 'dgram' {
      *          "reuseAddr": true | false, // reuse address, default is false
      *          "ipv6Only": true | false, // only accept IPv6 packets, default is false
      *          "recvBufferSize": 1024,     // specify the size of the receive buffer
-     *          "sendBufferSize": 1024      // specify the size of the send buffer
+     *          "sendBufferSize": 1024,     // specify the size of the send buffer
+     *          "recvBatch": 1,             // datagrams received by one recvmmsg call, 1 to 20, default is 1
+     *          "gso": true | false         // let sendBatch use UDP GSO, default is false
      *      }
      *      ```
      *      @param opts
@@ -73,7 +75,9 @@ declare module 'dgram' {
      *          "reuseAddr": true | false, // reuse address, default is false
      *          "ipv6Only": true | false, // only accept IPv6 packets, default is false
      *          "recvBufferSize": 1024,     // specify the size of the receive buffer
-     *          "sendBufferSize": 1024      // specify the size of the send buffer
+     *          "sendBufferSize": 1024,     // specify the size of the send buffer
+     *          "recvBatch": 1,             // datagrams received by one recvmmsg call, 1 to 20, default is 1
+     *          "gso": true | false         // let sendBatch use UDP GSO, default is false
      *      }
      *      ```
      *      @param opts
@@ -9,6 +9,20 @@
  *  
  */
 declare module 'dns' {
+    /**
+     * @description 查询和设置域名查询结果的缓存时间，单位为秒，缺省为 60，设为 0 时不缓存
+     * 
+     *      系统解析接口不提供记录的 TTL，所有查询结果使用相同的缓存时间。缓存过期后的一个缓存时间内，查询会先返回过期的结果，同时在后台刷新。
+     *      同一个域名同时发起的多个查询只会产生一次系统查询。
+     *      
+     */
+    var ttl: number;
+
+    /**
+     * @description 查询和设置查询失败结果的缓存时间，单位为秒，缺省为 5 
+     */
+    var negativeTtl: number;
+
     /**
      * @description 查询给定的主机名的地址
      *      @param name 指定主机名
@@ -77,6 +77,15 @@ declare module 'fs' {
      */
     const constants: typeof import ('fs_constants');
 
+    /**
+     * @description 查询当前文件 io 引擎
+     * 
+     *      使用 --io-uring 启动，并且内核支持时返回 IoUring，否则返回 Sync
+     *      @return 返回文件 io 引擎名称
+     *     
+     */
+    function backend(): string;
+
     /**
      * @description 查询指定的文件或目录是否存在
      *      @param path 指定要查询的路径
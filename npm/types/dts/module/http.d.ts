@@ -135,7 +135,7 @@ declare module 'http' {
     var userAgent: string;
 
     /**
-     * @description 查询和设置 keep-alive 最大缓存连接数，缺省 128 
+     * @description 查询和设置每个主机保留的 keep-alive 空闲连接数，缺省 128 
      */
     var poolSize: number;
 
@@ -144,6 +144,30 @@ declare module 'http' {
      */
     var poolTimeout: number;
 
+    /**
+     * @description 查询和设置每个主机的最大连接数，缺省为 0，不限制
+     * 
+     *      连接数达到上限后，新的请求将按照到达的顺序排队，等待已有连接空闲或者关闭
+     *      
+     */
+    var maxConnsPerHost: number;
+
+    /**
+     * @description 查询和设置每个连接上同时发送的请求数，缺省为 1，不启用 http 管线
+     * 
+     *      大于 1 时，没有 body 的 GET 和 HEAD 请求可以在尚未返回的连接上继续发送，响应按照发送的顺序读取。连接中途断开时，管线中的请求将重新发送
+     *      
+     */
+    var pipelining: number;
+
+    /**
+     * @description 查询和设置是否启用 HTTP/2，缺省为 false
+     * 
+     *      启用后，https 请求在 tls 握手时通过 ALPN 协商 h2，服务器支持时同一主机的请求复用一个连接，以多路流的方式并发发送，不受 maxConnsPerHost 和 pipelining 限制。服务器不支持 h2 时自动回退到 HTTP/1.1。使用 https 代理时不启用 HTTP/2
+     *      
+     */
+    var enableHttp2: boolean;
+
     /**
      * @description 查询和设置 http 请求代理，支持 http/https/socks5 代理 
      */
@@ -157,15 +181,27 @@ declare module 'http' {
     /**
      * @description 创建一个 http 静态文件处理器，用以用静态文件响应 http 消息
      * 
-     *      fileHandler 支持 gzip 预压缩，当请求接受 gzip 编码，且相同路径下 filename.ext.gz 文件存在时，将直接返回此文件，
-     *      从而避免重复压缩带来服务器负载。
+     *      fileHandler 支持 gzip 和 brotli 预压缩，当请求接受 br 或 gzip 编码，且相同路径下 filename.ext.br 或 filename.ext.gz 文件存在时，
+     *      将直接返回此文件，从而避免重复压缩带来服务器负载。Range 请求始终返回原始文件。
      *      @param root 文件根路径
      *      @param mimes 扩展 mime 设置
      *      @param autoIndex 是否支持浏览目录文件，缺省为 false，不支持
+     *      @param cache 文件缓存设置，缺省不缓存
+     * 
+     *      cache 支持以下属性：
+     *      - size: 缓存的文件数量上限，缺省为 0，不缓存。缓存会保存文件的打开句柄，stat 结果以及 Content-Type，Last-Modified 响应头
+     *      - ttl: 缓存的有效时间，单位为毫秒，缺省为 1000，超时后将重新打开并检查文件
      *      @return 返回一个静态文件处理器用于处理 http 消息
      *      
      */
-    function fileHandler(root: string, mimes?: FIBJS.GeneralObject, autoIndex?: boolean): Class_Handler;
+    function fileHandler(root: string, mimes?: FIBJS.GeneralObject, autoIndex?: boolean, cache?: FIBJS.GeneralObject): Class_Handler;
+
+    /**
+     * @description 查询 http 模块的运行统计
+     *      @return 返回统计信息，fileCache 为 fileHandler 文件缓存的命中次数 hits，未命中次数 misses 以及缓存条目数量 entries，zipCache 为静态文件压缩结果缓存的 hits，misses，entries 以及缓存字节数 size，client 为缺省 HttpClient 连接池的统计，参见 HttpClient.stats
+     *     
+     */
+    function stats(): FIBJS.GeneralObject;
 
     /**
      * @description 发送 http 请求到指定的流对象，并返回结果
@@ -39,6 +39,14 @@ declare module 'net' {
      */
     var use_uv_socket: boolean;
 
+    /**
+     * @description 查询和设置 uv socket 使用的事件循环数量，缺省为 1，也可以使用启动参数 `--uv-loops=n` 设置
+     * 
+     *      新建和 accept 得到的 socket 会依次轮流分配到各个事件循环上，并固定在该事件循环上，减少数量只影响之后创建的 socket
+     *      
+     */
+    var uv_loops: number;
+
     /**
      * @description 查询当前运行环境网络信息
      *      @return 返回网卡信息
@@ -46,6 +54,13 @@ declare module 'net' {
      */
     function info(): FIBJS.GeneralObject;
 
+    /**
+     * @description 查询网络模块的运行统计
+     *      @return 返回统计信息，loops 为每个 uv 事件循环的状态，包含待处理任务数量 pending 和活动句柄数量 handles；dns 为域名缓存的统计，包含命中次数 hits、未命中次数 misses、返回过期结果的次数 stale、命中失败结果的次数 negative 和缓存条目数 entries
+     *     
+     */
+    function stats(): FIBJS.GeneralObject;
+
     /**
      * @description 查询给定的主机名的地址
      *      @param name 指定主机名
@@ -84,6 +99,8 @@ declare module 'net' {
 
     /**
      * @description 创建一个 Socket 或 SslSocket 对象并建立连接
+     * 
+     *      host 为域名时会按 RFC 8305 交替尝试其 ipv6 和 ipv4 地址，前一个地址 250 毫秒内未连接成功或者连接失败时开始尝试下一个地址，使用最先连接成功的 socket
      *      @param url 指定连接的协议，可以是：tcp://host:port 或者 ssl://host:port，也可以是：unix:/usr/local/proc1 或者 pipe://./pipe/proc1，连接 pipe 时需要用 `/` 替换 `\`
      *      @param timeout 指定超时时间，单位是毫秒，默认为 0
      *      @return 返回连接成功的 Socket 或者 SslSocket 对象
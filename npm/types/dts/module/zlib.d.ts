@@ -11,6 +11,8 @@
  * - inflate：解压数据；
  * - gzip：gzip 压缩格式。
  * 
+ * 此外还提供 brotli 和 zstd 两种压缩格式，接口形式与 gzip 一致，zstd 支持使用预先训练的字典压缩和解压缩。brotli 和 zstd 仅在编译时 vender 提供相应的库时可用，可通过 util.buildInfo().vender 检查，不可用时调用会抛出错误。
+ * 
  * 在使用 zlib 前，需要先根据需要使用的压缩算法选择其中一种。可以参考 zlib 的常量来选择相应的压缩算法。比如，我们使用 deflate 压缩算法进行模块说明：
  * 
  * ```JavaScript
@@ -111,6 +113,53 @@ declare module 'zlib' {
      */
     function createInflateRaw(to: Class_Stream, maxSize?: number): Class_Stream;
 
+    /**
+     * @description 创建一个 brotli 压缩流对象 
+     *      @param to 用于存储处理结果的流
+     *      @return 返回封装过的流对象
+     */
+    function createBrotliCompress(to: Class_Stream): Class_Stream;
+
+    /**
+     * @description 创建一个 brotli 解压缩流对象 
+     *      @param to 用于存储处理结果的流
+     *      @param maxSize 指定解压缩尺寸限制，缺省为 -1，不限制
+     *      @return 返回封装过的流对象
+     */
+    function createBrotliDecompress(to: Class_Stream, maxSize?: number): Class_Stream;
+
+    /**
+     * @description 创建一个 zstd 压缩流对象 
+     *      @param to 用于存储处理结果的流
+     *      @return 返回封装过的流对象
+     */
+    function createZstdCompress(to: Class_Stream): Class_Stream;
+
+    /**
+     * @description 使用字典创建一个 zstd 压缩流对象 
+     *      @param to 用于存储处理结果的流
+     *      @param dict 指定压缩字典，解压缩时需要使用相同的字典
+     *      @return 返回封装过的流对象
+     */
+    function createZstdCompress(to: Class_Stream, dict: Class_Buffer): Class_Stream;
+
+    /**
+     * @description 创建一个 zstd 解压缩流对象 
+     *      @param to 用于存储处理结果的流
+     *      @param maxSize 指定解压缩尺寸限制，缺省为 -1，不限制
+     *      @return 返回封装过的流对象
+     */
+    function createZstdDecompress(to: Class_Stream, maxSize?: number): Class_Stream;
+
+    /**
+     * @description 使用字典创建一个 zstd 解压缩流对象 
+     *      @param to 用于存储处理结果的流
+     *      @param dict 指定压缩时使用的字典
+     *      @param maxSize 指定解压缩尺寸限制，缺省为 -1，不限制
+     *      @return 返回封装过的流对象
+     */
+    function createZstdDecompress(to: Class_Stream, dict: Class_Buffer, maxSize?: number): Class_Stream;
+
     /**
      * @description 使用 deflate 算法压缩数据(zlib格式)
      *      @param data 给定要压缩的数据
@@ -306,5 +355,161 @@ declare module 'zlib' {
 
     function inflateRawTo(src: Class_Stream, stm: Class_Stream, maxSize?: number, callback?: (err: Error | undefined | null)=>any): void;
 
+    /**
+     * @description 使用 brotli 算法压缩数据 
+     *      @param data 给定要压缩的数据
+     *      @param level 指定压缩级别，取值范围 0 - 11，缺省为 DEFAULT_COMPRESSION，即 11
+     *      @return 返回压缩后的二进制数据
+     *      
+     */
+    function brotliCompress(data: Class_Buffer, level: number): Class_Buffer;
+
+    function brotliCompress(data: Class_Buffer, level: number, callback: (err: Error | undefined | null, retVal: Class_Buffer)=>any): void;
+
+    /**
+     * @description 使用 brotli 算法压缩数据到流对象中 
+     *      @param data 给定要压缩的数据
+     *      @param stm 指定存储压缩数据的流
+     *      @param level 指定压缩级别，取值范围 0 - 11，缺省为 DEFAULT_COMPRESSION，即 11
+     *      
+     */
+    function brotliCompressTo(data: Class_Buffer, stm: Class_Stream, level: number): void;
+
+    function brotliCompressTo(data: Class_Buffer, stm: Class_Stream, level: number, callback: (err: Error | undefined | null)=>any): void;
+
+    /**
+     * @description 使用 brotli 算法压缩源流中的数据到流对象中 
+     *      @param src 给定要压缩的数据所在的流
+     *      @param stm 指定存储压缩数据的流
+     *      @param level 指定压缩级别，取值范围 0 - 11，缺省为 DEFAULT_COMPRESSION，即 11
+     *      
+     */
+    function brotliCompressTo(src: Class_Stream, stm: Class_Stream, level: number): void;
+
+    function brotliCompressTo(src: Class_Stream, stm: Class_Stream, level: number, callback: (err: Error | undefined | null)=>any): void;
+
+    /**
+     * @description 解压缩 brotli 算法压缩的数据 
+     *      @param data 给定压缩后的数据
+     *      @param maxSize 指定解压缩尺寸限制，缺省为 -1，不限制
+     *      @return 返回解压缩后的二进制数据
+     *      
+     */
+    function brotliDecompress(data: Class_Buffer, maxSize?: number): Class_Buffer;
+
+    function brotliDecompress(data: Class_Buffer, maxSize?: number, callback?: (err: Error | undefined | null, retVal: Class_Buffer)=>any): void;
+
+    /**
+     * @description 解压缩 brotli 算法压缩的数据到流对象中 
+     *      @param data 给定要解压缩的数据
+     *      @param stm 指定存储解压缩数据的流
+     *      @param maxSize 指定解压缩尺寸限制，缺省为 -1，不限制
+     *      
+     */
+    function brotliDecompressTo(data: Class_Buffer, stm: Class_Stream, maxSize?: number): void;
+
+    function brotliDecompressTo(data: Class_Buffer, stm: Class_Stream, maxSize?: number, callback?: (err: Error | undefined | null)=>any): void;
+
+    /**
+     * @description 解压缩源流中 brotli 算法压缩的数据到流对象中 
+     *      @param src 给定要解压缩的数据所在的流
+     *      @param stm 指定存储解压缩数据的流
+     *      @param maxSize 指定解压缩尺寸限制，缺省为 -1，不限制
+     *      
+     */
+    function brotliDecompressTo(src: Class_Stream, stm: Class_Stream, maxSize?: number): void;
+
+    function brotliDecompressTo(src: Class_Stream, stm: Class_Stream, maxSize?: number, callback?: (err: Error | undefined | null)=>any): void;
+
+    /**
+     * @description 使用 zstd 算法压缩数据 
+     *      @param data 给定要压缩的数据
+     *      @param level 指定压缩级别，取值范围 1 - 22，缺省为 DEFAULT_COMPRESSION，即 3
+     *      @return 返回压缩后的二进制数据
+     *      
+     */
+    function zstdCompress(data: Class_Buffer, level: number): Class_Buffer;
+
+    function zstdCompress(data: Class_Buffer, level: number, callback: (err: Error | undefined | null, retVal: Class_Buffer)=>any): void;
+
+    /**
+     * @description 使用字典以 zstd 算法压缩数据 
+     *      @param data 给定要压缩的数据
+     *      @param dict 指定压缩字典，解压缩时需要使用相同的字典
+     *      @param level 指定压缩级别，取值范围 1 - 22，缺省为 DEFAULT_COMPRESSION，即 3
+     *      @return 返回压缩后的二进制数据
+     *      
+     */
+    function zstdCompress(data: Class_Buffer, dict: Class_Buffer, level: number): Class_Buffer;
+
+    function zstdCompress(data: Class_Buffer, dict: Class_Buffer, level: number, callback: (err: Error | undefined | null, retVal: Class_Buffer)=>any): void;
+
+    /**
+     * @description 使用 zstd 算法压缩数据到流对象中 
+     *      @param data 给定要压缩的数据
+     *      @param stm 指定存储压缩数据的流
+     *      @param level 指定压缩级别，取值范围 1 - 22，缺省为 DEFAULT_COMPRESSION，即 3
+     *      
+     */
+    function zstdCompressTo(data: Class_Buffer, stm: Class_Stream, level: number): void;
+
+    function zstdCompressTo(data: Class_Buffer, stm: Class_Stream, level: number, callback: (err: Error | undefined | null)=>any): void;
+
+    /**
+     * @description 使用 zstd 算法压缩源流中的数据到流对象中 
+     *      @param src 给定要压缩的数据所在的流
+     *      @param stm 指定存储压缩数据的流
+     *      @param level 指定压缩级别，取值范围 1 - 22，缺省为 DEFAULT_COMPRESSION，即 3
+     *      
+     */
+    function zstdCompressTo(src: Class_Stream, stm: Class_Stream, level: number): void;
+
+    function zstdCompressTo(src: Class_Stream, stm: Class_Stream, level: number, callback: (err: Error | undefined | null)=>any): void;
+
+    /**
+     * @description 解压缩 zstd 算法压缩的数据 
+     *      @param data 给定压缩后的数据
+     *      @param maxSize 指定解压缩尺寸限制，缺省为 -1，不限制
+     *      @return 返回解压缩后的二进制数据
+     *      
+     */
+    function zstdDecompress(data: Class_Buffer, maxSize?: number): Class_Buffer;
+
+    function zstdDecompress(data: Class_Buffer, maxSize?: number, callback?: (err: Error | undefined | null, retVal: Class_Buffer)=>any): void;
+
+    /**
+     * @description 使用字典解压缩 zstd 算法压缩的数据 
+     *      @param data 给定压缩后的数据
+     *      @param dict 指定压缩时使用的字典
+     *      @param maxSize 指定解压缩尺寸限制，缺省为 -1，不限制
+     *      @return 返回解压缩后的二进制数据
+     *      
+     */
+    function zstdDecompress(data: Class_Buffer, dict: Class_Buffer, maxSize?: number): Class_Buffer;
+
+    function zstdDecompress(data: Class_Buffer, dict: Class_Buffer, maxSize?: number, callback?: (err: Error | undefined | null, retVal: Class_Buffer)=>any): void;
+
+    /**
+     * @description 解压缩 zstd 算法压缩的数据到流对象中 
+     *      @param data 给定要解压缩的数据
+     *      @param stm 指定存储解压缩数据的流
+     *      @param maxSize 指定解压缩尺寸限制，缺省为 -1，不限制
+     *      
+     */
+    function zstdDecompressTo(data: Class_Buffer, stm: Class_Stream, maxSize?: number): void;
+
+    function zstdDecompressTo(data: Class_Buffer, stm: Class_Stream, maxSize?: number, callback?: (err: Error | undefined | null)=>any): void;
+
+    /**
+     * @description 解压缩源流中 zstd 算法压缩的数据到流对象中 
+     *      @param src 给定要解压缩的数据所在的流
+     *      @param stm 指定存储解压缩数据的流
+     *      @param maxSize 指定解压缩尺寸限制，缺省为 -1，不限制
+     *      
+     */
+    function zstdDecompressTo(src: Class_Stream, stm: Class_Stream, maxSize?: number): void;
+
+    function zstdDecompressTo(src: Class_Stream, stm: Class_Stream, maxSize?: number, callback?: (err: Error | undefined | null)=>any): void;
+
 }
 
@@ -0,0 +1,44 @@
+var fs = require('fs');
+var os = require('os');
+var path = require('path');
+var coroutine = require('coroutine');
+var child_process = require('child_process');
+
+// random 4k reads, the file is in the page cache after it is written,
+// so this measures the cost of each call rather than the disk.
+var size = 64 * 1024 * 1024;
+var block = 4096;
+var cnt = 200000;
+var fname = path.join(os.tmpdir(), 'fibjs_bench_fs_uring.bin');
+
+function bench(conc) {
+    var fd = fs.open(fname, 'r');
+    var blocks = size / block;
+    var cpu = process.cpuUsage();
+    var t = Date.now();
+
+    coroutine.parallel(() => {
+        var buf = Buffer.alloc(block);
+        for (var i = 0; i < cnt / conc; i++)
+            fs.read(fd, buf, 0, block, Math.floor(Math.random() * blocks) * block);
+    }, conc);
+
+    t = Date.now() - t;
+    cpu = process.cpuUsage(cpu);
+    fs.close(fd);
+
+    console.log(`${fs.backend()}, ${conc} fibers: ${Math.round(cnt * 1000 / t)} IOPS, ${((cpu.user + cpu.system) / cnt).toFixed(2)} us cpu/read`);
+}
+
+if (process.argv[2] === 'child') {
+    bench(Number(process.argv[3]));
+} else {
+    fs.writeFile(fname, Buffer.alloc(size, 'a'));
+
+    [1, 16, 64].forEach(conc => {
+        child_process.run(process.execPath, ['--io-uring=off', __filename, 'child', `${conc}`]);
+        child_process.run(process.execPath, ['--io-uring', __filename, 'child', `${conc}`]);
+    });
+
+    fs.unlink(fname);
+}
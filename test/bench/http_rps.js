@@ -0,0 +1,64 @@
+var http = require('http');
+var net = require('net');
+var io = require('io');
+var coroutine = require('coroutine');
+
+// keep-alive hello world, each fiber keeps one connection and sends the next request
+// as soon as the response is read, so the time goes to parsing and dispatch.
+var port = 19081;
+var cnt = 200000;
+
+var svr = new http.Server(port, (r) => {
+    r.response.write('hello, world');
+});
+svr.start();
+
+var browser = [
+    'Host: 127.0.0.1',
+    'User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/120.0.0.0 Safari/537.36',
+    'Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,*/*;q=0.8',
+    'Accept-Language: en-US,en;q=0.9,zh-CN;q=0.8',
+    'Accept-Encoding: identity',
+    'Cache-Control: max-age=0',
+    'Sec-Fetch-Dest: document',
+    'Sec-Fetch-Mode: navigate',
+    'Sec-Fetch-Site: none',
+    'Upgrade-Insecure-Requests: 1',
+    'Cookie: session=0123456789abcdef0123456789abcdef; theme=dark; lang=en',
+    'Connection: keep-alive'
+];
+
+function bench(name, headers, conc) {
+    var req = `GET / HTTP/1.1\r\n${headers.join('\r\n')}\r\n\r\n`;
+    var cpu = process.cpuUsage();
+    var t = Date.now();
+
+    coroutine.parallel(() => {
+        var c = new net.Socket();
+        c.connect('127.0.0.1', port);
+
+        var bs = new io.BufferedStream(c);
+        bs.EOL = '\r\n';
+
+        for (var i = 0; i < cnt / conc; i++) {
+            c.write(req);
+
+            var r = new http.Response();
+            r.readFrom(bs);
+        }
+
+        c.close();
+    }, conc);
+
+    t = Date.now() - t;
+    cpu = process.cpuUsage(cpu);
+
+    console.log(`${name}, ${conc} connections: ${Math.round(cnt * 1000 / t)} req/s, ${((cpu.user + cpu.system) / cnt).toFixed(2)} us cpu/req`);
+}
+
+[1, 16, 64].forEach(conc => {
+    bench('short head', ['Host: 127.0.0.1'], conc);
+    bench('browser head', browser, conc);
+});
+
+svr.stop();
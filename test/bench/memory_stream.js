@@ -0,0 +1,33 @@
+var io = require('io');
+
+// body round trip as HttpMessage does it: write the body in pieces, then read it back,
+// clone it and copy it to another MemoryStream.
+var total = 256 * 1024 * 1024;
+var piece = 16 * 1024;
+
+function bench(size) {
+    var data = Buffer.alloc(size > piece ? piece : size, 'a');
+    var cnt = Math.max(Math.floor(total / size), 4);
+    var t = Date.now();
+
+    for (var i = 0; i < cnt; i++) {
+        var ms = new io.MemoryStream();
+
+        for (var n = 0; n < size; n += data.length)
+            ms.write(data);
+
+        ms.rewind();
+        ms.readAll();
+
+        var cms = ms.clone();
+        var ms1 = new io.MemoryStream();
+        cms.copyTo(ms1);
+    }
+
+    t = Date.now() - t;
+
+    var mb = size * cnt / (1024 * 1024);
+    console.log(`${size >= 1048576 ? size / 1048576 + ' MB' : size / 1024 + ' KB'}: ${Math.round(cnt * 1000 / t)} trips/s, ${Math.round(mb * 1000 / t)} MB/s`);
+}
+
+[1024, 16 * 1024, 256 * 1024, 4 * 1024 * 1024, 64 * 1024 * 1024].forEach(bench);
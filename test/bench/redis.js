@@ -0,0 +1,120 @@
+var db = require('db');
+var net = require('net');
+var io = require('io');
+var coroutine = require('coroutine');
+
+// usage: fibjs redis.js [redis://host:port]
+// without an url, an in-process RESP stub is started so the client side can be measured alone.
+var url = process.argv[2];
+
+if (!url) {
+    var port = 16379;
+    var store = {};
+
+    var svr = new net.TcpServer(port, conn => {
+        var bs = new io.BufferedStream(conn);
+        bs.EOL = "\r\n";
+
+        function reply(v) {
+            if (v === null)
+                return "$-1\r\n";
+            if (typeof v === 'number')
+                return `:${v}\r\n`;
+            if (v === true)
+                return "+OK\r\n";
+            if (Array.isArray(v))
+                return `*${v.length}\r\n` + v.map(reply).join('');
+            return `$${Buffer.byteLength(v)}\r\n${v}\r\n`;
+        }
+
+        var line;
+        while ((line = bs.readLine()) !== null) {
+            var args = [];
+            var n = Number(line.substr(1));
+
+            for (var i = 0; i < n; i++) {
+                var sz = Number(bs.readLine().substr(1));
+                args.push(bs.read(sz + 2).slice(0, sz).toString());
+            }
+
+            var cmd = args[0].toUpperCase();
+            var r;
+
+            if (cmd == 'SET')
+                store[args[1]] = args[2], r = true;
+            else if (cmd == 'GET')
+                r = store.hasOwnProperty(args[1]) ? store[args[1]] : null;
+            else if (cmd == 'MGET')
+                r = args.slice(1).map(k => store.hasOwnProperty(k) ? store[k] : null);
+            else if (cmd == 'INCR')
+                r = store[args[1]] = (Number(store[args[1]]) || 0) + 1;
+            else
+                r = true;
+
+            bs.write(reply(r));
+        }
+    });
+    svr.start();
+
+    url = `redis://127.0.0.1:${port}`;
+}
+
+var cnt = 100000;
+var fibers = 100;
+var value = "x".repeat(64);
+
+function bench(name, fn) {
+    var t = Date.now();
+    fn();
+    t = Date.now() - t;
+
+    console.log(`${name}: ${(cnt * 1000 / t).toFixed(0)} ops/s`);
+}
+
+function parallel(rdb, fn) {
+    var per = cnt / fibers;
+    coroutine.parallel(() => {
+        for (var i = 0; i < per; i++)
+            fn(rdb, i);
+    }, fibers);
+}
+
+var rdb = db.openRedis(url);
+
+bench('sequential set', () => {
+    for (var i = 0; i < cnt; i++)
+        rdb.set("bench" + (i % 1000), value);
+});
+
+bench('sequential get', () => {
+    for (var i = 0; i < cnt; i++)
+        rdb.get("bench" + (i % 1000));
+});
+
+bench('pipeline(100) get', () => {
+    for (var i = 0; i < cnt; i += 100) {
+        var pipe = rdb.pipeline();
+        for (var j = 0; j < 100; j++)
+            pipe.command("get", "bench" + ((i + j) % 1000));
+        pipe.exec();
+    }
+});
+
+var keys = [];
+for (var i = 0; i < 1000; i++)
+    keys.push("bench" + i);
+
+bench('mget(1000) keys', () => {
+    for (var i = 0; i < cnt; i += 1000)
+        rdb.mget(keys);
+});
+
+rdb.autoPipelining = true;
+
+bench(`${fibers} fibers get (autoPipelining)`, () => parallel(rdb, (r, i) => r.get("bench" + (i % 1000))));
+bench(`${fibers} fibers incr (autoPipelining)`, () => parallel(rdb, (r, i) => r.incr("benchCounter")));
+
+rdb.close();
+
+if (svr)
+    svr.stop();
@@ -0,0 +1,27 @@
+var mq = require('mq');
+var http = require('http');
+
+function bench(name, rules, path) {
+    var r = new mq.Routing();
+    for (var i = 0; i < rules; i++)
+        r.get(`/api/v1/res${i}/:id`, (v) => { });
+    r.get('/api/v1/last/:id', (v) => { });
+
+    var req = new http.Request();
+    req.method = 'GET';
+
+    var cnt = 100000;
+    var t = Date.now();
+    for (var i = 0; i < cnt; i++) {
+        req.value = path;
+        mq.invoke(r, req);
+    }
+    t = Date.now() - t;
+
+    console.log(`${name} ${rules} rules: ${(cnt * 1000 / t).toFixed(0)} ops/s`);
+}
+
+[10, 100, 1000].forEach(n => {
+    bench('first', n, '/api/v1/res0/1234');
+    bench('last', n, '/api/v1/last/1234');
+});
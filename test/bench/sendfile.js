@@ -0,0 +1,58 @@
+var http = require('http');
+var io = require('io');
+var fs = require('fs');
+var os = require('os');
+var path = require('path');
+var coroutine = require('coroutine');
+
+var port = 19080;
+var size = 64 * 1024 * 1024;
+var dir = path.join(os.tmpdir(), 'fibjs_bench_sendfile');
+var name = 'asset.bin';
+
+try {
+    fs.mkdir(dir);
+} catch (e) { }
+fs.writeFile(path.join(dir, name), Buffer.alloc(size, 'a'));
+
+var mem = fs.readFile(path.join(dir, name));
+
+var svr = new http.Server(port, {
+    '/file/(.*)': http.fileHandler(dir),
+    '/range/(.*)': (r, p) => {
+        r.response.statusCode = 206;
+        r.response.body = new io.RangeStream(fs.openFile(path.join(dir, p)), 0, size);
+    },
+    '/memory/(.*)': (r) => {
+        var ms = new io.MemoryStream();
+        ms.write(mem);
+        r.response.body = ms;
+    }
+});
+svr.start();
+
+function bench(name, url) {
+    var cnt = 50;
+    var conc = 4;
+    var cpu = process.cpuUsage();
+    var t = Date.now();
+
+    coroutine.parallel(() => {
+        var client = new http.Client();
+        for (var i = 0; i < cnt / conc; i++)
+            client.get(url).body.readAll();
+    }, conc);
+
+    t = Date.now() - t;
+    cpu = process.cpuUsage(cpu);
+
+    var gb = size * cnt / (1024 * 1024 * 1024);
+    console.log(`${name}: ${(gb * 1000 / t).toFixed(2)} GB/s, ${((cpu.user + cpu.system) / cnt / 1000).toFixed(2)} ms cpu/req`);
+}
+
+bench('sendfile', `http://127.0.0.1:${port}/file/${name}`);
+bench('sendfile range', `http://127.0.0.1:${port}/range/${name}`);
+bench('user-space copy', `http://127.0.0.1:${port}/memory/${name}`);
+
+svr.stop();
+fs.unlink(path.join(dir, name));
@@ -0,0 +1,48 @@
+var db = require('db');
+var fs = require('fs');
+var os = require('os');
+var path = require('path');
+
+var file = path.join(os.tmpdir(), 'fibjs_bench_sqlite.db');
+var cnt = 1000000;
+
+function clean() {
+    ['', '-wal', '-shm'].forEach(ext => {
+        try {
+            fs.unlink(file + ext);
+        } catch (e) { }
+    });
+}
+
+function bench(name, fn) {
+    var t = Date.now();
+    fn();
+    t = Date.now() - t;
+
+    console.log(`${name}: ${(cnt * 1000 / t).toFixed(0)} ops/s`);
+}
+
+clean();
+
+var conn = db.open('sqlite:' + file);
+conn.execute('create table test(id integer primary key, name text, score double)');
+
+bench('insert', () => {
+    conn.begin();
+    for (var i = 0; i < cnt; i++)
+        conn.execute('insert into test values(?, ?, ?)', i, `name ${i}`, i / 3);
+    conn.commit();
+});
+
+bench('point select', () => {
+    for (var i = 0; i < cnt; i++)
+        conn.execute('select * from test where id=?', i);
+});
+
+bench('point select (inline sql)', () => {
+    for (var i = 0; i < cnt; i++)
+        conn.execute(`select * from test where id=${i}`);
+});
+
+conn.close();
+clean();
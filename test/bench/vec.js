@@ -0,0 +1,69 @@
+var db = require('db');
+
+var dim = 128;
+var cnt = 100000;
+var queries = 200;
+var k = 10;
+
+function random_vector() {
+    var v = [];
+    for (var j = 0; j < dim; j++)
+        v.push(Math.random() - 0.5);
+    return Buffer.from(Float32Array.from(v).buffer);
+}
+
+var data = [];
+for (var i = 0; i < cnt; i++)
+    data.push(random_vector());
+
+var keys = [];
+for (var i = 0; i < queries; i++)
+    keys.push(JSON.stringify(Array.from(new Float32Array(random_vector().buffer))));
+
+function bench(name, options) {
+    var conn = db.openSQLite(":memory:");
+    conn.execute(`create virtual table vindex using vec_index(vec(${dim})${options})`);
+
+    var t = Date.now();
+    conn.trans(() => {
+        for (var i = 0; i < cnt; i++)
+            conn.execute("insert into vindex(vec, rowid) values(?,?)", data[i], i);
+    });
+    t = Date.now() - t;
+    console.log(`${name} insert: ${(cnt * 1000 / t).toFixed(0)} ops/s`);
+
+    var results = [];
+    t = Date.now();
+    for (var i = 0; i < queries; i++)
+        results.push(conn.execute(`select rowid from vindex where vec_search(vec, "${keys[i]}:${k}")`).map(r => r.rowid));
+    t = Date.now() - t;
+    console.log(`${name} search: ${(queries * 1000 / t).toFixed(1)} qps`);
+
+    conn.close();
+    return results;
+}
+
+function recall(truth, results) {
+    var hits = 0;
+    for (var i = 0; i < queries; i++) {
+        var s = new Set(truth[i]);
+        hits += results[i].filter(r => s.has(r)).length;
+    }
+
+    return hits / (queries * k);
+}
+
+var truth = bench('flat', '');
+
+[16, 64, 256].forEach(ef => {
+    var results = bench(`hnsw(efSearch=${ef})`, `, index=hnsw, M=16, efConstruction=200, efSearch=${ef}`);
+    console.log(`hnsw(efSearch=${ef}) recall@${k}: ${recall(truth, results).toFixed(4)}`);
+});
+
+['int8', 'binary'].forEach(q => {
+    [0, 8].forEach(r => {
+        var name = r ? `${q}(rerank=${r})` : q;
+        var results = bench(name, r ? `, quantize=${q}, rerank=${r}` : `, quantize=${q}`);
+        console.log(`${name} recall@${k}: ${recall(truth, results).toFixed(4)}`);
+    });
+});
@@ -0,0 +1,47 @@
+var coroutine = require('coroutine');
+var path = require('path');
+var util = require('util');
+
+var worker = new coroutine.Worker(path.join(__dirname, 'worker_files/echo.js'));
+
+var ping = util.sync((msg, done) => {
+    worker.onmessage = (evt) => {
+        done(null, evt.data);
+    };
+    worker.postMessage(msg);
+});
+
+function bench(name, cnt, fn) {
+    var t = Date.now();
+    for (var i = 0; i < cnt; i++)
+        fn(i);
+    t = Date.now() - t;
+
+    console.log(`${name}: ${(cnt * 1000 / t).toFixed(0)} round trips/s`);
+}
+
+var small = {
+    id: 1,
+    name: 'ping',
+    tags: ['a', 'b', 'c'],
+    ts: new Date(),
+    meta: new Map([['k', 1]])
+};
+
+var buf = new Buffer(1024 * 1024);
+var f32 = new Float32Array(256 * 1024);
+
+bench('small object', 100000, () => ping(small));
+bench('1MB Buffer', 10000, () => ping(buf));
+bench('1MB Float32Array (copy)', 1000, () => ping(f32));
+bench('1MB ArrayBuffer (transfer)', 10000, () => {
+    var ab = new ArrayBuffer(1024 * 1024);
+    util.sync((done) => {
+        worker.onmessage = (evt) => {
+            done(null, evt.data);
+        };
+        worker.postMessage(ab, [ab]);
+    })();
+});
+
+process.exit();
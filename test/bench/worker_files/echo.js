@@ -0,0 +1,3 @@
+Master.onmessage = (evt) => {
+    Master.postMessage(evt.data);
+};
@@ -77,6 +77,38 @@ describe("buffered stream", () => {
         }
     });
 
+    it("marks across reads", () => {
+        var svr = new net.Socket();
+        svr.bind(8183 + base_port);
+        svr.listen();
+
+        coroutine.start(() => {
+            var c = svr.accept();
+            ['ab\r', '\ncd', '\r', '\nef', 'gh--', '-ij', 'klmn'].forEach(d => {
+                c.write(d);
+                coroutine.sleep(20);
+            });
+            c.close();
+        });
+
+        var conn = new net.Socket();
+        conn.connect('127.0.0.1', 8183 + base_port);
+
+        var r = new io.BufferedStream(conn);
+        r.EOL = '\r\n';
+
+        assert.equal(r.readLine(), 'ab');
+        assert.equal(r.readLine(), 'cd');
+        assert.equal(r.read(2).toString(), 'ef');
+        assert.equal(r.readUntil('---'), 'gh');
+        assert.equal(r.read(3).toString(), 'ijk');
+        assert.equal(r.read().toString(), 'lmn');
+        assert.isNull(r.read());
+
+        conn.close();
+        svr.close();
+    });
+
     it("readline", () => {
         f = fs.openFile(path.join(__dirname, "test0000" + base_port));
         var r = new io.BufferedStream(f);
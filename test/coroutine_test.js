@@ -286,6 +286,30 @@ describe('coroutine', () => {
         coroutine.sleep();
     });
 
+    it('stats', () => {
+        function total(st) {
+            return st.latency.reduce((a, b) => a + b, 0);
+        }
+
+        var st = coroutine.stats();
+        assert.equal(st.async.latency.length, 21);
+        assert.equal(st.blocking.latency.length, 21);
+        assert.greaterThan(st.async.pools, 0);
+        assert.greaterThan(st.blocking.threads, 0);
+
+        var ev = new coroutine.Event();
+        require('fs').readFile(__filename, () => ev.set());
+        ev.wait();
+
+        var conn = require('db').openSQLite(':memory:');
+        conn.execute('select 1');
+        conn.close();
+
+        var st1 = coroutine.stats();
+        assert.greaterThan(total(st1.async), total(st.async));
+        assert.greaterThan(total(st1.blocking), total(st.blocking));
+    });
+
     describe('Worker', () => {
         it("new", () => {
             var flag = false;
@@ -389,6 +413,75 @@ describe('coroutine', () => {
                         assert.deepEqual(msg_trans(o), o);
                     });
 
+                    it('structured clone', () => {
+                        var o = {
+                            m: new Map([[1, 'a'], ['b', { c: 2 }]]),
+                            s: new Set([1, 2, 3]),
+                            d: new Date(),
+                            r: /ab+c/gi,
+                            n: 12345678901234567890n,
+                            u: undefined
+                        };
+                        var o1 = msg_trans(o);
+
+                        assert.ok(o1.m instanceof Map);
+                        assert.deepEqual(Array.from(o1.m), Array.from(o.m));
+                        assert.ok(o1.s instanceof Set);
+                        assert.deepEqual(Array.from(o1.s), [1, 2, 3]);
+                        assert.equal(o1.d.getTime(), o.d.getTime());
+                        assert.equal(o1.r.source, 'ab+c');
+                        assert.equal(o1.r.flags, 'gi');
+                        assert.strictEqual(o1.n, o.n);
+                        assert.ok('u' in o1);
+
+                        var a = { v: 1 };
+                        a.self = a;
+                        var a1 = msg_trans(a);
+                        assert.strictEqual(a1.self, a1);
+
+                        var f = Float32Array.from([1.5, 2.5, 3.5]);
+                        var f1 = msg_trans({ f: f }).f;
+                        assert.ok(f1 instanceof Float32Array);
+                        assert.deepEqual(Array.from(f1), [1.5, 2.5, 3.5]);
+
+                        var b = msg_trans({ b: new Buffer("abc") }).b;
+                        assert.ok(Buffer.isBuffer(b));
+                        assert.equal(b.toString(), "abc");
+
+                        assert.throws(() => {
+                            msg_trans({ f: () => { } });
+                        });
+                    });
+
+                    it('SharedArrayBuffer', () => {
+                        var sab = new SharedArrayBuffer(16);
+                        var sab1 = msg_trans(sab);
+
+                        new Int32Array(sab1)[1] = 100;
+                        assert.equal(new Int32Array(sab)[1], 100);
+                    });
+
+                    it('transfer', () => {
+                        var ab = Uint8Array.from([1, 2, 3, 4]).buffer;
+
+                        var res = util.sync((done) => {
+                            worker.onmessage = (evt) => {
+                                done(null, [evt.data, evt.data]);
+                            };
+                            worker.postMessage({ ab: ab }, [ab]);
+                        })();
+
+                        var ab1 = res[0];
+                        assert.equal(res[1], ab1);
+
+                        assert.equal(ab.byteLength, 0);
+                        assert.deepEqual(Array.from(new Uint8Array(ab1.ab)), [1, 2, 3, 4]);
+
+                        assert.throws(() => {
+                            worker.postMessage(1, [new Uint8Array(4)]);
+                        });
+                    });
+
                     describe('native object', () => {
                         it('default', () => {
                             assert.throws(() => {
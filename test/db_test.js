@@ -1356,6 +1356,51 @@ describe("db", () => {
             assert.equal(journal_mode, "wal");
         });
 
+        it("bound parameters", () => {
+            var conn = db.open(conn_str);
+
+            conn.execute('create table test_bind(k int, v text, b blob);');
+            for (var i = 0; i < 100; i++)
+                conn.execute('insert into test_bind values(?, ?, ?);', i, `it's ${i}`, Buffer.from([i]));
+
+            for (var i = 0; i < 100; i++) {
+                var rs = conn.execute('select * from test_bind where k=?', i);
+                assert.equal(rs.length, 1);
+                assert.equal(rs[0].v, `it's ${i}`);
+                assert.deepEqual(rs[0].b, Buffer.from([i]));
+            }
+
+            assert.equal(conn.execute('select ? as v', 1.5)[0].v, 1.5);
+            assert.equal(conn.execute('select ? as v', 12n)[0].v, 12);
+            assert.equal(conn.execute('select ? as v', '12')[0].v, '12');
+            assert.equal(conn.execute('select count(*) as c from test_bind where k in ?', [1, 2, 3])[0].c, 3);
+
+            var rs = conn.execute("select '?' as a, ? as b, 'it''s ?' as c", 1);
+            assert.equal(rs[0].a, '?');
+            assert.equal(rs[0].b, 1);
+            assert.equal(rs[0].c, "it's ?");
+
+            var rs = conn.execute("select ? as a; select count(*) as c from test_bind where k in ? and v <> '?'", 1, [1, 2]);
+            assert.equal(rs[0][0].a, 1);
+            assert.equal(rs[1][0].c, 2);
+
+            assert.throws(() => {
+                conn.execute('select ? as v', 1, 2);
+            });
+            assert.throws(() => {
+                conn.execute('select ? as a, ? as b', 1);
+            });
+            assert.throws(() => {
+                conn.execute("select '?' as v", 1);
+            });
+
+            conn.execute('alter table test_bind add column v1 int default 7;');
+            assert.equal(conn.execute('select * from test_bind where k=?', 1)[0].v1, 7);
+
+            conn.execute('drop table test_bind;');
+            conn.close();
+        });
+
         it("backup", () => {
             var conn = db.open(conn_str);
             conn.backup(conn_str + ".backup");
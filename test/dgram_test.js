@@ -177,6 +177,50 @@ describe('dgram', () => {
         test_message('big message', Buffer.alloc(4000).hex(), 1004);
     });
 
+    describe("sendBatch", () => {
+        function test_batch(name, opts, port) {
+            it(name, () => {
+                var msgs = [];
+                for (var i = 0; i < 100; i++)
+                    msgs.push(Buffer.alloc(i % 10 == 9 ? 50 : 100, i));
+                msgs.push(Buffer.alloc(0));
+
+                var recv = [];
+                const s = dgram.createSocket(Object.assign({
+                    type: 'udp4',
+                    recvBatch: 16
+                }, opts));
+                s.on('message', msg => recv.push(msg));
+                s.bind(base_port + port);
+
+                const c = dgram.createSocket(Object.assign({
+                    type: 'udp4'
+                }, opts));
+                assert.equal(c.sendBatch(msgs, base_port + port), 9500);
+
+                for (var i = 0; i < 100 && recv.length < msgs.length; i++)
+                    coroutine.sleep(10);
+
+                c.close();
+                s.close();
+
+                assert.deepEqual(recv, msgs);
+            });
+        }
+
+        test_batch('sendBatch', {}, 1020);
+        test_batch('sendBatch with gso', {
+            gso: true
+        }, 1021);
+
+        it('recvBatch out of range', () => {
+            assert.throws(() => dgram.createSocket({
+                type: 'udp4',
+                recvBatch: 21
+            }));
+        });
+    });
+
     it("broadcast", () => {
         var t = false;
         const s = dgram.createSocket('udp4');
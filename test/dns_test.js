@@ -1,5 +1,6 @@
 const dns = require('dns');
 const net = require('net');
+const coroutine = require('coroutine');
 const test = require('test');
 test.setup();
 
@@ -33,6 +34,69 @@ describe('dns', () => {
             net.resolve('999.999.999.999');
         });
     });
+
+    describe('cache', () => {
+        var ttl = dns.ttl;
+
+        after(() => {
+            dns.ttl = ttl;
+        });
+
+        it('ttl', () => {
+            assert.equal(dns.ttl, 60);
+            assert.equal(dns.negativeTtl, 5);
+
+            assert.throws(() => {
+                dns.ttl = -1;
+            });
+        });
+
+        it('hits', () => {
+            dns.resolve('localhost');
+
+            var st = net.stats().dns;
+            var a = dns.resolve('localhost');
+            var st1 = net.stats().dns;
+
+            assert.equal(st1.hits, st.hits + 1);
+            assert.equal(st1.misses, st.misses);
+            assert.deepEqual(dns.resolve('localhost'), a);
+            assert.equal(dns.lookup('localhost'), a[0]);
+            assert.greaterThan(st1.entries, 0);
+        });
+
+        it('negative', () => {
+            try {
+                dns.resolve('999.999.999.999');
+            } catch (e) {}
+
+            var st = net.stats().dns;
+            assert.throws(() => {
+                dns.resolve('999.999.999.999');
+            });
+            assert.equal(net.stats().dns.negative, st.negative + 1);
+        });
+
+        it('stale', () => {
+            dns.ttl = 1;
+            dns.resolve('127.0.0.9');
+            coroutine.sleep(1100);
+
+            var st = net.stats().dns;
+            assert.deepEqual(dns.resolve('127.0.0.9'), ['127.0.0.9']);
+            assert.equal(net.stats().dns.stale, st.stale + 1);
+        });
+
+        it('connect by host name', () => {
+            var svr = new net.TcpServer(8884, s => s.close());
+            svr.start();
+
+            var c = net.connect('tcp://localhost:8884');
+            c.close();
+
+            svr.stop();
+        });
+    });
 });
 
 require.main === module && test.run(console.DEBUG);
\ No newline at end of file
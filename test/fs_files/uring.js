@@ -0,0 +1,45 @@
+var assert = require('assert');
+var fs = require('fs');
+var os = require('os');
+var path = require('path');
+var coroutine = require('coroutine');
+
+var fname = path.join(os.tmpdir(), process.argv[2]);
+
+if (process.platform === 'linux')
+    assert.ok(['IoUring', 'Sync'].indexOf(fs.backend()) >= 0);
+else
+    assert.equal(fs.backend(), 'Sync');
+
+var data = Buffer.alloc(256 * 1024);
+for (var i = 0; i < data.length; i++)
+    data[i] = i * 7;
+
+var fd = fs.open(fname, 'w+');
+assert.equal(fs.write(fd, data), data.length);
+fs.fsync(fd);
+fs.fdatasync(fd);
+assert.equal(fs.fstat(fd).size, data.length);
+assert.equal(fs.stat(fname).size, data.length);
+
+coroutine.parallel(() => {
+    var buf = Buffer.alloc(4096);
+    for (var i = 0; i < 100; i++) {
+        var pos = Math.floor(Math.random() * (data.length - buf.length));
+        assert.equal(fs.read(fd, buf, 0, buf.length, pos), buf.length);
+        assert.deepEqual(buf, data.slice(pos, pos + buf.length));
+    }
+}, 16);
+
+var buf = Buffer.alloc(16);
+assert.equal(fs.read(fd, buf, 0, 16, data.length - 8), 8);
+assert.equal(fs.read(fd, buf, 0, 16), 0);
+fs.close(fd);
+
+var f = fs.openFile(fname);
+assert.deepEqual(f.readAll(), data);
+f.close();
+
+assert.throws(() => fs.open(fname + '.none'));
+
+fs.unlink(fname);
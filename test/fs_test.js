@@ -4,6 +4,7 @@ var path = require('path');
 var fs = require('fs');
 var zip = require('zip');
 var io = require('io');
+var child_process = require('child_process');
 var {
     ensureDirectoryExisted
 } = require('./_helpers/process');
@@ -361,6 +362,12 @@ describe('fs', () => {
         fs.unlink(path.join(__dirname, 'fs_test.js.bak' + vmid));
     });
 
+    it("io_uring backend", () => {
+        assert.equal(fs.backend(), 'Sync');
+        assert.equal(child_process.run(process.execPath, ['--io-uring',
+            path.join(__dirname, 'fs_files', 'uring.js'), 'uring_test' + vmid]), 0);
+    });
+
     it("readFile", () => {
         var f = fs.openFile(path.join(__dirname, 'fs_test.js'));
         var d = f.readAll();
@@ -9,6 +9,7 @@ var fs = require('fs');
 var http = require('http');
 var net = require('net');
 var zip = require('zip');
+var zlib = require('zlib');
 var coroutine = require("coroutine");
 var path = require("path");
 
@@ -610,6 +611,61 @@ describe("http", () => {
             assert.equal('123456', r.body.read());
         });
 
+        it("head format", () => {
+            var req = get_request("\r\nGET / HTTP/1.1\nhead1:   100  \r\nhead2:\t200\n\r\n");
+            assert.equal(req.protocol, 'HTTP/1.1');
+            assert.equal(req.headers['head1'], '100');
+            assert.equal(req.headers['head2'], '200');
+
+            assert.throws(() => {
+                get_request("GET / HTTP/1.1\r\nhead 1: 100\r\n\r\n");
+            });
+
+            assert.throws(() => {
+                get_request("GET / HTTP/1.1\r\n: 100\r\n\r\n");
+            });
+
+            assert.throws(() => {
+                get_request("GET / HTTP/1.1\r\nhead1: 1\x0100\r\n\r\n");
+            });
+
+            assert.throws(() => {
+                get_request("GET / HTTP/1.1\r\nContent-Length: 1a\r\n\r\n");
+            });
+
+            assert.throws(() => {
+                get_request("GET / HTTP/1.1\r\nhead1: 100\r\n");
+            });
+        });
+
+        it("head limits", () => {
+            var hdrs = "";
+            for (var i = 0; i < 10; i++)
+                hdrs += `head${i}: ${i}\r\n`;
+
+            var r = get_response("HTTP/1.1 200 ok\r\n" + hdrs + "\r\n", {
+                maxHeadersCount: 10
+            });
+            assert.equal(r.headers['head9'], '9');
+
+            assert.throws(() => {
+                get_response("HTTP/1.1 200 ok\r\n" + hdrs + "\r\n", {
+                    maxHeadersCount: 9
+                });
+            });
+
+            var r = get_response("HTTP/1.1 200 ok\r\nhead: " + "a".repeat(94) + "\r\n\r\n", {
+                maxHeaderSize: 100
+            });
+            assert.equal(r.headers['head'].length, 94);
+
+            assert.throws(() => {
+                get_response("HTTP/1.1 200 ok\r\nhead: " + "a".repeat(95) + "\r\n\r\n", {
+                    maxHeaderSize: 100
+                });
+            });
+        });
+
         it("keep-alive", () => {
             var keep_reqs = {
                 "GET / HTTP/1.0\r\n\r\n": false,
@@ -1174,6 +1230,14 @@ describe("http", () => {
                     r.response.write("01234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567");
                 } else if (r.value == '/gzip_bin') {
                     r.response.write("0123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789");
+                } else if (r.value == '/gzip_file') {
+                    r.response.addHeader("Content-Type", "text/javascript");
+                    r.response.addHeader("Last-Modified", fs.stat(__filename).mtime.toUTCString());
+                    r.response.body = fs.openFile(__filename);
+                } else if (r.value == '/stream_all') {
+                    r.response.write((r.body instanceof io.MemoryStream ? "memory:" : "stream:") + r.body.readAll().toString());
+                } else if (r.value == '/stream_part') {
+                    r.response.write(r.body.read(3));
                 }
             });
 
@@ -1227,6 +1291,57 @@ describe("http", () => {
             assert.equal(req.firstHeader('Content-Encoding'), 'gzip');
         });
 
+        it("gzip cache", () => {
+            var st = http.stats().zipCache;
+
+            c.write("GET /gzip_file HTTP/1.1\r\nAccept-Encoding: gzip,deflate\r\n\r\n");
+            var req = get_response();
+            assert.equal(req.statusCode, 200);
+            assert.equal(req.firstHeader('Content-Encoding'), 'gzip');
+            assert.equal(req.firstHeader('Vary'), 'Accept-Encoding');
+            var data = req.readAll();
+
+            c.write("GET /gzip_file HTTP/1.1\r\nAccept-Encoding: gzip,deflate\r\n\r\n");
+            var req = get_response();
+            assert.equal(req.statusCode, 200);
+            assert.equal(req.firstHeader('Content-Encoding'), 'gzip');
+            assert.equal(data.compare(req.readAll()), 0);
+            assert.equal(zlib.gunzip(data).toString(), fs.readTextFile(__filename));
+
+            var st1 = http.stats().zipCache;
+            assert.equal(st1.misses - st.misses, 1);
+            assert.equal(st1.hits - st.hits, 1);
+        });
+
+        it("br/zstd request", () => {
+            var text = "0123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789";
+
+            function test_encoding(accept, encoding) {
+                c.write(`GET /gzip_test HTTP/1.1\r\nAccept-Encoding: ${accept}\r\n\r\n`);
+                var req = get_response();
+                assert.equal(req.statusCode, 200);
+                assert.equal(req.firstHeader('Content-Encoding'), encoding);
+                return req.readAll();
+            }
+
+            // a build without brotli or zstd falls back to gzip
+            var vender = require('util').buildInfo().vender;
+
+            if (vender.brotli)
+                assert.equal(zlib.brotliDecompress(test_encoding("gzip, deflate, br, zstd", "br")).toString(), text);
+            else
+                assert.equal(zlib.gunzip(test_encoding("gzip, br", "gzip")).toString(), text);
+
+            if (vender.zstd) {
+                assert.equal(zlib.zstdDecompress(test_encoding("gzip, zstd", "zstd")).toString(), text);
+                assert.equal(zlib.zstdDecompress(test_encoding("br;q=0, zstd;q=0.5, gzip", "zstd")).toString(), text);
+            } else
+                assert.equal(zlib.gunzip(test_encoding("gzip, zstd", "gzip")).toString(), text);
+
+            assert.equal(zlib.gunzip(test_encoding("BR; q=0.0, gzip", "gzip")).toString(), text);
+            assert.equal(test_encoding("brotli, gzip;q=0", null).toString(), text);
+        });
+
         it("not zip small file", () => {
             c.write("GET /gzip_small HTTP/1.0\r\nAccept-Encoding: gzip,deflate\r\n\r\n");
             var req = get_response();
@@ -1303,6 +1418,33 @@ describe("http", () => {
             assert.equal(err_404, 0);
         });
 
+        it("stream body", () => {
+            c.write("POST /stream_all HTTP/1.1\r\nContent-Length: 10\r\n\r\n0123456789");
+            assert.equal(get_response().readAll().toString(), "memory:0123456789");
+
+            hdr.streamBody = true;
+            try {
+                c.write("POST /stream_all HTTP/1.1\r\nContent-Length: 10\r\n\r\n0123456789");
+                assert.equal(get_response().readAll().toString(), "stream:0123456789");
+
+                c.write("POST /stream_all HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n3\r\nabc\r\n4\r\ndefg\r\n0\r\n\r\n");
+                assert.equal(get_response().readAll().toString(), "stream:abcdefg");
+
+                // the handler answers before the body has arrived, the rest is drained afterwards
+                c.write("POST /stream_part HTTP/1.1\r\nContent-Length: 10\r\n\r\n012");
+                assert.equal(get_response().readAll().toString(), "012");
+                c.write("3456789");
+
+                c.write("POST /stream_part HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n5\r\n01234\r\n5\r\n56789\r\n0\r\n\r\n");
+                assert.equal(get_response().readAll().toString(), "012");
+
+                c.write("POST /stream_all HTTP/1.1\r\nContent-Length: 3\r\n\r\nxyz");
+                assert.equal(get_response().readAll().toString(), "stream:xyz");
+            } finally {
+                hdr.streamBody = false;
+            }
+        });
+
         it("options request", () => {
             c.write("OPTIONS / HTTP/1.1\r\norigin: localhost\r\n\r\n");
             var req = get_response();
@@ -1340,6 +1482,9 @@ describe("http", () => {
             try {
                 fs.unlink(filePath + '.gz');
             } catch (e) { };
+            try {
+                fs.unlink(filePath + '.br');
+            } catch (e) { };
         }
 
         before(clean);
@@ -1386,6 +1531,54 @@ describe("http", () => {
             rep.clear();
         });
 
+        it("precompressed", () => {
+            fs.writeFile(filePath + '.gz', zlib.gzip(Buffer.from('test html file')));
+
+            var rep = hfh_test(url, {
+                'Accept-Encoding': 'gzip, deflate'
+            });
+            assert.equal(200, rep.statusCode);
+            assert.equal('gzip', rep.firstHeader('Content-Encoding'));
+            assert.equal('Accept-Encoding', rep.firstHeader('Vary'));
+            assert.equal('text/html', rep.firstHeader('Content-Type'));
+            assert.equal('test html file', zlib.gunzip(rep.readAll()).toString());
+
+            fs.writeFile(filePath + '.br', 'brotli data');
+
+            var rep = hfh_test(url, {
+                'Accept-Encoding': 'gzip, deflate, br'
+            });
+            assert.equal('br', rep.firstHeader('Content-Encoding'));
+            assert.equal('brotli data', rep.readAll().toString());
+
+            var rep = hfh_test(url, {
+                'Accept-Encoding': 'br;q=0, gzip'
+            });
+            assert.equal('gzip', rep.firstHeader('Content-Encoding'));
+            assert.equal('test html file', zlib.gunzip(rep.readAll()).toString());
+
+            var rep = hfh_test(url, {
+                'Accept-Encoding': 'x-gzip, deflate'
+            });
+            assert.equal(null, rep.firstHeader('Content-Encoding'));
+            assert.equal('test html file', rep.readAll().toString());
+
+            var rep = hfh_test(url);
+            assert.equal(null, rep.firstHeader('Content-Encoding'));
+            assert.equal('test html file', rep.readAll().toString());
+
+            var rep = hfh_test(url, {
+                'Accept-Encoding': 'gzip, deflate, br',
+                'Range': 'bytes=0-3'
+            });
+            assert.equal(206, rep.statusCode);
+            assert.equal(null, rep.firstHeader('Content-Encoding'));
+            assert.equal('test', rep.readAll().toString());
+
+            fs.unlink(filePath + '.gz');
+            fs.unlink(filePath + '.br');
+        });
+
         it("index.html", () => {
             var rep = hfh_test("/");
             assert.equal(200, rep.statusCode);
@@ -1400,6 +1593,64 @@ describe("http", () => {
             assert.equal("this is index.html", rep.readAll().toString());
         });
 
+        it("cache", () => {
+            var _hfHandler = hfHandler;
+            hfHandler = new http.fileHandler(baseFolder, {}, false, {
+                size: 16,
+                ttl: 60000
+            });
+
+            var st = http.stats().fileCache;
+
+            var rep = hfh_test(url);
+            assert.equal(200, rep.statusCode);
+            assert.equal('text/html', rep.firstHeader('Content-Type'));
+            assert.equal("test html file", rep.readAll().toString());
+            var lastModified = rep.firstHeader('Last-Modified');
+
+            for (var i = 0; i < 5; i++) {
+                var rep = hfh_test(url);
+                assert.equal(200, rep.statusCode);
+                assert.equal('text/html', rep.firstHeader('Content-Type'));
+                assert.equal('bytes', rep.firstHeader('Accept-Ranges'));
+                assert.equal(lastModified, rep.firstHeader('Last-Modified'));
+                assert.equal("test html file", rep.readAll().toString());
+            }
+
+            var rep = hfh_test(url, {
+                'If-Modified-Since': lastModified
+            });
+            assert.equal(304, rep.statusCode);
+
+            var st1 = http.stats().fileCache;
+            assert.equal(st1.misses - st.misses, 1);
+            assert.equal(st1.hits - st.hits, 6);
+
+            hfHandler = _hfHandler;
+        });
+
+        it("cache revalidates rewritten file", () => {
+            var _hfHandler = hfHandler;
+            hfHandler = new http.fileHandler(baseFolder, {}, false, {
+                size: 16,
+                ttl: 60000
+            });
+
+            var rep = hfh_test(url);
+            assert.equal(200, rep.statusCode);
+            assert.equal("test html file", rep.readAll().toString());
+
+            fs.writeFile(filePath, 'test html file, rewritten');
+
+            var rep = hfh_test(url);
+            assert.equal(200, rep.statusCode);
+            assert.equal(25, rep.length);
+            assert.equal("test html file, rewritten", rep.readAll().toString());
+
+            fs.writeFile(filePath, 'test html file');
+            hfHandler = _hfHandler;
+        });
+
         it("bad request", () => {
             var rep = hfh_test("/%25");
             assert.equal(400, rep.statusCode);
@@ -1492,6 +1743,45 @@ describe("http", () => {
             });
         });
 
+        describe("send over socket", () => {
+            var svr;
+            var bigFile = path.join(baseFolder, base_port + 'big.bin');
+            var data = Buffer.alloc(4 * 1024 * 1024);
+            var _url = 'http://127.0.0.1:' + (8888 + base_port) + '/' + base_port + 'big.bin';
+
+            before(() => {
+                for (var i = 0; i < data.length; i += 4)
+                    data.writeUInt32LE(i, i);
+                fs.writeFile(bigFile, data);
+
+                svr = new http.Server(8888 + base_port, hfHandler);
+                svr.start();
+                test_util.push(svr.socket);
+            });
+
+            after(() => {
+                try {
+                    fs.unlink(bigFile);
+                } catch (e) { }
+            });
+
+            it("whole file", () => {
+                var rep = http.get(_url);
+                assert.equal(200, rep.statusCode);
+                assert.equal(0, data.compare(rep.data));
+            });
+
+            it("range", () => {
+                var rep = http.get(_url, {
+                    headers: {
+                        "Range": "bytes=100000-3000000"
+                    }
+                });
+                assert.equal(206, rep.statusCode);
+                assert.equal(0, data.slice(100000, 3000001).compare(rep.data));
+            });
+        });
+
         describe("zip virtual file", () => {
             var zurl = base_port + 'test.html.zip$/test.html';
 
@@ -1760,6 +2050,50 @@ describe("http", () => {
                     "/request");
             });
 
+            it("h2c with prior knowledge", () => {
+                svr.enableHttp2 = true;
+
+                try {
+                    var c = new net.Socket();
+                    c.connect("127.0.0.1", 8882 + base_port);
+                    var bs = new io.BufferedStream(c);
+
+                    var authority = "127.0.0.1:" + (8882 + base_port);
+                    var block = Buffer.concat([
+                        Buffer.from([0x82, 0x86, 0x04, 6]), Buffer.from("/host:"),
+                        Buffer.from([0x01, authority.length]), Buffer.from(authority)
+                    ]);
+
+                    c.write(Buffer.from("PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"));
+                    c.write(Buffer.from([0, 0, 0, 4, 0, 0, 0, 0, 0]));
+                    c.write(Buffer.concat([Buffer.from([0, 0, block.length, 1, 5, 0, 0, 0, 1]), block]));
+
+                    var status;
+                    var body = [];
+
+                    while (true) {
+                        var h = bs.read(9);
+                        var len = (h[0] << 16) | (h[1] << 8) | h[2];
+                        var payload = len ? bs.read(len) : Buffer.alloc(0);
+
+                        if (h[3] == 1)
+                            status = payload[0];
+                        else if (h[3] == 0) {
+                            body.push(payload);
+                            if (h[4] & 1)
+                                break;
+                        }
+                    }
+
+                    assert.equal(status, 0x88);
+                    assert.equal(Buffer.concat(body).toString(), "/host:" + authority);
+
+                    c.close();
+                } finally {
+                    svr.enableHttp2 = false;
+                }
+            });
+
             it("redirect", () => {
                 assert.equal(http.request("GET", "http://127.0.0.1:" + (8882 + base_port) + "/redirect").body.read().toString(),
                     "/request");
@@ -1934,6 +2268,99 @@ describe("http", () => {
                 var r2 = http.get("http://127.0.0.1:" + (8882 + base_port) + "/request");
                 assert.equal(r1.stream.stream, r2.stream.stream);
             });
+
+            it("maxConnsPerHost of keep-alive", () => {
+                var hc = new http.Client({
+                    maxConnsPerHost: 2
+                });
+                assert.equal(hc.maxConnsPerHost, 2);
+
+                assert.throws(() => {
+                    hc.maxConnsPerHost = -1;
+                });
+
+                var conns = [];
+                coroutine.parallel(() => {
+                    var r = hc.get("http://127.0.0.1:" + (8882 + base_port) + "/request");
+                    assert.equal(r.body.readAll().toString(), "/request");
+                    if (conns.indexOf(r.stream.stream) == -1)
+                        conns.push(r.stream.stream);
+                }, 10);
+
+                assert.lessThan(conns.length, 3);
+
+                var st = hc.stats();
+                assert.equal(st.requests, 10);
+                assert.equal(st.connects, conns.length);
+                assert.equal(st.reused, 10 - conns.length);
+                assert.equal(st.waiters, 0);
+                assert.equal(st.active, 0);
+                assert.equal(st.idle, conns.length);
+                assert.equal(st.reuseRatio, st.reused / st.requests);
+
+                var host = st.hosts["tcp://127.0.0.1:" + (8882 + base_port)];
+                assert.equal(host.requests, 10);
+                assert.equal(host.idle, conns.length);
+            });
+
+            it("pipelining of keep-alive", () => {
+                var hc = new http.Client({
+                    maxConnsPerHost: 1,
+                    pipelining: 4
+                });
+                assert.equal(hc.pipelining, 4);
+
+                assert.throws(() => {
+                    hc.pipelining = 0;
+                });
+
+                var res = [];
+                coroutine.parallel([0, 1, 2, 3, 4, 5, 6, 7], (i) => {
+                    var r = hc.get("http://127.0.0.1:" + (8882 + base_port) + "/request" + i);
+                    res[i] = r.body.readAll().toString();
+                });
+
+                for (var i = 0; i < 8; i++)
+                    assert.equal(res[i], "/request" + i);
+
+                var st = hc.stats();
+                assert.equal(st.connects, 1);
+                assert.equal(st.requests, 8);
+                assert.equal(st.reused, 7);
+
+                var r = hc.post("http://127.0.0.1:" + (8882 + base_port) + "/request", {
+                    body: "body"
+                });
+                assert.equal(r.body.readAll().toString(), "/requestbody");
+                assert.equal(hc.stats().connects, 1);
+            });
+
+            it("stats keep swept pools", () => {
+                var hc = new http.Client();
+                hc.poolTimeout = 0;
+
+                var r = hc.get("http://127.0.0.1:" + (8882 + base_port) + "/request");
+                assert.equal(r.body.readAll().toString(), "/request");
+                coroutine.sleep(100);
+
+                r = hc.get("http://127.0.0.1:" + (8882 + base_port) + "/request");
+                assert.equal(r.body.readAll().toString(), "/request");
+
+                var st = hc.stats();
+                assert.equal(st.requests, 2);
+                assert.equal(st.connects, 2);
+                assert.equal(st.hosts["tcp://127.0.0.1:" + (8882 + base_port)].requests, 1);
+            });
+
+            it("stats of client", () => {
+                var st = http.stats().client;
+                assert.property(st, "idle");
+                assert.property(st, "active");
+                assert.property(st, "waiters");
+                assert.property(st, "reuseRatio");
+                assert.property(st, "connectLatency");
+                assert.property(st, "hosts");
+            });
         });
 
         describe("head", () => {
@@ -2086,6 +2513,9 @@ describe("http", () => {
             assert.equal(hc.maxBodySize, -1);
             assert.equal(hc.poolSize, 128);
             assert.equal(hc.poolTimeout, 10000);
+            assert.equal(hc.maxConnsPerHost, 0);
+            assert.equal(hc.pipelining, 1);
+            assert.equal(hc.enableHttp2, false);
             assert.equal(hc.userAgent, "Mozilla/5.0 AppleWebKit/537.36 (KHTML, like Gecko) Chrome/54.0.2840.98 Safari/537.36");
             assert.equal(hc.http_proxy, "");
             assert.equal(hc.https_proxy, "");
@@ -2102,6 +2532,7 @@ describe("http", () => {
                 maxBodySize: 100,
                 poolSize: 100,
                 poolTimeout: 1000,
+                enableHttp2: true,
                 userAgent: "test agent",
                 http_proxy: "http://127.0.0.1:9998",
                 https_proxy: "https://127.0.0.1:9999"
@@ -2116,6 +2547,7 @@ describe("http", () => {
             assert.equal(hc.maxBodySize, 100);
             assert.equal(hc.poolSize, 100);
             assert.equal(hc.poolTimeout, 1000);
+            assert.equal(hc.enableHttp2, true);
             assert.equal(hc.userAgent, "test agent");
             assert.equal(hc.http_proxy, "http://127.0.0.1:9998");
             assert.equal(hc.https_proxy, "https://127.0.0.1:9999");
@@ -2195,6 +2627,71 @@ describe("http", () => {
                 assert.equal(hc.get("https://localhost:" + (8883 + base_port) + "/gzip_test").body.read().toString(),
                     "0123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789");
             });
+
+            it("fallback to http/1.1 when h2 is not negotiated", () => {
+                var hc1 = new http.Client({
+                    ca: ca,
+                    enableHttp2: true
+                });
+
+                var rs = coroutine.parallel([1, 2, 3, 4], (i) => hc1.get("https://localhost:" + (8883 + base_port) + "/request:" + i));
+                rs.forEach((r, i) => {
+                    assert.equal(r.protocol, "HTTP/1.1");
+                    assert.equal(r.body.read().toString(), "/request:" + (i + 1));
+                });
+
+                var r = hc1.post("https://localhost:" + (8883 + base_port) + "/request:", {
+                    body: "body"
+                });
+                assert.equal(r.protocol, "HTTP/1.1");
+                assert.equal(r.body.read().toString(), "/request:body");
+            });
+
+            it("h2 server", () => {
+                svr.enableHttp2 = true;
+                assert.equal(svr.maxConcurrentStreams, 100);
+                assert.equal(svr.headerTableSize, 4096);
+
+                try {
+                    var hc1 = new http.Client({
+                        ca: ca,
+                        enableHttp2: true
+                    });
+
+                    var rs = coroutine.parallel([1, 2, 3, 4, 5, 6, 7, 8], (i) => hc1.get("https://localhost:" + (8883 + base_port) + "/request:" + i));
+                    rs.forEach((r, i) => {
+                        assert.equal(r.protocol, "HTTP/2.0");
+                        assert.equal(r.statusCode, 200);
+                        assert.equal(r.body.read().toString(), "/request:" + (i + 1));
+                        assert.equal(r.firstHeader("set-cookie"), "request1=value; path=/");
+                        assert.equal(r.allHeader("set-cookie").length, 2);
+                    });
+
+                    var r = hc1.post("https://localhost:" + (8883 + base_port) + "/request:", {
+                        body: "body",
+                        headers: {
+                            cookie: "a=1; b=2",
+                            test_header: "header"
+                        }
+                    });
+                    assert.equal(r.protocol, "HTTP/2.0");
+                    assert.equal(r.body.read().toString(), "/request:bodyheader");
+                    assert.equal(cookie_for['_'], "a=1; b=2");
+
+                    svr.enableEncoding = true;
+                    r = hc1.get("https://localhost:" + (8883 + base_port) + "/gzip_test");
+                    assert.equal(r.protocol, "HTTP/2.0");
+                    assert.equal(r.body.read().toString(),
+                        "0123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789");
+
+                    r = hc1.head("https://localhost:" + (8883 + base_port) + "/request:");
+                    assert.equal(r.protocol, "HTTP/2.0");
+                    assert.equal(r.body.read(), null);
+                } finally {
+                    svr.enableEncoding = false;
+                    svr.enableHttp2 = false;
+                }
+            });
         });
 
         describe("head", () => {
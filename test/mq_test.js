@@ -1048,6 +1048,44 @@ describe("mq", () => {
                 mq.invoke(r, m);
                 assert.equal('/', m.value);
             });
+
+            it("tree and regex", () => {
+                var val = 0;
+                var r = new mq.Routing();
+
+                r.get("/api/:id", (v) => { val = 1; });
+                r.append("^/api/(.*)$", (v) => { val = 2; });
+                r.append("/API/test", (v) => { val = 3; });
+                r.append("/:a/:b/:c", (v) => { val = 4; });
+
+                htm.method = "GET";
+                htm.value = "/api/test";
+                mq.invoke(r, htm);
+                assert.equal(val, 1);
+                assert.equal(htm.value, "test");
+                assert.deepEqual(Array.prototype.slice.call(htm.params), ["test"]);
+
+                htm.method = "POST";
+                htm.value = "/api/test";
+                mq.invoke(r, htm);
+                assert.equal(val, 2);
+
+                htm.method = "POST";
+                htm.value = "/a/b%20/c/";
+                mq.invoke(r, htm);
+                assert.equal(val, 4);
+                assert.equal(htm.value, "");
+                assert.deepEqual(Array.prototype.slice.call(htm.params), ["a", "b ", "c"]);
+
+                var r1 = new mq.Routing();
+                r1.append("^/a/.*$", (v) => { val = 5; });
+                r1.append("/a/:id", (v) => { val = 6; });
+
+                var m = new mq.Message();
+                m.value = '/a/1';
+                mq.invoke(r1, m);
+                assert.equal(val, 5);
+            });
         });
 
         it("memory leak", () => {
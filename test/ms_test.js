@@ -88,6 +88,95 @@ describe('ms', () => {
         assert.equal('abcdefghijabcdefghijklmnopqrstuvwxyz', ms.read().toString());
     });
 
+    it("segments", () => {
+        var m = new io.MemoryStream();
+        var big = Buffer.alloc(100000, 'x');
+
+        m.write('head');
+        m.write(big);
+        m.write('tail');
+        assert.equal(m.size(), 100008);
+
+        m.rewind();
+        assert.equal(m.read(6).toString(), 'headxx');
+        m.seek(-6, fs.SEEK_END);
+        assert.equal(m.read().toString(), 'xxtail');
+
+        m.seek(2, fs.SEEK_SET);
+        m.write(Buffer.alloc(100004, 'y'));
+        m.rewind();
+        var d = m.read();
+        assert.equal(d.length, 100008);
+        assert.equal(d.slice(0, 3).toString(), 'hey');
+        assert.equal(d.slice(-3).toString(), 'yil');
+
+        var c = m.clone();
+        m.rewind();
+        m.write('abc');
+        assert.equal(c.read(3).toString(), 'hey');
+
+        var m1 = new io.MemoryStream();
+        c.rewind();
+        assert.equal(c.copyTo(m1, 100000), 100000);
+        assert.equal(c.tell(), 100000);
+        assert.equal(c.copyTo(m1), 8);
+        m1.rewind();
+        assert.deepEqual(m1.read(), d);
+    });
+
+    it("small writes", () => {
+        var m = new io.MemoryStream();
+        var s = '';
+
+        for (var i = 0; i < 1000; i++) {
+            m.write(i + ',');
+            s += i + ',';
+        }
+
+        m.rewind();
+        assert.equal(m.read().toString(), s);
+
+        var buf = Buffer.from('0123');
+        m.write(buf);
+        buf[0] = 0x41;
+        m.seek(-4, fs.SEEK_END);
+        assert.equal(m.read().toString(), '0123');
+    });
+
+    it("keeps its own copy", () => {
+        var m = new io.MemoryStream();
+        var big = Buffer.alloc(10000, 'a');
+
+        m.write(big);
+        big[0] = 0x62;
+        m.rewind();
+
+        var d = m.read();
+        assert.equal(d[0], 0x61);
+
+        d[1] = 0x62;
+        m.rewind();
+        assert.deepEqual(m.read(), Buffer.alloc(10000, 'a'));
+    });
+
+    it("truncate", () => {
+        var m = new io.MemoryStream();
+
+        m.write('abcdef');
+        m.truncate(3);
+        assert.equal(m.size(), 3);
+        assert.equal(m.tell(), 3);
+        assert.isTrue(m.eof());
+
+        m.write('xyz');
+        m.rewind();
+        assert.equal(m.read().toString(), 'abcxyz');
+
+        m.truncate(8);
+        m.rewind();
+        assert.deepEqual(m.read(), Buffer.from('abcxyz\0\0'));
+    });
+
 });
 
 require.main === module && test.run(console.DEBUG);
\ No newline at end of file
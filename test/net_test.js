@@ -49,7 +49,7 @@ function del(f) {
     } catch (e) { }
 }
 
-function test_net(eng, use_uv) {
+function test_net(eng, use_uv, uv_loops) {
     var now_port = 8080;
 
     function getPort() {
@@ -59,17 +59,27 @@ function test_net(eng, use_uv) {
     describe("net " + eng, () => {
         before(() => {
             net.use_uv_socket = use_uv;
+            net.uv_loops = uv_loops || 1;
         })
 
         after(() => {
             test_util.cleanup();
             net.use_uv_socket = false;
+            net.uv_loops = 1;
         });
 
         it("backend", () => {
             assert.equal(net.backend(), backend);
         });
 
+        it("stats", () => {
+            var st = net.stats();
+            assert.isArray(st.loops);
+            assert.notLessThan(st.loops.length, net.uv_loops);
+            assert.isNumber(st.loops[0].pending);
+            assert.isNumber(st.loops[0].handles);
+        });
+
         it("echo", () => {
             function connect(c) {
                 console.log(c.remoteAddress, c.remotePort, "->",
@@ -480,6 +490,29 @@ function test_net(eng, use_uv) {
             test_util.push(svr.socket);
         });
 
+        if (process.platform != "win32")
+            it("reusePort", () => {
+                var _port = getPort();
+                var svr1 = new net.TcpServer({
+                    port: _port,
+                    backlog: 64,
+                    reusePort: true
+                }, (c) => { });
+                var svr2 = new net.TcpServer({
+                    port: _port,
+                    reusePort: true
+                }, (c) => { });
+                test_util.push(svr1.socket);
+                test_util.push(svr2.socket);
+
+                assert.throws(() => {
+                    new net.TcpServer({
+                        port: _port,
+                        backlog: 0
+                    }, (c) => { });
+                });
+            });
+
         describe("abort Pending I/O", () => {
             function close_it(s) {
                 coroutine.sleep(50);
@@ -767,5 +800,6 @@ function test_net(eng, use_uv) {
 
 test_net("ev", false);
 test_net("uv", true);
+test_net("uv loops", true, 4);
 
 require.main === module && test.run(console.DEBUG);
\ No newline at end of file
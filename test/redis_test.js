@@ -118,6 +118,16 @@ describe("redis", () => {
             assert.equal(rdb.incr("test", 9), 110);
         });
 
+        it("incr/decr int64 limits", () => {
+            rdb.set("test", "9223372036854775806");
+            assert.equal(rdb.incr("test"), 9223372036854775807);
+            assert.equal(rdb.get("test").toString(), "9223372036854775807");
+
+            rdb.set("test", "-9223372036854775807");
+            assert.equal(rdb.decr("test"), -9223372036854775808);
+            assert.equal(rdb.get("test").toString(), "-9223372036854775808");
+        });
+
         it("setBit/getBit", () => {
             rdb.set("test", "aaa");
             assert.equal(rdb.getBit("test", 5), 0);
@@ -523,6 +533,268 @@ describe("redis", () => {
         });
     });
 
+    describe("reply", () => {
+        it("large bulk", () => {
+            var v = "0123456789".repeat(100 * 1024) + "end";
+            rdb.set("testBig", v);
+
+            var r = rdb.get("testBig");
+            assert.equal(r.length, v.length);
+            assert.equal(r.toString(), v);
+
+            rdb.del("testBig");
+        });
+
+        it("many keys", () => {
+            var keys = [];
+            var kvs = {};
+
+            for (var i = 0; i < 5000; i++) {
+                keys.push("testMany" + i);
+                kvs["testMany" + i] = "value" + i;
+            }
+
+            rdb.mset(kvs);
+            keys.push("testMany_none");
+
+            var r = rdb.mget(keys);
+            assert.equal(r.length, keys.length);
+            for (var i = 0; i < 5000; i++)
+                assert.equal(r[i], "value" + i);
+            assert.isNull(r[5000]);
+
+            rdb.del(keys);
+        });
+
+        it("resp3", () => {
+            var rdb1 = db.open(dbs);
+
+            try {
+                rdb1.command("hello", "3");
+            } catch (e) {
+                rdb1.close();
+                return;
+            }
+
+            var hash = rdb1.getHash("testResp3Hash");
+            hash.mset("a", "1", "b", "2");
+            listEquals(hash.getAll(), ["a", "1", "b", "2"]);
+
+            var zset = rdb1.getSortedSet("testResp3Zset");
+            zset.add("a", 7);
+            assert.equal(zset.score("a"), "7");
+
+            var set = rdb1.getSet("testResp3Set");
+            set.add("a", "b");
+            listEquals(set.members().sort(), ["a", "b"]);
+
+            assert.isTrue(rdb1.exists("testResp3Hash"));
+            assert.isNull(rdb1.get("testResp3None"));
+
+            rdb1.del("testResp3Hash", "testResp3Zset", "testResp3Set");
+            rdb1.close();
+        });
+    });
+
+    describe("pipeline", () => {
+        it("exec", () => {
+            var pipe = rdb.pipeline();
+
+            assert.equal(pipe.length, 0);
+            assert.deepEqual(pipe.exec(), []);
+
+            assert.equal(pipe.command("set", "testPipe", "100")
+                .command("incr", "testPipe")
+                .command("get", "testPipe")
+                .command("get", "testPipe1"), pipe);
+            assert.equal(pipe.length, 4);
+
+            var r = pipe.exec();
+            assert.equal(pipe.length, 0);
+
+            assert.equal(r.length, 4);
+            assert.equal(r[0], "OK");
+            assert.equal(r[1], 101);
+            assert.equal(r[2], "101");
+            assert.isNull(r[3]);
+        });
+
+        it("nested reply", () => {
+            var pipe = rdb.pipeline();
+
+            pipe.command("del", "testPipeList");
+            pipe.command("rpush", "testPipeList", "a", "b", "c");
+            pipe.command("lrange", "testPipeList", 0, -1);
+
+            var r = pipe.exec();
+            listEquals(r[2], ["a", "b", "c"]);
+        });
+
+        it("error", () => {
+            var pipe = rdb.pipeline();
+
+            pipe.command("set", "testPipe", "aaa");
+            pipe.command("incr", "testPipe");
+            pipe.command("set", "testPipe", "bbb");
+
+            assert.throws(() => {
+                pipe.exec();
+            });
+
+            assert.equal(rdb.get("testPipe"), "bbb");
+        });
+
+        it("autoPipelining", () => {
+            var rdb1 = db.open(dbs);
+
+            assert.isFalse(rdb1.autoPipelining);
+            rdb1.autoPipelining = true;
+            assert.isTrue(rdb1.autoPipelining);
+
+            var keys = [];
+            for (var i = 0; i < 100; i++)
+                keys.push("testAuto" + i);
+
+            coroutine.parallel(keys, k => rdb1.set(k, k));
+            var r = coroutine.parallel(keys, k => rdb1.get(k));
+            listEquals(r, keys);
+
+            var r = coroutine.parallel(keys, k => rdb1.incr(k + "_n", 2));
+            assert.deepEqual(r, keys.map(k => 2));
+
+            assert.throws(() => {
+                rdb1.incr("testAuto0");
+            });
+            assert.equal(rdb1.get("testAuto1"), "testAuto1");
+
+            var pipe = rdb1.pipeline();
+            pipe.command("get", "testAuto2").command("get", "testAuto3");
+            listEquals(pipe.exec(), ["testAuto2", "testAuto3"]);
+
+            rdb1.del(keys);
+            rdb1.del(keys.map(k => k + "_n"));
+            rdb1.close();
+        });
+    });
+
+    describe("cluster", () => {
+        // needs a local cluster, e.g. the one started by utils/create-cluster in the redis source tree
+        var rdc;
+
+        before(() => {
+            try {
+                rdc = db.open("redis-cluster://127.0.0.1:30001,127.0.0.1:30002,127.0.0.1:30003");
+            } catch (e) {}
+        });
+
+        after(() => {
+            if (rdc)
+                rdc.close();
+        });
+
+        it("route", () => {
+            if (!rdc)
+                return;
+
+            var keys = [];
+            for (var i = 0; i < 100; i++) {
+                keys.push("testCluster" + i);
+                rdc.set("testCluster" + i, "value" + i);
+            }
+
+            for (var i = 0; i < 100; i++)
+                assert.equal(rdc.get("testCluster" + i), "value" + i);
+
+            assert.equal(rdc.incr("testClusterNum", 5), 5);
+            assert.isNull(rdc.get("testClusterNone"));
+
+            assert.ok(rdc.keys("testCluster*").length >= 100);
+
+            rdc.del(keys);
+            rdc.del("testClusterNum");
+        });
+
+        it("multi-key", () => {
+            if (!rdc)
+                return;
+
+            var kvs = {};
+            var keys = [];
+
+            for (var i = 0; i < 200; i++) {
+                keys.push("testMulti" + i);
+                kvs["testMulti" + i] = "v" + i;
+            }
+
+            rdc.mset(kvs);
+            keys.push("testMultiNone");
+
+            var r = rdc.mget(keys);
+            assert.equal(r.length, 201);
+            for (var i = 0; i < 200; i++)
+                assert.equal(r[i], "v" + i);
+            assert.isNull(r[200]);
+
+            assert.equal(rdc.del(keys), 200);
+            assert.isFalse(rdc.exists("testMulti0"));
+        });
+
+        it("hash tag", () => {
+            if (!rdc)
+                return;
+
+            assert.equal(rdc.command("cluster", "keyslot", "{user1}.a"),
+                rdc.command("cluster", "keyslot", "{user1}.b"));
+
+            assert.isTrue(rdc.msetNX("{user1}.a", "1", "{user1}.b", "2"));
+            listEquals(rdc.mget("{user1}.a", "{user1}.b"), ["1", "2"]);
+            rdc.del("{user1}.a", "{user1}.b");
+        });
+
+        it("pipeline", () => {
+            if (!rdc)
+                return;
+
+            var pipe = rdc.pipeline();
+            for (var i = 0; i < 50; i++)
+                pipe.command("set", "testClusterPipe" + i, i);
+            for (var i = 0; i < 50; i++)
+                pipe.command("incr", "testClusterPipe" + i);
+
+            var r = pipe.exec();
+            assert.equal(r.length, 100);
+            for (var i = 0; i < 50; i++) {
+                assert.equal(r[i], "OK");
+                assert.equal(r[50 + i], i + 1);
+            }
+
+            for (var i = 0; i < 50; i++)
+                rdc.del("testClusterPipe" + i);
+        });
+
+        it("parallel", () => {
+            if (!rdc)
+                return;
+
+            var keys = [];
+            for (var i = 0; i < 100; i++)
+                keys.push("testClusterPar" + i);
+
+            coroutine.parallel(keys, k => rdc.set(k, k));
+            listEquals(coroutine.parallel(keys, k => rdc.get(k)), keys);
+            rdc.del(keys);
+        });
+
+        it("sub is not supported", () => {
+            if (!rdc)
+                return;
+
+            assert.throws(() => {
+                rdc.sub("test.cluster", () => {});
+            });
+        });
+    });
+
     describe("PubSub", () => {
         var c, m, p,
             n1 = 0,
@@ -432,6 +432,293 @@ describe("vec", () => {
         ]);
     });
 
+    describe("hnsw", () => {
+        it("create table", () => {
+            conn.execute("create virtual table vindex using vec_index(title(3), description(3), index=hnsw, M=8)");
+            assert.deepEqual(conn.execute(`select name from vec_index where tbl="vindex" order by name desc`), [
+                {
+                    "name": "title:hnsw"
+                },
+                {
+                    "name": "title"
+                },
+                {
+                    "name": "description:hnsw"
+                },
+                {
+                    "name": "description"
+                }
+            ]);
+
+            conn.execute("drop table vindex");
+            assert.deepEqual(conn.execute(`select name from vec_index where tbl="vindex"`), []);
+        });
+
+        it("bad options", () => {
+            assert.throws(() => {
+                conn.execute("create virtual table vindex using vec_index(title(3), index=ivf)");
+            });
+
+            assert.throws(() => {
+                conn.execute("create virtual table vindex using vec_index(title(3), index=hnsw, M=1)");
+            });
+
+            assert.throws(() => {
+                conn.execute("create virtual table vindex using vec_index(title(3), index=hnsw, ef=10)");
+            });
+        });
+
+        it("search", () => {
+            conn.execute("create virtual table vindex using vec_index(title(3), description(3), index=hnsw)");
+            conn.execute(`insert into vindex(title, description, rowid) values("[2,2,3]", "[3,4,5]", 1)`);
+            conn.execute(`insert into vindex(title, description, rowid) values("[3,200,1]", "[3,4,5]", 2)`);
+            conn.execute(`insert into vindex(title, description, rowid) values("[-1,2,10]", "[3,4,5]", 3)`);
+            conn.execute(`insert into vindex(title, description, rowid) values("[1,2,5.1234]", "[3,4,5]", 4)`);
+
+            var res = conn.execute(`select rowid, distance from vindex where vec_search(title, "[1,2,5.1234]")`);
+            assert.deepEqual(res.map(r => r.rowid), [4, 3, 1, 2]);
+            assert.closeTo(res[0].distance, 0, 0.0001);
+            assert.closeTo(res[1].distance, 0.053202, 0.0001);
+            assert.closeTo(res[2].distance, 0.072819, 0.0001);
+            assert.closeTo(res[3].distance, 0.635004, 0.0001);
+
+            var res = conn.execute(`select rowid, distance from vindex where vec_search(title, "[1,2,5.1234]:1")`);
+            assert.equal(res[0].rowid, 4);
+        });
+
+        it("delete and update", () => {
+            conn.execute("create virtual table vindex using vec_index(title(3), index=hnsw)");
+            conn.execute(`insert into vindex(title, rowid) values("[1,2,3]", 1)`);
+            conn.execute(`insert into vindex(title, rowid) values("[3,2,1]", 2)`);
+            conn.execute(`insert into vindex(title, rowid) values("[1,0,0]", 3)`);
+
+            conn.execute(`delete from vindex where rowid = 1`);
+            var res = conn.execute(`select rowid from vindex where vec_search(title, "[1,2,3]")`);
+            assert.deepEqual(res.map(r => r.rowid), [2, 3]);
+
+            conn.execute(`update vindex set title="[1,2,3]" where rowid = 3`);
+            var res = conn.execute(`select rowid from vindex where vec_search(title, "[1,2,3]:1")`);
+            assert.deepEqual(res.map(r => r.rowid), [3]);
+
+            conn.trans(() => {
+                conn.execute(`delete from vindex where rowid = 2`);
+                conn.execute(`insert into vindex(title, rowid) values("[3,2,1]", 2)`);
+                conn.execute(`insert into vindex(title, rowid) values("[3,2,1]", 4)`);
+            });
+
+            var res = conn.execute(`select rowid from vindex where vec_search(title, "[3,2,1]")`);
+            assert.deepEqual(res.map(r => r.rowid).sort(), [2, 3, 4]);
+        });
+
+        it("load from disk db", () => {
+            conn = db.openSQLite(path.join(__dirname, "vec_test.db"));
+            conn.execute("create virtual table vindex using vec_index(title(8), index=hnsw, M=4)");
+
+            var vecs = [];
+            conn.trans(() => {
+                for (var i = 0; i < 500; i++) {
+                    var v = [];
+                    for (var j = 0; j < 8; j++)
+                        v.push(Math.random() - 0.5);
+                    vecs.push(v);
+                    conn.execute("insert into vindex(title, rowid) values(?,?)", JSON.stringify(v), i);
+                }
+            });
+            conn.execute(`delete from vindex where rowid < 100`);
+
+            var key = JSON.stringify(vecs[200]);
+            var r1 = conn.execute(`select rowid, distance from vindex where vec_search(title, "${key}:10")`);
+
+            var graph = conn.execute(`select data from vec_index where tbl="vindex" and name="title:hnsw"`)[0].data;
+            assert.greaterThan(graph.length, 0);
+
+            conn.close();
+            conn = db.openSQLite(path.join(__dirname, "vec_test.db"));
+
+            var r2 = conn.execute(`select rowid, distance from vindex where vec_search(title, "${key}:10")`);
+            assert.deepEqual(r1, r2);
+            assert.equal(r2[0].rowid, 200);
+
+            assert.equal(conn.execute(`select count(*) as c from vindex`)[0].c, 400);
+            assert.deepEqual(conn.execute(`select rowid from vindex where rowid = 50`), []);
+        });
+
+        it("save changed pages only", () => {
+            conn = db.openSQLite(path.join(__dirname, "vec_test.db"));
+            conn.execute("create virtual table vindex using vec_index(title(8), index=hnsw, M=4)");
+
+            function rand_vec() {
+                var v = [];
+                for (var j = 0; j < 8; j++)
+                    v.push(Math.random() - 0.5);
+                return v;
+            }
+
+            var vecs = [];
+            conn.trans(() => {
+                for (var i = 0; i < 1000; i++) {
+                    vecs.push(rand_vec());
+                    conn.execute("insert into vindex(title, rowid) values(?,?)", JSON.stringify(vecs[i]), i);
+                }
+            });
+
+            function pages() {
+                return conn.execute(`select name, data from vec_index where tbl="vindex" and name like "title:hnsw:%" order by rowid`);
+            }
+
+            var p1 = pages();
+            assert.equal(p1.length, 4);
+
+            conn.execute(`delete from vindex where rowid = 900`);
+
+            var p2 = pages();
+            assert.equal(p2.length, 4);
+            for (var i = 0; i < 3; i++)
+                assert.deepEqual(p2[i], p1[i]);
+            assert.notDeepEqual(p2[3], p1[3]);
+
+            vecs[10] = rand_vec();
+            conn.execute(`update vindex set title=? where rowid = 10`, JSON.stringify(vecs[10]));
+            conn.execute("insert into vindex(title, rowid) values(?,?)", JSON.stringify(vecs[10]), 1000);
+            assert.equal(pages().length, 4);
+
+            var key = JSON.stringify(vecs[10]);
+            var r1 = conn.execute(`select rowid, distance from vindex where vec_search(title, "${key}:10")`);
+
+            conn.close();
+            conn = db.openSQLite(path.join(__dirname, "vec_test.db"));
+
+            var r2 = conn.execute(`select rowid, distance from vindex where vec_search(title, "${key}:10")`);
+            assert.deepEqual(r1, r2);
+            assert.deepEqual(r2.slice(0, 2).map(r => r.rowid).sort(), [10, 1000]);
+        });
+    });
+
+    describe("quantize", () => {
+        function insert_rows() {
+            conn.execute(`insert into vindex(title, rowid) values("[2,2,3]", 1)`);
+            conn.execute(`insert into vindex(title, rowid) values("[3,200,1]", 2)`);
+            conn.execute(`insert into vindex(title, rowid) values("[-1,2,10]", 3)`);
+            conn.execute(`insert into vindex(title, rowid) values("[1,2,5.1234]", 4)`);
+        }
+
+        it("bad options", () => {
+            assert.throws(() => {
+                conn.execute("create virtual table vindex using vec_index(title(3), quantize=int4)");
+            });
+
+            assert.throws(() => {
+                conn.execute("create virtual table vindex using vec_index(title(3), rerank=4)");
+            });
+        });
+
+        it("int8", () => {
+            conn.execute("create virtual table vindex using vec_index(title(3), quantize=int8)");
+            insert_rows();
+
+            var data = conn.execute(`select data from vec_index where tbl="vindex" and name="title"`)[0].data;
+            assert.equal(data.length, 4 * (3 + 8));
+            assert.deepEqual([data.readInt8(0), data.readInt8(1), data.readInt8(2)], [62, 62, 92]);
+
+            var res = conn.execute(`select rowid, distance from vindex where vec_search(title, "[1,2,5.1234]")`);
+            assert.equal(res.length, 4);
+            assert.equal(res[0].rowid, 4);
+            assert.closeTo(res[0].distance, 0, 0.02);
+            assert.equal(res[3].rowid, 2);
+            assert.closeTo(res[3].distance, 0.635004, 0.02);
+        });
+
+        it("binary", () => {
+            conn.execute("create virtual table vindex using vec_index(title(3), quantize=binary)");
+            insert_rows();
+
+            var data = conn.execute(`select data from vec_index where tbl="vindex" and name="title"`)[0].data;
+            assert.equal(data.length, 4 * (1 + 8));
+            assert.equal(data[0], 7);
+            assert.equal(data[18], 6);
+
+            var res = conn.execute(`select rowid, distance from vindex where vec_search(title, "[1,2,5.1234]")`);
+            assert.equal(res.length, 4);
+            assert.equal(res[3].rowid, 3);
+            assert.closeTo(res[3].distance, 2 / 3, 0.0001);
+        });
+
+        it("rerank", () => {
+            conn.execute("create virtual table vindex using vec_index(title(3), quantize=binary, rerank=4)");
+            insert_rows();
+
+            var res = conn.execute(`select rowid, distance from vindex where vec_search(title, "[1,2,5.1234]")`);
+            assert.deepEqual(res.map(r => r.rowid), [4, 3, 1, 2]);
+            assert.closeTo(res[1].distance, 0.053202, 0.0001);
+            assert.closeTo(res[2].distance, 0.072819, 0.0001);
+
+            conn.execute(`delete from vindex where rowid = 4`);
+            conn.execute(`update vindex set title="[1,2,5.1234]" where rowid = 2`);
+
+            var res = conn.execute(`select rowid, distance from vindex where vec_search(title, "[1,2,5.1234]:2")`);
+            assert.deepEqual(res.map(r => r.rowid), [2, 3]);
+            assert.closeTo(res[0].distance, 0, 0.0001);
+        });
+
+        it("rerank pages", () => {
+            conn = db.openSQLite(path.join(__dirname, "vec_test.db"));
+            conn.execute("create virtual table vindex using vec_index(title(128), quantize=binary, rerank=4)");
+
+            function rand_vec() {
+                var v = [];
+                for (var j = 0; j < 128; j++)
+                    v.push(Math.random() - 0.5);
+                return v;
+            }
+
+            function pages() {
+                return conn.execute(`select name, data from vec_index where tbl="vindex" and name like "title:float:%" order by name`);
+            }
+
+            var vecs = [];
+            conn.trans(() => {
+                for (var i = 0; i < 300; i++) {
+                    vecs.push(rand_vec());
+                    conn.execute("insert into vindex(title, rowid) values(?,?)", JSON.stringify(vecs[i]), i);
+                }
+            });
+
+            var p1 = pages();
+            assert.equal(p1.length, 3);
+
+            conn.execute(`update vindex set title=? where rowid = 280`, JSON.stringify(vecs[280] = rand_vec()));
+            var p2 = pages();
+            assert.deepEqual(p2[0], p1[0]);
+            assert.deepEqual(p2[1], p1[1]);
+            assert.notDeepEqual(p2[2], p1[2]);
+
+            conn.trans(() => {
+                conn.execute(`delete from vindex where rowid < 50`);
+                conn.execute(`update vindex set title=? where rowid = 100`, JSON.stringify(vecs[100] = rand_vec()));
+            });
+            assert.equal(pages().length, 2);
+
+            conn.close();
+            conn = db.openSQLite(path.join(__dirname, "vec_test.db"));
+
+            [100, 150, 280, 299].forEach(id => {
+                var key = JSON.stringify(vecs[id]);
+                var res = conn.execute(`select rowid, distance from vindex where vec_search(title, "${key}:1")`);
+                assert.equal(res[0].rowid, id);
+                assert.closeTo(res[0].distance, 0, 0.0001);
+            });
+        });
+
+        it("hnsw", () => {
+            conn.execute("create virtual table vindex using vec_index(title(3), index=hnsw, quantize=int8, rerank=2)");
+            insert_rows();
+
+            var res = conn.execute(`select rowid, distance from vindex where vec_search(title, "[1,2,5.1234]")`);
+            assert.deepEqual(res.map(r => r.rowid), [4, 3, 1, 2]);
+            assert.closeTo(res[0].distance, 0, 0.0001);
+        });
+    });
+
     it("benchmark", () => {
         conn.execute("create virtual table vindex using vec_index(title(3), description(3))");
 
@@ -5,6 +5,13 @@ var zlib = require('zlib');
 var io = require('io');
 var fs = require('fs');
 var path = require('path');
+var util = require('util');
+
+// brotli and zstd are compiled in only when the vender tree has them
+var vender = util.buildInfo().vender;
+var br_it = vender.brotli ? it : xit;
+var zstd_it = vender.zstd ? it : xit;
+var both_it = vender.brotli && vender.zstd ? it : xit;
 
 var M = 102400;
 var b = Buffer.alloc(M);
@@ -112,6 +119,126 @@ describe("zlib", () => {
         var f2 = fs.openFile(path.join(__dirname, 'zlib_files', 'original.js'));
         assert.deepEqual(zlib.inflateRaw(f1.readAll()), f2.readAll());
     });
+
+    br_it("brotli", () => {
+        assert.deepEqual(zlib.brotliDecompress(zlib.brotliCompress(b)), b);
+        assert.deepEqual(zlib.brotliDecompress(zlib.brotliCompress(b, 1)), b);
+        assert.deepEqual(zlib.brotliDecompress(zlib.brotliCompress(Buffer.alloc(0))), Buffer.alloc(0));
+    });
+
+    br_it("brotli maxSize", () => {
+        var data = zlib.brotliCompress(b, 5);
+        zlib.brotliDecompress(data, M);
+        assert.throws(() => {
+            zlib.brotliDecompress(data, M - 1);
+        });
+    });
+
+    br_it("brotliCompressTo/brotliDecompressTo (from Stream)", () => {
+        var stm = new io.MemoryStream();
+        stm.write(b);
+        stm.rewind();
+
+        var stm1 = new io.MemoryStream();
+        zlib.brotliCompressTo(stm, stm1, 5);
+        stm1.rewind();
+
+        var stm2 = new io.MemoryStream();
+        zlib.brotliDecompressTo(stm1, stm2);
+        stm2.rewind();
+        assert.deepEqual(stm2.readAll(), b);
+    });
+
+    zstd_it("zstd", () => {
+        assert.deepEqual(zlib.zstdDecompress(zlib.zstdCompress(b)), b);
+        assert.deepEqual(zlib.zstdDecompress(zlib.zstdCompress(b, 19)), b);
+        assert.deepEqual(zlib.zstdDecompress(zlib.zstdCompress(Buffer.alloc(0))), Buffer.alloc(0));
+    });
+
+    zstd_it("zstd maxSize", () => {
+        var data = zlib.zstdCompress(b);
+        zlib.zstdDecompress(data, M);
+        assert.throws(() => {
+            zlib.zstdDecompress(data, M - 1);
+        });
+    });
+
+    zstd_it("zstd dictionary", () => {
+        var dict = b.slice(0, 4096);
+        var data = b.slice(0, 1024);
+
+        var packed = zlib.zstdCompress(data, dict);
+        assert.lessThan(packed.length, zlib.zstdCompress(data).length);
+        assert.deepEqual(zlib.zstdDecompress(packed, dict), data);
+        assert.deepEqual(zlib.zstdDecompress(packed, dict, 1024), data);
+
+        assert.throws(() => {
+            zlib.zstdDecompress(packed);
+        });
+    });
+
+    zstd_it("zstdCompressTo/zstdDecompressTo (from Stream)", () => {
+        var stm = new io.MemoryStream();
+        stm.write(b);
+        stm.rewind();
+
+        var stm1 = new io.MemoryStream();
+        zlib.zstdCompressTo(stm, stm1);
+        stm1.rewind();
+
+        var stm2 = new io.MemoryStream();
+        zlib.zstdDecompressTo(stm1, stm2);
+        stm2.rewind();
+        assert.deepEqual(stm2.readAll(), b);
+    });
+
+    both_it("streaming brotli/zstd", () => {
+        function test_stream(comp, decomp, unpack) {
+            var stm = new io.MemoryStream();
+            var z = comp(stm);
+
+            z.write(b.slice(0, 1000));
+            z.flush();
+
+            var out = new io.MemoryStream();
+            var u = decomp(out);
+            stm.rewind();
+            u.write(stm.readAll());
+            u.flush();
+            out.rewind();
+            assert.deepEqual(out.readAll(), b.slice(0, 1000));
+
+            z.write(b.slice(1000));
+            z.close();
+
+            stm.rewind();
+            var data = stm.readAll();
+            assert.deepEqual(unpack(data), b);
+        }
+
+        test_stream(zlib.createBrotliCompress, zlib.createBrotliDecompress, zlib.brotliDecompress);
+        test_stream(zlib.createZstdCompress, zlib.createZstdDecompress, zlib.zstdDecompress);
+
+        var dict = b.slice(0, 4096);
+        test_stream(to => zlib.createZstdCompress(to, dict), to => zlib.createZstdDecompress(to, dict),
+            data => zlib.zstdDecompress(data, dict));
+    });
+
+    both_it("truncated brotli/zstd", () => {
+        var data = zlib.brotliCompress(b);
+        assert.throws(() => {
+            zlib.brotliDecompress(data.slice(0, data.length - 10));
+        });
+
+        data = zlib.zstdCompress(b);
+        assert.throws(() => {
+            zlib.zstdDecompress(data.slice(0, data.length - 10));
+        });
+
+        assert.throws(() => {
+            zlib.zstdDecompress(Buffer.from('not a zstd frame'));
+        });
+    });
 });
 
 require.main === module && test.run(console.DEBUG);
\ No newline at end of file